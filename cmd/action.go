@@ -3,6 +3,7 @@ package cmd
 import (
 	"fmt"
 
+	"github.com/mj1618/desktop-cli/internal/model"
 	"github.com/mj1618/desktop-cli/internal/output"
 	"github.com/mj1618/desktop-cli/internal/platform"
 	"github.com/spf13/cobra"
@@ -59,7 +60,7 @@ func init() {
 }
 
 func runAction(cmd *cobra.Command, args []string) error {
-	provider, err := platform.NewProvider()
+	provider, err := newProvider(cmd)
 	if err != nil {
 		return err
 	}
@@ -92,36 +93,41 @@ func runAction(cmd *cobra.Command, args []string) error {
 	prOpts := getPostReadOptions(cmd)
 	var preSnapshot elementSnapshot
 	var preActionTarget *ElementInfo
+	var preElements []model.Element // tree the target was found in, for --post-read-diff
+	var path []int
 
 	// Resolve target and capture pre-action snapshot
 	if hasRef && !hasID {
-		elem, _, err := resolveElementByRef(provider, appName, window, windowID, pid, ref)
+		elem, tree, err := resolveElementByRef(provider, appName, window, windowID, pid, ref)
 		if err != nil {
 			return err
 		}
-		id = elem.ID
+		preElements = tree
+		id, path = elem.ID, elem.Path
 		preActionTarget = elementInfoFromElement(elem)
 		if vOpts.Verify {
 			preSnapshot = snapshotElement(elem)
 		}
 	} else if hasText && !hasID {
-		elem, _, err := resolveElementByText(provider, appName, window, windowID, pid, text, roles, exact, scopeID)
+		elem, tree, err := resolveElementByText(provider, appName, window, windowID, pid, text, roles, exact, scopeID)
 		if err != nil {
 			return err
 		}
-		id = elem.ID
+		preElements = tree
+		id, path = elem.ID, elem.Path
 		preActionTarget = elementInfoFromElement(elem)
 		if vOpts.Verify {
 			preSnapshot = snapshotElement(elem)
 		}
 	} else {
 		preActionTarget = readElementByID(provider, appName, window, windowID, pid, id)
-		if vOpts.Verify && preActionTarget != nil {
+		if (vOpts.Verify || prOpts.Diff) && preActionTarget != nil {
 			// Re-read to get full element for snapshot
 			if elements, readErr := provider.Reader.ReadElements(platform.ReadOptions{
 				App: appName, Window: window, WindowID: windowID, PID: pid,
 			}); readErr == nil {
-				if el := findElementByID(elements, id); el != nil {
+				preElements = elements
+				if el := findElementByID(elements, id); el != nil && vOpts.Verify {
 					preSnapshot = snapshotElement(el)
 				}
 			}
@@ -134,6 +140,7 @@ func runAction(cmd *cobra.Command, args []string) error {
 		WindowID: windowID,
 		PID:      pid,
 		ID:       id,
+		Path:     path,
 		Action:   action,
 	}
 
@@ -163,11 +170,7 @@ func runAction(cmd *cobra.Command, args []string) error {
 	// Post-read: include full UI state in agent format
 	var state string
 	if prOpts.PostRead {
-		if vr.PostState != "" {
-			state = vr.PostState
-		} else {
-			state = readPostActionState(provider, appName, window, windowID, pid, prOpts.Delay, prOpts.MaxElements)
-		}
+		state = postActionState(provider, prOpts, vr, preElements, appName, window, windowID, pid)
 	}
 
 	result := ActionResult{
@@ -55,7 +55,7 @@ func init() {
 }
 
 func runAssert(cmd *cobra.Command, args []string) error {
-	provider, err := platform.NewProvider()
+	provider, err := newProvider(cmd)
 	if err != nil {
 		return err
 	}
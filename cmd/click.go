@@ -51,7 +51,7 @@ func init() {
 }
 
 func runClick(cmd *cobra.Command, args []string) error {
-	provider, err := platform.NewProvider()
+	provider, err := newProvider(cmd)
 	if err != nil {
 		return err
 	}
@@ -88,6 +88,7 @@ func runClick(cmd *cobra.Command, args []string) error {
 	prOpts := getPostReadOptions(cmd)
 	var preSnapshot elementSnapshot
 	var resolvedElem *model.Element // kept for verify fallback (action press)
+	var preElements []model.Element // tree the target was found in, for --post-read-diff
 	var targetBounds [4]int         // bounds of clicked element for display proximity
 
 	if hasRef {
@@ -95,10 +96,11 @@ func runClick(cmd *cobra.Command, args []string) error {
 		if appName == "" && window == "" {
 			return fmt.Errorf("--ref requires --app or --window to scope the element lookup")
 		}
-		elem, _, err := resolveElementByRef(provider, appName, window, 0, 0, ref)
+		elem, tree, err := resolveElementByRef(provider, appName, window, 0, 0, ref)
 		if err != nil {
 			return err
 		}
+		preElements = tree
 		targetBounds = elem.Bounds
 		x = elem.Bounds[0] + elem.Bounds[2]/2
 		y = elem.Bounds[1] + elem.Bounds[3]/2
@@ -120,6 +122,7 @@ func runClick(cmd *cobra.Command, args []string) error {
 			if err != nil {
 				return err
 			}
+			preElements = allElements
 
 			elem := pickBestNearMatch(allElements, allMatches)
 			targetBounds = elem.Bounds
@@ -144,10 +147,11 @@ func runClick(cmd *cobra.Command, args []string) error {
 				x, y = nearFallbackOffset(elem, nearDirection)
 			}
 		} else {
-			elem, _, err := resolveElementByText(provider, appName, window, 0, 0, text, roles, exact, scopeID)
+			elem, tree, err := resolveElementByText(provider, appName, window, 0, 0, text, roles, exact, scopeID)
 			if err != nil {
 				return err
 			}
+			preElements = tree
 
 			targetBounds = elem.Bounds
 			if vOpts.Verify {
@@ -174,6 +178,7 @@ func runClick(cmd *cobra.Command, args []string) error {
 		if err != nil {
 			return err
 		}
+		preElements = elements
 
 		elem := findElementByID(elements, id)
 		if elem == nil {
@@ -205,12 +210,12 @@ func runClick(cmd *cobra.Command, args []string) error {
 		var fallbacks []fallbackAction
 		// Fallback 1: accessibility "press" action
 		if provider.ActionPerformer != nil && resolvedElem != nil {
-			elemID := resolvedElem.ID
+			elemID, elemPath := resolvedElem.ID, resolvedElem.Path
 			fallbacks = append(fallbacks, fallbackAction{
 				Method: "action",
 				Execute: func() error {
 					return provider.ActionPerformer.PerformAction(platform.ActionOptions{
-						App: appName, Window: window, ID: elemID, Action: "press",
+						App: appName, Window: window, ID: elemID, Path: elemPath, Action: "press",
 					})
 				},
 			})
@@ -236,12 +241,7 @@ func runClick(cmd *cobra.Command, args []string) error {
 	// Post-read: include full UI state in agent format
 	var state string
 	if prOpts.PostRead && (appName != "" || window != "") {
-		if vr.PostState != "" {
-			// Reuse the tree already read during verification
-			state = vr.PostState
-		} else {
-			state = readPostActionState(provider, appName, window, 0, 0, prOpts.Delay, prOpts.MaxElements)
-		}
+		state = postActionState(provider, prOpts, vr, preElements, appName, window, 0, 0)
 	}
 
 	result := ClickResult{
@@ -78,7 +78,7 @@ func init() {
 }
 
 func runClipboardRead(cmd *cobra.Command, args []string) error {
-	provider, err := platform.NewProvider()
+	provider, err := newProvider(cmd)
 	if err != nil {
 		return err
 	}
@@ -99,7 +99,7 @@ func runClipboardRead(cmd *cobra.Command, args []string) error {
 }
 
 func runClipboardWrite(cmd *cobra.Command, args []string) error {
-	provider, err := platform.NewProvider()
+	provider, err := newProvider(cmd)
 	if err != nil {
 		return err
 	}
@@ -130,7 +130,7 @@ func runClipboardWrite(cmd *cobra.Command, args []string) error {
 }
 
 func runClipboardClear(cmd *cobra.Command, args []string) error {
-	provider, err := platform.NewProvider()
+	provider, err := newProvider(cmd)
 	if err != nil {
 		return err
 	}
@@ -149,7 +149,7 @@ func runClipboardClear(cmd *cobra.Command, args []string) error {
 }
 
 func runClipboardGrab(cmd *cobra.Command, args []string) error {
-	provider, err := platform.NewProvider()
+	provider, err := newProvider(cmd)
 	if err != nil {
 		return err
 	}
@@ -182,8 +182,8 @@ func runClipboardGrab(cmd *cobra.Command, args []string) error {
 		return fmt.Errorf("failed to focus app: %w", err)
 	}
 
-	// Brief pause for focus to settle
-	time.Sleep(100 * time.Millisecond)
+	// Wait for the app to come to the front
+	waitFrontmost(provider, appName, pid, 100*time.Millisecond)
 
 	// Select all (Cmd+A)
 	if err := provider.Inputter.KeyCombo(strings.Split("cmd+a", "+")); err != nil {
@@ -191,14 +191,12 @@ func runClipboardGrab(cmd *cobra.Command, args []string) error {
 	}
 	time.Sleep(50 * time.Millisecond)
 
-	// Copy (Cmd+C)
+	// Copy (Cmd+C), then wait for the clipboard to change
+	mark := markClipboard(provider.ClipboardManager)
 	if err := provider.Inputter.KeyCombo(strings.Split("cmd+c", "+")); err != nil {
 		return fmt.Errorf("failed to copy: %w", err)
 	}
-	time.Sleep(100 * time.Millisecond)
-
-	// Read clipboard
-	text, err := provider.ClipboardManager.GetText()
+	text, err := waitClipboardChange(provider.ClipboardManager, mark, 100*time.Millisecond)
 	if err != nil {
 		return err
 	}
@@ -1,11 +1,13 @@
 package cmd
 
 import (
+	"errors"
 	"fmt"
 	"io"
 	"os"
 	"os/exec"
 	"strings"
+	"sync"
 	"time"
 
 	"github.com/mj1618/desktop-cli/internal/model"
@@ -24,6 +26,15 @@ type DoResult struct {
 	Error     string       `yaml:"error,omitempty"     json:"error,omitempty"`
 	Results   []StepResult `yaml:"results"             json:"results"`
 	Display   []ElementInfo `yaml:"display,omitempty"  json:"display,omitempty"`
+	// TraversalsSaved counts element tree reads served from the batch's
+	// tree cache instead of the accessibility API.
+	TraversalsSaved int `yaml:"traversals_saved,omitempty" json:"traversals_saved,omitempty"`
+	// PrefetchHits counts reads served by a tree prefetched while the batch
+	// was waiting.
+	PrefetchHits int `yaml:"prefetch_hits,omitempty" json:"prefetch_hits,omitempty"`
+	// DisplayReused is true when the display elements came from a tree the
+	// batch read after its last UI write, rather than from a final read.
+	DisplayReused bool `yaml:"display_reused,omitempty" json:"display_reused,omitempty"`
 }
 
 // StepResult is the output for a single step within a batch.
@@ -90,7 +101,7 @@ func init() {
 }
 
 func runDo(cmd *cobra.Command, args []string) error {
-	provider, err := platform.NewProvider()
+	provider, err := newProvider(cmd)
 	if err != nil {
 		return err
 	}
@@ -113,8 +124,10 @@ func runDo(cmd *cobra.Command, args []string) error {
 		return fmt.Errorf("failed to parse YAML steps: %w", err)
 	}
 
-	if len(rawSteps) == 0 {
-		return fmt.Errorf("no steps provided — expected a YAML list of actions")
+	// Validate every step before running any of them.
+	plan, err := CompileDo(rawSteps, defaultApp, defaultWindow)
+	if err != nil {
+		return err
 	}
 
 	ctx := &DoContext{
@@ -124,7 +137,7 @@ func runDo(cmd *cobra.Command, args []string) error {
 		StopOnError:   stopOnError,
 	}
 
-	ctx.ExecuteSteps(rawSteps, 0)
+	ctx.ExecutePlan(plan)
 
 	results := ctx.Results
 	hasFailure := ctx.HasFailure
@@ -146,19 +159,24 @@ func runDo(cmd *cobra.Command, args []string) error {
 
 	// Collect display elements once at the end using the last app context
 	var display []ElementInfo
+	displayReused := false
 	if lastApp != "" {
-		display = readDisplayElements(provider, lastApp, defaultWindow, 0, 0, [4]int{})
+		display, displayReused = ctx.finalDisplay(lastApp, defaultWindow)
 	}
 
 	allOK := !hasFailure
 	return output.Print(DoResult{
 		OK:        allOK,
 		Action:    "do",
-		Steps:     len(rawSteps),
+		Steps:     plan.Len(),
 		Completed: completed,
 		Error:     lastErr,
 		Results:   results,
 		Display:   display,
+
+		TraversalsSaved: ctx.TraversalsSaved(),
+		PrefetchHits:    ctx.PrefetchHits(),
+		DisplayReused:   displayReused,
 	})
 }
 
@@ -173,57 +191,208 @@ type DoContext struct {
 	HasFailure    bool
 	Stopped       bool
 	LastApp       string
+
+	// trees is shared by the contexts of nested steps (then/else/try).
+	trees *doTreeCache
+	// input serializes the steps that drive the global mouse and keyboard
+	// once a parallel group has started; nil before that.
+	input *sync.Mutex
+}
+
+// provider returns ctx.Provider reading through the batch's tree cache:
+// steps that only read share the last tree of their scope, and steps that
+// write to the UI make the next read fetch a fresh one.
+func (ctx *DoContext) provider() *platform.Provider {
+	if ctx.Provider == nil {
+		return nil
+	}
+	if ctx.trees == nil {
+		ctx.trees = newDoTreeCache(ctx.Provider)
+	}
+	return ctx.trees.provider
+}
+
+// refreshTrees drops the cached trees before a step that asked for a fresh
+// read (refresh: true) or that lets the UI change on its own.
+func (ctx *DoContext) refreshTrees() {
+	if ctx.trees != nil {
+		ctx.trees.invalidate()
+	}
+}
+
+// TraversalsSaved returns the number of element tree reads the batch served
+// from its tree cache.
+func (ctx *DoContext) TraversalsSaved() int {
+	if ctx.trees == nil {
+		return 0
+	}
+	return ctx.trees.traversalsSaved()
+}
+
+// PrefetchHits returns the number of element tree reads the batch served
+// from trees prefetched during sleeps and settle delays.
+func (ctx *DoContext) PrefetchHits() int {
+	if ctx.trees == nil {
+		return 0
+	}
+	return ctx.trees.prefetchHits()
+}
+
+// finalDisplay returns the display elements of app at the end of the batch.
+// If a step read a tree of app after the batch last wrote to the UI — a
+// verify or post-read after its final input, or a read-only step — that
+// tree is used (reused is true); otherwise the tree is read.
+func (ctx *DoContext) finalDisplay(app, window string) (display []ElementInfo, reused bool) {
+	if ctx.trees != nil {
+		if elements, ok := ctx.trees.latest(app, window); ok {
+			return displayElementInfos(elements, [4]int{}), true
+		}
+	}
+	return readDisplayElements(ctx.provider(), app, window, 0, 0, [4]int{}), false
+}
+
+// nextRead returns the tree read the first of steps starts with, if it
+// starts by reading a tree (to find its target or check a condition).
+func (ctx *DoContext) nextRead(steps []doStep) (platform.ReadOptions, bool) {
+	if len(steps) == 0 || ctx.trees == nil {
+		return platform.ReadOptions{}, false
+	}
+	step := steps[0]
+	reads := false
+	switch step.action {
+	case "if-exists", "if-focused":
+		reads = true
+	case "click", "hover", "type", "action", "set-value", "scroll", "assert":
+		for _, k := range []string{"text", "ref", "id", "target"} {
+			if _, ok := step.params[k]; ok && !(step.action == "type" && k == "text") {
+				reads = true
+			}
+		}
+	}
+	if !reads || step.err != nil || step.refresh {
+		return platform.ReadOptions{}, false
+	}
+	return platform.ReadOptions{
+		App:      step.app,
+		Window:   step.window,
+		WindowID: IntParam(step.params, "window-id", 0),
+		PID:      IntParam(step.params, "pid", 0),
+	}, true
+}
+
+// subContext returns the context for nested steps, sharing ctx's tree cache.
+func (ctx *DoContext) subContext(stopOnError bool) *DoContext {
+	ctx.provider()
+	return &DoContext{
+		Provider:      ctx.Provider,
+		DefaultApp:    ctx.DefaultApp,
+		DefaultWindow: ctx.DefaultWindow,
+		StopOnError:   stopOnError,
+		LastApp:       ctx.LastApp,
+		trees:         ctx.trees,
+		input:         ctx.input,
+	}
+}
+
+// usesInput reports whether a step drives the global mouse, keyboard or
+// window focus, which steps running in parallel must take turns with.
+// Reads, assertions and steps that go through the accessibility API
+// (action, set-value) do not, except a set-value that verifies: if the
+// value does not take, it falls back to clicking the element and typing.
+func usesInput(action string, params map[string]interface{}) bool {
+	switch action {
+	case "click", "hover", "type", "scroll", "focus", "fill", "open":
+		return true
+	case "set-value":
+		return getVerifyOptionsFromParams(params).Verify
+	}
+	return false
 }
 
-// executeSteps runs a list of raw YAML steps, appending results to ctx.Results.
-// stepOffset is added to step numbers for substep numbering.
+// arbitrate waits for the input arbiter if the step needs it, returning the
+// function that releases it.
+func (ctx *DoContext) arbitrate(action string, params map[string]interface{}) func() {
+	if ctx.input == nil || !usesInput(action, params) {
+		return func() {}
+	}
+	ctx.input.Lock()
+	return ctx.input.Unlock
+}
+
+// ExecuteSteps runs a list of raw YAML steps, appending results to ctx.Results.
+// stepOffset is added to step numbers for substep numbering. Invalid steps
+// fail when they are reached; use CompileDo and ExecutePlan to validate a
+// batch before running any of it.
 func (ctx *DoContext) ExecuteSteps(rawSteps []map[string]interface{}, stepOffset int) {
-	for i, step := range rawSteps {
+	ctx.run(compileSteps(rawSteps, ctx.DefaultApp, ctx.DefaultWindow), stepOffset)
+}
+
+// ExecutePlan runs a compiled batch, appending results to ctx.Results.
+func (ctx *DoContext) ExecutePlan(plan *DoPlan) {
+	ctx.run(plan.steps, 0)
+}
+
+// run executes compiled steps, appending results to ctx.Results.
+func (ctx *DoContext) run(steps []doStep, stepOffset int) {
+	for i, step := range steps {
 		if ctx.Stopped {
 			break
 		}
 		stepNum := stepOffset + i + 1
 
-		// Check for conditional step types
-		if _, ok := step["if-exists"]; ok {
+		switch step.action {
+		case "if-exists":
 			ctx.executeIfExists(step, stepNum)
 			continue
-		}
-		if _, ok := step["if-focused"]; ok {
+		case "if-focused":
 			ctx.executeIfFocused(step, stepNum)
 			continue
-		}
-		if _, ok := step["try"]; ok {
+		case "try":
 			ctx.executeTry(step, stepNum)
 			continue
+		case "parallel":
+			ctx.executeParallel(step, stepNum)
+			continue
 		}
 
-		// Regular step: find the single action key
-		action, params, err := parseRegularStep(step)
-		if err != nil {
-			ctx.HasFailure = true
-			if ctx.StopOnError {
-				ctx.Results = append(ctx.Results, StepResult{Step: stepNum, OK: false, Error: err.Error()})
-				ctx.Stopped = true
+		// Regular step
+		if step.err != nil {
+			ctx.fail(StepResult{Step: stepNum, OK: false, Error: step.err.Error()})
+			if ctx.Stopped {
 				break
 			}
-			ctx.Results = append(ctx.Results, StepResult{Step: stepNum, OK: false, Error: err.Error()})
 			continue
 		}
 
-		app := StringParam(params, "app", ctx.DefaultApp)
-		window := StringParam(params, "window", ctx.DefaultWindow)
-		ctx.LastApp = app
+		action, params := step.action, step.params
+		ctx.LastApp = step.app
 
-		result, execErr := ExecuteStep(ctx.Provider, action, params, app, window)
+		provider := ctx.provider()
+		switch {
+		case action == "wait":
+			// wait polls for changes, so every one of its reads must be fresh.
+			provider = ctx.Provider
+			ctx.refreshTrees()
+		case action == "sleep" || action == "open" || step.refresh:
+			ctx.refreshTrees()
+		}
+
+		var result StepResult
+		var execErr error
+		release := ctx.arbitrate(action, params)
+		if next, ok := ctx.nextRead(steps[i+1:]); action == "sleep" && ok {
+			// Read the next step's tree while sleeping.
+			result, execErr = executeSleep(params, func(d time.Duration) { ctx.trees.pause(d, next) })
+		} else {
+			result, execErr = ExecuteStep(provider, action, params, step.app, step.window)
+		}
+		release()
 		result.Step = stepNum
 		if execErr != nil {
 			result.OK = false
 			result.Error = execErr.Error()
-			ctx.Results = append(ctx.Results, result)
-			ctx.HasFailure = true
-			if ctx.StopOnError {
-				ctx.Stopped = true
+			ctx.fail(result)
+			if ctx.Stopped {
 				break
 			}
 		} else {
@@ -233,6 +402,15 @@ func (ctx *DoContext) ExecuteSteps(rawSteps []map[string]interface{}, stepOffset
 	}
 }
 
+// fail records a failed step, stopping the batch if StopOnError is set.
+func (ctx *DoContext) fail(result StepResult) {
+	ctx.HasFailure = true
+	ctx.Results = append(ctx.Results, result)
+	if ctx.StopOnError {
+		ctx.Stopped = true
+	}
+}
+
 // parseRegularStep extracts the action name and params from a regular (non-conditional) step.
 func parseRegularStep(step map[string]interface{}) (string, map[string]interface{}, error) {
 	// Find the action key (skip "then", "else" which belong to conditionals)
@@ -281,36 +459,32 @@ func parseSubsteps(raw interface{}) ([]map[string]interface{}, error) {
 }
 
 // executeIfExists handles the if-exists conditional step.
-func (ctx *DoContext) executeIfExists(step map[string]interface{}, stepNum int) {
-	condRaw := step["if-exists"]
-	condParams, ok := condRaw.(map[string]interface{})
-	if !ok {
-		ctx.HasFailure = true
-		r := StepResult{Step: stepNum, OK: false, Action: "if-exists", Error: "if-exists condition must be a map with text/roles/id params"}
-		ctx.Results = append(ctx.Results, r)
-		if ctx.StopOnError {
-			ctx.Stopped = true
-		}
+func (ctx *DoContext) executeIfExists(step doStep, stepNum int) {
+	if step.err != nil {
+		ctx.fail(StepResult{Step: stepNum, OK: false, Action: "if-exists", Error: step.err.Error()})
 		return
 	}
 
 	// Check if the element exists
+	condParams := step.params
 	text := StringParam(condParams, "text", "")
 	id := IntParam(condParams, "id", 0)
 	roles := StringParam(condParams, "roles", "")
 	exact := BoolParam(condParams, "exact", false)
 	scopeID := IntParam(condParams, "scope-id", 0)
-	app := StringParam(condParams, "app", ctx.DefaultApp)
-	window := StringParam(condParams, "window", ctx.DefaultWindow)
+	app, window := step.app, step.window
 	ctx.LastApp = app
+	if step.refresh {
+		ctx.refreshTrees()
+	}
 
 	matched := false
 	if text != "" && ctx.Provider != nil {
-		elem, _, err := resolveElementByText(ctx.Provider, app, window, 0, 0, text, roles, exact, scopeID)
+		elem, _, err := resolveElementByText(ctx.provider(), app, window, 0, 0, text, roles, exact, scopeID)
 		matched = err == nil && elem != nil
 	} else if id > 0 {
 		if ctx.Provider.Reader != nil {
-			elements, err := ctx.Provider.Reader.ReadElements(platform.ReadOptions{App: app, Window: window})
+			elements, err := ctx.provider().Reader.ReadElements(platform.ReadOptions{App: app, Window: window})
 			if err == nil {
 				matched = findElementByID(elements, id) != nil
 			}
@@ -324,91 +498,29 @@ func (ctx *DoContext) executeIfExists(step map[string]interface{}, stepNum int)
 		Action:  "if-exists",
 		Matched: &matchedVal,
 	}
-
-	// Determine which branch to execute
-	var substeps []map[string]interface{}
-	if matched {
-		result.Branch = "then"
-		if thenRaw, ok := step["then"]; ok {
-			var err error
-			substeps, err = parseSubsteps(thenRaw)
-			if err != nil {
-				result.OK = false
-				result.Error = fmt.Sprintf("invalid then steps: %s", err)
-				ctx.HasFailure = true
-				ctx.Results = append(ctx.Results, result)
-				if ctx.StopOnError {
-					ctx.Stopped = true
-				}
-				return
-			}
-		}
-	} else {
-		result.Branch = "else"
-		if elseRaw, ok := step["else"]; ok {
-			var err error
-			substeps, err = parseSubsteps(elseRaw)
-			if err != nil {
-				result.OK = false
-				result.Error = fmt.Sprintf("invalid else steps: %s", err)
-				ctx.HasFailure = true
-				ctx.Results = append(ctx.Results, result)
-				if ctx.StopOnError {
-					ctx.Stopped = true
-				}
-				return
-			}
-		}
-	}
-
-	// Execute the selected branch, collecting substep results
-	if len(substeps) > 0 {
-		subCtx := &DoContext{
-			Provider:      ctx.Provider,
-			DefaultApp:    ctx.DefaultApp,
-			DefaultWindow: ctx.DefaultWindow,
-			StopOnError:   ctx.StopOnError,
-			LastApp:       ctx.LastApp,
-		}
-		subCtx.ExecuteSteps(substeps, 0)
-		result.Substeps = subCtx.Results
-		ctx.LastApp = subCtx.LastApp
-		if subCtx.HasFailure {
-			ctx.HasFailure = true
-			result.OK = false
-			if ctx.StopOnError {
-				ctx.Stopped = true
-			}
-		}
-	}
-
-	ctx.Results = append(ctx.Results, result)
+	ctx.executeBranch(step, matched, result)
 }
 
 // executeIfFocused handles the if-focused conditional step.
-func (ctx *DoContext) executeIfFocused(step map[string]interface{}, stepNum int) {
-	condRaw := step["if-focused"]
-	condParams, ok := condRaw.(map[string]interface{})
-	if !ok {
-		ctx.HasFailure = true
-		r := StepResult{Step: stepNum, OK: false, Action: "if-focused", Error: "if-focused condition must be a map with roles/text params"}
-		ctx.Results = append(ctx.Results, r)
-		if ctx.StopOnError {
-			ctx.Stopped = true
-		}
+func (ctx *DoContext) executeIfFocused(step doStep, stepNum int) {
+	if step.err != nil {
+		ctx.fail(StepResult{Step: stepNum, OK: false, Action: "if-focused", Error: step.err.Error()})
 		return
 	}
 
+	condParams := step.params
 	roles := StringParam(condParams, "roles", "")
 	text := StringParam(condParams, "text", "")
-	app := StringParam(condParams, "app", ctx.DefaultApp)
-	window := StringParam(condParams, "window", ctx.DefaultWindow)
+	app, window := step.app, step.window
 	ctx.LastApp = app
+	if step.refresh {
+		ctx.refreshTrees()
+	}
 
 	// Read the focused element
 	var focusedInfo *ElementInfo
 	if ctx.Provider != nil {
-		focusedInfo = readFocusedElement(ctx.Provider, app, window, 0, 0)
+		focusedInfo = readFocusedElement(ctx.provider(), app, window, 0, 0)
 	}
 
 	matched := false
@@ -446,51 +558,29 @@ func (ctx *DoContext) executeIfFocused(step map[string]interface{}, stepNum int)
 		Matched: &matchedVal,
 		Focused: focusedInfo,
 	}
+	ctx.executeBranch(step, matched, result)
+}
 
-	var substeps []map[string]interface{}
-	if matched {
-		result.Branch = "then"
-		if thenRaw, ok := step["then"]; ok {
-			var err error
-			substeps, err = parseSubsteps(thenRaw)
-			if err != nil {
-				result.OK = false
-				result.Error = fmt.Sprintf("invalid then steps: %s", err)
-				ctx.HasFailure = true
-				ctx.Results = append(ctx.Results, result)
-				if ctx.StopOnError {
-					ctx.Stopped = true
-				}
-				return
-			}
-		}
-	} else {
+// executeBranch runs the then or else branch of a conditional step,
+// collecting its results as substeps of result, and records result.
+func (ctx *DoContext) executeBranch(step doStep, matched bool, result StepResult) {
+	substeps, branchErr := step.then, step.thenErr
+	result.Branch = "then"
+	if !matched {
+		substeps, branchErr = step.els, step.elseErr
 		result.Branch = "else"
-		if elseRaw, ok := step["else"]; ok {
-			var err error
-			substeps, err = parseSubsteps(elseRaw)
-			if err != nil {
-				result.OK = false
-				result.Error = fmt.Sprintf("invalid else steps: %s", err)
-				ctx.HasFailure = true
-				ctx.Results = append(ctx.Results, result)
-				if ctx.StopOnError {
-					ctx.Stopped = true
-				}
-				return
-			}
-		}
+	}
+	if branchErr != nil {
+		result.OK = false
+		result.Error = fmt.Sprintf("invalid %s steps: %s", result.Branch, branchErr)
+		ctx.fail(result)
+		return
 	}
 
+	// Execute the selected branch, collecting substep results
 	if len(substeps) > 0 {
-		subCtx := &DoContext{
-			Provider:      ctx.Provider,
-			DefaultApp:    ctx.DefaultApp,
-			DefaultWindow: ctx.DefaultWindow,
-			StopOnError:   ctx.StopOnError,
-			LastApp:       ctx.LastApp,
-		}
-		subCtx.ExecuteSteps(substeps, 0)
+		subCtx := ctx.subContext(ctx.StopOnError)
+		subCtx.run(substeps, 0)
 		result.Substeps = subCtx.Results
 		ctx.LastApp = subCtx.LastApp
 		if subCtx.HasFailure {
@@ -506,29 +596,16 @@ func (ctx *DoContext) executeIfFocused(step map[string]interface{}, stepNum int)
 }
 
 // executeTry handles the try step type — executes substeps and always continues.
-func (ctx *DoContext) executeTry(step map[string]interface{}, stepNum int) {
-	tryRaw := step["try"]
-	substeps, err := parseSubsteps(tryRaw)
-	if err != nil {
-		ctx.HasFailure = true
-		r := StepResult{Step: stepNum, OK: false, Action: "try", Error: fmt.Sprintf("invalid try steps: %s", err)}
-		ctx.Results = append(ctx.Results, r)
-		if ctx.StopOnError {
-			ctx.Stopped = true
-		}
+func (ctx *DoContext) executeTry(step doStep, stepNum int) {
+	if step.err != nil {
+		ctx.fail(StepResult{Step: stepNum, OK: false, Action: "try", Error: step.err.Error()})
 		return
 	}
 
 	// Execute substeps with stopOnError=true (stop within the try block on first error)
 	// but the try block itself always succeeds
-	subCtx := &DoContext{
-		Provider:      ctx.Provider,
-		DefaultApp:    ctx.DefaultApp,
-		DefaultWindow: ctx.DefaultWindow,
-		StopOnError:   true, // stop within try on first error
-		LastApp:       ctx.LastApp,
-	}
-	subCtx.ExecuteSteps(substeps, 0)
+	subCtx := ctx.subContext(true) // stop within try on first error
+	subCtx.run(step.substeps, 0)
 
 	result := StepResult{
 		Step:     stepNum,
@@ -541,6 +618,48 @@ func (ctx *DoContext) executeTry(step map[string]interface{}, stepNum int) {
 	ctx.Results = append(ctx.Results, result)
 }
 
+// executeParallel handles the parallel step type — runs each substep
+// concurrently and waits for all of them. Substeps that use the global mouse
+// or keyboard (see usesInput) still run one at a time. Results are reported
+// in declaration order; the group fails if any substep failed.
+func (ctx *DoContext) executeParallel(step doStep, stepNum int) {
+	if step.err != nil {
+		ctx.fail(StepResult{Step: stepNum, OK: false, Action: "parallel", Error: step.err.Error()})
+		return
+	}
+
+	if ctx.input == nil {
+		ctx.input = &sync.Mutex{}
+	}
+	subCtxs := make([]*DoContext, len(step.substeps))
+	var wg sync.WaitGroup
+	for i := range step.substeps {
+		subCtxs[i] = ctx.subContext(ctx.StopOnError)
+		wg.Add(1)
+		go func(i int) {
+			defer wg.Done()
+			subCtxs[i].run(step.substeps[i:i+1], i)
+		}(i)
+	}
+	wg.Wait()
+
+	result := StepResult{Step: stepNum, OK: true, Action: "parallel"}
+	for _, subCtx := range subCtxs {
+		result.Substeps = append(result.Substeps, subCtx.Results...)
+		ctx.LastApp = subCtx.LastApp
+		if subCtx.HasFailure {
+			result.OK = false
+		}
+	}
+	if !result.OK {
+		ctx.HasFailure = true
+		if ctx.StopOnError {
+			ctx.Stopped = true
+		}
+	}
+	ctx.Results = append(ctx.Results, result)
+}
+
 // ExecuteStep dispatches a single action step to the appropriate handler.
 // Used by both the `do` batch command and the MCP server.
 func ExecuteStep(provider *platform.Provider, action string, params map[string]interface{}, app, window string) (StepResult, error) {
@@ -572,10 +691,15 @@ func ExecuteStep(provider *platform.Provider, action string, params map[string]i
 	case "sleep":
 		return ExecuteSleep(params)
 	default:
-		return StepResult{Action: action}, fmt.Errorf("unknown step type %q — supported: click, hover, type, action, set-value, fill, scroll, wait, focus, read, open, assert, sleep, if-exists, if-focused, try", action)
+		return StepResult{Action: action}, unknownStepError(action)
 	}
 }
 
+// unknownStepError is the error for a step of an unknown type.
+func unknownStepError(action string) error {
+	return fmt.Errorf("unknown step type %q — supported: click, hover, type, action, set-value, fill, scroll, wait, focus, read, open, assert, sleep, if-exists, if-focused, try, parallel", action)
+}
+
 // getVerifyOptionsFromParams extracts verify options from a do-step params map.
 func getVerifyOptionsFromParams(params map[string]interface{}) verifyOptions {
 	return verifyOptions{
@@ -698,12 +822,12 @@ func ExecuteClick(provider *platform.Provider, params map[string]interface{}, ap
 	if vOpts.Verify && preSnapshot.Exists {
 		var fallbacks []fallbackAction
 		if provider.ActionPerformer != nil && resolvedElem != nil {
-			elemID := resolvedElem.ID
+			elemID, elemPath := resolvedElem.ID, resolvedElem.Path
 			fallbacks = append(fallbacks, fallbackAction{
 				Method: "action",
 				Execute: func() error {
 					return provider.ActionPerformer.PerformAction(platform.ActionOptions{
-						App: app, Window: window, ID: elemID, Action: "press",
+						App: app, Window: window, ID: elemID, Path: elemPath, Action: "press",
 					})
 				},
 			})
@@ -793,6 +917,7 @@ func ExecuteType(provider *platform.Provider, params map[string]interface{}, app
 	exact := BoolParam(params, "exact", false)
 	scopeID := IntParam(params, "scope-id", 0)
 	delayMs := IntParam(params, "delay", 0)
+	useKeypad := BoolParam(params, "keypad", false)
 
 	if text == "" && key == "" {
 		return StepResult{Action: "type"}, fmt.Errorf("specify text or key")
@@ -810,12 +935,9 @@ func ExecuteType(provider *platform.Provider, params map[string]interface{}, app
 		}
 		hasTargetedElement = true
 		verifyElemID = elem.ID
-		cx := elem.Bounds[0] + elem.Bounds[2]/2
-		cy := elem.Bounds[1] + elem.Bounds[3]/2
-		if err := provider.Inputter.Click(cx, cy, platform.MouseLeft, 1); err != nil {
+		if err := clickToFocus(provider, platform.ReadOptions{App: app, Window: window}, elem); err != nil {
 			return StepResult{Action: "type"}, fmt.Errorf("failed to focus element: %w", err)
 		}
-		time.Sleep(50 * time.Millisecond)
 	} else if target != "" {
 		elem, _, err := resolveElementByText(provider, app, window, 0, 0, target, roles, exact, scopeID)
 		if err != nil {
@@ -823,12 +945,9 @@ func ExecuteType(provider *platform.Provider, params map[string]interface{}, app
 		}
 		hasTargetedElement = true
 		verifyElemID = elem.ID
-		cx := elem.Bounds[0] + elem.Bounds[2]/2
-		cy := elem.Bounds[1] + elem.Bounds[3]/2
-		if err := provider.Inputter.Click(cx, cy, platform.MouseLeft, 1); err != nil {
+		if err := clickToFocus(provider, platform.ReadOptions{App: app, Window: window}, elem); err != nil {
 			return StepResult{Action: "type"}, fmt.Errorf("failed to focus element: %w", err)
 		}
-		time.Sleep(50 * time.Millisecond)
 	} else if id > 0 {
 		if provider.Reader == nil {
 			return StepResult{Action: "type"}, fmt.Errorf("reader not available on this platform")
@@ -843,12 +962,9 @@ func ExecuteType(provider *platform.Provider, params map[string]interface{}, app
 		}
 		hasTargetedElement = true
 		verifyElemID = elem.ID
-		cx := elem.Bounds[0] + elem.Bounds[2]/2
-		cy := elem.Bounds[1] + elem.Bounds[3]/2
-		if err := provider.Inputter.Click(cx, cy, platform.MouseLeft, 1); err != nil {
+		if err := clickToFocus(provider, platform.ReadOptions{App: app, Window: window}, elem); err != nil {
 			return StepResult{Action: "type"}, fmt.Errorf("failed to focus element: %w", err)
 		}
-		time.Sleep(50 * time.Millisecond)
 	}
 
 	// Snapshot focused element for verification (after click-to-focus, before typing)
@@ -867,8 +983,8 @@ func ExecuteType(provider *platform.Provider, params map[string]interface{}, app
 
 	// Type text
 	if text != "" {
-		if isCalculatorApp(app) && !hasTargetedElement && provider.ActionPerformer != nil {
-			if err := typeViaButtons(provider, app, window, text); err != nil {
+		if !hasTargetedElement && (useKeypad || (isCalculatorApp(app) && provider.ActionPerformer != nil)) {
+			if err := typeOnKeypad(provider, app, window, text); err != nil {
 				return StepResult{Action: "type"}, err
 			}
 		} else {
@@ -876,7 +992,7 @@ func ExecuteType(provider *platform.Provider, params map[string]interface{}, app
 				return StepResult{Action: "type"}, err
 			}
 		}
-		time.Sleep(50 * time.Millisecond)
+		pause(provider, 50*time.Millisecond, platform.ReadOptions{App: app, Window: window})
 	}
 
 	// Capture target info after typing but before key press
@@ -891,7 +1007,7 @@ func ExecuteType(provider *platform.Provider, params map[string]interface{}, app
 		if err := provider.Inputter.KeyCombo(keys); err != nil {
 			return StepResult{Action: "type"}, err
 		}
-		time.Sleep(80 * time.Millisecond)
+		pause(provider, 80*time.Millisecond, platform.ReadOptions{App: app, Window: window})
 	}
 
 	result := StepResult{Text: text, Key: key}
@@ -954,13 +1070,14 @@ func ExecuteAction(provider *platform.Provider, params map[string]interface{}, a
 	vOpts := getVerifyOptionsFromParams(params)
 	var preSnapshot elementSnapshot
 	var preActionTarget *ElementInfo
+	var path []int
 
 	if ref != "" && id == 0 {
 		elem, _, err := resolveElementByRef(provider, app, window, windowID, pid, ref)
 		if err != nil {
 			return StepResult{Action: "action"}, err
 		}
-		id = elem.ID
+		id, path = elem.ID, elem.Path
 		preActionTarget = elementInfoFromElement(elem)
 		if vOpts.Verify {
 			preSnapshot = snapshotElement(elem)
@@ -970,7 +1087,7 @@ func ExecuteAction(provider *platform.Provider, params map[string]interface{}, a
 		if err != nil {
 			return StepResult{Action: "action"}, err
 		}
-		id = elem.ID
+		id, path = elem.ID, elem.Path
 		preActionTarget = elementInfoFromElement(elem)
 		if vOpts.Verify {
 			preSnapshot = snapshotElement(elem)
@@ -994,6 +1111,7 @@ func ExecuteAction(provider *platform.Provider, params map[string]interface{}, a
 		WindowID: windowID,
 		PID:      pid,
 		ID:       id,
+		Path:     path,
 		Action:   actionName,
 	}
 
@@ -1067,6 +1185,7 @@ func ExecuteSetValue(provider *platform.Provider, params map[string]interface{},
 		WindowID:  windowID,
 		PID:       pid,
 		ID:        id,
+		Path:      elementPath(resolvedElem),
 		Value:     value,
 		Attribute: attribute,
 	}
@@ -1080,16 +1199,13 @@ func ExecuteSetValue(provider *platform.Provider, params map[string]interface{},
 	if vOpts.Verify && preSnapshot.Exists {
 		var fallbacks []fallbackAction
 		if provider.Inputter != nil && resolvedElem != nil && attribute == "value" {
-			elemBounds := resolvedElem.Bounds
 			fallbacks = append(fallbacks, fallbackAction{
 				Method: "type",
 				Execute: func() error {
-					cx := elemBounds[0] + elemBounds[2]/2
-					cy := elemBounds[1] + elemBounds[3]/2
-					if err := provider.Inputter.Click(cx, cy, platform.MouseLeft, 1); err != nil {
+					scope := platform.ReadOptions{App: app, Window: window, WindowID: windowID, PID: pid}
+					if err := clickToFocus(provider, scope, resolvedElem); err != nil {
 						return err
 					}
-					time.Sleep(50 * time.Millisecond)
 					if err := provider.Inputter.KeyCombo([]string{"cmd", "a"}); err != nil {
 						return err
 					}
@@ -1214,6 +1330,10 @@ func ExecuteWait(provider *platform.Provider, params map[string]interface{}, app
 	for {
 		elements, err := provider.Reader.ReadElements(readOpts)
 		if err != nil {
+			if errors.Is(err, platform.ErrTruncated) {
+				// The command as a whole ran out of time; stop polling.
+				return StepResult{Action: "wait"}, err
+			}
 			if time.Now().After(deadline) {
 				return StepResult{Action: "wait"}, fmt.Errorf("timeout after %s (last error: %w)", timeout, err)
 			}
@@ -1274,15 +1394,9 @@ func ExecuteFocus(provider *platform.Provider, params map[string]interface{}, ap
 		if provider.Inputter == nil {
 			return StepResult{Action: "focus"}, fmt.Errorf("input simulation not available (required for new-document)")
 		}
-		time.Sleep(300 * time.Millisecond)
-		if err := provider.Inputter.KeyCombo([]string{"escape"}); err != nil {
-			return StepResult{Action: "focus"}, fmt.Errorf("failed to dismiss dialog: %w", err)
-		}
-		time.Sleep(200 * time.Millisecond)
-		if err := provider.Inputter.KeyCombo([]string{"cmd", "n"}); err != nil {
-			return StepResult{Action: "focus"}, fmt.Errorf("failed to create new document: %w", err)
+		if err := createNewDocument(provider, platform.ReadOptions{App: app, Window: window, WindowID: windowID, PID: pid}); err != nil {
+			return StepResult{Action: "focus"}, err
 		}
-		time.Sleep(300 * time.Millisecond)
 	}
 
 	return StepResult{Action: "focus"}, nil
@@ -1407,11 +1521,16 @@ func ExecuteAssert(provider *platform.Provider, params map[string]interface{}, a
 }
 
 func ExecuteSleep(params map[string]interface{}) (StepResult, error) {
+	return executeSleep(params, time.Sleep)
+}
+
+// executeSleep runs a sleep step, sleeping with sleep.
+func executeSleep(params map[string]interface{}, sleep func(time.Duration)) (StepResult, error) {
 	ms := IntParam(params, "ms", 0)
 	if ms <= 0 {
 		return StepResult{Action: "sleep"}, fmt.Errorf("ms must be > 0")
 	}
-	time.Sleep(time.Duration(ms) * time.Millisecond)
+	sleep(time.Duration(ms) * time.Millisecond)
 	return StepResult{Action: "sleep", Elapsed: fmt.Sprintf("%dms", ms)}, nil
 }
 
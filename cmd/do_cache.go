@@ -0,0 +1,331 @@
+package cmd
+
+import (
+	"sync"
+	"time"
+
+	"github.com/mj1618/desktop-cli/internal/model"
+	"github.com/mj1618/desktop-cli/internal/platform"
+)
+
+// doCacheKey identifies a tree read scope within a do batch.
+type doCacheKey struct {
+	App       string
+	Window    string
+	WindowID  int
+	PID       int
+	TextLimit int
+}
+
+// doTreeCache shares element trees between the steps of a do batch. Steps
+// that only look at the UI (if-exists, assert, resolving a click target)
+// reuse the last tree read for their scope; anything that writes to the UI
+// through the provider — input, actions, set-value, focus — drops every
+// cached tree, so the next read sees the result.
+//
+// While the batch waits (sleep steps, settling and verify delays) the tree
+// the next read will need is prefetched in the background (see pause).
+type doTreeCache struct {
+	provider *platform.Provider // the batch's provider, reading through the cache
+	reader   platform.Reader    // the platform reader
+
+	mu         sync.Mutex
+	entries    map[doCacheKey][]model.Element
+	pending    map[doCacheKey]*doPrefetch
+	durations  map[doCacheKey]time.Duration // how long the last read of each scope took
+	writes     uint64                       // UI writes so far
+	saved      int                          // reads served from the cache
+	prefetched int                          // reads served by a prefetch
+
+	// The tree most recently read, of any scope, and c.writes at the time.
+	lastKey    doCacheKey
+	lastTree   []model.Element
+	lastWrites uint64
+}
+
+// doPrefetch is a background read started by pause.
+type doPrefetch struct {
+	writes   uint64 // doTreeCache.writes when the read started
+	done     chan struct{}
+	elements []model.Element
+	err      error
+}
+
+// newDoTreeCache returns a cache whose provider wraps p.
+func newDoTreeCache(p *platform.Provider) *doTreeCache {
+	c := &doTreeCache{
+		reader:    p.Reader,
+		entries:   make(map[doCacheKey][]model.Element),
+		pending:   make(map[doCacheKey]*doPrefetch),
+		durations: make(map[doCacheKey]time.Duration),
+	}
+	wrapped := *p
+	if p.Reader != nil {
+		wrapped.Reader = &doCachedReader{Reader: p.Reader, cache: c}
+	}
+	if p.Inputter != nil {
+		wrapped.Inputter = &doWriteInputter{inner: p.Inputter, cache: c}
+	}
+	if p.WindowManager != nil {
+		wrapped.WindowManager = &doWriteWindowManager{WindowManager: p.WindowManager, cache: c}
+	}
+	if p.ActionPerformer != nil {
+		wrapped.ActionPerformer = &doWriteActionPerformer{inner: p.ActionPerformer, cache: c}
+	}
+	if p.ValueSetter != nil {
+		wrapped.ValueSetter = &doWriteValueSetter{inner: p.ValueSetter, cache: c}
+	}
+	c.provider = &wrapped
+	return c
+}
+
+// doCacheKeyFor returns the cache key of a full-tree read of a scope, or
+// false for reads the cache does not serve: reads with a depth limit,
+// filters or a scope path, and reads without a target.
+func doCacheKeyFor(opts platform.ReadOptions) (doCacheKey, bool) {
+	key := doCacheKey{App: opts.App, Window: opts.Window, WindowID: opts.WindowID, PID: opts.PID, TextLimit: opts.TextLimit}
+	if key.App == "" && key.Window == "" && key.WindowID == 0 && key.PID == 0 {
+		return key, false
+	}
+	if opts.Depth != 0 || opts.Roles != nil || opts.VisibleOnly || opts.BBox != nil || opts.Compact ||
+		opts.Text != "" || opts.Flat || opts.BreadthFirst || opts.Scope != nil {
+		return key, false
+	}
+	return key, true
+}
+
+// invalidate drops every cached tree and prefetch after the UI was written
+// to.
+func (c *doTreeCache) invalidate() {
+	c.mu.Lock()
+	defer c.mu.Unlock()
+	c.writes++
+	clear(c.entries)
+	clear(c.pending)
+}
+
+// traversalsSaved returns the number of reads served from the cache.
+func (c *doTreeCache) traversalsSaved() int {
+	c.mu.Lock()
+	defer c.mu.Unlock()
+	return c.saved
+}
+
+// prefetchHits returns the number of reads served by a prefetch.
+func (c *doTreeCache) prefetchHits() int {
+	c.mu.Lock()
+	defer c.mu.Unlock()
+	return c.prefetched
+}
+
+// record notes elements, read when c.writes was writes, as the tree most
+// recently read. Must be called with c.mu held.
+func (c *doTreeCache) record(key doCacheKey, elements []model.Element, writes uint64) {
+	c.lastKey, c.lastTree, c.lastWrites = key, elements, writes
+}
+
+// latest returns the tree most recently read if nothing was written to the
+// UI since and it was read with exactly the scope of the display read — app
+// and window, no window ID, PID or text limit — so that the display read
+// made now would see the same UI.
+func (c *doTreeCache) latest(app, window string) ([]model.Element, bool) {
+	c.mu.Lock()
+	defer c.mu.Unlock()
+	if c.lastTree == nil || c.lastWrites != c.writes || c.lastKey != (doCacheKey{App: app, Window: window}) {
+		return nil, false
+	}
+	return c.lastTree, true
+}
+
+// read reads opts from the platform, recording how long the read took.
+func (c *doTreeCache) read(key doCacheKey, opts platform.ReadOptions) ([]model.Element, error) {
+	start := time.Now()
+	elements, err := c.reader.ReadElements(opts)
+	c.mu.Lock()
+	c.durations[key] = time.Since(start)
+	c.mu.Unlock()
+	return elements, err
+}
+
+// pause sleeps for d. If the tree of next is not cached, it is read in the
+// background, timed from the duration of the last read of that scope to
+// finish as the pause ends, so that it sees the UI about as settled as a
+// read after the pause would. The read is used only if nothing was written
+// to the UI after it started. Scopes not read before in the batch are not
+// prefetched.
+func (c *doTreeCache) pause(d time.Duration, next platform.ReadOptions) {
+	key, ok := doCacheKeyFor(next)
+	c.mu.Lock()
+	estimate := c.durations[key]
+	_, cached := c.entries[key]
+	_, running := c.pending[key]
+	c.mu.Unlock()
+	if !ok || estimate == 0 || cached || running {
+		time.Sleep(d)
+		return
+	}
+
+	lead := max(d-estimate, 0)
+	time.Sleep(lead)
+	c.mu.Lock()
+	p := &doPrefetch{writes: c.writes, done: make(chan struct{})}
+	c.pending[key] = p
+	c.mu.Unlock()
+	go func() {
+		defer close(p.done)
+		p.elements, p.err = c.read(key, next)
+	}()
+	time.Sleep(d - lead)
+}
+
+// doCachedReader serves full-tree reads of a scope from the cache or a
+// prefetch. Other reads go to the platform.
+type doCachedReader struct {
+	platform.Reader
+	cache *doTreeCache
+}
+
+func (r *doCachedReader) ReadElements(opts platform.ReadOptions) ([]model.Element, error) {
+	key, ok := doCacheKeyFor(opts)
+	if !ok {
+		return r.Reader.ReadElements(opts)
+	}
+
+	c := r.cache
+	c.mu.Lock()
+	if elements, ok := c.entries[key]; ok {
+		c.saved++
+		c.record(key, elements, c.writes)
+		c.mu.Unlock()
+		return elements, nil
+	}
+	p := c.pending[key]
+	delete(c.pending, key)
+	writes := c.writes
+	c.mu.Unlock()
+
+	if p != nil {
+		<-p.done
+		c.mu.Lock()
+		if p.err == nil && p.writes == c.writes {
+			c.entries[key] = p.elements
+			c.prefetched++
+			c.record(key, p.elements, p.writes)
+			c.mu.Unlock()
+			return p.elements, nil
+		}
+		c.mu.Unlock()
+	}
+
+	elements, err := r.cache.read(key, opts)
+	if err != nil {
+		// Truncated reads return a partial tree; pass it on but don't cache it.
+		return elements, err
+	}
+	// Cache the tree only if nothing was written to the UI while it was read
+	// (e.g. by a parallel substep); otherwise it may show the UI before the
+	// write.
+	c.mu.Lock()
+	if writes == c.writes {
+		c.entries[key] = elements
+		c.record(key, elements, writes)
+	}
+	c.mu.Unlock()
+	return elements, nil
+}
+
+// StreamElements implements platform.StreamReader by streaming from the
+// platform, bypassing the cache: a stream stops early, so it cannot fill the
+// cache, and a wait polls it for changes a cached tree would never show.
+func (r *doCachedReader) StreamElements(opts platform.ReadOptions, fn func(el model.Element, depth int) bool) error {
+	return platform.StreamElements(r.Reader, opts, fn)
+}
+
+// pause sleeps for d before a read of next (see doTreeCache.pause). Outside
+// a do batch it just sleeps.
+func pause(provider *platform.Provider, d time.Duration, next platform.ReadOptions) {
+	if r, ok := provider.Reader.(*doCachedReader); ok {
+		r.cache.pause(d, next)
+		return
+	}
+	time.Sleep(d)
+}
+
+// doWriteInputter invalidates the cache after every input event.
+type doWriteInputter struct {
+	inner platform.Inputter
+	cache *doTreeCache
+}
+
+func (in *doWriteInputter) Click(x, y int, button platform.MouseButton, count int) error {
+	defer in.cache.invalidate()
+	return in.inner.Click(x, y, button, count)
+}
+
+func (in *doWriteInputter) MoveMouse(x, y int) error {
+	defer in.cache.invalidate()
+	return in.inner.MoveMouse(x, y)
+}
+
+func (in *doWriteInputter) Scroll(x, y int, dx, dy int) error {
+	defer in.cache.invalidate()
+	return in.inner.Scroll(x, y, dx, dy)
+}
+
+func (in *doWriteInputter) Drag(fromX, fromY, toX, toY int) error {
+	defer in.cache.invalidate()
+	return in.inner.Drag(fromX, fromY, toX, toY)
+}
+
+func (in *doWriteInputter) TypeText(text string, delayMs int) error {
+	defer in.cache.invalidate()
+	return in.inner.TypeText(text, delayMs)
+}
+
+func (in *doWriteInputter) KeyCombo(keys []string) error {
+	defer in.cache.invalidate()
+	return in.inner.KeyCombo(keys)
+}
+
+// doWriteWindowManager invalidates the cache after focusing a window.
+type doWriteWindowManager struct {
+	platform.WindowManager
+	cache *doTreeCache
+}
+
+func (wm *doWriteWindowManager) FocusWindow(opts platform.FocusOptions) error {
+	defer wm.cache.invalidate()
+	return wm.WindowManager.FocusWindow(opts)
+}
+
+// doWriteActionPerformer invalidates the cache after every action.
+type doWriteActionPerformer struct {
+	inner platform.ActionPerformer
+	cache *doTreeCache
+}
+
+func (a *doWriteActionPerformer) PerformAction(opts platform.ActionOptions) error {
+	defer a.cache.invalidate()
+	return a.inner.PerformAction(opts)
+}
+
+func (a *doWriteActionPerformer) PerformActions(opts platform.PerformActionsOptions) (int, error) {
+	defer a.cache.invalidate()
+	return a.inner.PerformActions(opts)
+}
+
+// doWriteValueSetter invalidates the cache after every value it sets.
+type doWriteValueSetter struct {
+	inner platform.ValueSetter
+	cache *doTreeCache
+}
+
+func (s *doWriteValueSetter) SetValue(opts platform.SetValueOptions) error {
+	defer s.cache.invalidate()
+	return s.inner.SetValue(opts)
+}
+
+func (s *doWriteValueSetter) SetValues(opts platform.SetValuesOptions) []error {
+	defer s.cache.invalidate()
+	return s.inner.SetValues(opts)
+}
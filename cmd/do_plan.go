@@ -0,0 +1,341 @@
+package cmd
+
+import (
+	"crypto/sha256"
+	"encoding/json"
+	"errors"
+	"fmt"
+	"strings"
+	"sync"
+
+	"github.com/mj1618/desktop-cli/internal/platform"
+)
+
+// doStep is a compiled step of a do batch: its kind decided, its target
+// resolved against the batch defaults and its substeps compiled.
+type doStep struct {
+	action string                 // action name, or if-exists, if-focused, try or parallel
+	params map[string]interface{} // action params, or the if-exists/if-focused condition; read-only
+	app    string                 // target app, defaulting to the batch's
+	window string                 // target window, defaulting to the batch's
+
+	refresh bool // refresh: true — read a fresh tree
+
+	then, els        []doStep // if-exists/if-focused branches
+	thenErr, elseErr error    // why a branch is invalid; reported if it is taken
+	substeps         []doStep // try and parallel substeps
+	err              error    // why the step is invalid; reported when it is reached
+}
+
+// compileSteps compiles raw YAML steps. Steps that cannot be compiled keep
+// their error, to be reported when they are reached (see CompileDo for
+// upfront validation).
+func compileSteps(rawSteps []map[string]interface{}, defaultApp, defaultWindow string) []doStep {
+	steps := make([]doStep, len(rawSteps))
+	for i, raw := range rawSteps {
+		steps[i] = compileStep(raw, defaultApp, defaultWindow)
+	}
+	return steps
+}
+
+// compileSubsteps compiles the raw value of a then/else/try/parallel list.
+func compileSubsteps(raw interface{}, defaultApp, defaultWindow string) ([]doStep, error) {
+	rawSteps, err := parseSubsteps(raw)
+	if err != nil {
+		return nil, err
+	}
+	return compileSteps(rawSteps, defaultApp, defaultWindow), nil
+}
+
+// doConditionParams names the params of each condition, for errors.
+var doConditionParams = map[string]string{"if-exists": "text/roles/id", "if-focused": "roles/text"}
+
+func compileStep(raw map[string]interface{}, defaultApp, defaultWindow string) doStep {
+	target := func(step doStep) doStep {
+		step.app = StringParam(step.params, "app", defaultApp)
+		step.window = StringParam(step.params, "window", defaultWindow)
+		step.refresh = BoolParam(step.params, "refresh", false)
+		return step
+	}
+
+	for _, kind := range []string{"if-exists", "if-focused"} {
+		condRaw, ok := raw[kind]
+		if !ok {
+			continue
+		}
+		step := doStep{action: kind}
+		cond, ok := condRaw.(map[string]interface{})
+		if !ok {
+			step.err = fmt.Errorf("%s condition must be a map with %s params", kind, doConditionParams[kind])
+			return step
+		}
+		step.params = cond
+		step.then, step.thenErr = compileSubsteps(raw["then"], defaultApp, defaultWindow)
+		step.els, step.elseErr = compileSubsteps(raw["else"], defaultApp, defaultWindow)
+		return target(step)
+	}
+
+	for _, kind := range []string{"try", "parallel"} {
+		if subRaw, ok := raw[kind]; ok {
+			step := doStep{action: kind}
+			substeps, err := compileSubsteps(subRaw, defaultApp, defaultWindow)
+			if err != nil {
+				step.err = fmt.Errorf("invalid %s steps: %s", kind, err)
+			}
+			step.substeps = substeps
+			return step
+		}
+	}
+
+	action, params, err := parseRegularStep(raw)
+	if err != nil {
+		return doStep{err: err}
+	}
+	return target(doStep{action: action, params: params})
+}
+
+// DoPlan is a compiled and validated do batch.
+type DoPlan struct {
+	steps []doStep
+}
+
+// Len returns the number of top-level steps in the plan.
+func (p *DoPlan) Len() int { return len(p.steps) }
+
+// CompileDo compiles raw YAML steps into a plan, applying the default app
+// and window, and validates every step — including those in branches that
+// may not be taken — so that a malformed batch fails before touching the UI.
+func CompileDo(rawSteps []map[string]interface{}, defaultApp, defaultWindow string) (*DoPlan, error) {
+	if len(rawSteps) == 0 {
+		return nil, fmt.Errorf("no steps provided — expected a YAML list of actions")
+	}
+	plan := &DoPlan{steps: compileSteps(rawSteps, defaultApp, defaultWindow)}
+	if err := checkSteps(plan.steps, "step "); err != nil {
+		return nil, err
+	}
+	return plan, nil
+}
+
+// checkSteps returns the first error in steps, naming the step it is in.
+func checkSteps(steps []doStep, prefix string) error {
+	for i, step := range steps {
+		where := fmt.Sprintf("%s%d", prefix, i+1)
+		if err := step.check(); err != nil {
+			return fmt.Errorf("%s: %w", where, err)
+		}
+		if step.thenErr != nil {
+			return fmt.Errorf("%s: invalid then steps: %w", where, step.thenErr)
+		}
+		if step.elseErr != nil {
+			return fmt.Errorf("%s: invalid else steps: %w", where, step.elseErr)
+		}
+		for _, sub := range []struct {
+			name  string
+			steps []doStep
+		}{{"then", step.then}, {"else", step.els}, {step.action, step.substeps}} {
+			if err := checkSteps(sub.steps, where+" "+sub.name+" step "); err != nil {
+				return err
+			}
+		}
+	}
+	return nil
+}
+
+// doIntParams and doBoolParams are the step params that must be numbers
+// and booleans; anything else is read as a string.
+var (
+	doIntParams = []string{"id", "x", "y", "ms", "timeout", "interval", "window-id", "pid", "scope-id",
+		"delay", "verify-delay", "max-retries", "amount", "for-id", "depth", "text-limit", "budget-ms"}
+	doBoolParams = []string{"exact", "double", "near", "verify", "gone", "refresh", "new-document",
+		"checked", "unchecked", "disabled", "enabled", "focused", "tab-between"}
+)
+
+// check validates a step on its own, with the checks its action would make
+// when run.
+func (s doStep) check() error {
+	if s.err != nil {
+		return s.err
+	}
+	for _, k := range doIntParams {
+		if v, ok := s.params[k]; ok {
+			switch v.(type) {
+			case int, int64, float64:
+			default:
+				return fmt.Errorf("%s: %s must be a number, got %v", s.action, k, v)
+			}
+		}
+	}
+	for _, k := range doBoolParams {
+		if v, ok := s.params[k]; ok {
+			if _, isBool := v.(bool); !isBool {
+				return fmt.Errorf("%s: %s must be true or false, got %v", s.action, k, v)
+			}
+		}
+	}
+
+	p := s.params
+	// has reports whether any of keys is given a value.
+	has := func(keys ...string) bool {
+		for _, k := range keys {
+			if v, ok := p[k]; ok && v != nil {
+				return true
+			}
+		}
+		return false
+	}
+	var err error
+	switch s.action {
+	case "if-exists":
+		if !has("text", "id") {
+			err = errors.New("specify text or id to test for")
+		}
+	case "if-focused", "try", "parallel", "read":
+	case "click", "hover":
+		switch {
+		case has("x") != has("y"):
+			err = errors.New("specify both x and y coordinates")
+		case !has("text", "ref", "id", "x"):
+			err = errors.New("specify text, ref, id, or x/y coordinates")
+		case s.action == "click":
+			_, err = platform.ParseMouseButton(StringParam(p, "button", "left"))
+		}
+	case "type":
+		if !has("text", "key") {
+			err = errors.New("specify text or key")
+		}
+	case "action", "set-value":
+		if !has("id", "text", "ref") {
+			err = errors.New("specify id, text, or ref to target an element")
+		}
+	case "scroll":
+		switch direction := StringParam(p, "direction", ""); strings.ToLower(direction) {
+		case "up", "down", "left", "right":
+			if has("x") != has("y") {
+				err = errors.New("specify both x and y coordinates")
+			}
+		case "":
+			err = errors.New("direction is required (up, down, left, right)")
+		default:
+			err = fmt.Errorf("invalid direction %q: use up, down, left, or right", direction)
+		}
+	case "wait":
+		if !has("for-text", "for-role", "for-id") {
+			err = errors.New("specify at least one condition: for-text, for-role, or for-id")
+		}
+	case "focus":
+		if s.app == "" && s.window == "" && !has("window-id", "pid") {
+			err = errors.New("specify app, window, window-id, or pid")
+		}
+	case "assert":
+		if !has("text", "id") {
+			err = errors.New("specify text or id to target an element")
+		}
+	case "fill":
+		err = checkFillFields(p)
+	case "sleep":
+		if IntParam(p, "ms", 0) <= 0 {
+			err = errors.New("ms must be > 0")
+		}
+	case "open":
+		if !has("url", "file", "app") {
+			err = errors.New("specify url, file, or app")
+		}
+	default:
+		return unknownStepError(s.action)
+	}
+	if err != nil {
+		return fmt.Errorf("%s: %w", s.action, err)
+	}
+	return nil
+}
+
+// checkFillFields validates the fields list of a fill step.
+func checkFillFields(params map[string]interface{}) error {
+	fields, ok := params["fields"].([]interface{})
+	if !ok || len(fields) == 0 {
+		return errors.New("fill step requires a \"fields\" list with at least one field")
+	}
+	for _, raw := range fields {
+		f, ok := raw.(map[string]interface{})
+		if !ok {
+			return errors.New("each field must be a map with label/id and value")
+		}
+		if StringParam(f, "label", "") == "" && IntParam(f, "id", 0) == 0 {
+			return errors.New("each field must have a \"label\" or \"id\"")
+		}
+	}
+	return nil
+}
+
+// defaultDoPlanCacheSize is how many compiled plans a DoPlanCache keeps.
+const defaultDoPlanCacheSize = 64
+
+// DoPlanCache keeps compiled do plans by content hash, so that a server
+// running the same workflow repeatedly compiles and validates it once.
+// Batches that failed to compile are cached too, and fail straight away.
+// When full the cache is emptied. Safe for concurrent use.
+//
+// Every run of a cached plan, including concurrent ones, is given the same
+// step params maps, so steps must never write to their params.
+type DoPlanCache struct {
+	mu      sync.Mutex
+	entries map[[sha256.Size]byte]doPlanEntry
+	size    int
+	hits    int
+}
+
+type doPlanEntry struct {
+	plan *DoPlan
+	err  error
+}
+
+// NewDoPlanCache returns a cache of up to size plans. A size of 0 means
+// the default.
+func NewDoPlanCache(size int) *DoPlanCache {
+	if size <= 0 {
+		size = defaultDoPlanCacheSize
+	}
+	return &DoPlanCache{entries: make(map[[sha256.Size]byte]doPlanEntry), size: size}
+}
+
+// Compile returns the plan of rawSteps with the given defaults, like
+// CompileDo, compiling it only if the same steps and defaults were not
+// compiled before.
+func (c *DoPlanCache) Compile(rawSteps []map[string]interface{}, defaultApp, defaultWindow string) (*DoPlan, error) {
+	data, err := json.Marshal(struct {
+		Steps  []map[string]interface{}
+		App    string
+		Window string
+	}{rawSteps, defaultApp, defaultWindow})
+	if err != nil {
+		// Not representable as JSON (YAML allows non-string map keys):
+		// compile without caching.
+		return CompileDo(rawSteps, defaultApp, defaultWindow)
+	}
+	key := sha256.Sum256(data)
+
+	c.mu.Lock()
+	if e, ok := c.entries[key]; ok {
+		c.hits++
+		c.mu.Unlock()
+		return e.plan, e.err
+	}
+	c.mu.Unlock()
+
+	plan, err := CompileDo(rawSteps, defaultApp, defaultWindow)
+
+	c.mu.Lock()
+	if len(c.entries) >= c.size {
+		clear(c.entries)
+	}
+	c.entries[key] = doPlanEntry{plan: plan, err: err}
+	c.mu.Unlock()
+	return plan, err
+}
+
+// Hits returns the number of plans served from the cache.
+func (c *DoPlanCache) Hits() int {
+	c.mu.Lock()
+	defer c.mu.Unlock()
+	return c.hits
+}
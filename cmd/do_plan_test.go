@@ -0,0 +1,125 @@
+package cmd
+
+import (
+	"strings"
+	"testing"
+)
+
+func TestCompileDo_ResolvesDefaults(t *testing.T) {
+	plan, err := CompileDo(parseSteps(t, `
+- click: { text: "Send" }
+- if-exists: { text: "Sent", app: "Mail" }
+  then:
+    - type: { key: "cmd+w" }
+`), "Chrome", "Inbox")
+	if err != nil {
+		t.Fatal(err)
+	}
+	if plan.Len() != 2 {
+		t.Fatalf("plan has %d steps, want 2", plan.Len())
+	}
+	click, cond := plan.steps[0], plan.steps[1]
+	if click.action != "click" || click.app != "Chrome" || click.window != "Inbox" {
+		t.Errorf("click = %q in %q/%q", click.action, click.app, click.window)
+	}
+	if cond.app != "Mail" || len(cond.then) != 1 || cond.then[0].app != "Chrome" {
+		t.Errorf("if-exists in %q with then %+v", cond.app, cond.then)
+	}
+}
+
+func TestCompileDo_RejectsInvalidSteps(t *testing.T) {
+	tests := []struct {
+		name string
+		yaml string
+		want string
+	}{
+		{"unknown action", `
+- sleep: { ms: 10 }
+- tap: { text: "OK" }`, `step 2: unknown step type "tap"`},
+		{"untaken branch", `
+- if-exists: { text: "Cookies" }
+  else:
+    - type: { target: "Search" }`, "step 1 else step 1: type: specify text or key"},
+		{"parallel substep", `
+- parallel:
+    - assert: { text: "A" }
+    - scroll: { direction: "sideways" }`, `step 1 parallel step 2: scroll: invalid direction "sideways"`},
+		{"param type", `
+- click: { text: "OK", double: "yes" }`, "step 1: click: double must be true or false"},
+		{"number param", `
+- sleep: { ms: "soon" }`, "step 1: sleep: ms must be a number"},
+		{"bad then list", `
+- if-focused: { roles: "input" }
+  then: { type: { text: "x" } }`, "step 1: invalid then steps"},
+		{"multiple actions", `
+- click: { text: "A" }
+  hover: { text: "B" }`, "step 1: expected exactly one action key"},
+		{"x without y", `
+- click: { x: 100 }`, "step 1: click: specify both x and y coordinates"},
+		{"y without x", `
+- scroll: { direction: "down", y: 100 }`, "step 1: scroll: specify both x and y coordinates"},
+	}
+	for _, tt := range tests {
+		t.Run(tt.name, func(t *testing.T) {
+			_, err := CompileDo(parseSteps(t, tt.yaml), "", "")
+			if err == nil || !strings.Contains(err.Error(), tt.want) {
+				t.Errorf("err = %v, want it to contain %q", err, tt.want)
+			}
+		})
+	}
+}
+
+func TestCompileDo_AcceptsZeroParams(t *testing.T) {
+	// Coordinates on the screen's top and left edges are given.
+	if _, err := CompileDo(parseSteps(t, `
+- click: { x: 0, y: 0 }
+- hover: { x: 0, y: 10 }
+`), "", ""); err != nil {
+		t.Error(err)
+	}
+}
+
+func TestDoContextExecutePlan(t *testing.T) {
+	plan, err := CompileDo(parseSteps(t, `
+- sleep: { ms: 1 }
+- try:
+    - sleep: { ms: 1 }
+`), "", "")
+	if err != nil {
+		t.Fatal(err)
+	}
+	ctx := &DoContext{StopOnError: true}
+	ctx.ExecutePlan(plan)
+	if ctx.HasFailure || len(ctx.Results) != 2 || len(ctx.Results[1].Substeps) != 1 {
+		t.Errorf("results = %+v", ctx.Results)
+	}
+}
+
+func TestDoPlanCache(t *testing.T) {
+	c := NewDoPlanCache(2)
+	steps := `
+- click: { text: "Compose" }
+- type: { text: "hello" }
+`
+	a, err := c.Compile(parseSteps(t, steps), "Chrome", "")
+	if err != nil {
+		t.Fatal(err)
+	}
+	b, _ := c.Compile(parseSteps(t, steps), "Chrome", "")
+	if a != b || c.Hits() != 1 {
+		t.Errorf("identical batch compiled again (hits %d)", c.Hits())
+	}
+	if other, _ := c.Compile(parseSteps(t, steps), "Safari", ""); other == a || other.steps[0].app != "Safari" {
+		t.Error("batch with other defaults served from the cache")
+	}
+
+	bad := parseSteps(t, `- sleep: { ms: 0 }`)
+	_, err1 := c.Compile(bad, "", "")
+	_, err2 := c.Compile(bad, "", "")
+	if err1 == nil || err2 == nil || err1.Error() != err2.Error() {
+		t.Errorf("invalid batch: %v, then %v", err1, err2)
+	}
+	if len(c.entries) > 2 {
+		t.Errorf("cache holds %d plans, want at most 2", len(c.entries))
+	}
+}
@@ -1,8 +1,16 @@
 package cmd
 
 import (
+	"context"
+	"slices"
+	"strings"
+	"sync"
 	"testing"
+	"time"
 
+	"github.com/mj1618/desktop-cli/internal/model"
+	"github.com/mj1618/desktop-cli/internal/platform"
+	"github.com/mj1618/desktop-cli/internal/platform/fake"
 	"gopkg.in/yaml.v3"
 )
 
@@ -622,3 +630,282 @@ func TestDoContextTry_MultipleSubsteps(t *testing.T) {
 		t.Fatal("expected second substep to fail")
 	}
 }
+
+// nopInputter accepts every input event.
+type nopInputter struct{}
+
+func (nopInputter) Click(x, y int, button platform.MouseButton, count int) error { return nil }
+func (nopInputter) MoveMouse(x, y int) error                                     { return nil }
+func (nopInputter) Scroll(x, y int, dx, dy int) error                            { return nil }
+func (nopInputter) Drag(fromX, fromY, toX, toY int) error                        { return nil }
+func (nopInputter) TypeText(text string, delayMs int) error                      { return nil }
+func (nopInputter) KeyCombo(keys []string) error                                 { return nil }
+
+func TestDoContext_ReadOnlyStepsShareTree(t *testing.T) {
+	reader := &fake.Reader{App: "Mail", PID: 42, Windows: []fake.Window{{ID: 1, Title: "Inbox", Elements: []model.Element{
+		{Role: "btn", Title: "Send", Bounds: [4]int{10, 10, 50, 20}, Actions: []string{"press"}},
+	}}}}
+	rawSteps := parseSteps(t, `
+- if-exists: { text: "Send" }
+- assert: { text: "Send" }
+- hover: { x: 5, y: 5 }
+- assert: { text: "Send" }
+- assert: { text: "Send", refresh: true }
+`)
+	ctx := &DoContext{Provider: &platform.Provider{Reader: reader, Inputter: nopInputter{}}, DefaultApp: "Mail", StopOnError: true}
+	ctx.ExecuteSteps(rawSteps, 0)
+	for _, r := range ctx.Results {
+		if !r.OK {
+			t.Fatalf("step %d (%s) failed: %s", r.Step, r.Action, r.Error)
+		}
+	}
+	// The first assert reuses the if-exists tree; the hover makes the next
+	// assert read again, and refresh forces the last one to.
+	if reader.Reads() != 3 || ctx.TraversalsSaved() != 1 {
+		t.Errorf("%d reads, %d saved; want 3 reads and 1 saved", reader.Reads(), ctx.TraversalsSaved())
+	}
+}
+
+func TestDoContext_SleepPrefetchesNextTree(t *testing.T) {
+	reader := &fake.Reader{App: "Mail", PID: 42, Latency: 5 * time.Millisecond, Windows: []fake.Window{{ID: 1, Title: "Inbox", Elements: []model.Element{
+		{Role: "btn", Title: "Send", Bounds: [4]int{10, 10, 50, 20}, Actions: []string{"press"}},
+	}}}}
+	rawSteps := parseSteps(t, `
+- if-exists: { text: "Send" }
+- sleep: { ms: 40 }
+- assert: { text: "Send" }
+- hover: { x: 5, y: 5 }
+- sleep: { ms: 40 }
+- assert: { text: "Send" }
+`)
+	ctx := &DoContext{Provider: &platform.Provider{Reader: reader, Inputter: nopInputter{}}, DefaultApp: "Mail", StopOnError: true}
+	ctx.ExecuteSteps(rawSteps, 0)
+	for _, r := range ctx.Results {
+		if !r.OK {
+			t.Fatalf("step %d (%s) failed: %s", r.Step, r.Action, r.Error)
+		}
+	}
+	// Both asserts are served by the tree read during the sleep before them.
+	if reader.Reads() != 3 || ctx.PrefetchHits() != 2 {
+		t.Errorf("%d reads, %d prefetch hits; want 3 reads and 2 hits", reader.Reads(), ctx.PrefetchHits())
+	}
+}
+
+func TestDoTreeCache_WriteDuringReadNotCached(t *testing.T) {
+	reader := &fake.Reader{App: "Mail", PID: 42, Latency: 20 * time.Millisecond, Windows: []fake.Window{{ID: 1, Title: "Inbox", Elements: []model.Element{
+		{Role: "btn", Title: "Send", Bounds: [4]int{10, 10, 50, 20}, Actions: []string{"press"}},
+	}}}}
+	c := newDoTreeCache(&platform.Provider{Reader: reader})
+	opts := platform.ReadOptions{App: "Mail"}
+
+	// A parallel substep writes to the UI while another reads it.
+	done := make(chan struct{})
+	go func() {
+		defer close(done)
+		c.provider.Reader.ReadElements(opts)
+	}()
+	time.Sleep(10 * time.Millisecond)
+	c.invalidate()
+	<-done
+
+	if _, err := c.provider.Reader.ReadElements(opts); err != nil {
+		t.Fatal(err)
+	}
+	if reader.Reads() != 2 || c.traversalsSaved() != 0 {
+		t.Errorf("%d reads, %d saved; want the tree read before the write not to be reused", reader.Reads(), c.traversalsSaved())
+	}
+}
+
+func TestDoTreeCache_StreamsFromPlatform(t *testing.T) {
+	reader := &fake.Reader{App: "Mail", PID: 42, Windows: []fake.Window{{ID: 1, Title: "Inbox", Elements: []model.Element{
+		{Role: "btn", Title: "Send"}, {Role: "btn", Title: "Reply"}, {Role: "btn", Title: "Delete"},
+	}}}}
+	// The readers the MCP server builds, under the batch's cache.
+	server := platform.WithStableIDs(&platform.Provider{Reader: platform.WithConcurrentWindows(reader, platform.DefaultWindowWorkers)})
+	c := newDoTreeCache(platform.WithContext(context.Background(), server))
+	opts := platform.ReadOptions{App: "Mail"}
+	if _, err := c.provider.Reader.ReadElements(opts); err != nil {
+		t.Fatal(err)
+	}
+
+	before, streamed := reader.Reads(), 0
+	err := platform.StreamElements(c.provider.Reader, opts, func(el model.Element, _ int) bool {
+		streamed++
+		return false
+	})
+	if err != nil {
+		t.Fatal(err)
+	}
+	if reader.Reads()-before != 1 || streamed != 1 {
+		t.Errorf("%d reads streaming %d elements; want one platform stream stopped at the first", reader.Reads()-before, streamed)
+	}
+}
+
+func TestDoContext_FinalDisplayReusesLastRead(t *testing.T) {
+	reader := &fake.Reader{App: "Mail", PID: 42, Windows: []fake.Window{{ID: 1, Title: "Inbox", Elements: []model.Element{
+		{Role: "btn", Title: "Send", Bounds: [4]int{10, 10, 50, 20}, Actions: []string{"press"}},
+		{Role: "txt", Value: "Sent", Bounds: [4]int{10, 40, 50, 20}},
+	}}}}
+	run := func(steps string) (*DoContext, []ElementInfo, bool) {
+		t.Helper()
+		ctx := &DoContext{Provider: &platform.Provider{Reader: reader, Inputter: nopInputter{}}, DefaultApp: "Mail", StopOnError: true}
+		ctx.ExecuteSteps(parseSteps(t, steps), 0)
+		for _, r := range ctx.Results {
+			if !r.OK {
+				t.Fatalf("step %d (%s) failed: %s", r.Step, r.Action, r.Error)
+			}
+		}
+		display, reused := ctx.finalDisplay("Mail", "")
+		return ctx, display, reused
+	}
+
+	// The assert reads the app after the hover: its tree has the display
+	// text, and nothing changed since.
+	before := reader.Reads()
+	_, display, reused := run(`
+- hover: { x: 5, y: 5 }
+- assert: { text: "Send" }
+`)
+	if !reused || reader.Reads()-before != 1 || len(display) != 1 || display[0].Value != "Sent" {
+		t.Errorf("reused %v after %d reads, display %+v; want the assert's tree", reused, reader.Reads()-before, display)
+	}
+
+	// A read of one window is not the whole app's display.
+	before = reader.Reads()
+	_, display, reused = run(`
+- hover: { x: 5, y: 5 }
+- assert: { text: "Send", window: "Inbox" }
+`)
+	if reused || reader.Reads()-before != 2 || len(display) != 1 {
+		t.Errorf("reused %v after %d reads, display %+v; want a fresh app-wide read", reused, reader.Reads()-before, display)
+	}
+
+	// The hover comes after the last read, so the display is read afresh.
+	before = reader.Reads()
+	_, display, reused = run(`
+- assert: { text: "Send" }
+- hover: { x: 5, y: 5 }
+`)
+	if reused || reader.Reads()-before != 2 || len(display) != 1 {
+		t.Errorf("reused %v after %d reads, display %+v; want a fresh read", reused, reader.Reads()-before, display)
+	}
+}
+
+// overlapInputter records how many input events ever ran at once, and the
+// events in the order they started.
+type overlapInputter struct {
+	nopInputter
+	mu      sync.Mutex
+	active  int
+	maxSeen int
+	events  []string
+}
+
+func (in *overlapInputter) event(name string) error {
+	in.mu.Lock()
+	in.active++
+	in.maxSeen = max(in.maxSeen, in.active)
+	in.events = append(in.events, name)
+	in.mu.Unlock()
+	time.Sleep(10 * time.Millisecond)
+	in.mu.Lock()
+	in.active--
+	in.mu.Unlock()
+	return nil
+}
+
+func (in *overlapInputter) Click(x, y int, button platform.MouseButton, count int) error {
+	return in.event("click")
+}
+
+func (in *overlapInputter) TypeText(text string, delayMs int) error {
+	return in.event("type " + text)
+}
+
+func (in *overlapInputter) KeyCombo(keys []string) error {
+	return in.event("key " + strings.Join(keys, "+"))
+}
+
+// ignoredSetter accepts every value without setting it, as an app that
+// ignores accessibility writes does.
+type ignoredSetter struct{}
+
+func (ignoredSetter) SetValue(opts platform.SetValueOptions) error { return nil }
+func (ignoredSetter) SetValues(opts platform.SetValuesOptions) []error {
+	return make([]error, len(opts.Values))
+}
+
+func TestDoContextParallel_ResultsInOrder(t *testing.T) {
+	reader := &fake.Reader{App: "Mail", PID: 42, Latency: 20 * time.Millisecond, Windows: []fake.Window{{ID: 1, Title: "Inbox", Elements: []model.Element{
+		{Role: "btn", Title: "Send", Bounds: [4]int{10, 10, 50, 20}},
+	}}}}
+	rawSteps := parseSteps(t, `
+- parallel:
+    - assert: { text: "Send" }
+    - sleep: { ms: 1 }
+    - assert: { text: "Missing" }
+- sleep: { ms: 1 }
+`)
+	ctx := &DoContext{Provider: &platform.Provider{Reader: reader}, DefaultApp: "Mail", StopOnError: true}
+	ctx.ExecuteSteps(rawSteps, 0)
+	if len(ctx.Results) != 1 || !ctx.Stopped {
+		t.Fatalf("expected the failed group to stop the batch, got %d results", len(ctx.Results))
+	}
+	group := ctx.Results[0]
+	if group.OK || group.Action != "parallel" || len(group.Substeps) != 3 {
+		t.Fatalf("group = %+v", group)
+	}
+	for i, want := range []bool{true, true, false} {
+		if sub := group.Substeps[i]; sub.Step != i+1 || sub.OK != want {
+			t.Errorf("substep %d = step %d ok=%v, want step %d ok=%v", i, sub.Step, sub.OK, i+1, want)
+		}
+	}
+}
+
+func TestDoContextParallel_InputSerialized(t *testing.T) {
+	in := &overlapInputter{}
+	rawSteps := parseSteps(t, `
+- parallel:
+    - click: { x: 1, y: 1 }
+    - click: { x: 2, y: 2 }
+    - click: { x: 3, y: 3 }
+`)
+	ctx := &DoContext{Provider: &platform.Provider{Inputter: in}, StopOnError: true}
+	ctx.ExecuteSteps(rawSteps, 0)
+	if !ctx.Results[0].OK {
+		t.Fatalf("group failed: %+v", ctx.Results[0].Substeps)
+	}
+	if in.maxSeen != 1 {
+		t.Errorf("%d clicks ran at once, want 1", in.maxSeen)
+	}
+}
+
+func TestDoContextParallel_SetValueFallbackSerialized(t *testing.T) {
+	reader := &fake.Reader{App: "Mail", PID: 42, Windows: []fake.Window{{ID: 1, Title: "Compose", Elements: []model.Element{
+		{Role: "input", Title: "Subject", Bounds: [4]int{10, 10, 200, 20}},
+	}}}}
+	in := &overlapInputter{}
+	// The value does not take, so the set-value clicks the field, selects
+	// all and types while the sibling types too.
+	rawSteps := parseSteps(t, `
+- parallel:
+    - set-value: { text: "Subject", value: "Hi", verify: true, verify-delay: 10, max-retries: 1 }
+    - type: { text: "abc", key: "enter" }
+`)
+	ctx := &DoContext{Provider: &platform.Provider{Reader: reader, Inputter: in, ValueSetter: ignoredSetter{}}, DefaultApp: "Mail", StopOnError: true}
+	ctx.ExecuteSteps(rawSteps, 0)
+	if !ctx.Results[0].OK {
+		t.Fatalf("group failed: %+v", ctx.Results[0].Substeps)
+	}
+	if sub := ctx.Results[0].Substeps[0]; sub.RetryMethod != "type" {
+		t.Fatalf("set-value = %+v, want it to fall back to typing", sub)
+	}
+	if in.maxSeen != 1 {
+		t.Errorf("%d input events ran at once, want 1", in.maxSeen)
+	}
+	fallback := []string{"click", "key cmd+a", "type Hi"}
+	start := slices.Index(in.events, "click")
+	if start < 0 || len(in.events) < start+len(fallback) || !slices.Equal(in.events[start:start+len(fallback)], fallback) {
+		t.Errorf("input events %q; want the set-value fallback %q uninterrupted", in.events, fallback)
+	}
+}
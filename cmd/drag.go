@@ -45,7 +45,7 @@ func init() {
 }
 
 func runDrag(cmd *cobra.Command, args []string) error {
-	provider, err := platform.NewProvider()
+	provider, err := newProvider(cmd)
 	if err != nil {
 		return err
 	}
@@ -85,7 +85,7 @@ type parsedField struct {
 }
 
 func runFill(cmd *cobra.Command, args []string) error {
-	provider, err := platform.NewProvider()
+	provider, err := newProvider(cmd)
 	if err != nil {
 		return err
 	}
@@ -136,8 +136,7 @@ func runFill(cmd *cobra.Command, args []string) error {
 	results := make([]FillFieldResult, 0, len(fields))
 	fieldsSet := 0
 
-	for i, f := range fields {
-		result := fillOneField(provider, elements, f, appName, window, windowID, pid, tabBetween && i > 0)
+	for _, result := range fillFields(provider, elements, fields, appName, window, windowID, pid, tabBetween) {
 		results = append(results, result)
 		if result.OK {
 			fieldsSet++
@@ -177,6 +176,7 @@ func runFill(cmd *cobra.Command, args []string) error {
 				WindowID: windowID,
 				PID:      pid,
 				ID:       elem.ID,
+				Path:     elem.Path,
 				Action:   "press",
 			}); err != nil {
 				return fmt.Errorf("failed to press submit element: %w", err)
@@ -189,7 +189,7 @@ func runFill(cmd *cobra.Command, args []string) error {
 	prOpts := getPostReadOptions(cmd)
 	var state string
 	if prOpts.PostRead {
-		state = readPostActionState(provider, appName, window, windowID, pid, prOpts.Delay, prOpts.MaxElements)
+		state = postActionState(provider, prOpts, verifyResult{}, elements, appName, window, windowID, pid)
 	}
 
 	return output.Print(FillResult{
@@ -202,39 +202,105 @@ func runFill(cmd *cobra.Command, args []string) error {
 	})
 }
 
-// fillOneField resolves and fills a single form field.
-func fillOneField(provider *platform.Provider, elements []model.Element, f parsedField, appName, window string, windowID, pid int, useTab bool) FillFieldResult {
-	method := f.method
+// fillFields fills fields in order, resolving them in elements.
+// Consecutive fields set with set-value are set together in one
+// ValueSetter.SetValues call, which resolves all their elements in a single
+// traversal instead of one per field.
+func fillFields(provider *platform.Provider, elements []model.Element, fields []parsedField, appName, window string, windowID, pid int, tabBetween bool) []FillFieldResult {
+	results := make([]FillFieldResult, len(fields))
+	var batch []int // indexes of the fields waiting to be set together
+	var batchElems []*model.Element
+	flush := func() {
+		if len(batch) == 0 {
+			return
+		}
+		values := make([]platform.ElementValue, len(batch))
+		for k, i := range batch {
+			values[k] = platform.ElementValue{ID: batchElems[k].ID, Path: batchElems[k].Path, Attribute: "value", Value: fields[i].value}
+		}
+		errs := provider.ValueSetter.SetValues(platform.SetValuesOptions{
+			App:      appName,
+			Window:   window,
+			WindowID: windowID,
+			PID:      pid,
+			Values:   values,
+		})
+		for k, i := range batch {
+			elem := batchElems[k]
+			label := fillFieldLabel(fields[i], elem)
+			if errs[k] != nil {
+				results[i] = FillFieldResult{Label: label, ID: elem.ID, OK: false, Error: fmt.Sprintf("set-value failed: %v", errs[k])}
+			} else {
+				results[i] = FillFieldResult{Label: label, ID: elem.ID, OK: true, Target: elementInfoFromElement(elem)}
+			}
+		}
+		batch, batchElems = batch[:0], batchElems[:0]
+	}
 
-	// Resolve element
-	var elem *model.Element
-	var err error
+	for i, f := range fields {
+		useTab := tabBetween && i > 0
+		if f.method != "type" && !useTab && provider.ValueSetter != nil {
+			elem, failed := resolveFillField(elements, f)
+			if elem == nil {
+				results[i] = failed
+				continue
+			}
+			batch = append(batch, i)
+			batchElems = append(batchElems, elem)
+			continue
+		}
+		flush()
+		results[i] = fillOneField(provider, elements, f, appName, window, windowID, pid, useTab)
+	}
+	flush()
+	return results
+}
 
+// resolveFillField finds the element of a field in elements. When it is not
+// found, it returns nil and the field's failed result.
+func resolveFillField(elements []model.Element, f parsedField) (*model.Element, FillFieldResult) {
 	if f.id > 0 {
-		elem = findElementByID(elements, f.id)
+		elem := findElementByID(elements, f.id)
 		if elem == nil {
-			return FillFieldResult{
+			return nil, FillFieldResult{
 				Label: f.label,
 				ID:    f.id,
 				OK:    false,
 				Error: fmt.Sprintf("element with id %d not found", f.id),
 			}
 		}
-	} else {
-		elem, err = resolveElementByTextFromTree(elements, f.label, "", false, 0)
-		if err != nil {
-			return FillFieldResult{
-				Label: f.label,
-				OK:    false,
-				Error: err.Error(),
-			}
+		return elem, FillFieldResult{}
+	}
+	elem, err := resolveElementByTextFromTree(elements, f.label, "", false, 0)
+	if err != nil {
+		return nil, FillFieldResult{
+			Label: f.label,
+			OK:    false,
+			Error: err.Error(),
 		}
 	}
+	return elem, FillFieldResult{}
+}
 
-	label := f.label
-	if label == "" {
-		label = elem.Title
+// fillFieldLabel returns the label to report for a field: its own, or the
+// title of its element.
+func fillFieldLabel(f parsedField, elem *model.Element) string {
+	if f.label != "" {
+		return f.label
 	}
+	return elem.Title
+}
+
+// fillOneField resolves and fills a single form field.
+func fillOneField(provider *platform.Provider, elements []model.Element, f parsedField, appName, window string, windowID, pid int, useTab bool) FillFieldResult {
+	method := f.method
+
+	elem, failed := resolveFillField(elements, f)
+	if elem == nil {
+		return failed
+	}
+	label := fillFieldLabel(f, elem)
+	scope := platform.ReadOptions{App: appName, Window: window, WindowID: windowID, PID: pid}
 
 	// Fill the field
 	if useTab {
@@ -243,7 +309,7 @@ func fillOneField(provider *platform.Provider, elements []model.Element, f parse
 			if err := provider.Inputter.KeyCombo([]string{"tab"}); err != nil {
 				return FillFieldResult{Label: label, ID: elem.ID, OK: false, Error: fmt.Sprintf("tab failed: %v", err)}
 			}
-			time.Sleep(50 * time.Millisecond)
+			waitFocused(provider, scope, elem, focusClickTimeout)
 		}
 	}
 
@@ -253,12 +319,9 @@ func fillOneField(provider *platform.Provider, elements []model.Element, f parse
 			return FillFieldResult{Label: label, ID: elem.ID, OK: false, Error: "input simulation not available"}
 		}
 		if !useTab {
-			cx := elem.Bounds[0] + elem.Bounds[2]/2
-			cy := elem.Bounds[1] + elem.Bounds[3]/2
-			if err := provider.Inputter.Click(cx, cy, platform.MouseLeft, 1); err != nil {
+			if err := clickToFocus(provider, scope, elem); err != nil {
 				return FillFieldResult{Label: label, ID: elem.ID, OK: false, Error: fmt.Sprintf("failed to focus: %v", err)}
 			}
-			time.Sleep(50 * time.Millisecond)
 		}
 		// Select all first to replace existing content
 		if err := provider.Inputter.KeyCombo([]string{"cmd", "a"}); err != nil {
@@ -280,6 +343,7 @@ func fillOneField(provider *platform.Provider, elements []model.Element, f parse
 			WindowID:  windowID,
 			PID:       pid,
 			ID:        elem.ID,
+			Path:      elem.Path,
 			Value:     f.value,
 			Attribute: "value",
 		}
@@ -434,8 +498,7 @@ func executeFill(provider *platform.Provider, params map[string]interface{}, app
 
 	// Fill fields
 	filled := 0
-	for i, f := range fields {
-		result := fillOneField(provider, elements, f, app, window, windowID, pid, tabBetween && i > 0)
+	for _, result := range fillFields(provider, elements, fields, app, window, windowID, pid, tabBetween) {
 		if !result.OK {
 			return StepResult{Action: "fill"}, fmt.Errorf("field %q: %s", result.Label, result.Error)
 		}
@@ -0,0 +1,62 @@
+package cmd
+
+import (
+	"testing"
+
+	"github.com/mj1618/desktop-cli/internal/model"
+	"github.com/mj1618/desktop-cli/internal/platform"
+	"github.com/mj1618/desktop-cli/internal/platform/fake"
+)
+
+// countingSetter counts the calls made to a ValueSetter.
+type countingSetter struct {
+	platform.ValueSetter
+	single, batches int
+}
+
+func (s *countingSetter) SetValue(opts platform.SetValueOptions) error {
+	s.single++
+	return s.ValueSetter.SetValue(opts)
+}
+
+func (s *countingSetter) SetValues(opts platform.SetValuesOptions) []error {
+	s.batches++
+	return s.ValueSetter.SetValues(opts)
+}
+
+func TestFillFields_SetsValuesTogether(t *testing.T) {
+	field := func(title string) model.Element {
+		return model.Element{Role: "input", Title: title, Bounds: [4]int{0, 0, 100, 20}, Actions: []string{"press"}}
+	}
+	reader := &fake.Reader{App: "Mail", PID: 42, Windows: []fake.Window{{ID: 1, Title: "Sign Up", Elements: []model.Element{
+		field("Name"), field("Email"), field("Phone"), field("City"),
+	}}}}
+	setter := &countingSetter{ValueSetter: reader}
+	provider := &platform.Provider{Reader: reader, ValueSetter: setter, Inputter: nopInputter{}}
+	elements, err := reader.ReadElements(platform.ReadOptions{App: "Mail"})
+	if err != nil {
+		t.Fatal(err)
+	}
+
+	results := fillFields(provider, elements, []parsedField{
+		{label: "Name", value: "Ann", method: "set-value"},
+		{label: "Email", value: "ann@example.com", method: "set-value"},
+		{label: "Phone", value: "555", method: "type"},
+		{label: "City", value: "Oslo", method: "set-value"},
+		{label: "Fax", value: "1", method: "set-value"},
+	}, "Mail", "", 0, 0, false)
+
+	for i, want := range []bool{true, true, true, true, false} {
+		if results[i].OK != want {
+			t.Errorf("field %d: ok = %v (%s), want %v", i, results[i].OK, results[i].Error, want)
+		}
+	}
+	// The typed field splits the set-value fields into two batches.
+	if setter.batches != 2 || setter.single != 0 {
+		t.Errorf("%d batches and %d single sets, want 2 batches", setter.batches, setter.single)
+	}
+	got := reader.Windows[0].Elements
+	if got[0].Value != "Ann" || got[1].Value != "ann@example.com" || got[3].Value != "Oslo" {
+		t.Errorf("values = %q, %q, %q", got[0].Value, got[1].Value, got[3].Value)
+	}
+}
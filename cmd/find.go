@@ -65,7 +65,7 @@ func runFind(cmd *cobra.Command, args []string) error {
 		return fmt.Errorf("--text is required")
 	}
 
-	provider, err := platform.NewProvider()
+	provider, err := newProvider(cmd)
 	if err != nil {
 		return err
 	}
@@ -107,24 +107,27 @@ func runFind(cmd *cobra.Command, args []string) error {
 			break
 		}
 
-		elements, err := provider.Reader.ReadElements(platform.ReadOptions{
+		// Stream the window so the read stops as soon as the limit is reached.
+		remaining := limit - totalFound
+		var found []model.Element
+		matcher := &leafMatcher{textLower: textLower, roles: roleSet, exact: exact, emit: func(el model.Element) bool {
+			if el.Bounds[2] > 0 && el.Bounds[3] > 0 {
+				found = append(found, el)
+			}
+			return len(found) < remaining
+		}}
+		err := platform.StreamElements(provider.Reader, platform.ReadOptions{
 			PID:      win.PID,
 			WindowID: win.ID,
-		})
+		}, matcher.add)
 		if err != nil {
 			continue // skip windows that fail to read
 		}
-
-		found := filterVisibleElements(collectLeafMatches(elements, textLower, roleSet, exact))
+		matcher.finish()
 		if len(found) == 0 {
 			continue
 		}
 
-		remaining := limit - totalFound
-		if len(found) > remaining {
-			found = found[:remaining]
-		}
-
 		var elInfos []findElementInfo
 		for _, el := range found {
 			elInfos = append(elInfos, findElementInfo{
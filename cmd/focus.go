@@ -2,7 +2,6 @@ package cmd
 
 import (
 	"fmt"
-	"time"
 
 	"github.com/mj1618/desktop-cli/internal/output"
 	"github.com/mj1618/desktop-cli/internal/platform"
@@ -36,7 +35,7 @@ func init() {
 }
 
 func runFocus(cmd *cobra.Command, args []string) error {
-	provider, err := platform.NewProvider()
+	provider, err := newProvider(cmd)
 	if err != nil {
 		return err
 	}
@@ -71,20 +70,9 @@ func runFocus(cmd *cobra.Command, args []string) error {
 		if provider.Inputter == nil {
 			return fmt.Errorf("input simulation not available on this platform (required for --new-document)")
 		}
-		// Wait for the app to settle after focusing
-		time.Sleep(300 * time.Millisecond)
-
-		// Press Escape to dismiss any open dialog (e.g. file-open dialog in TextEdit)
-		if err := provider.Inputter.KeyCombo([]string{"escape"}); err != nil {
-			return fmt.Errorf("failed to dismiss dialog: %w", err)
-		}
-		time.Sleep(200 * time.Millisecond)
-
-		// Press Cmd+N to create a new blank document
-		if err := provider.Inputter.KeyCombo([]string{"cmd", "n"}); err != nil {
-			return fmt.Errorf("failed to create new document: %w", err)
+		if err := createNewDocument(provider, platform.ReadOptions{App: appName, Window: window, WindowID: windowID, PID: pid}); err != nil {
+			return err
 		}
-		time.Sleep(300 * time.Millisecond)
 	}
 
 	return output.Print(FocusResult{
@@ -96,3 +84,21 @@ func runFocus(cmd *cobra.Command, args []string) error {
 		NewDocument: newDocument,
 	})
 }
+
+// createNewDocument dismisses any dialog open in the focused app (e.g. the
+// file-open dialog of TextEdit) and creates a blank document, waiting for
+// the app in scope to come to the front, and to settle before and after
+// each key.
+func createNewDocument(provider *platform.Provider, scope platform.ReadOptions) error {
+	waitFrontmost(provider, scope.App, scope.PID, frontmostTimeout)
+	waitSettled(provider, scope, focusSettle)
+	if err := provider.Inputter.KeyCombo([]string{"escape"}); err != nil {
+		return fmt.Errorf("failed to dismiss dialog: %w", err)
+	}
+	waitSettled(provider, scope, focusSettle)
+	if err := provider.Inputter.KeyCombo([]string{"cmd", "n"}); err != nil {
+		return fmt.Errorf("failed to create new document: %w", err)
+	}
+	waitSettled(provider, scope, focusSettle)
+	return nil
+}
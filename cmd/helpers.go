@@ -3,6 +3,7 @@ package cmd
 import (
 	"fmt"
 	"math"
+	"slices"
 	"sort"
 	"strings"
 	"time"
@@ -17,6 +18,20 @@ import (
 // Set by the --no-auto-scope flag on commands that use text-based targeting.
 var noAutoScope bool
 
+// newProvider returns the platform provider for a command, bound to the
+// command's context so that the root --deadline applies to every call the
+// command makes (see platform.WithContext).
+func newProvider(cmd *cobra.Command) (*platform.Provider, error) {
+	provider, err := platform.NewProvider()
+	if err != nil {
+		return nil, err
+	}
+	if ctx := cmd.Context(); ctx != nil && ctx.Done() != nil {
+		provider = platform.WithContext(ctx, provider)
+	}
+	return provider, nil
+}
+
 // findElementByID searches the element tree recursively for an element with the given ID.
 func findElementByID(elements []model.Element, id int) *model.Element {
 	for i := range elements {
@@ -30,6 +45,15 @@ func findElementByID(elements []model.Element, id int) *model.Element {
 	return nil
 }
 
+// elementPath returns el's child-index path for platform lookups, or nil if
+// el is nil or its reader provides none (the lookup then uses the ID).
+func elementPath(el *model.Element) []int {
+	if el == nil {
+		return nil
+	}
+	return el.Path
+}
+
 // directChildrenOnly returns a copy of elements with their children removed,
 // effectively showing only the direct children of a parent element.
 func directChildrenOnly(elements []model.Element) []model.Element {
@@ -80,6 +104,58 @@ func collectLeafMatches(elements []model.Element, textLower string, roles map[st
 	return results
 }
 
+// leafMatcher finds the same elements as collectLeafMatches in a stream of
+// elements in pre-order (see platform.StreamElements), so a search can stop
+// reading once it has what it needs. A matching element is reported as soon
+// as its subtree has ended without a match inside it.
+type leafMatcher struct {
+	textLower string
+	roles     map[string]bool
+	exact     bool
+	emit      func(el model.Element) bool // return false to stop matching
+
+	open    []openElement // the current element and its ancestors
+	stopped bool
+}
+
+type openElement struct {
+	el          model.Element
+	depth       int
+	match       bool
+	descMatched bool // some descendant matched, so el is not a leaf match
+}
+
+// add feeds the next element of the stream. It returns false once emit has,
+// which callers pass on to stop the traversal.
+func (m *leafMatcher) add(el model.Element, depth int) bool {
+	if !m.close(depth) {
+		return false
+	}
+	match := textMatchesElement(el, m.textLower, m.exact) && (len(m.roles) == 0 || m.roles[el.Role])
+	m.open = append(m.open, openElement{el: el, depth: depth, match: match})
+	return true
+}
+
+// finish ends the stream, reporting the matches still open.
+func (m *leafMatcher) finish() {
+	m.close(1)
+}
+
+// close ends the subtrees of the open elements at depth or deeper.
+func (m *leafMatcher) close(depth int) bool {
+	for !m.stopped && len(m.open) > 0 && m.open[len(m.open)-1].depth >= depth {
+		top := m.open[len(m.open)-1]
+		m.open = m.open[:len(m.open)-1]
+		if (top.match || top.descMatched) && len(m.open) > 0 {
+			m.open[len(m.open)-1].descMatched = true
+		}
+		if top.match && !top.descMatched && !m.emit(top.el) {
+			m.stopped = true
+		}
+	}
+	return !m.stopped
+}
+
 func textMatchesElement(el model.Element, textLower string, exact bool) bool {
 	if exact {
 		return exactFieldMatch(el.Title, textLower) ||
@@ -937,6 +1013,12 @@ func readDisplayElements(provider *platform.Provider, appName, window string, wi
 	if err != nil {
 		return nil
 	}
+	return displayElementInfos(elements, targetBounds)
+}
+
+// displayElementInfos returns the display elements of a tree as
+// readDisplayElements does, without reading it.
+func displayElementInfos(elements []model.Element, targetBounds [4]int) []ElementInfo {
 	displays := collectDisplayElements(elements)
 	if len(displays) == 0 {
 		return nil
@@ -981,18 +1063,23 @@ func requireScope(appName, window string, windowID, pid int) error {
 	return nil
 }
 
-// addPostReadFlags adds --post-read, --post-read-delay, and --post-read-max-elements flags to a command.
+// addPostReadFlags adds --post-read, --post-read-delay, --post-read-settle and --post-read-max-elements flags to a command.
 func addPostReadFlags(cmd *cobra.Command) {
 	cmd.Flags().Bool("post-read", false, "Include compact UI state (agent format) in the response after the action")
-	cmd.Flags().Int("post-read-delay", 0, "Delay in ms before reading UI state (use for actions that trigger animations/transitions)")
+	cmd.Flags().Int("post-read-delay", 0, "Fixed delay in ms before reading UI state, instead of waiting for the UI to settle")
+	cmd.Flags().Int("post-read-settle", int(defaultPostReadSettle.Quiet/time.Millisecond), "Before reading UI state, wait until the UI has not changed for this many ms (0 = read immediately)")
+	cmd.Flags().Int("post-read-settle-max", int(defaultPostReadSettle.Max/time.Millisecond), "Longest to wait in ms for the UI to settle before reading UI state")
 	cmd.Flags().Int("post-read-max-elements", 0, "Max elements in post-read output (default: 200 for web content, 0=unlimited for native apps)")
+	cmd.Flags().Bool("post-read-diff", false, "Like --post-read, but include only the elements the action added, removed or changed, and where focus moved (the full state when much changed)")
 }
 
 // postReadOptions holds the parameters for --post-read behavior.
 type postReadOptions struct {
 	PostRead    bool
-	Delay       int // ms
-	MaxElements int // 0 = auto (200 for web, unlimited for native)
+	Delay       int // ms; when > 0, a fixed delay used instead of Settle
+	Settle      settleOptions
+	MaxElements int  // 0 = auto (200 for web, unlimited for native)
+	Diff        bool // report changes since the pre-action read (implies PostRead)
 }
 
 // getPostReadFlags reads --post-read, --post-read-delay, and --post-read-max-elements from a command.
@@ -1007,13 +1094,42 @@ func getPostReadOptions(cmd *cobra.Command) postReadOptions {
 	postRead, _ := cmd.Flags().GetBool("post-read")
 	delay, _ := cmd.Flags().GetInt("post-read-delay")
 	maxElements, _ := cmd.Flags().GetInt("post-read-max-elements")
+	diff, _ := cmd.Flags().GetBool("post-read-diff")
+	settleMs, _ := cmd.Flags().GetInt("post-read-settle")
+	settleMaxMs, _ := cmd.Flags().GetInt("post-read-settle-max")
 	return postReadOptions{
-		PostRead:    postRead,
+		PostRead:    postRead || diff,
 		Delay:       delay,
+		Settle:      settleOptions{Quiet: time.Duration(settleMs) * time.Millisecond, Max: time.Duration(settleMaxMs) * time.Millisecond},
 		MaxElements: maxElements,
+		Diff:        diff,
 	}
 }
 
+// postActionState returns the --post-read state after an action: the tree
+// read during verification if there was one, or a fresh read. With
+// --post-read-diff and pre, the tree the action's target was looked up in,
+// only the changes since pre are reported, unless much changed.
+func postActionState(provider *platform.Provider, opts postReadOptions, vr verifyResult, pre []model.Element, appName, window string, windowID, pid int) string {
+	if !opts.Diff || pre == nil {
+		if vr.PostState != "" {
+			return vr.PostState // reuse the tree already read during verification
+		}
+		return readPostActionState(provider, appName, window, windowID, pid, opts.Delay, opts.Settle, opts.MaxElements)
+	}
+
+	post, state := vr.PostElements, vr.PostState
+	if post == nil {
+		if post, state = readPostActionElements(provider, appName, window, windowID, pid, opts.Delay, opts.Settle, opts.MaxElements); post == nil {
+			return ""
+		}
+	}
+	if diff, ok := output.FormatAgentDiff(appName, pid, window, pre, post); ok {
+		return diff
+	}
+	return state
+}
+
 // defaultPostReadMaxElements is the max elements applied to post-read output
 // for web content, matching the read command's smart default. This prevents
 // 30KB+ output on complex web pages that would trigger file-based storage.
@@ -1022,8 +1138,8 @@ const defaultPostReadMaxElements = 200
 // readPostActionState reads the UI tree after an action and returns a compact
 // agent-format string. Best-effort: returns "" if the read fails.
 // maxElements controls the element cap: 0 means auto (200 for web, unlimited for native).
-func readPostActionState(provider *platform.Provider, appName, window string, windowID, pid int, delayMs int, maxElements int) string {
-	_, formatted := readPostActionElements(provider, appName, window, windowID, pid, delayMs, maxElements)
+func readPostActionState(provider *platform.Provider, appName, window string, windowID, pid int, delayMs int, settle settleOptions, maxElements int) string {
+	_, formatted := readPostActionElements(provider, appName, window, windowID, pid, delayMs, settle, maxElements)
 	return formatted
 }
 
@@ -1031,20 +1147,24 @@ func readPostActionState(provider *platform.Provider, appName, window string, wi
 // raw element tree and the formatted agent string. The raw elements can be
 // reused by --verify to avoid a redundant tree read. Best-effort: returns nil
 // elements and "" if the read fails.
+// It first waits delayMs if positive, or else for the UI to settle.
 // maxElements controls the element cap: 0 means auto (200 for web, unlimited for native).
-func readPostActionElements(provider *platform.Provider, appName, window string, windowID, pid int, delayMs int, maxElements int) ([]model.Element, string) {
+func readPostActionElements(provider *platform.Provider, appName, window string, windowID, pid int, delayMs int, settle settleOptions, maxElements int) ([]model.Element, string) {
 	if provider.Reader == nil {
 		return nil, ""
 	}
-	if delayMs > 0 {
-		time.Sleep(time.Duration(delayMs) * time.Millisecond)
-	}
-	elements, err := provider.Reader.ReadElements(platform.ReadOptions{
+	opts := platform.ReadOptions{
 		App:      appName,
 		Window:   window,
 		WindowID: windowID,
 		PID:      pid,
-	})
+	}
+	if delayMs > 0 {
+		pause(provider, time.Duration(delayMs)*time.Millisecond, opts)
+	} else {
+		waitSettled(provider, opts, settle)
+	}
+	elements, err := provider.Reader.ReadElements(opts)
 	if err != nil {
 		return nil, ""
 	}
@@ -1075,12 +1195,15 @@ func readPostActionElements(provider *platform.Provider, appName, window string,
 // used by --verify to detect whether the action caused a change.
 type elementSnapshot struct {
 	ID         int
+	Path       []int // child-index path, for watching the element (see watchTarget)
+	Role       string
 	Title      string
 	Value      string
 	Focused    bool
 	Selected   bool
 	Bounds     [4]int
-	ChildCount int
+	ChildCount int  // number of descendants
+	Children   int  // number of children
 	Exists     bool // true when the element was found pre-action
 }
 
@@ -1088,12 +1211,15 @@ type elementSnapshot struct {
 func snapshotElement(el *model.Element) elementSnapshot {
 	return elementSnapshot{
 		ID:         el.ID,
+		Path:       el.Path,
+		Role:       el.Role,
 		Title:      el.Title,
 		Value:      el.Value,
 		Focused:    el.Focused,
 		Selected:   el.Selected,
 		Bounds:     el.Bounds,
 		ChildCount: countAllDescendants(el.Children),
+		Children:   len(el.Children),
 		Exists:     true,
 	}
 }
@@ -1116,6 +1242,15 @@ func stateChanged(pre elementSnapshot, postElements []model.Element) bool {
 	if postEl == nil {
 		return true // element disappeared (e.g. dialog dismissed, navigation)
 	}
+	return elementChanged(pre, postEl)
+}
+
+// elementChanged reports whether any verifiable property of postEl differs
+// from the snapshot.
+func elementChanged(pre elementSnapshot, postEl *model.Element) bool {
+	if pre.Role != "" && postEl.Role != pre.Role {
+		return true // another element now sits at the path
+	}
 	if postEl.Title != pre.Title {
 		return true
 	}
@@ -1137,17 +1272,79 @@ func stateChanged(pre elementSnapshot, postElements []model.Element) bool {
 	return false
 }
 
+// verifyPollInterval is how often verification re-reads the element it
+// watches.
+const verifyPollInterval = 10 * time.Millisecond
+
+// watchTarget watches the element pre was taken of for a change, re-reading
+// only its parent, itself and its children (a scoped, depth-limited read
+// addressed by the element's path) every verifyPollInterval for up to
+// timeout. It returns as soon as the element changes, disappears or is
+// replaced by another. ok is false if the scope could not be read, in which
+// case the caller should verify with a full read: a failed read may be a
+// transient accessibility timeout as well as the parent going away.
+func watchTarget(provider *platform.Provider, pre elementSnapshot, appName, window string, windowID, pid int, timeout time.Duration) (changed, ok bool) {
+	if provider.Reader == nil || len(pre.Path) == 0 {
+		return false, false
+	}
+	scope, depth := pre.Path, 2 // the element and its children
+	if len(scope) > 1 {
+		scope, depth = scope[:len(scope)-1], 3 // its parent too
+	}
+	opts := platform.ReadOptions{App: appName, Window: window, WindowID: windowID, PID: pid, Scope: scope, Depth: depth}
+
+	deadline := time.Now().Add(timeout)
+	for {
+		time.Sleep(min(verifyPollInterval, max(time.Until(deadline), 0)))
+		elements, err := provider.Reader.ReadElements(opts)
+		if err != nil {
+			return false, false
+		}
+		el := findElementByPath(elements, pre.Path)
+		if el == nil || watchedElementChanged(pre, el) {
+			return true, true
+		}
+		if !time.Now().Before(deadline) {
+			return false, true
+		}
+	}
+}
+
+// watchedElementChanged is elementChanged for an element read with only
+// its children (see watchTarget), whose child count it compares instead of
+// the count of all its descendants.
+func watchedElementChanged(pre elementSnapshot, postEl *model.Element) bool {
+	self := *postEl
+	self.Children = nil
+	pre.ChildCount = 0
+	return elementChanged(pre, &self) || len(postEl.Children) != pre.Children
+}
+
+// findElementByPath returns the element with the given child-index path.
+func findElementByPath(elements []model.Element, path []int) *model.Element {
+	for i := range elements {
+		el := &elements[i]
+		if slices.Equal(el.Path, path) {
+			return el
+		}
+		if len(el.Path) < len(path) && slices.Equal(el.Path, path[:len(el.Path)]) {
+			return findElementByPath(el.Children, path)
+		}
+	}
+	return nil
+}
+
 // verifyOptions holds the parameters for action verification.
 type verifyOptions struct {
 	Verify      bool
-	VerifyDelay int // ms to wait before re-reading
+	VerifyDelay int // ms to watch the target for a change before retrying
 	MaxRetries  int // max retry attempts (total attempts = 1 + MaxRetries)
 }
 
 // addVerifyFlags adds --verify, --verify-delay, and --max-retries flags to a command.
 func addVerifyFlags(cmd *cobra.Command) {
 	cmd.Flags().Bool("verify", false, "Verify action succeeded by checking for UI changes; retry with fallback if no change detected")
-	cmd.Flags().Int("verify-delay", 100, "Delay in ms before verifying (default: 100)")
+	cmd.Flags().Int("verify-delay", 100, "How long in ms to watch for a UI change before retrying (default: 100)")
 	cmd.Flags().Int("max-retries", 2, "Max retry attempts when verification fails (default: 2)")
 }
 
@@ -1181,9 +1378,12 @@ type fallbackAction struct {
 	Execute func() error
 }
 
-// verifyAction performs verification after an action: waits, re-reads the tree,
-// checks if the UI changed. If not, retries with fallback strategies in order.
-// Returns a verifyResult describing the outcome.
+// verifyAction performs verification after an action: watches the target
+// element for a change (see watchTarget) or, when it cannot be watched,
+// waits and re-reads the whole tree. If nothing changed, retries with
+// fallback strategies in order. Returns a verifyResult describing the
+// outcome; its PostElements and PostState are set only when a full read was
+// made.
 // postReadMaxElements controls the element cap for the formatted state string
 // (0 = auto: 200 for web, unlimited for native).
 func verifyAction(
@@ -1196,17 +1396,22 @@ func verifyAction(
 ) verifyResult {
 	result := verifyResult{Verified: true}
 
-	// Wait, then re-read
-	postElements, postState := readPostActionElements(provider, appName, window, windowID, pid, opts.VerifyDelay, postReadMaxElements)
-	result.PostElements = postElements
-	result.PostState = postState
-
-	if postElements == nil {
-		// Could not read tree — can't verify, assume success (best-effort)
-		return result
+	// changed reports whether the UI changed. A full read that fails counts
+	// as a change on the first attempt (best-effort) and not after a retry.
+	changed := func(first bool) bool {
+		if changed, ok := watchTarget(provider, pre, appName, window, windowID, pid, time.Duration(opts.VerifyDelay)*time.Millisecond); ok {
+			return changed
+		}
+		postElements, postState := readPostActionElements(provider, appName, window, windowID, pid, opts.VerifyDelay, settleOptions{}, postReadMaxElements)
+		result.PostElements = postElements
+		result.PostState = postState
+		if postElements == nil {
+			return first
+		}
+		return stateChanged(pre, postElements)
 	}
 
-	if stateChanged(pre, postElements) {
+	if changed(true) {
 		return result
 	}
 
@@ -1222,12 +1427,7 @@ func verifyAction(
 			continue // fallback failed, try next
 		}
 
-		// Re-read after fallback
-		postElements, postState = readPostActionElements(provider, appName, window, windowID, pid, opts.VerifyDelay, postReadMaxElements)
-		result.PostElements = postElements
-		result.PostState = postState
-
-		if postElements != nil && stateChanged(pre, postElements) {
+		if changed(false) {
 			result.Retried = true
 			result.RetryMethod = fb.Method
 			result.RetryReason = "no UI change detected, retried with " + fb.Method
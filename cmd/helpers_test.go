@@ -4,8 +4,11 @@ import (
 	"fmt"
 	"sort"
 	"testing"
+	"time"
 
 	"github.com/mj1618/desktop-cli/internal/model"
+	"github.com/mj1618/desktop-cli/internal/platform"
+	"github.com/mj1618/desktop-cli/internal/platform/fake"
 )
 
 // buildGmailTree creates a simplified accessibility tree mimicking the Gmail
@@ -905,6 +908,125 @@ func TestStateChanged_ChildCountChanged(t *testing.T) {
 	}
 }
 
+// verifyFixture returns a fake app with a Send button, the provider reading
+// it and a snapshot of the button as read.
+func verifyFixture(t *testing.T) (*fake.Reader, *platform.Provider, elementSnapshot) {
+	t.Helper()
+	reader := &fake.Reader{App: "Mail", PID: 42, Windows: []fake.Window{{ID: 1, Title: "Compose", Elements: []model.Element{
+		{Role: "txt", Title: "To"},
+		{Role: "btn", Title: "Send", Children: []model.Element{{Role: "img"}}},
+	}}}}
+	elements, err := reader.ReadElements(platform.ReadOptions{App: "Mail"})
+	if err != nil {
+		t.Fatal(err)
+	}
+	send := findElementByPath(elements, []int{0, 1})
+	if send == nil || send.Title != "Send" {
+		t.Fatalf("no Send button at path 0.1 in %+v", elements)
+	}
+	return reader, &platform.Provider{Reader: reader}, snapshotElement(send)
+}
+
+func TestVerifyAction_WatchesTarget(t *testing.T) {
+	reader, provider, pre := verifyFixture(t)
+	reader.Windows[0].Elements[1].Title = "Sending…"
+
+	start := time.Now()
+	vr := verifyAction(provider, pre, verifyOptions{Verify: true, VerifyDelay: 1000, MaxRetries: 2}, "Mail", "", 0, 0, nil, 0)
+	if !vr.Verified || vr.Retried {
+		t.Errorf("verified=%v retried=%v, want verified on the first attempt", vr.Verified, vr.Retried)
+	}
+	if elapsed := time.Since(start); elapsed > 500*time.Millisecond {
+		t.Errorf("verification took %v; it should return as soon as the target changes", elapsed)
+	}
+	// One scoped read of the target's parent, no full read.
+	if reader.Reads() != 2 || vr.PostElements != nil || vr.PostState != "" {
+		t.Errorf("%d reads, post state %q; want one watch read and no full read", reader.Reads()-1, vr.PostState)
+	}
+}
+
+func TestVerifyAction_RetriesUntilTargetChanges(t *testing.T) {
+	reader, provider, pre := verifyFixture(t)
+	fallbacks := []fallbackAction{
+		{Method: "noop", Execute: func() error { return nil }},
+		{Method: "remove", Execute: func() error {
+			reader.Windows[0].Elements = reader.Windows[0].Elements[:1]
+			return nil
+		}},
+	}
+	vr := verifyAction(provider, pre, verifyOptions{Verify: true, VerifyDelay: 30, MaxRetries: 2}, "Mail", "", 0, 0, fallbacks, 0)
+	if !vr.Verified || vr.RetryMethod != "remove" {
+		t.Errorf("verified=%v method=%q, want verified after the remove fallback", vr.Verified, vr.RetryMethod)
+	}
+}
+
+func TestVerifyAction_NoChange(t *testing.T) {
+	_, provider, pre := verifyFixture(t)
+	start := time.Now()
+	vr := verifyAction(provider, pre, verifyOptions{Verify: true, VerifyDelay: 30}, "Mail", "", 0, 0, nil, 0)
+	if vr.Verified {
+		t.Error("verified without a change")
+	}
+	if elapsed := time.Since(start); elapsed < 30*time.Millisecond {
+		t.Errorf("gave up after %v, before the verify delay", elapsed)
+	}
+}
+
+// flakyReader records the options of each read and fails the reads
+// numbered in fail.
+type flakyReader struct {
+	platform.Reader
+	fail  map[int]bool
+	reads []platform.ReadOptions
+}
+
+func (r *flakyReader) ReadElements(opts platform.ReadOptions) ([]model.Element, error) {
+	r.reads = append(r.reads, opts)
+	if r.fail[len(r.reads)] {
+		return nil, fmt.Errorf("AX timeout")
+	}
+	return r.Reader.ReadElements(opts)
+}
+
+func TestWatchTarget_ReadsOnlyAroundTarget(t *testing.T) {
+	reader, _, pre := verifyFixture(t)
+	flaky := &flakyReader{Reader: reader}
+	changed, ok := watchTarget(&platform.Provider{Reader: flaky}, pre, "Mail", "", 0, 0, 20*time.Millisecond)
+	if changed || !ok {
+		t.Fatalf("changed=%v ok=%v, want an unchanged target", changed, ok)
+	}
+	// The parent, the target and the target's children.
+	if got := flaky.reads[0]; len(got.Scope) != 1 || got.Scope[0] != 0 || got.Depth != 3 {
+		t.Errorf("read scope %v depth %d, want the parent's path and depth 3", got.Scope, got.Depth)
+	}
+}
+
+func TestWatchTarget_ReadErrorIsNotAChange(t *testing.T) {
+	reader, _, pre := verifyFixture(t)
+	flaky := &flakyReader{Reader: reader, fail: map[int]bool{2: true}}
+	changed, ok := watchTarget(&platform.Provider{Reader: flaky}, pre, "Mail", "", 0, 0, time.Second)
+	if changed || ok {
+		t.Errorf("changed=%v ok=%v, want a fall back to a full read", changed, ok)
+	}
+}
+
+func TestVerifyAction_WatchesThroughStableIDs(t *testing.T) {
+	reader, _, _ := verifyFixture(t)
+	provider := platform.WithStableIDs(&platform.Provider{Reader: reader})
+	elements, err := provider.Reader.ReadElements(platform.ReadOptions{App: "Mail"})
+	if err != nil {
+		t.Fatal(err)
+	}
+	pre := snapshotElement(findElementByPath(elements, []int{0, 1}))
+	reader.Windows[0].Elements[1].Title = "Sending…"
+
+	before := reader.Reads()
+	vr := verifyAction(provider, pre, verifyOptions{Verify: true, VerifyDelay: 1000}, "Mail", "", 0, 0, nil, 0)
+	if !vr.Verified || reader.Reads()-before != 1 || vr.PostElements != nil {
+		t.Errorf("verified=%v after %d reads, full read %v; want one scoped read", vr.Verified, reader.Reads()-before, vr.PostElements != nil)
+	}
+}
+
 func TestFindFocusedElementRaw(t *testing.T) {
 	tree := []model.Element{
 		{ID: 1, Role: "window", Children: []model.Element{
@@ -1155,3 +1277,74 @@ func TestBoolPtr(t *testing.T) {
 		t.Error("expected *false")
 	}
 }
+
+// streamLeafMatches feeds tree to a leafMatcher in pre-order, stopping after
+// limit matches (0 = no limit).
+func streamLeafMatches(tree []model.Element, textLower string, roles map[string]bool, exact bool, limit int) []*model.Element {
+	var found []*model.Element
+	m := &leafMatcher{textLower: textLower, roles: roles, exact: exact, emit: func(el model.Element) bool {
+		found = append(found, &el)
+		return limit == 0 || len(found) < limit
+	}}
+	var walk func(els []model.Element, depth int) bool
+	walk = func(els []model.Element, depth int) bool {
+		for _, el := range els {
+			children := el.Children
+			el.Children = nil
+			if !m.add(el, depth) || !walk(children, depth+1) {
+				return false
+			}
+		}
+		return true
+	}
+	if walk(tree, 1) {
+		m.finish()
+	}
+	return found
+}
+
+func TestLeafMatcher_MatchesCollectLeafMatches(t *testing.T) {
+	nested := []model.Element{{
+		ID: 1, Role: "group", Title: "Subject line",
+		Children: []model.Element{
+			{ID: 2, Role: "txt", Title: "Subject"},
+			{ID: 3, Role: "group", Children: []model.Element{{ID: 4, Role: "txt", Value: "no"}}},
+		},
+	}, {ID: 5, Role: "txt", Title: "subject"}}
+	cases := []struct {
+		tree  []model.Element
+		text  string
+		roles map[string]bool
+		exact bool
+	}{
+		{buildGmailTree(), "subject", nil, false},
+		{buildGmailTree(), "subject", nil, true},
+		{buildGmailTree(), "subject", map[string]bool{"input": true}, false},
+		{buildFlightsTree(), "flights", map[string]bool{"lnk": true}, false},
+		{buildFlightsTree(), "google chrome", nil, false},
+		{nested, "subject", nil, false},
+		{nested, "subject", map[string]bool{"group": true}, false},
+	}
+	for _, c := range cases {
+		want := collectLeafMatches(c.tree, c.text, c.roles, c.exact)
+		got := streamLeafMatches(c.tree, c.text, c.roles, c.exact, 0)
+		if fmt.Sprint(elementIDs(got)) != fmt.Sprint(elementIDs(want)) {
+			t.Errorf("%q roles=%v exact=%v: streamed %v, want %v", c.text, c.roles, c.exact, elementIDs(got), elementIDs(want))
+		}
+	}
+}
+
+func TestLeafMatcher_StopsAtLimit(t *testing.T) {
+	got := streamLeafMatches(buildFlightsTree(), "flights", nil, false, 2)
+	if fmt.Sprint(elementIDs(got)) != "[2 3]" {
+		t.Errorf("got %v, want the first two matches [2 3]", elementIDs(got))
+	}
+}
+
+func elementIDs(els []*model.Element) []int {
+	out := make([]int, len(els))
+	for i, el := range els {
+		out[i] = el.ID
+	}
+	return out
+}
@@ -3,6 +3,7 @@ package cmd
 import (
 	"fmt"
 
+	"github.com/mj1618/desktop-cli/internal/model"
 	"github.com/mj1618/desktop-cli/internal/output"
 	"github.com/mj1618/desktop-cli/internal/platform"
 	"github.com/spf13/cobra"
@@ -38,7 +39,7 @@ func init() {
 }
 
 func runHover(cmd *cobra.Command, args []string) error {
-	provider, err := platform.NewProvider()
+	provider, err := newProvider(cmd)
 	if err != nil {
 		return err
 	}
@@ -57,15 +58,17 @@ func runHover(cmd *cobra.Command, args []string) error {
 	hasRef := ref != ""
 
 	var target *ElementInfo
+	var preElements []model.Element // tree the target was found in, for --post-read-diff
 
 	if hasRef {
 		if appName == "" && window == "" {
 			return fmt.Errorf("--ref requires --app or --window to scope the element lookup")
 		}
-		elem, _, err := resolveElementByRef(provider, appName, window, 0, 0, ref)
+		elem, tree, err := resolveElementByRef(provider, appName, window, 0, 0, ref)
 		if err != nil {
 			return err
 		}
+		preElements = tree
 		target = elementInfoFromElement(elem)
 		x = elem.Bounds[0] + elem.Bounds[2]/2
 		y = elem.Bounds[1] + elem.Bounds[3]/2
@@ -73,10 +76,11 @@ func runHover(cmd *cobra.Command, args []string) error {
 		if appName == "" && window == "" {
 			return fmt.Errorf("--text requires --app or --window to scope the element lookup")
 		}
-		elem, _, err := resolveElementByText(provider, appName, window, 0, 0, text, roles, exact, scopeID)
+		elem, tree, err := resolveElementByText(provider, appName, window, 0, 0, text, roles, exact, scopeID)
 		if err != nil {
 			return err
 		}
+		preElements = tree
 		target = elementInfoFromElement(elem)
 		x = elem.Bounds[0] + elem.Bounds[2]/2
 		y = elem.Bounds[1] + elem.Bounds[3]/2
@@ -96,6 +100,7 @@ func runHover(cmd *cobra.Command, args []string) error {
 		if err != nil {
 			return err
 		}
+		preElements = elements
 
 		elem := findElementByID(elements, id)
 		if elem == nil {
@@ -120,7 +125,7 @@ func runHover(cmd *cobra.Command, args []string) error {
 	prOpts := getPostReadOptions(cmd)
 	var state string
 	if prOpts.PostRead && (appName != "" || window != "") {
-		state = readPostActionState(provider, appName, window, 0, 0, prOpts.Delay, prOpts.MaxElements)
+		state = postActionState(provider, prOpts, verifyResult{}, preElements, appName, window, 0, 0)
 	}
 
 	return output.Print(HoverResult{
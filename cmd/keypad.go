@@ -0,0 +1,105 @@
+package cmd
+
+import (
+	"fmt"
+	"strings"
+
+	"github.com/mj1618/desktop-cli/internal/model"
+	"github.com/mj1618/desktop-cli/internal/platform"
+)
+
+// keypadKeyNames maps characters to the names on-screen keypads give the
+// keys that type them, besides the character itself (e.g. Calculator's
+// "Add" key for '+').
+var keypadKeyNames = map[rune][]string{
+	'+':  {"Add", "Plus"},
+	'-':  {"Subtract", "Minus"},
+	'*':  {"Multiply", "Times", "×"},
+	'/':  {"Divide", "÷"},
+	'=':  {"Equals"},
+	'.':  {"Point", "Decimal"},
+	'%':  {"Percent"},
+	'#':  {"Pound", "Hash"},
+	' ':  {"Space"},
+	'\n': {"Return", "Enter"},
+}
+
+// isCalculatorApp returns true if the app name matches Calculator.
+func isCalculatorApp(appName string) bool {
+	return strings.EqualFold(appName, "calculator")
+}
+
+// keypad maps characters to the on-screen keys that type them.
+type keypad map[rune]*model.Element
+
+// buildKeypad finds the key for each distinct character of text among the
+// buttons of elements: the one labelled with the character or one of its
+// keypadKeyNames, matched exactly before as a substring.
+func buildKeypad(elements []model.Element, text string) (keypad, error) {
+	kp := keypad{}
+	for _, r := range text {
+		if _, ok := kp[r]; ok {
+			continue
+		}
+		el := findKeypadKey(elements, r)
+		if el == nil {
+			return nil, fmt.Errorf("no on-screen key found for character %q", r)
+		}
+		kp[r] = el
+	}
+	return kp, nil
+}
+
+// findKeypadKey returns the button that types r, or nil.
+func findKeypadKey(elements []model.Element, r rune) *model.Element {
+	names := append([]string{string(r)}, keypadKeyNames[r]...)
+	for _, exact := range []bool{true, false} {
+		for _, name := range names {
+			if !exact && strings.TrimSpace(name) == "" {
+				continue // a space is part of too many labels to match by
+			}
+			if el, err := resolveElementByTextFromTree(elements, name, "btn", exact, 0); err == nil {
+				return el
+			}
+		}
+	}
+	return nil
+}
+
+// typeOnKeypad types text by pressing on-screen keys, for apps without a
+// text input such as Calculator or a PIN pad. It reads the UI once, finds
+// the key for each character, and presses them all back to back in one
+// ActionPerformer.PerformActions call. The callers' display read afterwards
+// shows the result.
+func typeOnKeypad(provider *platform.Provider, appName, window, text string) error {
+	if appName == "" && window == "" {
+		return fmt.Errorf("typing on a keypad requires --app or --window")
+	}
+	if provider.Reader == nil {
+		return fmt.Errorf("reader not available on this platform")
+	}
+	if provider.ActionPerformer == nil {
+		return fmt.Errorf("actions not available on this platform")
+	}
+	elements, err := provider.Reader.ReadElements(platform.ReadOptions{App: appName, Window: window})
+	if err != nil {
+		return fmt.Errorf("failed to read elements: %w", err)
+	}
+	kp, err := buildKeypad(elements, text)
+	if err != nil {
+		return err
+	}
+
+	var actions []platform.ElementAction
+	for _, r := range text {
+		el := kp[r]
+		actions = append(actions, platform.ElementAction{ID: el.ID, Path: el.Path, Action: "press"})
+	}
+	n, err := provider.ActionPerformer.PerformActions(platform.PerformActionsOptions{
+		App: appName, Window: window, Actions: actions,
+	})
+	if err != nil {
+		return fmt.Errorf("pressed %d of %d keys: %w", n, len(actions), err)
+	}
+	return nil
+}
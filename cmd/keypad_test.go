@@ -0,0 +1,46 @@
+package cmd
+
+import (
+	"reflect"
+	"testing"
+
+	"github.com/mj1618/desktop-cli/internal/model"
+	"github.com/mj1618/desktop-cli/internal/platform"
+	"github.com/mj1618/desktop-cli/internal/platform/fake"
+)
+
+func calculator() *fake.Reader {
+	key := func(title string) model.Element {
+		return model.Element{Role: "btn", Title: title, Bounds: [4]int{0, 0, 40, 40}, Actions: []string{"press"}}
+	}
+	return &fake.Reader{App: "Calculator", PID: 7, Windows: []fake.Window{{ID: 1, Title: "Calculator", Elements: []model.Element{
+		{Role: "txt", Value: "12", Bounds: [4]int{0, 0, 200, 40}},
+		{Role: "group", Children: []model.Element{key("1"), key("2"), key("3"), key("Add"), key("Equals"), key("All Clear")}},
+	}}}}
+}
+
+func TestTypeOnKeypad_OneRead(t *testing.T) {
+	reader := calculator()
+	provider := &platform.Provider{Reader: reader, ActionPerformer: reader}
+	if err := typeOnKeypad(provider, "Calculator", "", "12+21="); err != nil {
+		t.Fatal(err)
+	}
+	if reader.Reads() != 1 {
+		t.Errorf("%d reads, want 1", reader.Reads())
+	}
+	want := []string{"press 1", "press 2", "press Add", "press 2", "press 1", "press Equals"}
+	if got := reader.Performed(); !reflect.DeepEqual(got, want) {
+		t.Errorf("pressed %q, want %q", got, want)
+	}
+}
+
+func TestTypeOnKeypad_MissingKey(t *testing.T) {
+	reader := calculator()
+	provider := &platform.Provider{Reader: reader, ActionPerformer: reader}
+	if err := typeOnKeypad(provider, "Calculator", "", "1 2"); err == nil {
+		t.Fatal("expected an error for a character without a key")
+	}
+	if got := reader.Performed(); len(got) != 0 {
+		t.Errorf("pressed %q before finding every key", got)
+	}
+}
@@ -31,7 +31,7 @@ type appEntry struct {
 }
 
 func runList(cmd *cobra.Command, args []string) error {
-	provider, err := platform.NewProvider()
+	provider, err := newProvider(cmd)
 	if err != nil {
 		return err
 	}
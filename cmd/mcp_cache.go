@@ -10,10 +10,11 @@ import (
 
 // mcpCacheKey identifies a unique tree read scope.
 type mcpCacheKey struct {
-	App      string
-	Window   string
-	WindowID int
-	PID      int
+	App       string
+	Window    string
+	WindowID  int
+	PID       int
+	TextLimit int
 }
 
 // mcpCacheEntry holds a cached element tree with its timestamp.
@@ -44,10 +45,11 @@ func (c *mcpTreeCache) readElements(reader platform.Reader, opts platform.ReadOp
 	}
 
 	key := mcpCacheKey{
-		App:      opts.App,
-		Window:   opts.Window,
-		WindowID: opts.WindowID,
-		PID:      opts.PID,
+		App:       opts.App,
+		Window:    opts.Window,
+		WindowID:  opts.WindowID,
+		PID:       opts.PID,
+		TextLimit: opts.TextLimit,
 	}
 
 	c.mu.Lock()
@@ -60,7 +62,8 @@ func (c *mcpTreeCache) readElements(reader platform.Reader, opts platform.ReadOp
 
 	elements, err := reader.ReadElements(opts)
 	if err != nil {
-		return nil, err
+		// Truncated reads return a partial tree; pass it on but don't cache it.
+		return elements, err
 	}
 
 	c.mu.Lock()
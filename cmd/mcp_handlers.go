@@ -3,7 +3,9 @@ package cmd
 import (
 	"context"
 	"encoding/base64"
+	"errors"
 	"fmt"
+	"time"
 
 	"github.com/mark3labs/mcp-go/mcp"
 	"github.com/mj1618/desktop-cli/internal/model"
@@ -21,8 +23,9 @@ func mcpResultToText(result StepResult) string {
 	return string(b)
 }
 
-// writeActionHandler wraps an executeX call: locks provider, executes, invalidates cache.
+// writeActionHandler wraps an executeX call: acquires the provider, executes, invalidates cache.
 func (s *mcpServer) writeActionHandler(
+	ctx context.Context,
 	request mcp.CallToolRequest,
 	action string,
 	fn func(*platform.Provider, map[string]interface{}, string, string) (StepResult, error),
@@ -31,10 +34,13 @@ func (s *mcpServer) writeActionHandler(
 	app := StringParam(params, "app", "")
 	window := StringParam(params, "window", "")
 
-	s.providerMu.Lock()
-	defer s.providerMu.Unlock()
+	p, release, err := s.acquire(ctx)
+	if err != nil {
+		return mcp.NewToolResultError(err.Error()), nil
+	}
+	defer release()
 
-	result, err := fn(s.provider, params, app, window)
+	result, err := fn(p, params, app, window)
 	if err != nil {
 		result.OK = false
 		result.Error = err.Error()
@@ -51,20 +57,23 @@ func (s *mcpServer) writeActionHandler(
 	return mcp.NewToolResultText(mcpResultToText(result)), nil
 }
 
-func (s *mcpServer) handleList(_ context.Context, request mcp.CallToolRequest) (*mcp.CallToolResult, error) {
+func (s *mcpServer) handleList(ctx context.Context, request mcp.CallToolRequest) (*mcp.CallToolResult, error) {
 	params := request.GetArguments()
 	apps := BoolParam(params, "apps", false)
 	pid := IntParam(params, "pid", 0)
 	appName := StringParam(params, "app", "")
 
-	s.providerMu.Lock()
-	defer s.providerMu.Unlock()
+	p, release, err := s.acquire(ctx)
+	if err != nil {
+		return mcp.NewToolResultError(err.Error()), nil
+	}
+	defer release()
 
-	if s.provider.Reader == nil {
+	if p.Reader == nil {
 		return mcp.NewToolResultError("reader not available on this platform"), nil
 	}
 
-	windows, err := s.provider.Reader.ListWindows(platform.ListOptions{
+	windows, err := p.Reader.ListWindows(platform.ListOptions{
 		Apps: apps,
 		PID:  pid,
 		App:  appName,
@@ -94,36 +103,68 @@ func (s *mcpServer) handleList(_ context.Context, request mcp.CallToolRequest) (
 	return mcp.NewToolResultText(string(b)), nil
 }
 
-func (s *mcpServer) handleRead(_ context.Context, request mcp.CallToolRequest) (*mcp.CallToolResult, error) {
+func (s *mcpServer) handleRead(ctx context.Context, request mcp.CallToolRequest) (*mcp.CallToolResult, error) {
 	params := request.GetArguments()
 	app := StringParam(params, "app", "")
 	window := StringParam(params, "window", "")
 	windowID := IntParam(params, "window-id", 0)
 	pid := IntParam(params, "pid", 0)
 	depth := IntParam(params, "depth", 0)
+	textLimit := IntParam(params, "text-limit", 0)
 	scopeID := IntParam(params, "scope-id", 0)
 	text := StringParam(params, "text", "")
 	focused := BoolParam(params, "focused", false)
+	budgetMs := IntParam(params, "budget-ms", 0)
 
-	s.providerMu.Lock()
-	defer s.providerMu.Unlock()
+	var scope []int
+	if scopePath := StringParam(params, "scope-path", ""); scopePath != "" {
+		var err error
+		if scope, err = model.ParsePath(scopePath); err != nil {
+			return mcp.NewToolResultError(err.Error()), nil
+		}
+	}
 
-	if s.provider.Reader == nil {
+	p, release, err := s.acquire(ctx)
+	if err != nil {
+		return mcp.NewToolResultError(err.Error()), nil
+	}
+	defer release()
+
+	if p.Reader == nil {
 		return mcp.NewToolResultError("reader not available on this platform"), nil
 	}
 
 	opts := platform.ReadOptions{
-		App:      app,
-		Window:   window,
-		WindowID: windowID,
-		PID:      pid,
-		Depth:    depth,
+		App:       app,
+		Window:    window,
+		WindowID:  windowID,
+		PID:       pid,
+		Depth:     depth,
+		TextLimit: textLimit,
+		Scope:     scope,
 	}
 
-	elements, err := s.cache.readElements(s.provider.Reader, opts)
-	if err != nil {
+	reader := p.Reader
+	if budgetMs > 0 {
+		budgetCtx, cancel := context.WithTimeout(ctx, time.Duration(budgetMs)*time.Millisecond)
+		defer cancel()
+		opts.BreadthFirst = true
+		reader = platform.WithContext(budgetCtx, p).Reader
+	}
+
+	// A read that ran out of time still returns what it reached. The cache
+	// holds whole trees, so a subtree is always read afresh.
+	var elements []model.Element
+	if len(scope) > 0 {
+		elements, err = reader.ReadElements(opts)
+	} else {
+		elements, err = s.cache.readElements(reader, opts)
+	}
+	truncated := errors.Is(err, platform.ErrTruncated)
+	if err != nil && !truncated {
 		return mcp.NewToolResultError(err.Error()), nil
 	}
+	markExpandable(elements)
 
 	// Auto-prune web content
 	hasWeb := model.HasWebContent(elements)
@@ -162,46 +203,93 @@ func (s *mcpServer) handleRead(_ context.Context, request mcp.CallToolRequest) (
 	}
 
 	agentStr := output.FormatAgentString(app, pid, windowTitle, elements)
+	if truncated {
+		agentStr += output.TruncatedNote
+	}
 	return mcp.NewToolResultText(agentStr), nil
 }
 
-func (s *mcpServer) handleClick(_ context.Context, request mcp.CallToolRequest) (*mcp.CallToolResult, error) {
-	return s.writeActionHandler(request, "click", ExecuteClick)
+func (s *mcpServer) handleClick(ctx context.Context, request mcp.CallToolRequest) (*mcp.CallToolResult, error) {
+	return s.writeActionHandler(ctx, request, "click", ExecuteClick)
+}
+
+func (s *mcpServer) handleType(ctx context.Context, request mcp.CallToolRequest) (*mcp.CallToolResult, error) {
+	return s.writeActionHandler(ctx, request, "type", ExecuteType)
 }
 
-func (s *mcpServer) handleType(_ context.Context, request mcp.CallToolRequest) (*mcp.CallToolResult, error) {
-	return s.writeActionHandler(request, "type", ExecuteType)
+func (s *mcpServer) handleAction(ctx context.Context, request mcp.CallToolRequest) (*mcp.CallToolResult, error) {
+	return s.writeActionHandler(ctx, request, "action", ExecuteAction)
 }
 
-func (s *mcpServer) handleAction(_ context.Context, request mcp.CallToolRequest) (*mcp.CallToolResult, error) {
-	return s.writeActionHandler(request, "action", ExecuteAction)
+func (s *mcpServer) handleSetValue(ctx context.Context, request mcp.CallToolRequest) (*mcp.CallToolResult, error) {
+	return s.writeActionHandler(ctx, request, "set_value", ExecuteSetValue)
 }
 
-func (s *mcpServer) handleSetValue(_ context.Context, request mcp.CallToolRequest) (*mcp.CallToolResult, error) {
-	return s.writeActionHandler(request, "set_value", ExecuteSetValue)
+func (s *mcpServer) handleReadText(ctx context.Context, request mcp.CallToolRequest) (*mcp.CallToolResult, error) {
+	params := request.GetArguments()
+	opts := platform.ReadTextOptions{
+		App:      StringParam(params, "app", ""),
+		Window:   StringParam(params, "window", ""),
+		WindowID: IntParam(params, "window-id", 0),
+		PID:      IntParam(params, "pid", 0),
+		ID:       IntParam(params, "id", 0),
+		MaxChars: IntParam(params, "max-chars", 0),
+	}
+	ref := StringParam(params, "ref", "")
+	if opts.ID == 0 && ref == "" {
+		return mcp.NewToolResultError("specify id or ref to target an element"), nil
+	}
+
+	p, release, err := s.acquire(ctx)
+	if err != nil {
+		return mcp.NewToolResultError(err.Error()), nil
+	}
+	defer release()
+
+	if p.TextReader == nil {
+		return mcp.NewToolResultError("read_text not supported on this platform"), nil
+	}
+
+	if opts.ID == 0 {
+		elem, _, err := resolveElementByRef(p, opts.App, opts.Window, opts.WindowID, opts.PID, ref)
+		if err != nil {
+			return mcp.NewToolResultError(err.Error()), nil
+		}
+		opts.ID = elem.ID
+	}
+
+	result, err := readElementText(p, opts)
+	if err != nil {
+		return mcp.NewToolResultError(err.Error()), nil
+	}
+	b, _ := yaml.Marshal(result)
+	return mcp.NewToolResultText(string(b)), nil
 }
 
-func (s *mcpServer) handleScroll(_ context.Context, request mcp.CallToolRequest) (*mcp.CallToolResult, error) {
-	return s.writeActionHandler(request, "scroll", ExecuteScroll)
+func (s *mcpServer) handleScroll(ctx context.Context, request mcp.CallToolRequest) (*mcp.CallToolResult, error) {
+	return s.writeActionHandler(ctx, request, "scroll", ExecuteScroll)
 }
 
-func (s *mcpServer) handleHover(_ context.Context, request mcp.CallToolRequest) (*mcp.CallToolResult, error) {
-	return s.writeActionHandler(request, "hover", ExecuteHover)
+func (s *mcpServer) handleHover(ctx context.Context, request mcp.CallToolRequest) (*mcp.CallToolResult, error) {
+	return s.writeActionHandler(ctx, request, "hover", ExecuteHover)
 }
 
-func (s *mcpServer) handleFocus(_ context.Context, request mcp.CallToolRequest) (*mcp.CallToolResult, error) {
-	return s.writeActionHandler(request, "focus", ExecuteFocus)
+func (s *mcpServer) handleFocus(ctx context.Context, request mcp.CallToolRequest) (*mcp.CallToolResult, error) {
+	return s.writeActionHandler(ctx, request, "focus", ExecuteFocus)
 }
 
-func (s *mcpServer) handleFill(_ context.Context, request mcp.CallToolRequest) (*mcp.CallToolResult, error) {
+func (s *mcpServer) handleFill(ctx context.Context, request mcp.CallToolRequest) (*mcp.CallToolResult, error) {
 	params := request.GetArguments()
 	app := StringParam(params, "app", "")
 	window := StringParam(params, "window", "")
 
-	s.providerMu.Lock()
-	defer s.providerMu.Unlock()
+	p, release, err := s.acquire(ctx)
+	if err != nil {
+		return mcp.NewToolResultError(err.Error()), nil
+	}
+	defer release()
 
-	result, err := ExecuteStep(s.provider, "fill", params, app, window)
+	result, err := ExecuteStep(p, "fill", params, app, window)
 	if err != nil {
 		result.OK = false
 		result.Error = err.Error()
@@ -216,15 +304,18 @@ func (s *mcpServer) handleFill(_ context.Context, request mcp.CallToolRequest) (
 	return mcp.NewToolResultText(mcpResultToText(result)), nil
 }
 
-func (s *mcpServer) handleWait(_ context.Context, request mcp.CallToolRequest) (*mcp.CallToolResult, error) {
+func (s *mcpServer) handleWait(ctx context.Context, request mcp.CallToolRequest) (*mcp.CallToolResult, error) {
 	params := request.GetArguments()
 	app := StringParam(params, "app", "")
 	window := StringParam(params, "window", "")
 
-	s.providerMu.Lock()
-	defer s.providerMu.Unlock()
+	p, release, err := s.acquire(ctx)
+	if err != nil {
+		return mcp.NewToolResultError(err.Error()), nil
+	}
+	defer release()
 
-	result, err := ExecuteWait(s.provider, params, app, window)
+	result, err := ExecuteWait(p, params, app, window)
 	if err != nil {
 		result.OK = false
 		result.Error = err.Error()
@@ -234,15 +325,18 @@ func (s *mcpServer) handleWait(_ context.Context, request mcp.CallToolRequest) (
 	return mcp.NewToolResultText(mcpResultToText(result)), nil
 }
 
-func (s *mcpServer) handleAssert(_ context.Context, request mcp.CallToolRequest) (*mcp.CallToolResult, error) {
+func (s *mcpServer) handleAssert(ctx context.Context, request mcp.CallToolRequest) (*mcp.CallToolResult, error) {
 	params := request.GetArguments()
 	app := StringParam(params, "app", "")
 	window := StringParam(params, "window", "")
 
-	s.providerMu.Lock()
-	defer s.providerMu.Unlock()
+	p, release, err := s.acquire(ctx)
+	if err != nil {
+		return mcp.NewToolResultError(err.Error()), nil
+	}
+	defer release()
 
-	result, err := ExecuteAssert(s.provider, params, app, window)
+	result, err := ExecuteAssert(p, params, app, window)
 	if err != nil {
 		result.OK = false
 		result.Error = err.Error()
@@ -265,7 +359,7 @@ func (s *mcpServer) handleOpen(_ context.Context, request mcp.CallToolRequest) (
 	return mcp.NewToolResultText(mcpResultToText(result)), nil
 }
 
-func (s *mcpServer) handleScreenshot(_ context.Context, request mcp.CallToolRequest) (*mcp.CallToolResult, error) {
+func (s *mcpServer) handleScreenshot(ctx context.Context, request mcp.CallToolRequest) (*mcp.CallToolResult, error) {
 	params := request.GetArguments()
 	app := StringParam(params, "app", "")
 	window := StringParam(params, "window", "")
@@ -280,14 +374,17 @@ func (s *mcpServer) handleScreenshot(_ context.Context, request mcp.CallToolRequ
 		}
 	}
 
-	s.providerMu.Lock()
-	defer s.providerMu.Unlock()
+	p, release, err := s.acquire(ctx)
+	if err != nil {
+		return mcp.NewToolResultError(err.Error()), nil
+	}
+	defer release()
 
-	if s.provider.Screenshotter == nil {
+	if p.Screenshotter == nil {
 		return mcp.NewToolResultError("screenshot not supported on this platform"), nil
 	}
 
-	data, err := s.provider.Screenshotter.CaptureWindow(platform.ScreenshotOptions{
+	data, err := p.Screenshotter.CaptureWindow(platform.ScreenshotOptions{
 		App:      app,
 		Window:   window,
 		WindowID: windowID,
@@ -317,7 +414,7 @@ func (s *mcpServer) handleScreenshot(_ context.Context, request mcp.CallToolRequ
 	}, nil
 }
 
-func (s *mcpServer) handleDo(_ context.Context, request mcp.CallToolRequest) (*mcp.CallToolResult, error) {
+func (s *mcpServer) handleDo(ctx context.Context, request mcp.CallToolRequest) (*mcp.CallToolResult, error) {
 	params := request.GetArguments()
 	app := StringParam(params, "app", "")
 	window := StringParam(params, "window", "")
@@ -342,24 +439,37 @@ func (s *mcpServer) handleDo(_ context.Context, request mcp.CallToolRequest) (*m
 		steps = append(steps, m)
 	}
 
-	s.providerMu.Lock()
-	defer s.providerMu.Unlock()
+	// Validate the whole batch before touching the UI. Workflows that agents
+	// repeat are compiled once.
+	plan, err := s.plans.Compile(steps, app, window)
+	if err != nil {
+		return mcp.NewToolResultError(err.Error()), nil
+	}
+
+	p, release, err := s.acquire(ctx)
+	if err != nil {
+		return mcp.NewToolResultError(err.Error()), nil
+	}
+	defer release()
 
 	doCtx := &DoContext{
-		Provider:      s.provider,
+		Provider:      p,
 		DefaultApp:    app,
 		DefaultWindow: window,
 		StopOnError:   stopOnError,
 	}
-	doCtx.ExecuteSteps(steps, 0)
+	doCtx.ExecutePlan(plan)
 
 	s.cache.invalidateAll()
 
 	doResult := DoResult{
 		OK:      !doCtx.HasFailure,
 		Action:  "do",
-		Steps:   len(steps),
+		Steps:   plan.Len(),
 		Results: doCtx.Results,
+
+		TraversalsSaved: doCtx.TraversalsSaved(),
+		PrefetchHits:    doCtx.PrefetchHits(),
 	}
 	completed := 0
 	for _, r := range doCtx.Results {
@@ -372,3 +482,12 @@ func (s *mcpServer) handleDo(_ context.Context, request mcp.CallToolRequest) (*m
 	b, _ := yaml.Marshal(doResult)
 	return mcp.NewToolResultText(string(b)), nil
 }
+
+func (s *mcpServer) handleMetrics(_ context.Context, request mcp.CallToolRequest) (*mcp.CallToolResult, error) {
+	params := request.GetArguments()
+	b, _ := yaml.Marshal(map[string]interface{}{"stats": s.stats.Report(), "do_plan_cache_hits": s.plans.Hits()})
+	if BoolParam(params, "reset", false) {
+		s.stats.Reset()
+	}
+	return mcp.NewToolResultText(string(b)), nil
+}
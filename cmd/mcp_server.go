@@ -1,28 +1,33 @@
 package cmd
 
 import (
+	"context"
 	"fmt"
-	"sync"
 	"time"
 
 	"github.com/mark3labs/mcp-go/mcp"
 	mcpserver "github.com/mark3labs/mcp-go/server"
+	"github.com/mj1618/desktop-cli/internal/axtree"
 	"github.com/mj1618/desktop-cli/internal/platform"
 )
 
 // mcpServer wraps the MCP server with the platform provider and cache.
 type mcpServer struct {
-	provider   *platform.Provider
-	cache      *mcpTreeCache
-	providerMu sync.Mutex
-	mcp        *mcpserver.MCPServer
+	provider       *platform.Provider
+	cache          *mcpTreeCache
+	plans          *DoPlanCache
+	stats          *axtree.Stats
+	providerSem    chan struct{} // held by the request using the provider
+	requestTimeout time.Duration
+	mcp            *mcpserver.MCPServer
 }
 
 // MCPConfig holds MCP server configuration.
 type MCPConfig struct {
-	Transport string
-	Port      int
-	CacheTTL  time.Duration
+	Transport      string
+	Port           int
+	CacheTTL       time.Duration
+	RequestTimeout time.Duration // 0 = only the client's cancellation
 }
 
 // newMCPServer creates and configures an MCP server with all desktop-cli tools.
@@ -32,9 +37,30 @@ func newMCPServer(cfg MCPConfig) (*mcpServer, error) {
 		return nil, err
 	}
 
+	// Record accessibility call counts and latencies for the metrics tool.
+	stats := axtree.NewStats()
+	if sr, ok := provider.Reader.(platform.StatsReader); ok {
+		sr.SetStats(stats)
+	}
+
+	// Repeated reads of the same window only re-fetch attributes that change
+	// often, reusing element handles retained from the previous read.
+	if ir, ok := provider.Reader.(platform.IncrementalReader); ok {
+		ir.SetIncremental(true)
+	}
+
+	// Read the windows of a multi-window app concurrently.
+	provider.Reader = platform.WithConcurrentWindows(provider.Reader, platform.DefaultWindowWorkers)
+
+	// The server is long-lived and agents act on IDs from earlier reads, so
+	// keep element IDs stable across reads of the same window.
 	s := &mcpServer{
-		provider: provider,
-		cache:    newMCPTreeCache(cfg.CacheTTL),
+		provider:       platform.WithStableIDs(provider),
+		cache:          newMCPTreeCache(cfg.CacheTTL),
+		plans:          NewDoPlanCache(0),
+		stats:          stats,
+		providerSem:    make(chan struct{}, 1),
+		requestTimeout: cfg.RequestTimeout,
 	}
 
 	s.mcp = mcpserver.NewMCPServer(
@@ -46,6 +72,42 @@ func newMCPServer(cfg MCPConfig) (*mcpServer, error) {
 	return s, nil
 }
 
+// abandonedWriteLimit is how long the next request waits for the input,
+// action or set-value calls a request left running when it ran out of time:
+// long enough for a slow app to finish, so that their input does not
+// interleave, but bounded so that an app that never returns does not lock
+// the server.
+const abandonedWriteLimit = 5 * time.Second
+
+// acquire takes the provider for one request and returns it bound to the
+// request's context, limited to the server's request timeout: reads that
+// run out of time return the part of the tree read so far, and a hung app
+// no longer holds up the requests queued behind it. Requests use the
+// provider one at a time; one still waiting when its context is done gives
+// up. Call release when done: the next request gets the provider once any
+// input, action or set-value call the request abandoned when it ran out of
+// time has returned, or after abandonedWriteLimit.
+func (s *mcpServer) acquire(ctx context.Context) (p *platform.Provider, release func(), err error) {
+	cancel := func() {}
+	if s.requestTimeout > 0 {
+		ctx, cancel = context.WithTimeout(ctx, s.requestTimeout)
+	}
+	select {
+	case s.providerSem <- struct{}{}:
+	case <-ctx.Done():
+		cancel()
+		return nil, nil, fmt.Errorf("gave up waiting for an earlier request to finish: %w", ctx.Err())
+	}
+	p, wait := platform.WithContextWait(ctx, s.provider)
+	return p, func() {
+		cancel()
+		go func() {
+			wait(abandonedWriteLimit)
+			<-s.providerSem
+		}()
+	}, nil
+}
+
 // serve starts the MCP server with the configured transport.
 func (s *mcpServer) serve(cfg MCPConfig) error {
 	switch cfg.Transport {
@@ -84,6 +146,9 @@ func (s *mcpServer) registerTools() {
 			mcp.WithBoolean("focused", mcp.Description("Only return the currently focused element")),
 			mcp.WithNumber("scope-id", mcp.Description("Limit to descendants of this element ID")),
 			mcp.WithNumber("max-elements", mcp.Description("Max elements in output (0 = unlimited)")),
+			mcp.WithNumber("text-limit", mcp.Description("Max characters of long text content inlined per element (default 200, -1 = none); longer text is marked textlen=N, fetch it with read_text")),
+			mcp.WithNumber("budget-ms", mcp.Description("Read breadth-first and return what has been read after this many milliseconds (0 = no budget); containers whose children were not reached are marked more=N expand=PATH")),
+			mcp.WithString("scope-path", mcp.Description("Read only the subtree at this child-index path, e.g. the expand path of an element a budgeted read left unexpanded")),
 		),
 		s.handleRead,
 	)
@@ -160,6 +225,21 @@ func (s *mcpServer) registerTools() {
 		s.handleSetValue,
 	)
 
+	// read_text
+	s.mcp.AddTool(
+		mcp.NewTool("read_text",
+			mcp.WithDescription("Read the full text content of a UI element. Reads inline only the start of long text (marked textlen=N); use this to fetch the rest."),
+			mcp.WithString("app", mcp.Description("Scope to application")),
+			mcp.WithString("window", mcp.Description("Scope to window")),
+			mcp.WithNumber("window-id", mcp.Description("Scope to window by system ID")),
+			mcp.WithNumber("pid", mcp.Description("Scope to process")),
+			mcp.WithNumber("id", mcp.Description("Element ID")),
+			mcp.WithString("ref", mcp.Description("Element ref from a prior read")),
+			mcp.WithNumber("max-chars", mcp.Description("Max characters to return (0 = all)")),
+		),
+		s.handleReadText,
+	)
+
 	// scroll
 	s.mcp.AddTool(
 		mcp.NewTool("scroll",
@@ -294,7 +374,7 @@ func (s *mcpServer) registerTools() {
 	// do (batch)
 	s.mcp.AddTool(
 		mcp.NewTool("do",
-			mcp.WithDescription("Execute multiple actions in a batch. Steps execute sequentially. Supports: click, type, action, set-value, scroll, hover, focus, wait, assert, fill, read, open, sleep, if-exists, if-focused, try"),
+			mcp.WithDescription("Execute multiple actions in a batch. Steps execute sequentially; the substeps of a parallel step run concurrently. Supports: click, type, action, set-value, scroll, hover, focus, wait, assert, fill, read, open, sleep, if-exists, if-focused, try, parallel"),
 			mcp.WithString("app", mcp.Description("Default app for all steps")),
 			mcp.WithString("window", mcp.Description("Default window for all steps")),
 			mcp.WithArray("steps", mcp.Description("Array of step objects"), mcp.Required()),
@@ -302,4 +382,13 @@ func (s *mcpServer) registerTools() {
 		),
 		s.handleDo,
 	)
+
+	// metrics
+	s.mcp.AddTool(
+		mcp.NewTool("metrics",
+			mcp.WithDescription("Accessibility call counts and latency histograms per app, call and attribute, recorded since the server started. Use to find apps or attributes that make reads slow."),
+			mcp.WithBoolean("reset", mcp.Description("Clear the recorded metrics after returning them")),
+		),
+		s.handleMetrics,
+	)
 }
@@ -41,7 +41,7 @@ func init() {
 }
 
 func runObserve(cmd *cobra.Command, args []string) error {
-	provider, err := platform.NewProvider()
+	provider, err := newProvider(cmd)
 	if err != nil {
 		return err
 	}
@@ -90,11 +90,17 @@ func runObserve(cmd *cobra.Command, args []string) error {
 	}
 	start := time.Now()
 
+	// IDs are kept persistent across polls so an insertion near the top of
+	// the tree is reported as one added element, not as every later element
+	// changing.
+	ids := model.NewIdentityTracker()
+
 	// Initial read to establish baseline
 	elements, err := provider.Reader.ReadElements(readOpts)
 	if err != nil {
 		return fmt.Errorf("initial read failed: %w", err)
 	}
+	ids.Assign(elements)
 	prevFlat := model.FlattenElements(elements)
 
 	// Emit snapshot event
@@ -124,6 +130,7 @@ func runObserve(cmd *cobra.Command, args []string) error {
 			continue
 		}
 
+		ids.Assign(elements)
 		currFlat := model.FlattenElements(elements)
 		changes := model.DiffElements(prevFlat, currFlat)
 
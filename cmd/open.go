@@ -89,7 +89,7 @@ func runOpen(cmd *cobra.Command, args []string) error {
 
 	// Wait for the application window to appear
 	if waitForWindow && resolvedApp != "" {
-		provider, err := platform.NewProvider()
+		provider, err := newProvider(cmd)
 		if err != nil {
 			return err
 		}
@@ -113,9 +113,9 @@ func runOpen(cmd *cobra.Command, args []string) error {
 	// Post-read: include full UI state in agent format
 	var state string
 	if prOpts.PostRead && resolvedApp != "" {
-		provider, err := platform.NewProvider()
+		provider, err := newProvider(cmd)
 		if err == nil {
-			state = readPostActionState(provider, resolvedApp, "", 0, 0, prOpts.Delay, prOpts.MaxElements)
+			state = readPostActionState(provider, resolvedApp, "", 0, 0, prOpts.Delay, prOpts.Settle, prOpts.MaxElements)
 		}
 	}
 
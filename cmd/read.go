@@ -2,7 +2,9 @@ package cmd
 
 import (
 	"bytes"
+	"context"
 	"encoding/base64"
+	"errors"
 	"fmt"
 	"image"
 	"image/jpeg"
@@ -11,10 +13,12 @@ import (
 	"strings"
 	"time"
 
+	"github.com/mj1618/desktop-cli/internal/axtree"
 	"github.com/mj1618/desktop-cli/internal/model"
 	"github.com/mj1618/desktop-cli/internal/output"
 	"github.com/mj1618/desktop-cli/internal/platform"
 	"github.com/spf13/cobra"
+	"gopkg.in/yaml.v3"
 )
 
 var readCmd = &cobra.Command{
@@ -41,9 +45,14 @@ func init() {
 	readCmd.Flags().Bool("prune", false, "Remove anonymous group/other elements that have no title, value, or description")
 	readCmd.Flags().Bool("focused", false, "Only return the currently focused element")
 	readCmd.Flags().Int("scope-id", 0, "Limit to descendants of this element ID")
+	readCmd.Flags().String("scope-path", "", "Read only the subtree at this child-index path, e.g. an expand path from a budgeted read; IDs are those of a full read")
+	readCmd.Flags().Int("budget-ms", 0, "Read breadth-first and return what has been read after this many milliseconds (0 = no budget); elements whose children were not reached are marked more=N")
 	readCmd.Flags().Bool("children", false, "Show only direct children of the matched element (use with --text or --scope-id)")
 	readCmd.Flags().Int("max-elements", 0, "Max elements in agent format output (0 = unlimited; auto-set to 200 for web content)")
 	readCmd.Flags().Int64("since", 0, "Return only changes since this timestamp (from a previous read's ts field)")
+	readCmd.Flags().Int("text-limit", 0, "Max characters of long text content inlined per element (0 = default 200, -1 = none); longer text is marked with its length, fetch it with read-text")
+	readCmd.Flags().Int("parallel-windows", 1, "Read up to N windows at once when reading a whole app (IDs are the same as a sequential read)")
+	readCmd.Flags().Bool("stats", false, "Write accessibility call counts and latency histograms (per app, call and attribute) to stderr")
 
 	// Screenshot format flags (only used with --format screenshot)
 	readCmd.Flags().Float64("scale", 0.25, "Screenshot scale factor 0.1-1.0 (default 0.25 for token efficiency, only with --format screenshot)")
@@ -54,7 +63,7 @@ func init() {
 }
 
 func runRead(cmd *cobra.Command, args []string) error {
-	provider, err := platform.NewProvider()
+	provider, err := newProvider(cmd)
 	if err != nil {
 		return err
 	}
@@ -76,6 +85,11 @@ func runRead(cmd *cobra.Command, args []string) error {
 	children, _ := cmd.Flags().GetBool("children")
 	maxElements, _ := cmd.Flags().GetInt("max-elements")
 	since, _ := cmd.Flags().GetInt64("since")
+	showStats, _ := cmd.Flags().GetBool("stats")
+	textLimit, _ := cmd.Flags().GetInt("text-limit")
+	parallelWindows, _ := cmd.Flags().GetInt("parallel-windows")
+	scopePath, _ := cmd.Flags().GetString("scope-path")
+	budgetMs, _ := cmd.Flags().GetInt("budget-ms")
 
 	var roles []string
 	if rolesStr != "" {
@@ -93,6 +107,13 @@ func runRead(cmd *cobra.Command, args []string) error {
 		}
 	}
 
+	var scope []int
+	if scopePath != "" {
+		if scope, err = model.ParsePath(scopePath); err != nil {
+			return err
+		}
+	}
+
 	if provider.Reader == nil {
 		return fmt.Errorf("reader not available on this platform")
 	}
@@ -107,12 +128,34 @@ func runRead(cmd *cobra.Command, args []string) error {
 		VisibleOnly: visibleOnly,
 		BBox:        bbox,
 		Compact:     compact,
+		TextLimit:   textLimit,
+		Scope:       scope,
 	}
 
-	elements, err := provider.Reader.ReadElements(opts)
-	if err != nil {
+	if showStats {
+		if sr, ok := provider.Reader.(platform.StatsReader); ok {
+			stats := axtree.NewStats()
+			sr.SetStats(stats)
+			defer printReadStats(stats)
+		}
+	}
+
+	// With --deadline or --budget-ms, a read that runs out of time returns
+	// what it reached.
+	ctx := cmd.Context()
+	if budgetMs > 0 {
+		var cancel context.CancelFunc
+		ctx, cancel = context.WithTimeout(ctx, time.Duration(budgetMs)*time.Millisecond)
+		defer cancel()
+		opts.BreadthFirst = true
+	}
+	reader := platform.WithConcurrentWindows(provider.Reader, parallelWindows)
+	elements, err := platform.ReadElementsContext(ctx, reader, opts)
+	truncated := errors.Is(err, platform.ErrTruncated)
+	if err != nil && !truncated {
 		return err
 	}
+	markExpandable(elements)
 
 	// --- Smart defaults ---
 	// Detect web content and apply optimal defaults unless --raw is set.
@@ -227,6 +270,12 @@ func runRead(cmd *cobra.Command, args []string) error {
 
 	// Diff mode: return only changes since the given timestamp
 	if since > 0 {
+		if truncated {
+			return fmt.Errorf("--since needs the whole tree: %w", err)
+		}
+		if len(scope) > 0 {
+			return fmt.Errorf("--since needs the whole tree; it cannot be used with --scope-path")
+		}
 		prevElements, err := model.LoadSnapshot(appName, since)
 		if err != nil {
 			return fmt.Errorf("no snapshot found for ts %d: %w", since, err)
@@ -249,7 +298,9 @@ func runRead(cmd *cobra.Command, args []string) error {
 	}
 
 	// Save snapshot for future --since calls
-	model.SaveSnapshot(appName, now, flatElements)
+	if !truncated && len(scope) == 0 {
+		model.SaveSnapshot(appName, now, flatElements)
+	}
 
 	// Output as flat list or tree
 	if flat {
@@ -259,6 +310,7 @@ func runRead(cmd *cobra.Command, args []string) error {
 			Window:        windowTitle,
 			SmartDefaults: smartDefaultsStr,
 			TS:            now,
+			Truncated:     truncated,
 			Elements:      flatElements,
 		}
 		return output.Print(result)
@@ -270,12 +322,35 @@ func runRead(cmd *cobra.Command, args []string) error {
 		Window:        windowTitle,
 		SmartDefaults: smartDefaultsStr,
 		TS:            now,
+		Truncated:     truncated,
 		Elements:      elements,
 	}
 
 	return output.Print(result)
 }
 
+// markExpandable gives elements whose children a budgeted read did not
+// reach, and elements it could not number, the --scope-path that reads them
+// with their IDs.
+func markExpandable(elements []model.Element) {
+	for i := range elements {
+		if elements[i].More > 0 || (elements[i].ID == 0 && len(elements[i].Path) > 0) {
+			elements[i].Expand = model.FormatPath(elements[i].Path)
+		}
+		markExpandable(elements[i].Children)
+	}
+}
+
+// printReadStats writes recorded accessibility call stats to stderr, keeping
+// them out of the read output.
+func printReadStats(stats *axtree.Stats) {
+	b, err := yaml.Marshal(map[string]interface{}{"stats": stats.Report()})
+	if err != nil {
+		return
+	}
+	os.Stderr.Write(b)
+}
+
 // runReadScreenshot implements the --format screenshot mode: captures an annotated
 // screenshot with [id] labels and returns it alongside a structured element list.
 func runReadScreenshot(cmd *cobra.Command, provider *platform.Provider, appName, window string, windowID, pid int, windowTitle string, elements []model.Element, prune bool) error {
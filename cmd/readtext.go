@@ -0,0 +1,108 @@
+package cmd
+
+import (
+	"fmt"
+
+	"github.com/mj1618/desktop-cli/internal/output"
+	"github.com/mj1618/desktop-cli/internal/platform"
+	"github.com/spf13/cobra"
+)
+
+// ReadTextResult is the output of a successful read-text command.
+type ReadTextResult struct {
+	OK        bool   `yaml:"ok"                  json:"ok"`
+	Action    string `yaml:"action"              json:"action"`
+	ID        int    `yaml:"id"                  json:"id"`
+	Length    int    `yaml:"length"              json:"length"` // full text length in characters
+	Truncated bool   `yaml:"truncated,omitempty" json:"truncated,omitempty"`
+	Text      string `yaml:"text"                json:"text"`
+}
+
+var readTextCmd = &cobra.Command{
+	Use:   "read-text",
+	Short: "Read the full text content of a UI element",
+	Long: `Read the full text content of a UI element by ID or ref.
+
+To keep reads small, text content that is only reachable through the text
+attributes (e.g. a contenteditable mail body) is inlined into the element's
+value only up to --text-limit characters (default 200). Such elements are
+marked with their full length (tl: in YAML/JSON, textlen= in agent format);
+use read-text to fetch the rest on demand.`,
+	RunE: runReadText,
+}
+
+func init() {
+	rootCmd.AddCommand(readTextCmd)
+	readTextCmd.Flags().Int("id", 0, "Element ID from read output")
+	readTextCmd.Flags().Int("max-chars", 0, "Max characters to return (0 = all)")
+	readTextCmd.Flags().String("app", "", "Scope to application")
+	readTextCmd.Flags().String("window", "", "Scope to window")
+	readTextCmd.Flags().Int("window-id", 0, "Scope to window by system ID")
+	readTextCmd.Flags().Int("pid", 0, "Scope to process by PID")
+	addRefFlag(readTextCmd)
+}
+
+func runReadText(cmd *cobra.Command, args []string) error {
+	provider, err := newProvider(cmd)
+	if err != nil {
+		return err
+	}
+	if provider.TextReader == nil {
+		return fmt.Errorf("read-text not supported on this platform")
+	}
+
+	id, _ := cmd.Flags().GetInt("id")
+	maxChars, _ := cmd.Flags().GetInt("max-chars")
+	appName, _ := cmd.Flags().GetString("app")
+	window, _ := cmd.Flags().GetString("window")
+	windowID, _ := cmd.Flags().GetInt("window-id")
+	pid, _ := cmd.Flags().GetInt("pid")
+	ref, _ := cmd.Flags().GetString("ref")
+
+	if !cmd.Flags().Changed("id") && ref == "" {
+		return fmt.Errorf("specify --id or --ref to target an element")
+	}
+	if err := requireScope(appName, window, windowID, pid); err != nil {
+		return err
+	}
+
+	var path []int
+	if ref != "" && !cmd.Flags().Changed("id") {
+		elem, _, err := resolveElementByRef(provider, appName, window, windowID, pid, ref)
+		if err != nil {
+			return err
+		}
+		id, path = elem.ID, elem.Path
+	}
+
+	result, err := readElementText(provider, platform.ReadTextOptions{
+		App:      appName,
+		Window:   window,
+		WindowID: windowID,
+		PID:      pid,
+		ID:       id,
+		Path:     path,
+		MaxChars: maxChars,
+	})
+	if err != nil {
+		return err
+	}
+	return output.Print(result)
+}
+
+// readElementText reads an element's text and reports whether it was cut
+// short by opts.MaxChars.
+func readElementText(provider *platform.Provider, opts platform.ReadTextOptions) (ReadTextResult, error) {
+	text, length, err := provider.TextReader.ReadText(opts)
+	if err != nil {
+		return ReadTextResult{}, err
+	}
+	return ReadTextResult{
+		OK:        true,
+		Action:    "read-text",
+		ID:        opts.ID,
+		Length:    length,
+		Truncated: opts.MaxChars > 0 && length > opts.MaxChars,
+		Text:      text,
+	}, nil
+}
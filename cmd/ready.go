@@ -0,0 +1,117 @@
+package cmd
+
+import (
+	"strings"
+	"time"
+
+	"github.com/mj1618/desktop-cli/internal/model"
+	"github.com/mj1618/desktop-cli/internal/platform"
+)
+
+// readyPollInterval is how often the readiness waits below check their
+// condition. The conditions are usually met within a few milliseconds.
+const readyPollInterval = 5 * time.Millisecond
+
+// Caps on the readiness waits, from the fixed delays they replace.
+const (
+	focusClickTimeout = 50 * time.Millisecond  // a click gives its element focus
+	frontmostTimeout  = 300 * time.Millisecond // a focused app comes to the front
+)
+
+// waitUntil checks cond every readyPollInterval until it holds, for up to
+// timeout, and reports whether it held.
+func waitUntil(timeout time.Duration, cond func() bool) bool {
+	deadline := time.Now().Add(timeout)
+	for {
+		if cond() {
+			return true
+		}
+		if !time.Now().Before(deadline) {
+			return false
+		}
+		time.Sleep(min(readyPollInterval, max(time.Until(deadline), 0)))
+	}
+}
+
+// waitFocused waits for el, or an element inside it, to have keyboard
+// focus, re-reading only el's subtree, for up to timeout. Without a reader
+// or a path to el it just waits timeout.
+func waitFocused(provider *platform.Provider, scope platform.ReadOptions, el *model.Element, timeout time.Duration) bool {
+	if provider.Reader == nil || len(el.Path) == 0 {
+		time.Sleep(timeout)
+		return false
+	}
+	scope.Scope = el.Path
+	return waitUntil(timeout, func() bool {
+		elements, err := provider.Reader.ReadElements(scope)
+		return err == nil && findFocusedElementRaw(elements) != nil
+	})
+}
+
+// waitFrontmost waits for the app named app, or with pid, to be the
+// frontmost app, for up to timeout. Without a window manager, or with
+// neither app nor pid, it just waits timeout.
+func waitFrontmost(provider *platform.Provider, app string, pid int, timeout time.Duration) bool {
+	if provider.WindowManager == nil || (app == "" && pid == 0) {
+		time.Sleep(timeout)
+		return false
+	}
+	return waitUntil(timeout, func() bool {
+		name, frontPID, err := provider.WindowManager.GetFrontmostApp()
+		return err == nil && ((pid != 0 && frontPID == pid) || (pid == 0 && strings.EqualFold(name, app)))
+	})
+}
+
+// clickToFocus clicks the center of el and waits for it to take focus
+// (see waitFocused), for up to focusClickTimeout.
+func clickToFocus(provider *platform.Provider, scope platform.ReadOptions, el *model.Element) error {
+	cx := el.Bounds[0] + el.Bounds[2]/2
+	cy := el.Bounds[1] + el.Bounds[3]/2
+	if err := provider.Inputter.Click(cx, cy, platform.MouseLeft, 1); err != nil {
+		return err
+	}
+	waitFocused(provider, scope, el, focusClickTimeout)
+	return nil
+}
+
+// clipboardMark is the state of the clipboard at some point, to tell
+// whether it has changed since.
+type clipboardMark struct {
+	count   int // platform.ClipboardChangeCounter count, if counted
+	counted bool
+	text    string // the clipboard text otherwise
+}
+
+// markClipboard records the state of the clipboard.
+func markClipboard(cm platform.ClipboardManager) clipboardMark {
+	if cc, ok := cm.(platform.ClipboardChangeCounter); ok {
+		if n, err := cc.ChangeCount(); err == nil {
+			return clipboardMark{count: n, counted: true}
+		}
+	}
+	text, _ := cm.GetText()
+	return clipboardMark{text: text}
+}
+
+// waitClipboardChange waits for the clipboard to change since mark, for up
+// to timeout, and returns its text. Where the clipboard keeps a change
+// count, that is polled; otherwise the text is, and text copied that
+// happens to equal the marked text is returned after timeout.
+func waitClipboardChange(cm platform.ClipboardManager, mark clipboardMark, timeout time.Duration) (string, error) {
+	cc, counted := cm.(platform.ClipboardChangeCounter)
+	counted = counted && mark.counted
+	var text string
+	var err error
+	waitUntil(timeout, func() bool {
+		if counted {
+			n, cerr := cc.ChangeCount()
+			return cerr != nil || n != mark.count
+		}
+		text, err = cm.GetText()
+		return err != nil || text != mark.text
+	})
+	if counted {
+		return cm.GetText()
+	}
+	return text, err
+}
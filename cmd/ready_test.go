@@ -0,0 +1,102 @@
+package cmd
+
+import (
+	"testing"
+	"time"
+
+	"github.com/mj1618/desktop-cli/internal/model"
+	"github.com/mj1618/desktop-cli/internal/platform"
+	"github.com/mj1618/desktop-cli/internal/platform/fake"
+)
+
+// frontmostAfter reports app as frontmost from its calls'th call on.
+type frontmostAfter struct {
+	app   string
+	pid   int
+	calls int
+}
+
+func (w *frontmostAfter) FocusWindow(opts platform.FocusOptions) error { return nil }
+
+func (w *frontmostAfter) GetFrontmostApp() (string, int, error) {
+	w.calls--
+	if w.calls > 0 {
+		return "Finder", 1, nil
+	}
+	return w.app, w.pid, nil
+}
+
+// focusAfter reads a text field that has focus from its reads'th read on.
+type focusAfter struct {
+	reads int
+	scope []int
+}
+
+func (r *focusAfter) ReadElements(opts platform.ReadOptions) ([]model.Element, error) {
+	r.reads--
+	r.scope = opts.Scope
+	return []model.Element{{ID: 1, Role: "input", Focused: r.reads <= 0}}, nil
+}
+
+func (r *focusAfter) ListWindows(opts platform.ListOptions) ([]model.Window, error) {
+	return nil, nil
+}
+
+func TestWaitFocused(t *testing.T) {
+	reader := &focusAfter{reads: 3}
+	provider := &platform.Provider{Reader: reader}
+	el := &model.Element{ID: 1, Role: "input", Path: []int{0, 2}}
+	start := time.Now()
+	if !waitFocused(provider, platform.ReadOptions{App: "Notes"}, el, time.Second) {
+		t.Fatal("element did not take focus")
+	}
+	if elapsed := time.Since(start); elapsed > 500*time.Millisecond {
+		t.Errorf("took %v", elapsed)
+	}
+	if len(reader.scope) != 2 || reader.scope[1] != 2 {
+		t.Errorf("read scope %v, want the element's path", reader.scope)
+	}
+}
+
+func TestWaitFocused_Timeout(t *testing.T) {
+	provider := &platform.Provider{Reader: &focusAfter{reads: 1 << 30}}
+	el := &model.Element{ID: 1, Role: "input", Path: []int{0}}
+	start := time.Now()
+	if waitFocused(provider, platform.ReadOptions{App: "Notes"}, el, 30*time.Millisecond) {
+		t.Fatal("unfocused element reported as focused")
+	}
+	if elapsed := time.Since(start); elapsed < 30*time.Millisecond {
+		t.Errorf("gave up after %v, want 30ms", elapsed)
+	}
+}
+
+func TestWaitFrontmost(t *testing.T) {
+	wm := &frontmostAfter{app: "Safari", pid: 42, calls: 3}
+	provider := &platform.Provider{WindowManager: wm}
+	if !waitFrontmost(provider, "safari", 0, time.Second) {
+		t.Error("app by name did not come to the front")
+	}
+	wm.calls = 3
+	if !waitFrontmost(provider, "", 42, time.Second) {
+		t.Error("app by pid did not come to the front")
+	}
+	wm.calls = 1 << 30
+	if waitFrontmost(provider, "Safari", 0, 20*time.Millisecond) {
+		t.Error("background app reported as frontmost")
+	}
+}
+
+func TestWaitFocused_ThroughStableIDs(t *testing.T) {
+	reader := &fake.Reader{App: "Notes", PID: 3, Windows: []fake.Window{{ID: 1, Title: "Note", Elements: []model.Element{
+		{Role: "input", Title: "Body", Focused: true, Bounds: [4]int{0, 0, 100, 20}},
+	}}}}
+	provider := platform.WithStableIDs(&platform.Provider{Reader: reader})
+	elements, err := provider.Reader.ReadElements(platform.ReadOptions{App: "Notes"})
+	if err != nil {
+		t.Fatal(err)
+	}
+	body := findElementByPath(elements, []int{0, 0})
+	if !waitFocused(provider, platform.ReadOptions{App: "Notes"}, body, 100*time.Millisecond) {
+		t.Error("focused element not seen through persistent IDs")
+	}
+}
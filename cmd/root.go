@@ -1,6 +1,7 @@
 package cmd
 
 import (
+	"context"
 	"fmt"
 	"os"
 
@@ -16,8 +17,15 @@ var rootCmd = &cobra.Command{
 	Long:  "A CLI tool that lets AI agents read and interact with desktop UI elements via accessibility APIs.",
 }
 
+// cancelDeadline releases the --deadline context once the command is done.
+var cancelDeadline context.CancelFunc
+
 func Execute() {
-	if err := rootCmd.Execute(); err != nil {
+	err := rootCmd.Execute()
+	if cancelDeadline != nil {
+		cancelDeadline()
+	}
+	if err != nil {
 		os.Exit(1)
 	}
 }
@@ -26,6 +34,7 @@ func init() {
 	rootCmd.Version = fmt.Sprintf("%s (commit: %s, built: %s)", version.Version, version.Commit, version.BuildDate)
 	rootCmd.PersistentFlags().String("format", "", "Output format: yaml, json, agent, screenshot (read only)")
 	rootCmd.PersistentFlags().Bool("raw", false, "Disable all smart defaults (auto-prune, auto-format)")
+	rootCmd.PersistentFlags().Duration("deadline", 0, "Give up on the target app after this long, e.g. 5s (0 = no limit); read returns the part of the tree read by then")
 	rootCmd.PersistentPreRunE = func(cmd *cobra.Command, args []string) error {
 		if platform.RequestPermissionsFunc != nil {
 			platform.RequestPermissionsFunc()
@@ -35,6 +44,13 @@ func init() {
 		raw, _ := rootCmd.PersistentFlags().GetBool("raw")
 		output.RawMode = raw
 
+		// Bound the whole command by --deadline (see newProvider).
+		if deadline, _ := rootCmd.PersistentFlags().GetDuration("deadline"); deadline > 0 {
+			ctx, cancel := context.WithTimeout(cmd.Context(), deadline)
+			cmd.SetContext(ctx)
+			cancelDeadline = cancel
+		}
+
 		// Use the root persistent flag directly to avoid conflicts with
 		// subcommand local flags (e.g. screenshot --format png/jpg).
 		format, _ := rootCmd.PersistentFlags().GetString("format")
@@ -30,7 +30,7 @@ func init() {
 }
 
 func runScreenshot(cmd *cobra.Command, args []string) error {
-	provider, err := platform.NewProvider()
+	provider, err := newProvider(cmd)
 	if err != nil {
 		return err
 	}
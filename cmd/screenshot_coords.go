@@ -61,7 +61,7 @@ func flattenRecursiveForAnnotation(el model.Element, result *[]model.Element) {
 }
 
 func runScreenshotCoords(cmd *cobra.Command, args []string) error {
-	provider, err := platform.NewProvider()
+	provider, err := newProvider(cmd)
 	if err != nil {
 		return err
 	}
@@ -40,7 +40,7 @@ func init() {
 }
 
 func runScroll(cmd *cobra.Command, args []string) error {
-	provider, err := platform.NewProvider()
+	provider, err := newProvider(cmd)
 	if err != nil {
 		return err
 	}
@@ -29,17 +29,20 @@ func init() {
 	serveCmd.Flags().String("transport", "stdio", "Transport: stdio, streamable-http")
 	serveCmd.Flags().Int("port", 8080, "HTTP port for streamable-http transport")
 	serveCmd.Flags().Int("cache-ttl", 500, "Element tree cache TTL in milliseconds (0 to disable)")
+	serveCmd.Flags().Int("request-timeout", 30000, "Give up on a tool call after this many milliseconds; reads return the part of the tree read so far (0 = no limit)")
 }
 
 func runServe(cmd *cobra.Command, args []string) error {
 	transport, _ := cmd.Flags().GetString("transport")
 	port, _ := cmd.Flags().GetInt("port")
 	cacheTTLMs, _ := cmd.Flags().GetInt("cache-ttl")
+	requestTimeoutMs, _ := cmd.Flags().GetInt("request-timeout")
 
 	cfg := MCPConfig{
-		Transport: transport,
-		Port:      port,
-		CacheTTL:  time.Duration(cacheTTLMs) * time.Millisecond,
+		Transport:      transport,
+		Port:           port,
+		CacheTTL:       time.Duration(cacheTTLMs) * time.Millisecond,
+		RequestTimeout: time.Duration(requestTimeoutMs) * time.Millisecond,
 	}
 
 	srv, err := newMCPServer(cfg)
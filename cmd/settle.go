@@ -0,0 +1,103 @@
+package cmd
+
+import (
+	"hash/fnv"
+	"strconv"
+	"time"
+
+	"github.com/mj1618/desktop-cli/internal/model"
+	"github.com/mj1618/desktop-cli/internal/platform"
+)
+
+// settleOptions configures waitSettled.
+type settleOptions struct {
+	Quiet time.Duration // how long the UI must stay unchanged; 0 = don't wait
+	Max   time.Duration // the longest to wait for that (0 = no limit)
+}
+
+var (
+	// defaultPostReadSettle is how --post-read waits for the UI after an
+	// action unless --post-read-delay asks for a fixed delay.
+	defaultPostReadSettle = settleOptions{Quiet: 50 * time.Millisecond, Max: 2 * time.Second}
+	// focusSettle is the wait after focusing an app or pressing a key in
+	// it, while the app activates or a window or dialog opens or closes.
+	focusSettle = settleOptions{Quiet: 150 * time.Millisecond, Max: 1500 * time.Millisecond}
+)
+
+// settlePollInterval is how often waitSettled reads the UI.
+const settlePollInterval = 10 * time.Millisecond
+
+// settleDepth bounds the reads waitSettled polls with: deep enough to see
+// windows, sheets, dialogs and page content appear, cheap enough to repeat
+// every few milliseconds.
+const settleDepth = 8
+
+// waitSettled waits until the UI of opts has stopped changing: until reads
+// of its top settleDepth levels have had the same fingerprint for s.Quiet,
+// or for at most s.Max. It reports whether the UI settled. Without a reader
+// it waits s.Quiet.
+func waitSettled(provider *platform.Provider, opts platform.ReadOptions, s settleOptions) bool {
+	if s.Quiet <= 0 {
+		return true
+	}
+	if provider == nil || provider.Reader == nil {
+		time.Sleep(s.Quiet)
+		return false
+	}
+	opts.Depth = settleDepth
+
+	start := time.Now()
+	var last uint64
+	var since time.Time // when the UI was first seen as it is now
+	for {
+		elements, err := provider.Reader.ReadElements(opts)
+		now := time.Now()
+		fp := treeFingerprint(elements)
+		if err != nil {
+			fp = 0 // a failed read is a state like any other (e.g. a window closing)
+		}
+		switch {
+		case since.IsZero() || fp != last:
+			last, since = fp, now
+		case now.Sub(since) >= s.Quiet:
+			return true
+		}
+		if s.Max > 0 && now.Sub(start) >= s.Max {
+			return false
+		}
+		time.Sleep(settlePollInterval)
+	}
+}
+
+// treeFingerprint hashes what the user can see of a tree: each element's
+// role, labels, value, state and bounds, and the tree's shape.
+func treeFingerprint(elements []model.Element) uint64 {
+	h := fnv.New64a()
+	var buf []byte
+	var walk func(els []model.Element)
+	walk = func(els []model.Element) {
+		for _, el := range els {
+			buf = buf[:0]
+			buf = append(buf, el.Role...)
+			buf = append(buf, 0)
+			buf = append(buf, el.Title...)
+			buf = append(buf, 0)
+			buf = append(buf, el.Description...)
+			buf = append(buf, 0)
+			buf = append(buf, el.Value...)
+			buf = append(buf, 0)
+			for _, b := range el.Bounds {
+				buf = strconv.AppendInt(buf, int64(b), 10)
+				buf = append(buf, ',')
+			}
+			buf = strconv.AppendBool(buf, el.Focused)
+			buf = strconv.AppendBool(buf, el.Selected)
+			buf = strconv.AppendInt(buf, int64(len(el.Children)), 10)
+			buf = append(buf, '\n')
+			h.Write(buf)
+			walk(el.Children)
+		}
+	}
+	walk(elements)
+	return h.Sum64()
+}
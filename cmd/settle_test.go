@@ -0,0 +1,52 @@
+package cmd
+
+import (
+	"fmt"
+	"testing"
+	"time"
+
+	"github.com/mj1618/desktop-cli/internal/model"
+	"github.com/mj1618/desktop-cli/internal/platform"
+)
+
+// changingReader returns a tree whose text changes on each of the first
+// changes reads, and then stays the same.
+type changingReader struct {
+	changes int
+	reads   int
+}
+
+func (r *changingReader) ReadElements(opts platform.ReadOptions) ([]model.Element, error) {
+	r.reads++
+	return []model.Element{{Role: "window", Title: "Inbox", Children: []model.Element{
+		{Role: "txt", Value: fmt.Sprintf("Loading %d", min(r.reads, r.changes))},
+	}}}, nil
+}
+
+func (r *changingReader) ListWindows(opts platform.ListOptions) ([]model.Window, error) {
+	return nil, nil
+}
+
+func TestWaitSettled(t *testing.T) {
+	reader := &changingReader{changes: 5}
+	provider := &platform.Provider{Reader: reader}
+	start := time.Now()
+	if !waitSettled(provider, platform.ReadOptions{App: "Mail"}, settleOptions{Quiet: 30 * time.Millisecond, Max: time.Second}) {
+		t.Fatal("UI did not settle")
+	}
+	// Five changing reads, then unchanged ones for the quiet period.
+	if reader.reads < 6 || time.Since(start) > 500*time.Millisecond {
+		t.Errorf("settled after %d reads in %v", reader.reads, time.Since(start))
+	}
+}
+
+func TestWaitSettled_Max(t *testing.T) {
+	provider := &platform.Provider{Reader: &changingReader{changes: 1 << 30}}
+	start := time.Now()
+	if waitSettled(provider, platform.ReadOptions{App: "Mail"}, settleOptions{Quiet: 30 * time.Millisecond, Max: 60 * time.Millisecond}) {
+		t.Fatal("changing UI reported as settled")
+	}
+	if elapsed := time.Since(start); elapsed < 60*time.Millisecond || elapsed > 500*time.Millisecond {
+		t.Errorf("gave up after %v, want about 60ms", elapsed)
+	}
+}
@@ -61,7 +61,7 @@ func init() {
 }
 
 func runSetValue(cmd *cobra.Command, args []string) error {
-	provider, err := platform.NewProvider()
+	provider, err := newProvider(cmd)
 	if err != nil {
 		return err
 	}
@@ -95,20 +95,23 @@ func runSetValue(cmd *cobra.Command, args []string) error {
 	prOpts := getPostReadOptions(cmd)
 	var preSnapshot elementSnapshot
 	var resolvedElem *model.Element
+	var preElements []model.Element // tree the target was found in, for --post-read-diff
 
 	// Resolve ref or text to element ID if needed
 	if hasRef && !hasID {
-		elem, _, err := resolveElementByRef(provider, appName, window, windowID, pid, ref)
+		elem, tree, err := resolveElementByRef(provider, appName, window, windowID, pid, ref)
 		if err != nil {
 			return err
 		}
+		preElements = tree
 		id = elem.ID
 		resolvedElem = elem
 	} else if hasText && !hasID {
-		elem, _, err := resolveElementByText(provider, appName, window, windowID, pid, text, roles, exact, scopeID)
+		elem, tree, err := resolveElementByText(provider, appName, window, windowID, pid, text, roles, exact, scopeID)
 		if err != nil {
 			return err
 		}
+		preElements = tree
 		id = elem.ID
 		resolvedElem = elem
 	} else if hasID {
@@ -117,6 +120,7 @@ func runSetValue(cmd *cobra.Command, args []string) error {
 			if elements, readErr := provider.Reader.ReadElements(platform.ReadOptions{
 				App: appName, Window: window, WindowID: windowID, PID: pid,
 			}); readErr == nil {
+				preElements = elements
 				resolvedElem = findElementByID(elements, id)
 			}
 		}
@@ -132,6 +136,7 @@ func runSetValue(cmd *cobra.Command, args []string) error {
 		WindowID:  windowID,
 		PID:       pid,
 		ID:        id,
+		Path:      elementPath(resolvedElem),
 		Value:     value,
 		Attribute: attribute,
 	}
@@ -146,17 +151,14 @@ func runSetValue(cmd *cobra.Command, args []string) error {
 	if vOpts.Verify && preSnapshot.Exists {
 		var fallbacks []fallbackAction
 		if provider.Inputter != nil && resolvedElem != nil && attribute == "value" {
-			elemBounds := resolvedElem.Bounds
 			fallbacks = append(fallbacks, fallbackAction{
 				Method: "type",
 				Execute: func() error {
 					// Click to focus, select all, then type the value
-					cx := elemBounds[0] + elemBounds[2]/2
-					cy := elemBounds[1] + elemBounds[3]/2
-					if err := provider.Inputter.Click(cx, cy, platform.MouseLeft, 1); err != nil {
+					scope := platform.ReadOptions{App: appName, Window: window, WindowID: windowID, PID: pid}
+					if err := clickToFocus(provider, scope, resolvedElem); err != nil {
 						return err
 					}
-					time.Sleep(50 * time.Millisecond)
 					if err := provider.Inputter.KeyCombo([]string{"cmd", "a"}); err != nil {
 						return err
 					}
@@ -171,11 +173,7 @@ func runSetValue(cmd *cobra.Command, args []string) error {
 	// Post-read: include full UI state in agent format
 	var state string
 	if prOpts.PostRead {
-		if vr.PostState != "" {
-			state = vr.PostState
-		} else {
-			state = readPostActionState(provider, appName, window, windowID, pid, prOpts.Delay, prOpts.MaxElements)
-		}
+		state = postActionState(provider, prOpts, vr, preElements, appName, window, windowID, pid)
 	}
 
 	result := SetValueResult{
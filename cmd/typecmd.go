@@ -5,6 +5,7 @@ import (
 	"strings"
 	"time"
 
+	"github.com/mj1618/desktop-cli/internal/model"
 	"github.com/mj1618/desktop-cli/internal/output"
 	"github.com/mj1618/desktop-cli/internal/platform"
 	"github.com/spf13/cobra"
@@ -45,13 +46,14 @@ func init() {
 	typeCmd.Flags().String("window", "", "Scope to window (used with --id or --target)")
 	addTextTargetingFlags(typeCmd, "target", "Find element by text and focus it before typing (case-insensitive match on title/value/description)")
 	addRefFlag(typeCmd)
+	typeCmd.Flags().Bool("keypad", false, "Type by pressing on-screen keys (Calculator, PIN pads, on-screen keyboards); on by default for Calculator")
 	typeCmd.Flags().Bool("no-display", false, "Skip collecting display elements in the response")
 	addPostReadFlags(typeCmd)
 	addVerifyFlags(typeCmd)
 }
 
 func runType(cmd *cobra.Command, args []string) error {
-	provider, err := platform.NewProvider()
+	provider, err := newProvider(cmd)
 	if err != nil {
 		return err
 	}
@@ -65,6 +67,7 @@ func runType(cmd *cobra.Command, args []string) error {
 	id, _ := cmd.Flags().GetInt("id")
 	appName, _ := cmd.Flags().GetString("app")
 	window, _ := cmd.Flags().GetString("window")
+	useKeypad, _ := cmd.Flags().GetBool("keypad")
 
 	// Positional arg overrides --text flag
 	if len(args) > 0 {
@@ -90,40 +93,37 @@ func runType(cmd *cobra.Command, args []string) error {
 	// We'll read the focused element AFTER typing to get fresh state that
 	// reflects any dialog/modal that appeared and the actual typed value.
 	var postFocused *ElementInfo
+	var preElements []model.Element // tree the target was found in, for --post-read-diff
 
 	// If --ref, --target, or --id specified, click the element first to focus it
 	if hasRef {
 		if appName == "" && window == "" {
 			return fmt.Errorf("--ref requires --app or --window to scope the element lookup")
 		}
-		elem, _, err := resolveElementByRef(provider, appName, window, 0, 0, ref)
+		elem, tree, err := resolveElementByRef(provider, appName, window, 0, 0, ref)
 		if err != nil {
 			return err
 		}
+		preElements = tree
 		hasTargetedElement = true
 		verifyElemID = elem.ID
-		cx := elem.Bounds[0] + elem.Bounds[2]/2
-		cy := elem.Bounds[1] + elem.Bounds[3]/2
-		if err := provider.Inputter.Click(cx, cy, platform.MouseLeft, 1); err != nil {
+		if err := clickToFocus(provider, platform.ReadOptions{App: appName, Window: window}, elem); err != nil {
 			return fmt.Errorf("failed to focus element: %w", err)
 		}
-		time.Sleep(50 * time.Millisecond)
 	} else if hasTarget {
 		if appName == "" && window == "" {
 			return fmt.Errorf("--target requires --app or --window to scope the element lookup")
 		}
-		elem, _, err := resolveElementByText(provider, appName, window, 0, 0, target, roles, exact, scopeID)
+		elem, tree, err := resolveElementByText(provider, appName, window, 0, 0, target, roles, exact, scopeID)
 		if err != nil {
 			return err
 		}
+		preElements = tree
 		hasTargetedElement = true
 		verifyElemID = elem.ID
-		cx := elem.Bounds[0] + elem.Bounds[2]/2
-		cy := elem.Bounds[1] + elem.Bounds[3]/2
-		if err := provider.Inputter.Click(cx, cy, platform.MouseLeft, 1); err != nil {
+		if err := clickToFocus(provider, platform.ReadOptions{App: appName, Window: window}, elem); err != nil {
 			return fmt.Errorf("failed to focus element: %w", err)
 		}
-		time.Sleep(50 * time.Millisecond)
 	} else if id > 0 {
 		if appName == "" && window == "" {
 			return fmt.Errorf("--id requires --app or --window to scope the element lookup")
@@ -138,18 +138,16 @@ func runType(cmd *cobra.Command, args []string) error {
 		if err != nil {
 			return fmt.Errorf("failed to read elements: %w", err)
 		}
+		preElements = elements
 		elem := findElementByID(elements, id)
 		if elem == nil {
 			return fmt.Errorf("element with id %d not found", id)
 		}
 		hasTargetedElement = true
 		verifyElemID = elem.ID
-		cx := elem.Bounds[0] + elem.Bounds[2]/2
-		cy := elem.Bounds[1] + elem.Bounds[3]/2
-		if err := provider.Inputter.Click(cx, cy, platform.MouseLeft, 1); err != nil {
+		if err := clickToFocus(provider, platform.ReadOptions{App: appName, Window: window}, elem); err != nil {
 			return fmt.Errorf("failed to focus element: %w", err)
 		}
-		time.Sleep(50 * time.Millisecond)
 	}
 
 	// Snapshot the focused element for verification (after click-to-focus, before typing)
@@ -170,10 +168,10 @@ func runType(cmd *cobra.Command, args []string) error {
 
 	// Type text first (if provided)
 	if text != "" {
-		// Calculator mode: when targeting Calculator with no specific element,
-		// translate text into button presses since Calculator has no text input.
-		if isCalculatorApp(appName) && !hasTargetedElement && provider.ActionPerformer != nil {
-			if err := typeViaButtons(provider, appName, window, text); err != nil {
+		// Keypad mode: with --keypad, or when targeting Calculator with no
+		// specific element, press on-screen keys since there is no text input.
+		if !hasTargetedElement && (useKeypad || (isCalculatorApp(appName) && provider.ActionPerformer != nil)) {
+			if err := typeOnKeypad(provider, appName, window, text); err != nil {
 				return err
 			}
 		} else {
@@ -290,49 +288,8 @@ func runType(cmd *cobra.Command, args []string) error {
 
 	// Post-read: include full UI state in agent format
 	if prOpts.PostRead && (appName != "" || window != "") {
-		if vr.PostState != "" {
-			result.State = vr.PostState
-		} else {
-			result.State = readPostActionState(provider, appName, window, 0, 0, prOpts.Delay, prOpts.MaxElements)
-		}
+		result.State = postActionState(provider, prOpts, vr, preElements, appName, window, 0, 0)
 	}
 
 	return output.Print(result)
 }
-
-// calculatorButtonMap maps text characters to Calculator button titles.
-var calculatorButtonMap = map[byte]string{
-	'0': "0", '1': "1", '2': "2", '3': "3", '4': "4",
-	'5': "5", '6': "6", '7': "7", '8': "8", '9': "9",
-	'+': "Add", '-': "Subtract", '*': "Multiply", '/': "Divide",
-	'=': "Equals", '.': "Point",
-}
-
-// isCalculatorApp returns true if the app name matches Calculator.
-func isCalculatorApp(appName string) bool {
-	return strings.EqualFold(appName, "calculator")
-}
-
-// typeViaButtons presses Calculator buttons for each character in text.
-func typeViaButtons(provider *platform.Provider, appName, window, text string) error {
-	for i := 0; i < len(text); i++ {
-		btnTitle, ok := calculatorButtonMap[text[i]]
-		if !ok {
-			return fmt.Errorf("unsupported Calculator character: %c", text[i])
-		}
-		elem, _, err := resolveElementByText(provider, appName, window, 0, 0, btnTitle, "btn", false, 0)
-		if err != nil {
-			return fmt.Errorf("Calculator button %q not found for character %c: %w", btnTitle, text[i], err)
-		}
-		if err := provider.ActionPerformer.PerformAction(platform.ActionOptions{
-			App:    appName,
-			Window: window,
-			ID:     elem.ID,
-			Action: "press",
-		}); err != nil {
-			return fmt.Errorf("failed to press Calculator button %q: %w", btnTitle, err)
-		}
-		time.Sleep(30 * time.Millisecond)
-	}
-	return nil
-}
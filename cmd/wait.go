@@ -1,6 +1,7 @@
 package cmd
 
 import (
+	"errors"
 	"fmt"
 	"strings"
 	"time"
@@ -44,7 +45,7 @@ func init() {
 }
 
 func runWait(cmd *cobra.Command, args []string) error {
-	provider, err := platform.NewProvider()
+	provider, err := newProvider(cmd)
 	if err != nil {
 		return err
 	}
@@ -95,6 +96,11 @@ func runWait(cmd *cobra.Command, args []string) error {
 		Depth:    depth,
 		Roles:    roles,
 	}
+	// Only elements with the awaited role can match, so let the reader skip
+	// fetching details for everything else.
+	if len(roles) == 0 && len(forRoles) > 0 {
+		readOpts.Roles = forRoles
+	}
 
 	timeout := time.Duration(timeoutSec) * time.Second
 	interval := time.Duration(intervalMs) * time.Millisecond
@@ -102,8 +108,12 @@ func runWait(cmd *cobra.Command, args []string) error {
 	start := time.Now()
 
 	for {
-		elements, err := provider.Reader.ReadElements(readOpts)
+		matched, err := readWaitCondition(provider.Reader, readOpts, forText, forRoles, forID)
 		if err != nil {
+			if errors.Is(err, platform.ErrTruncated) {
+				// The command as a whole ran out of time; stop polling.
+				return err
+			}
 			if time.Now().After(deadline) {
 				return fmt.Errorf("timeout after %s (last error: %w)", timeout, err)
 			}
@@ -111,8 +121,6 @@ func runWait(cmd *cobra.Command, args []string) error {
 			continue
 		}
 
-		matched := checkWaitCondition(elements, forText, forRoles, forID)
-
 		conditionMet := matched
 		if gone {
 			conditionMet = !matched
@@ -147,6 +155,25 @@ func runWait(cmd *cobra.Command, args []string) error {
 	}
 }
 
+// readWaitCondition reads the target and checks the wait criteria. Without a
+// role filter the tree is streamed and the read stops at the first match;
+// with one, the reader's role-filtered read fetches less per element.
+func readWaitCondition(reader platform.Reader, opts platform.ReadOptions, forText string, forRoles []string, forID int) (bool, error) {
+	if len(opts.Roles) == 0 {
+		matched := false
+		err := platform.StreamElements(reader, opts, func(el model.Element, _ int) bool {
+			matched = matchesCondition(el, forText, forRoles, forID)
+			return !matched
+		})
+		return matched, err
+	}
+	elements, err := reader.ReadElements(opts)
+	if err != nil {
+		return false, err
+	}
+	return checkWaitCondition(elements, forText, forRoles, forID), nil
+}
+
 // checkWaitCondition checks if any element in the tree matches the wait criteria.
 func checkWaitCondition(elements []model.Element, forText string, forRoles []string, forID int) bool {
 	for _, elem := range elements {
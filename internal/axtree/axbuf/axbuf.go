@@ -0,0 +1,162 @@
+// Package axbuf decodes the single-buffer format platform sources use to
+// return a batch of fetched attributes (see axbuf.h for the layout and the
+// C encoder).
+//
+// The whole batch crosses from C in one copy; Decode then returns strings
+// that are views into that copy rather than copying each one again.
+package axbuf
+
+import (
+	"bytes"
+	"encoding/binary"
+	"errors"
+	"fmt"
+	"math"
+	"time"
+	"unsafe"
+
+	"github.com/mj1618/desktop-cli/internal/axtree"
+)
+
+// Format constants; must match axbuf.h.
+const (
+	Magic      = 0x31425841 // "AXB1"
+	HeaderSize = 8
+	RecordSize = 96
+)
+
+// Record slots and scalar field offsets; must match axbuf.h.
+const (
+	slotRole = iota
+	slotSubrole
+	slotTitle
+	slotValue
+	slotDescription
+	slotActions
+	slotChildren
+)
+
+const (
+	offX            = 56
+	offY            = 60
+	offWidth        = 64
+	offHeight       = 68
+	offFlags        = 72
+	offTextLength   = 76
+	offFetchNanos   = 80
+	offActionsNanos = 88
+)
+
+const (
+	flagEnabled = 1 << iota
+	flagFocused
+	flagSelected
+)
+
+// Timing is the platform time spent fetching one record.
+type Timing struct {
+	Fetch   time.Duration // multi-attribute call (0 if none was made)
+	Actions time.Duration // action-names call (0 if none was made)
+}
+
+var errShort = errors.New("axbuf: buffer too short")
+
+// Decode parses a buffer written by the C encoder. The returned strings
+// share memory with buf, which must not be modified afterwards; it stays
+// alive as long as any of them does.
+func Decode(buf []byte) ([]axtree.Values, []Timing, error) {
+	if len(buf) < HeaderSize {
+		return nil, nil, errShort
+	}
+	if m := binary.LittleEndian.Uint32(buf); m != Magic {
+		return nil, nil, fmt.Errorf("axbuf: bad magic %#x", m)
+	}
+	count := uint64(binary.LittleEndian.Uint32(buf[4:]))
+	if count*RecordSize > uint64(len(buf)-HeaderSize) {
+		return nil, nil, errShort
+	}
+
+	values := make([]axtree.Values, count)
+	timings := make([]Timing, count)
+	for i := range values {
+		rec := buf[HeaderSize+i*RecordSize : HeaderSize+(i+1)*RecordSize]
+		v := &values[i]
+		var err error
+		field := func(slot int) []byte {
+			if err != nil {
+				return nil
+			}
+			var b []byte
+			b, err = slice(buf, rec, slot)
+			return b
+		}
+
+		v.Role = view(field(slotRole))
+		v.Subrole = view(field(slotSubrole))
+		v.Title = view(field(slotTitle))
+		v.Value = view(field(slotValue))
+		v.Description = view(field(slotDescription))
+		actions := field(slotActions)
+		children := field(slotChildren)
+		if err != nil {
+			return nil, nil, fmt.Errorf("axbuf: record %d: %w", i, err)
+		}
+
+		for len(actions) > 0 {
+			end := bytes.IndexByte(actions, 0)
+			if end < 0 {
+				return nil, nil, fmt.Errorf("axbuf: record %d: unterminated action name", i)
+			}
+			if end > 0 {
+				v.Actions = append(v.Actions, view(actions[:end]))
+			}
+			actions = actions[end+1:]
+		}
+		if len(children)%8 != 0 {
+			return nil, nil, fmt.Errorf("axbuf: record %d: child list of %d bytes", i, len(children))
+		}
+		if n := len(children) / 8; n > 0 {
+			v.Children = make([]axtree.Handle, n)
+			for j := range v.Children {
+				v.Children[j] = axtree.Handle(binary.LittleEndian.Uint64(children[j*8:]))
+			}
+		}
+
+		v.X = float64(f32(rec[offX:]))
+		v.Y = float64(f32(rec[offY:]))
+		v.Width = float64(f32(rec[offWidth:]))
+		v.Height = float64(f32(rec[offHeight:]))
+		flags := binary.LittleEndian.Uint32(rec[offFlags:])
+		v.Enabled = flags&flagEnabled != 0
+		v.Focused = flags&flagFocused != 0
+		v.Selected = flags&flagSelected != 0
+		v.TextLength = int(int32(binary.LittleEndian.Uint32(rec[offTextLength:])))
+		timings[i] = Timing{
+			Fetch:   time.Duration(binary.LittleEndian.Uint64(rec[offFetchNanos:])),
+			Actions: time.Duration(binary.LittleEndian.Uint64(rec[offActionsNanos:])),
+		}
+	}
+	return values, timings, nil
+}
+
+// slice returns the bytes of a record's offset/length slot.
+func slice(buf, rec []byte, slot int) ([]byte, error) {
+	off := uint64(binary.LittleEndian.Uint32(rec[slot*8:]))
+	n := uint64(binary.LittleEndian.Uint32(rec[slot*8+4:]))
+	if off+n > uint64(len(buf)) {
+		return nil, fmt.Errorf("field %d [%d:+%d] out of range", slot, off, n)
+	}
+	return buf[off : off+n], nil
+}
+
+// view returns b as a string without copying.
+func view(b []byte) string {
+	if len(b) == 0 {
+		return ""
+	}
+	return unsafe.String(&b[0], len(b))
+}
+
+func f32(b []byte) float32 {
+	return math.Float32frombits(binary.LittleEndian.Uint32(b))
+}
@@ -0,0 +1,195 @@
+#ifndef AXBUF_H
+#define AXBUF_H
+
+// Single-buffer transfer format for a batch of fetched element attributes.
+//
+// A platform source writes every record and every string of a Fetch batch
+// into one growable buffer, so the Go side makes one copy and one free
+// instead of converting and freeing each string separately. The encoder is
+// header-only portable C (no platform headers) so it can be fuzzed and
+// benchmarked on any OS; the decoder is axbuf.Decode.
+//
+// Layout, all integers little-endian:
+//
+//   header   magic u32, count u32
+//   records  count x AXBUF_RECORD_SIZE bytes (see AXBUF_OFF_*)
+//   data     string bytes and child handle arrays
+//
+// String and list fields are (offset u32, length u32) pairs into the
+// buffer. Action names are stored NUL-terminated in one field; children are
+// an array of u64 element handles.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define AXBUF_MAGIC       0x31425841u // "AXB1"
+#define AXBUF_HEADER_SIZE 8
+#define AXBUF_RECORD_SIZE 96
+
+// Offset/length slots within a record.
+#define AXBUF_ROLE        0
+#define AXBUF_SUBROLE     1
+#define AXBUF_TITLE       2
+#define AXBUF_VALUE       3
+#define AXBUF_DESCRIPTION 4
+#define AXBUF_ACTIONS     5
+#define AXBUF_CHILDREN    6
+
+// Byte offsets of the scalar fields within a record.
+#define AXBUF_OFF_X             56 // f32
+#define AXBUF_OFF_Y             60 // f32
+#define AXBUF_OFF_WIDTH         64 // f32
+#define AXBUF_OFF_HEIGHT        68 // f32
+#define AXBUF_OFF_FLAGS         72 // u32, AXBUF_FLAG_*
+#define AXBUF_OFF_TEXT_LENGTH   76 // u32
+#define AXBUF_OFF_FETCH_NANOS   80 // u64
+#define AXBUF_OFF_ACTIONS_NANOS 88 // u64
+
+#define AXBUF_FLAG_ENABLED  (1u << 0)
+#define AXBUF_FLAG_FOCUSED  (1u << 1)
+#define AXBUF_FLAG_SELECTED (1u << 2)
+
+typedef struct {
+    unsigned char* data;
+    size_t len;
+    size_t cap;
+    int failed;       // set on allocation failure or overflow; all writes become no-ops
+    size_t open;      // start of the field opened by axbuf_begin
+} AXBuf;
+
+static inline void axbuf_put_u32(unsigned char* p, uint32_t v) {
+    p[0] = (unsigned char)v;
+    p[1] = (unsigned char)(v >> 8);
+    p[2] = (unsigned char)(v >> 16);
+    p[3] = (unsigned char)(v >> 24);
+}
+
+static inline void axbuf_put_u64(unsigned char* p, uint64_t v) {
+    axbuf_put_u32(p, (uint32_t)v);
+    axbuf_put_u32(p + 4, (uint32_t)(v >> 32));
+}
+
+// Ensure room for n more bytes. Offsets are u32, so buffers stop at 4 GiB.
+static inline int axbuf_grow(AXBuf* b, size_t n) {
+    if (b->failed) return -1;
+    if (n > UINT32_MAX - b->len) {
+        b->failed = 1;
+        return -1;
+    }
+    if (b->len + n <= b->cap) return 0;
+    size_t cap = b->cap ? b->cap : 256;
+    while (cap < b->len + n) cap *= 2;
+    unsigned char* data = (unsigned char*)realloc(b->data, cap);
+    if (!data) {
+        b->failed = 1;
+        return -1;
+    }
+    b->data = data;
+    b->cap = cap;
+    return 0;
+}
+
+// Start a buffer of count zeroed records. sizeHint is extra capacity for
+// string data. Returns 0, or -1 on allocation failure.
+static inline int axbuf_init(AXBuf* b, uint32_t count, size_t sizeHint) {
+    memset(b, 0, sizeof(*b));
+    if ((size_t)count > (UINT32_MAX - AXBUF_HEADER_SIZE) / AXBUF_RECORD_SIZE) {
+        b->failed = 1;
+        return -1;
+    }
+    size_t fixed = AXBUF_HEADER_SIZE + (size_t)count * AXBUF_RECORD_SIZE;
+    if (axbuf_grow(b, fixed + sizeHint) != 0) return -1;
+    memset(b->data, 0, fixed);
+    axbuf_put_u32(b->data, AXBUF_MAGIC);
+    axbuf_put_u32(b->data + 4, count);
+    b->len = fixed;
+    return 0;
+}
+
+static inline unsigned char* axbuf_record(AXBuf* b, uint32_t rec) {
+    return b->data + AXBUF_HEADER_SIZE + (size_t)rec * AXBUF_RECORD_SIZE;
+}
+
+static inline void axbuf_set_u32(AXBuf* b, uint32_t rec, int off, uint32_t v) {
+    if (!b->failed) axbuf_put_u32(axbuf_record(b, rec) + off, v);
+}
+
+static inline void axbuf_set_u64(AXBuf* b, uint32_t rec, int off, uint64_t v) {
+    if (!b->failed) axbuf_put_u64(axbuf_record(b, rec) + off, v);
+}
+
+static inline void axbuf_set_f32(AXBuf* b, uint32_t rec, int off, float v) {
+    uint32_t bits;
+    memcpy(&bits, &v, sizeof(bits));
+    axbuf_set_u32(b, rec, off, bits);
+}
+
+// Reserve n bytes at the end of the buffer for the caller to write into,
+// then call axbuf_commit with the number actually written. The pointer is
+// only valid until the next call that may grow the buffer.
+static inline unsigned char* axbuf_reserve(AXBuf* b, size_t n) {
+    if (axbuf_grow(b, n) != 0) return NULL;
+    return b->data + b->len;
+}
+
+static inline void axbuf_commit(AXBuf* b, size_t n) {
+    if (!b->failed) b->len += n;
+}
+
+// Open a field at the end of the buffer; everything appended until
+// axbuf_end(b, rec, slot) becomes the contents of that slot. Fields cannot
+// be nested.
+static inline void axbuf_begin(AXBuf* b) {
+    b->open = b->len;
+}
+
+static inline void axbuf_end(AXBuf* b, uint32_t rec, int slot) {
+    if (b->failed) return;
+    unsigned char* r = axbuf_record(b, rec) + slot * 8;
+    axbuf_put_u32(r, (uint32_t)b->open);
+    axbuf_put_u32(r + 4, (uint32_t)(b->len - b->open));
+}
+
+// Append n bytes of s to the open field.
+static inline void axbuf_append(AXBuf* b, const void* s, size_t n) {
+    unsigned char* p = axbuf_reserve(b, n);
+    if (p) {
+        if (n > 0) memcpy(p, s, n);
+        axbuf_commit(b, n);
+    }
+}
+
+// Set a string field of record rec.
+static inline void axbuf_put_string(AXBuf* b, uint32_t rec, int slot, const char* s, size_t n) {
+    axbuf_begin(b);
+    axbuf_append(b, s, n);
+    axbuf_end(b, rec, slot);
+}
+
+// Append one action name (between axbuf_begin and axbuf_end of
+// AXBUF_ACTIONS), including its NUL separator.
+static inline void axbuf_append_action(AXBuf* b, const char* s, size_t n) {
+    axbuf_append(b, s, n);
+    axbuf_append(b, "", 1);
+}
+
+// Append one child handle (between axbuf_begin and axbuf_end of
+// AXBUF_CHILDREN).
+static inline void axbuf_append_child(AXBuf* b, uint64_t handle) {
+    unsigned char* p = axbuf_reserve(b, 8);
+    if (p) {
+        axbuf_put_u64(p, handle);
+        axbuf_commit(b, 8);
+    }
+}
+
+// Release the buffer's memory (for use on failure; on success the data is
+// handed to the caller, who frees it with free()).
+static inline void axbuf_free(AXBuf* b) {
+    free(b->data);
+    memset(b, 0, sizeof(*b));
+}
+
+#endif
@@ -0,0 +1,153 @@
+package axbuf
+
+import (
+	"reflect"
+	"strings"
+	"testing"
+	"time"
+
+	"github.com/mj1618/desktop-cli/internal/axtree"
+)
+
+func sampleValues() []axtree.Values {
+	return []axtree.Values{
+		{
+			Role: "AXWindow", Title: "Inbox – Gmail", Enabled: true, Focused: true,
+			X: 10, Y: 20.5, Width: 1200, Height: 800,
+			Children: []axtree.Handle{0x7f0000001000, 0x7f0000002000},
+		},
+		{
+			Role: "AXButton", Subrole: "AXCloseButton", Description: "close", Enabled: true,
+			Actions: []string{"AXPress", "AXShowMenu"},
+		},
+		{Role: "AXTextArea", Value: "héllo\nwörld", Selected: true, TextLength: 11},
+		{}, // nothing fetched
+	}
+}
+
+func TestRoundTrip(t *testing.T) {
+	want := sampleValues()
+	timings := []Timing{{Fetch: 120 * time.Microsecond, Actions: 40 * time.Microsecond}, {Fetch: time.Millisecond}}
+	buf, err := encode(want, timings)
+	if err != nil {
+		t.Fatal(err)
+	}
+	got, gotTimings, err := Decode(buf)
+	if err != nil {
+		t.Fatal(err)
+	}
+	if !reflect.DeepEqual(got, want) {
+		t.Errorf("decoded values differ:\ngot  %+v\nwant %+v", got, want)
+	}
+	if gotTimings[0] != timings[0] || gotTimings[1] != timings[1] || gotTimings[2] != (Timing{}) {
+		t.Errorf("timings = %v", gotTimings)
+	}
+}
+
+func TestDecode_Empty(t *testing.T) {
+	buf, err := encode(nil, nil)
+	if err != nil {
+		t.Fatal(err)
+	}
+	values, _, err := Decode(buf)
+	if err != nil || len(values) != 0 {
+		t.Errorf("Decode(empty) = %v, %v", values, err)
+	}
+}
+
+func TestDecode_RejectsMalformed(t *testing.T) {
+	good, _ := encode(sampleValues(), nil)
+	corrupt := func(f func(b []byte) []byte) []byte {
+		return f(append([]byte(nil), good...))
+	}
+	for name, buf := range map[string][]byte{
+		"short":          good[:4],
+		"magic":          corrupt(func(b []byte) []byte { b[0] ^= 0xff; return b }),
+		"count":          corrupt(func(b []byte) []byte { b[4] = 0xff; return b }),
+		"truncated data": good[:len(good)-3],
+		"field offset":   corrupt(func(b []byte) []byte { b[HeaderSize+slotTitle*8+3] = 0x7f; return b }),
+		"child list":     corrupt(func(b []byte) []byte { b[HeaderSize+slotChildren*8+4]--; return b }),
+		"action name": corrupt(func(b []byte) []byte {
+			rec := b[HeaderSize+RecordSize:]
+			rec[slotActions*8+4]-- // drop the last terminator
+			return b
+		}),
+	} {
+		if _, _, err := Decode(buf); err == nil {
+			t.Errorf("%s: expected an error", name)
+		}
+	}
+}
+
+func TestTransfer_MatchesPerString(t *testing.T) {
+	arena, err := transferArena(50)
+	if err != nil {
+		t.Fatal(err)
+	}
+	if !reflect.DeepEqual(arena, transferPerString(50)) {
+		t.Error("arena transfer differs from per-string transfer")
+	}
+}
+
+func FuzzDecode(f *testing.F) {
+	good, _ := encode(sampleValues(), nil)
+	f.Add(good)
+	f.Add([]byte{})
+	f.Fuzz(func(t *testing.T, buf []byte) {
+		// Must never panic or read out of bounds, whatever the input.
+		Decode(buf)
+	})
+}
+
+func FuzzRoundTrip(f *testing.F) {
+	f.Add("AXButton", "Save", "", "AXPress", uint64(0x1000), float32(1.5), true, 3)
+	f.Add("", "", "a\x00b", "", uint64(0), float32(-2), false, -1)
+	f.Fuzz(func(t *testing.T, role, title, value, action string, child uint64, x float32, focused bool, textLength int) {
+		v := axtree.Values{
+			Role: role, Title: title, Value: value, X: float64(x),
+			Focused: focused, TextLength: int(int32(textLength)),
+		}
+		// Action names come from C strings, so they never contain NUL.
+		if action = strings.ReplaceAll(action, "\x00", ""); action != "" {
+			v.Actions = []string{action}
+		}
+		if child != 0 {
+			v.Children = []axtree.Handle{axtree.Handle(child)}
+		}
+		want := []axtree.Values{v, {Role: role}}
+		buf, err := encode(want, nil)
+		if err != nil {
+			t.Fatal(err)
+		}
+		got, _, err := Decode(buf)
+		if err != nil {
+			t.Fatal(err)
+		}
+		if x != x { // NaN never compares equal
+			got[0].X, want[0].X = 0, 0
+		}
+		if !reflect.DeepEqual(got, want) {
+			t.Errorf("round trip:\ngot  %+v\nwant %+v", got, want)
+		}
+	})
+}
+
+// BenchmarkTransfer compares moving a batch of element records from C to Go
+// in one buffer against converting and freeing every string separately.
+func BenchmarkTransfer(b *testing.B) {
+	const count = 200
+	b.Run("arena", func(b *testing.B) {
+		b.ReportAllocs()
+		for i := 0; i < b.N; i++ {
+			if _, err := transferArena(count); err != nil {
+				b.Fatal(err)
+			}
+		}
+	})
+	b.Run("per-string", func(b *testing.B) {
+		b.ReportAllocs()
+		for i := 0; i < b.N; i++ {
+			transferPerString(count)
+		}
+	})
+}
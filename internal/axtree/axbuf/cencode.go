@@ -0,0 +1,195 @@
+//go:build cgo
+
+package axbuf
+
+// Cgo access to the portable C encoder, so that it can be tested, fuzzed
+// and benchmarked on any OS (cgo is not available in _test.go files).
+
+/*
+#include "axbuf.h"
+
+// Per-string records, the transfer format axbuf replaces: every string is
+// strdup'd, converted by Go one at a time and freed one at a time.
+typedef struct {
+    char* role;
+    char* subrole;
+    char* title;
+    char* value;
+    char* description;
+    int actionCount;
+    char** actions;
+} axbuf_legacy_record;
+
+static const char* axbuf_sample[] = {"AXButton", "AXCloseButton", "Close", "", "close window"};
+static const char* axbuf_sample_actions[] = {"AXPress", "AXShowMenu"};
+
+static axbuf_legacy_record* axbuf_legacy_fill(int count) {
+    axbuf_legacy_record* recs = (axbuf_legacy_record*)calloc(count, sizeof(axbuf_legacy_record));
+    for (int i = 0; i < count; i++) {
+        recs[i].role = strdup(axbuf_sample[0]);
+        recs[i].subrole = strdup(axbuf_sample[1]);
+        recs[i].title = strdup(axbuf_sample[2]);
+        recs[i].value = strdup(axbuf_sample[3]);
+        recs[i].description = strdup(axbuf_sample[4]);
+        recs[i].actionCount = 2;
+        recs[i].actions = (char**)malloc(2 * sizeof(char*));
+        recs[i].actions[0] = strdup(axbuf_sample_actions[0]);
+        recs[i].actions[1] = strdup(axbuf_sample_actions[1]);
+    }
+    return recs;
+}
+
+static void axbuf_legacy_free(axbuf_legacy_record* recs, int count) {
+    for (int i = 0; i < count; i++) {
+        free(recs[i].role);
+        free(recs[i].subrole);
+        free(recs[i].title);
+        free(recs[i].value);
+        free(recs[i].description);
+        for (int j = 0; j < recs[i].actionCount; j++) free(recs[i].actions[j]);
+        free(recs[i].actions);
+    }
+    free(recs);
+}
+
+static unsigned char* axbuf_sample_fill(int count, size_t* outLen) {
+    AXBuf b;
+    axbuf_init(&b, (uint32_t)count, (size_t)count * 64);
+    for (int i = 0; i < count; i++) {
+        for (int s = AXBUF_ROLE; s <= AXBUF_DESCRIPTION; s++) {
+            axbuf_put_string(&b, i, s, axbuf_sample[s], strlen(axbuf_sample[s]));
+        }
+        axbuf_begin(&b);
+        for (int j = 0; j < 2; j++) {
+            axbuf_append_action(&b, axbuf_sample_actions[j], strlen(axbuf_sample_actions[j]));
+        }
+        axbuf_end(&b, i, AXBUF_ACTIONS);
+        axbuf_set_u32(&b, i, AXBUF_OFF_FLAGS, AXBUF_FLAG_ENABLED);
+    }
+    if (b.failed) {
+        axbuf_free(&b);
+        return NULL;
+    }
+    *outLen = b.len;
+    return b.data;
+}
+
+// Go-callable wrappers for the static inline encoder functions.
+static int axbuf_c_init(AXBuf* b, uint32_t count) { return axbuf_init(b, count, 0); }
+static void axbuf_c_put_string(AXBuf* b, uint32_t rec, int slot, const char* s, size_t n) { axbuf_put_string(b, rec, slot, s, n); }
+static void axbuf_c_begin(AXBuf* b) { axbuf_begin(b); }
+static void axbuf_c_end(AXBuf* b, uint32_t rec, int slot) { axbuf_end(b, rec, slot); }
+static void axbuf_c_append_action(AXBuf* b, const char* s, size_t n) { axbuf_append_action(b, s, n); }
+static void axbuf_c_append_child(AXBuf* b, uint64_t h) { axbuf_append_child(b, h); }
+static void axbuf_c_set_u32(AXBuf* b, uint32_t rec, int off, uint32_t v) { axbuf_set_u32(b, rec, off, v); }
+static void axbuf_c_set_u64(AXBuf* b, uint32_t rec, int off, uint64_t v) { axbuf_set_u64(b, rec, off, v); }
+static void axbuf_c_set_f32(AXBuf* b, uint32_t rec, int off, float v) { axbuf_set_f32(b, rec, off, v); }
+static void axbuf_c_free(AXBuf* b) { axbuf_free(b); }
+*/
+import "C"
+
+import (
+	"errors"
+	"unsafe"
+
+	"github.com/mj1618/desktop-cli/internal/axtree"
+)
+
+// cstr returns a C view of s for the duration of a cgo call.
+func cstr(s string) (*C.char, C.size_t) {
+	if s == "" {
+		return nil, 0
+	}
+	return (*C.char)(unsafe.Pointer(unsafe.StringData(s))), C.size_t(len(s))
+}
+
+// encode writes values with the C encoder and returns a Go copy of the
+// buffer. Action names must not contain NUL bytes.
+func encode(values []axtree.Values, timings []Timing) ([]byte, error) {
+	var b C.AXBuf
+	if C.axbuf_c_init(&b, C.uint32_t(len(values))) != 0 {
+		return nil, errors.New("axbuf: init failed")
+	}
+	defer C.axbuf_c_free(&b)
+
+	for i, v := range values {
+		rec := C.uint32_t(i)
+		for slot, s := range [...]string{v.Role, v.Subrole, v.Title, v.Value, v.Description} {
+			p, n := cstr(s)
+			C.axbuf_c_put_string(&b, rec, C.int(slot), p, n)
+		}
+		C.axbuf_c_begin(&b)
+		for _, a := range v.Actions {
+			p, n := cstr(a)
+			C.axbuf_c_append_action(&b, p, n)
+		}
+		C.axbuf_c_end(&b, rec, slotActions)
+		C.axbuf_c_begin(&b)
+		for _, h := range v.Children {
+			C.axbuf_c_append_child(&b, C.uint64_t(h))
+		}
+		C.axbuf_c_end(&b, rec, slotChildren)
+
+		C.axbuf_c_set_f32(&b, rec, offX, C.float(v.X))
+		C.axbuf_c_set_f32(&b, rec, offY, C.float(v.Y))
+		C.axbuf_c_set_f32(&b, rec, offWidth, C.float(v.Width))
+		C.axbuf_c_set_f32(&b, rec, offHeight, C.float(v.Height))
+		var flags uint32
+		if v.Enabled {
+			flags |= flagEnabled
+		}
+		if v.Focused {
+			flags |= flagFocused
+		}
+		if v.Selected {
+			flags |= flagSelected
+		}
+		C.axbuf_c_set_u32(&b, rec, offFlags, C.uint32_t(flags))
+		C.axbuf_c_set_u32(&b, rec, offTextLength, C.uint32_t(uint32(int32(v.TextLength))))
+		if i < len(timings) {
+			C.axbuf_c_set_u64(&b, rec, offFetchNanos, C.uint64_t(timings[i].Fetch))
+			C.axbuf_c_set_u64(&b, rec, offActionsNanos, C.uint64_t(timings[i].Actions))
+		}
+	}
+	if b.failed != 0 {
+		return nil, errors.New("axbuf: encoding failed")
+	}
+	return C.GoBytes(unsafe.Pointer(b.data), C.int(b.len)), nil
+}
+
+// transferArena builds count sample records in one C buffer and brings them
+// into Go the way a platform source does: one copy, one free, Decode.
+func transferArena(count int) ([]axtree.Values, error) {
+	var n C.size_t
+	data := C.axbuf_sample_fill(C.int(count), &n)
+	if data == nil {
+		return nil, errors.New("axbuf: encoding failed")
+	}
+	buf := C.GoBytes(unsafe.Pointer(data), C.int(n))
+	C.free(unsafe.Pointer(data))
+	values, _, err := Decode(buf)
+	return values, err
+}
+
+// transferPerString builds count sample records with individually
+// allocated strings and converts them string by string.
+func transferPerString(count int) []axtree.Values {
+	recs := C.axbuf_legacy_fill(C.int(count))
+	defer C.axbuf_legacy_free(recs, C.int(count))
+	out := make([]axtree.Values, count)
+	for i, r := range unsafe.Slice(recs, count) {
+		v := &out[i]
+		v.Enabled = true
+		v.Role = C.GoString(r.role)
+		v.Subrole = C.GoString(r.subrole)
+		v.Title = C.GoString(r.title)
+		v.Value = C.GoString(r.value)
+		v.Description = C.GoString(r.description)
+		actions := unsafe.Slice(r.actions, int(r.actionCount))
+		v.Actions = make([]string, len(actions))
+		for j, a := range actions {
+			v.Actions[j] = C.GoString(a)
+		}
+	}
+	return out
+}
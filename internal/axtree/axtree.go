@@ -0,0 +1,261 @@
+// Package axtree is the platform-independent accessibility tree traversal.
+//
+// Platform packages supply a Source that fetches element attributes; axtree
+// decides which attributes to ask for and in what order, assigns element IDs
+// and builds the model.Element tree. Because all of the cross-process cost
+// goes through Source, the traversal can be tested and benchmarked on any OS
+// with an in-memory source (see MemSource).
+package axtree
+
+import "errors"
+
+// Handle is an opaque reference to a platform accessibility element
+// (an AXUIElementRef on macOS).
+type Handle uintptr
+
+// Attr is a bitmask of element attributes a Source can fetch.
+// The bit values are shared with the C sources and must not be reordered.
+type Attr uint32
+
+const (
+	AttrRole Attr = 1 << iota
+	AttrSubrole
+	AttrTitle
+	AttrValue
+	AttrDescription
+	AttrEnabled
+	AttrFocused
+	AttrSelected
+	AttrPosition
+	AttrSize
+	AttrChildren
+	AttrActions
+	AttrTextLength // number of characters of text content (AXNumberOfCharacters)
+
+	// AttrAll is every attribute a full read needs.
+	AttrAll = AttrRole | AttrSubrole | AttrTitle | AttrValue | AttrDescription |
+		AttrEnabled | AttrFocused | AttrSelected | AttrPosition | AttrSize |
+		AttrChildren | AttrActions | AttrTextLength
+)
+
+// DefaultTextLimit caps the text inlined into Value for elements whose value
+// is empty but which expose text content (e.g. contenteditable divs). Longer
+// text is truncated; its full length stays in TextLength and the rest can be
+// fetched on demand (platform.TextReader), so large documents such as mail
+// bodies do not inflate every read.
+const DefaultTextLimit = 200
+
+// Values holds the attributes fetched for one element. Attributes that were
+// not requested, or that the element does not have, are left at their zero
+// value, except Enabled, which a Source must report as true when unknown.
+type Values struct {
+	Role        string
+	Subrole     string
+	Title       string
+	Value       string
+	Description string
+	Enabled     bool
+	Focused     bool
+	Selected    bool
+	X, Y        float64
+	Width       float64
+	Height      float64
+	Children    []Handle // retained by the Source; released by the caller via Source.Release
+	Actions     []string // platform action names (e.g. "AXPress")
+	TextLength  int
+}
+
+// Source fetches accessibility attributes for elements.
+type Source interface {
+	// Fetch returns the requested attributes for each handle, in order.
+	// A Source should fetch all attributes of one element in as few round
+	// trips as the platform allows. Elements whose attributes cannot be read
+	// get zero Values; an error means the whole batch failed.
+	Fetch(handles []Handle, attrs Attr) ([]Values, error)
+
+	// Text returns up to max characters of an element's text content.
+	// ok is false if the element has no readable text.
+	Text(h Handle, max int) (text string, ok bool)
+
+	// Release drops the references to handles returned in Values.Children.
+	Release(handles []Handle)
+}
+
+// Node is one element visited by Walk.
+type Node struct {
+	ID       int  // pre-order index, starting at 1
+	ParentID int  // 0 for roots
+	Depth    int  // roots are at depth 1
+	Partial  bool // only Role was fetched (two-phase reads)
+	Unread   int  // number of children that were not read (breadth-first reads cut short)
+	Values
+}
+
+// Options controls a traversal.
+type Options struct {
+	MaxDepth  int // 0 = unlimited
+	TextLimit int // characters of text content inlined per element: 0 = DefaultTextLimit, <0 = none
+
+	// Roles, if set, switches to a two-phase read (see walkTwoPhase): only
+	// elements whose mapped role is in Roles get their full attributes.
+	// Other elements are returned with only Role set and Partial true.
+	Roles []string
+
+	// Parallelism is the number of concurrent Fetch batches in the second
+	// phase of a two-phase read. 0 = DefaultParallelism.
+	Parallelism int
+
+	// Visit, if set, is called with each node as soon as it is read, in
+	// pre-order. Returning false stops the walk: Walk then returns the nodes
+	// read so far without reading any more. Walk only; not supported with
+	// Roles.
+	Visit func(Node) bool
+
+	// BreadthFirst reads the tree level by level instead of depth-first
+	// (see walkBreadthFirst), so that a walk canceled through Done returns
+	// the top of every window rather than the first windows in full.
+	// Roles and Visit are ignored.
+	BreadthFirst bool
+
+	// Done, if set, cancels the walk when closed (pass a context's Done
+	// channel). It is checked before every Source call, so a walk overruns
+	// by at most one call. A canceled walk returns the nodes read so far —
+	// the first nodes of the full walk in pre-order, with the same IDs
+	// (breadth-first walks: see walkBreadthFirst) — and ErrCanceled.
+	Done <-chan struct{}
+}
+
+// ErrCanceled is returned, with the nodes read so far, by walks whose
+// Options.Done was closed.
+var ErrCanceled = errors.New("axtree: walk canceled")
+
+// Walk traverses the trees under roots depth-first and returns every element
+// in pre-order. IDs and depth limits follow the platform action lookups, so
+// an element's ID can be passed back to PerformAction and SetValue.
+//
+// Attributes are fetched one sibling group per Source.Fetch call. The caller
+// keeps ownership of roots; child handles are released before Walk returns.
+func Walk(src Source, roots []Handle, opts Options) ([]Node, error) {
+	if opts.TextLimit == 0 {
+		opts.TextLimit = DefaultTextLimit
+	}
+	if opts.BreadthFirst {
+		return walkBreadthFirst(src, roots, opts)
+	}
+	if len(opts.Roles) > 0 {
+		return walkTwoPhase(src, roots, opts)
+	}
+	w := &walker{src: src, opts: opts, attrs: AttrAll, nextID: 1}
+	switch err := w.group(roots, 0, 1); err {
+	case nil, errStopped:
+		return w.nodes, nil
+	case ErrCanceled:
+		return w.nodes, err
+	default:
+		return nil, err
+	}
+}
+
+// errStopped unwinds a walk whose Visit callback returned false.
+var errStopped = errors.New("axtree: walk stopped")
+
+type walker struct {
+	src    Source
+	opts   Options
+	attrs  Attr
+	nextID int
+	nodes  []Node
+
+	// When retain is set, child handles are kept (in held) instead of being
+	// released as soon as their subtree is done, and handles[i] is the
+	// handle of nodes[i]. The caller must call releaseHeld.
+	retain  bool
+	handles []Handle
+	held    [][]Handle
+}
+
+// group fetches a sibling group in one batch, then descends into each
+// sibling in order.
+func (w *walker) group(handles []Handle, parentID, depth int) error {
+	if len(handles) == 0 || (w.opts.MaxDepth > 0 && depth > w.opts.MaxDepth) {
+		return nil
+	}
+	if w.canceled() {
+		return ErrCanceled
+	}
+	attrs := w.attrs
+	if w.opts.MaxDepth > 0 && depth >= w.opts.MaxDepth {
+		attrs &^= AttrChildren
+	}
+	values, err := w.src.Fetch(handles, attrs)
+	if err != nil {
+		return err
+	}
+	for i := range values {
+		v := values[i]
+		w.inlineText(handles[i], &v)
+
+		id := w.nextID
+		w.nextID++
+		children := v.Children
+		v.Children = nil
+		w.nodes = append(w.nodes, Node{ID: id, ParentID: parentID, Depth: depth, Values: v})
+		if w.retain {
+			w.handles = append(w.handles, handles[i])
+		}
+		if w.opts.Visit != nil && !w.opts.Visit(w.nodes[len(w.nodes)-1]) {
+			w.src.Release(children)
+			for _, rest := range values[i+1:] {
+				w.src.Release(rest.Children)
+			}
+			return errStopped
+		}
+
+		if len(children) > 0 {
+			err := w.group(children, id, depth+1)
+			if w.retain {
+				w.held = append(w.held, children)
+			} else {
+				w.src.Release(children)
+			}
+			if err != nil {
+				for _, rest := range values[i+1:] {
+					w.src.Release(rest.Children)
+				}
+				return err
+			}
+		}
+	}
+	return nil
+}
+
+// canceled reports whether opts.Done has been closed.
+func (w *walker) canceled() bool {
+	select {
+	case <-w.opts.Done:
+		return true
+	default:
+		return false
+	}
+}
+
+// inlineText is the fallback for elements (like contenteditable divs) whose
+// AXValue is empty but whose text is reachable through the text attributes:
+// up to TextLimit characters are fetched into Value.
+func (w *walker) inlineText(h Handle, v *Values) {
+	if v.Value != "" || v.TextLength <= 0 || w.opts.TextLimit < 0 {
+		return
+	}
+	if text, ok := w.src.Text(h, min(v.TextLength, w.opts.TextLimit)); ok {
+		v.Value = text
+	}
+}
+
+// releaseHeld releases the child handles kept by a retaining walk.
+func (w *walker) releaseHeld() {
+	for _, hs := range w.held {
+		w.src.Release(hs)
+	}
+	w.held = nil
+	w.handles = nil
+}
@@ -0,0 +1,314 @@
+package axtree
+
+import (
+	"fmt"
+	"reflect"
+	"strings"
+	"sync"
+	"testing"
+	"time"
+
+	"github.com/mj1618/desktop-cli/internal/model"
+)
+
+// sampleWindow builds a small window: toolbar with two buttons, a text area
+// whose text is only reachable through Source.Text, and a disabled button.
+func sampleWindow() *MemNode {
+	return &MemNode{
+		Role: "AXWindow", Title: "Doc", Bounds: [4]int{0, 0, 800, 600},
+		Children: []*MemNode{
+			{Role: "AXToolbar", Bounds: [4]int{0, 0, 800, 40}, Children: []*MemNode{
+				{Role: "AXButton", Title: "Back", Actions: []string{"AXPress"}, Bounds: [4]int{0, 0, 40, 40}},
+				{Role: "AXButton", Title: "Menu", Actions: []string{"AXPress", "AXShowMenu"}, Bounds: [4]int{40, 0, 40, 40}},
+			}},
+			{Role: "AXTextArea", Text: "hello world", Focused: true, Bounds: [4]int{0, 40, 800, 500}},
+			{Role: "AXButton", Title: "Save", Disabled: true, Bounds: [4]int{0, 540, 80, 30}},
+		},
+	}
+}
+
+// wideTree builds a window with the given fan-out and depth below it.
+func wideTree(fanout, depth int) *MemNode {
+	var build func(d int) *MemNode
+	build = func(d int) *MemNode {
+		n := &MemNode{Role: "AXGroup", Title: fmt.Sprintf("g%d", d), Actions: []string{"AXPress"}}
+		if d < depth {
+			for i := 0; i < fanout; i++ {
+				n.Children = append(n.Children, build(d+1))
+			}
+		}
+		return n
+	}
+	root := build(1)
+	root.Role = "AXWindow"
+	return root
+}
+
+func TestWalk_PreOrderIDs(t *testing.T) {
+	src, roots := NewMemSource(sampleWindow())
+	nodes, err := Walk(src, roots, Options{})
+	if err != nil {
+		t.Fatal(err)
+	}
+	want := []struct {
+		id, parent, depth int
+		role              string
+	}{
+		{1, 0, 1, "AXWindow"},
+		{2, 1, 2, "AXToolbar"},
+		{3, 2, 3, "AXButton"},
+		{4, 2, 3, "AXButton"},
+		{5, 1, 2, "AXTextArea"},
+		{6, 1, 2, "AXButton"},
+	}
+	if len(nodes) != len(want) {
+		t.Fatalf("got %d nodes, want %d", len(nodes), len(want))
+	}
+	for i, w := range want {
+		n := nodes[i]
+		if n.ID != w.id || n.ParentID != w.parent || n.Depth != w.depth || n.Role != w.role {
+			t.Errorf("node %d = {%d %d %d %s}, want %+v", i, n.ID, n.ParentID, n.Depth, n.Role, w)
+		}
+	}
+	if src.Live() != 0 {
+		t.Errorf("%d child handles not released", src.Live())
+	}
+}
+
+func TestWalk_MaxDepth(t *testing.T) {
+	src, roots := NewMemSource(sampleWindow())
+	nodes, err := Walk(src, roots, Options{MaxDepth: 2})
+	if err != nil {
+		t.Fatal(err)
+	}
+	if len(nodes) != 4 {
+		t.Fatalf("got %d nodes at depth <= 2, want 4", len(nodes))
+	}
+	for _, n := range nodes {
+		if n.Depth > 2 {
+			t.Errorf("node %d at depth %d", n.ID, n.Depth)
+		}
+	}
+}
+
+func TestWalk_TextFallback(t *testing.T) {
+	src, roots := NewMemSource(sampleWindow())
+	nodes, _ := Walk(src, roots, Options{TextLimit: 5})
+	if nodes[4].Value != "hello" {
+		t.Errorf("text area value = %q, want text capped at 5 chars", nodes[4].Value)
+	}
+}
+
+func TestWalk_LongTextIsMarkedNotInlined(t *testing.T) {
+	win := sampleWindow()
+	body := strings.Repeat("lorem ipsum ", 1000)
+	win.Children[1].Text = body
+
+	src, roots := NewMemSource(win)
+	nodes, _ := Walk(src, roots, Options{})
+	el := NodeElement(nodes[4])
+	if len(el.Value) != DefaultTextLimit || el.TextLength != len(body) {
+		t.Errorf("value has %d chars, tl = %d; want %d inline and tl %d", len(el.Value), el.TextLength, DefaultTextLimit, len(body))
+	}
+
+	src, roots = NewMemSource(win)
+	nodes, _ = Walk(src, roots, Options{TextLimit: -1})
+	if el := NodeElement(nodes[4]); el.Value != "" || el.TextLength != len(body) {
+		t.Errorf("TextLimit -1: value %q, tl = %d; want no inline text and tl %d", el.Value, el.TextLength, len(body))
+	}
+	// Six elements: one multi-attribute and one action call each, no text.
+	if src.Calls() != 12 {
+		t.Errorf("TextLimit -1 made %d calls, want 12", src.Calls())
+	}
+
+	// Text that fits inline is not marked.
+	src, roots = NewMemSource(sampleWindow())
+	nodes, _ = Walk(src, roots, Options{})
+	if el := NodeElement(nodes[4]); el.Value != "hello world" || el.TextLength != 0 {
+		t.Errorf("short text: value %q, tl = %d", el.Value, el.TextLength)
+	}
+}
+
+func TestBuildTree(t *testing.T) {
+	src, roots := NewMemSource(sampleWindow(), wideTree(2, 2))
+	nodes, _ := Walk(src, roots, Options{})
+	tree := BuildTree(nodes)
+	if len(tree) != 2 {
+		t.Fatalf("got %d roots, want 2", len(tree))
+	}
+	win := tree[0]
+	if win.Role != "window" || len(win.Children) != 3 {
+		t.Fatalf("window = %s with %d children", win.Role, len(win.Children))
+	}
+	menu := win.Children[0].Children[1]
+	if menu.ID != 4 || menu.Title != "Menu" || len(menu.Actions) != 2 || menu.Actions[1] != "showmenu" {
+		t.Errorf("menu button = %+v", menu)
+	}
+	save := win.Children[2]
+	if save.Enabled == nil || *save.Enabled {
+		t.Error("disabled button should have Enabled=false")
+	}
+	if win.Children[1].Enabled != nil {
+		t.Error("enabled element should omit Enabled")
+	}
+	if tree[1].ID != 7 || len(tree[1].Children) != 2 {
+		t.Errorf("second root = id %d with %d children", tree[1].ID, len(tree[1].Children))
+	}
+	for _, c := range []struct {
+		el   model.Element
+		want []int
+	}{
+		{win, []int{0}},
+		{menu, []int{0, 0, 1}},
+		{save, []int{0, 2}},
+		{tree[1].Children[1], []int{1, 1}},
+	} {
+		if !reflect.DeepEqual(c.el.Path, c.want) {
+			t.Errorf("%s %q path = %v, want %v", c.el.Role, c.el.Title, c.el.Path, c.want)
+		}
+	}
+	if got := BuildTree(nil); got == nil || len(got) != 0 {
+		t.Error("empty walk should build an empty, non-nil tree")
+	}
+}
+
+func TestCountBefore_NumbersSubtreeLikeFullWalk(t *testing.T) {
+	mem, roots := NewMemSource(sampleWindow(), wideTree(3, 3))
+	nodes, _ := Walk(mem, roots, Options{})
+	var check func([]model.Element)
+	check = func(els []model.Element) {
+		for _, el := range els {
+			n, err := CountBefore(mem, roots, el.Path, nil)
+			if err != nil {
+				t.Fatal(err)
+			}
+			if n+1 != el.ID {
+				t.Errorf("%s at %v: %d elements before it, but ID %d", el.Role, el.Path, n, el.ID)
+			}
+			check(el.Children)
+		}
+	}
+	check(BuildTree(nodes))
+	if mem.Live() != 0 {
+		t.Errorf("%d child handles not released", mem.Live())
+	}
+	if _, err := CountBefore(mem, roots, []int{0, 9}, nil); err == nil {
+		t.Error("expected an error for a path with no element")
+	}
+}
+
+func TestWalk_BatchFetchHalvesCalls(t *testing.T) {
+	batch, roots := NewMemSource(wideTree(4, 4))
+	nodes, _ := Walk(batch, roots, Options{})
+
+	perAttr, roots2 := NewMemSource(wideTree(4, 4))
+	perAttr.PerAttribute = true
+	Walk(perAttr, roots2, Options{})
+
+	perNodeBatch := float64(batch.Calls()) / float64(len(nodes))
+	perNodeAttr := float64(perAttr.Calls()) / float64(len(nodes))
+	if perNodeBatch*2 > perNodeAttr {
+		t.Errorf("batch fetch made %.1f calls/node vs %.1f per-attribute; want at most half", perNodeBatch, perNodeAttr)
+	}
+}
+
+func BenchmarkWalk(b *testing.B) {
+	for _, perAttr := range []bool{false, true} {
+		name := "batch"
+		if perAttr {
+			name = "per-attribute"
+		}
+		b.Run(name, func(b *testing.B) {
+			var calls, nodes int64
+			for i := 0; i < b.N; i++ {
+				src, roots := NewMemSource(wideTree(6, 5))
+				src.PerAttribute = perAttr
+				ns, _ := Walk(src, roots, Options{})
+				calls += src.Calls()
+				nodes += int64(len(ns))
+			}
+			b.ReportMetric(float64(calls)/float64(nodes), "calls/node")
+		})
+	}
+}
+
+func TestStream_StopsEarly(t *testing.T) {
+	src, roots := NewMemSource(wideTree(4, 4))
+	nodes, _ := Walk(src, roots, Options{})
+	full := BuildTree(nodes)
+	fullCalls := src.Calls()
+
+	src, roots = NewMemSource(wideTree(4, 4))
+	var got []model.Element
+	err := Stream(src, roots, Options{}, func(el model.Element, depth int) bool {
+		got = append(got, el)
+		return len(got) < 10
+	})
+	if err != nil {
+		t.Fatal(err)
+	}
+	if len(got) != 10 {
+		t.Fatalf("streamed %d elements after stopping at 10", len(got))
+	}
+	for _, el := range got {
+		want := findByID(full, el.ID)
+		if want == nil || want.Title != el.Title || !reflect.DeepEqual(want.Path, el.Path) {
+			t.Errorf("streamed %d %q path %v, want %+v", el.ID, el.Title, el.Path, want)
+		}
+	}
+	if src.Calls() >= fullCalls/2 {
+		t.Errorf("stopped stream made %d calls, full walk %d", src.Calls(), fullCalls)
+	}
+	if src.Live() != 0 {
+		t.Errorf("%d child handles not released", src.Live())
+	}
+}
+
+func findByID(els []model.Element, id int) *model.Element {
+	for i := range els {
+		if els[i].ID == id {
+			return &els[i]
+		}
+		if el := findByID(els[i].Children, id); el != nil {
+			return el
+		}
+	}
+	return nil
+}
+
+// cancelAfter returns a view of src that closes the returned channel once
+// n calls have been made through it.
+func cancelAfter(src *MemSource, n int) (Source, <-chan struct{}) {
+	done := make(chan struct{})
+	var mu sync.Mutex
+	var once sync.Once
+	calls := 0
+	return src.Observe(func(string, time.Duration) {
+		mu.Lock()
+		defer mu.Unlock()
+		if calls++; calls >= n {
+			once.Do(func() { close(done) })
+		}
+	}), done
+}
+
+func TestWalk_CanceledReturnsPrefix(t *testing.T) {
+	mem, roots := NewMemSource(wideTree(4, 4))
+	full, _ := Walk(mem, roots, Options{})
+
+	mem, roots = NewMemSource(wideTree(4, 4))
+	src, done := cancelAfter(mem, 20)
+	nodes, err := Walk(src, roots, Options{Done: done})
+	if err != ErrCanceled {
+		t.Fatalf("err = %v, want ErrCanceled", err)
+	}
+	if len(nodes) == 0 || len(nodes) >= len(full) {
+		t.Fatalf("canceled walk returned %d of %d nodes", len(nodes), len(full))
+	}
+	if !reflect.DeepEqual(nodes, full[:len(nodes)]) {
+		t.Errorf("canceled walk is not a prefix of the full walk")
+	}
+	if mem.Live() != 0 {
+		t.Errorf("%d child handles not released", mem.Live())
+	}
+}
@@ -0,0 +1,105 @@
+package axtree
+
+// bfsNode is a node read by walkBreadthFirst, before it is numbered.
+type bfsNode struct {
+	values   Values // without Children
+	depth    int
+	children []int // indices of the children read, in order
+	unread   int   // children not read
+}
+
+// bfsGroup is a sibling group waiting to be read: the children of parent
+// (-1 for the roots).
+type bfsGroup struct {
+	parent  int
+	handles []Handle
+}
+
+// walkBreadthFirst reads the trees under roots level by level: every root,
+// then all of their children, then all of their grandchildren, and so on,
+// fetching one sibling group per Source.Fetch call like Walk. A walk that
+// runs to the end returns exactly what Walk returns.
+//
+// If opts.Done is closed, the walk stops before the next sibling group and
+// returns every group read so far — all levels above the current one, and
+// part of the current one — with ErrCanceled. The returned nodes are
+// numbered in pre-order among themselves, so only the nodes before the
+// first one with Unread set keep the IDs a full walk would give them;
+// child-index paths (BuildTree) are exact, as a node's children are either
+// all read or all unread.
+func walkBreadthFirst(src Source, roots []Handle, opts Options) ([]Node, error) {
+	w := &walker{src: src, opts: opts}
+	var nodes []bfsNode
+	var top []int
+	level := []bfsGroup{{parent: -1, handles: roots}}
+	var err error
+	for depth := 1; len(level) > 0 && err == nil; depth++ {
+		attrs := AttrAll
+		if opts.MaxDepth > 0 && depth >= opts.MaxDepth {
+			attrs &^= AttrChildren
+		}
+		var next []bfsGroup
+		for gi, g := range level {
+			if w.canceled() {
+				err = ErrCanceled
+			} else {
+				var values []Values
+				values, err = src.Fetch(g.handles, attrs)
+				if err == nil {
+					for i := range values {
+						v := values[i]
+						w.inlineText(g.handles[i], &v)
+						if len(v.Children) > 0 {
+							next = append(next, bfsGroup{parent: len(nodes), handles: v.Children})
+						}
+						v.Children = nil
+						if g.parent < 0 {
+							top = append(top, len(nodes))
+						} else {
+							nodes[g.parent].children = append(nodes[g.parent].children, len(nodes))
+						}
+						nodes = append(nodes, bfsNode{values: v, depth: depth})
+					}
+				}
+			}
+			if err != nil {
+				// Groups that will not be read leave their parents with
+				// unread children.
+				for _, rest := range level[gi:] {
+					if rest.parent >= 0 {
+						nodes[rest.parent].unread = len(rest.handles)
+					}
+				}
+				break
+			}
+		}
+		for _, g := range level {
+			if g.parent >= 0 {
+				src.Release(g.handles)
+			}
+		}
+		if err != nil {
+			for _, g := range next {
+				nodes[g.parent].unread = len(g.handles)
+				src.Release(g.handles)
+			}
+		}
+		level = next
+	}
+	if err != nil && err != ErrCanceled {
+		return nil, err
+	}
+
+	out := make([]Node, 0, len(nodes))
+	var number func(idx []int, parentID int)
+	number = func(idx []int, parentID int) {
+		for _, i := range idx {
+			n := nodes[i]
+			id := len(out) + 1
+			out = append(out, Node{ID: id, ParentID: parentID, Depth: n.depth, Unread: n.unread, Values: n.values})
+			number(n.children, id)
+		}
+	}
+	number(top, 0)
+	return out, err
+}
@@ -0,0 +1,123 @@
+package axtree
+
+import (
+	"reflect"
+	"testing"
+
+	"github.com/mj1618/desktop-cli/internal/model"
+)
+
+func TestWalkBreadthFirst_MatchesWalk(t *testing.T) {
+	for _, maxDepth := range []int{0, 2} {
+		mem, roots := NewMemSource(sampleWindow(), wideTree(3, 4))
+		want, err := Walk(mem, roots, Options{MaxDepth: maxDepth})
+		if err != nil {
+			t.Fatal(err)
+		}
+		calls := mem.Calls()
+		mem.ResetCalls()
+
+		got, err := Walk(mem, roots, Options{MaxDepth: maxDepth, BreadthFirst: true})
+		if err != nil {
+			t.Fatal(err)
+		}
+		if !reflect.DeepEqual(got, want) {
+			t.Errorf("depth %d: breadth-first walk differs from Walk", maxDepth)
+		}
+		if mem.Calls() != calls {
+			t.Errorf("depth %d: breadth-first walk made %d calls, Walk %d", maxDepth, mem.Calls(), calls)
+		}
+		if mem.Live() != 0 {
+			t.Errorf("depth %d: %d child handles not released", maxDepth, mem.Live())
+		}
+	}
+}
+
+func TestWalkBreadthFirst_CanceledKeepsTopLevels(t *testing.T) {
+	mem, roots := NewMemSource(wideTree(4, 4), wideTree(4, 4))
+	fullNodes, _ := Walk(mem, roots, Options{})
+	full := BuildTree(fullNodes)
+	perElement := int(mem.Calls()) / len(fullNodes)
+
+	// Cancel while the third level (8 groups of 4) is being read.
+	mem, roots = NewMemSource(wideTree(4, 4), wideTree(4, 4))
+	src, done := cancelAfter(mem, (2+8+5)*perElement)
+	nodes, err := Walk(src, roots, Options{BreadthFirst: true, Done: done})
+	if err != ErrCanceled {
+		t.Fatalf("err = %v, want ErrCanceled", err)
+	}
+	if mem.Live() != 0 {
+		t.Errorf("%d child handles not released", mem.Live())
+	}
+
+	perDepth := map[int]int{}
+	for i, n := range nodes {
+		perDepth[n.Depth]++
+		if n.ID != i+1 {
+			t.Fatalf("node %d has ID %d; want pre-order IDs from 1", i, n.ID)
+		}
+	}
+	if perDepth[1] != 2 || perDepth[2] != 8 || perDepth[3] == 0 || perDepth[3] == 32 || perDepth[4] != 0 {
+		t.Fatalf("nodes per depth = %v, want both windows' first two levels and part of the third", perDepth)
+	}
+
+	// Every element sits at its own path in the full tree, and the ones
+	// left unexpanded count exactly the children they are missing.
+	unexpanded := 0
+	var check func([]model.Element)
+	check = func(els []model.Element) {
+		for _, el := range els {
+			at := elementAt(full, el.Path)
+			if at == nil || at.Title != el.Title {
+				t.Fatalf("element %d has path %v, which is not it in the full tree", el.ID, el.Path)
+			}
+			if el.More > 0 {
+				unexpanded++
+				if len(el.Children) != 0 || el.More != len(at.Children) {
+					t.Errorf("element %d: more=%d with %d children read, has %d children", el.ID, el.More, len(el.Children), len(at.Children))
+				}
+			} else if len(el.Children) != len(at.Children) {
+				t.Errorf("element %d has %d of its %d children and no more marker", el.ID, len(el.Children), len(at.Children))
+			}
+			check(el.Children)
+		}
+	}
+	tree := BuildTree(nodes)
+	check(tree)
+	if unexpanded == 0 {
+		t.Error("no element marked as unexpanded")
+	}
+
+	// Once IDs a full walk would not give are cleared, the rest are the
+	// full walk's.
+	ClearIDsAfterUnread(tree)
+	kept, cleared := 0, 0
+	var ids func([]model.Element)
+	ids = func(els []model.Element) {
+		for _, el := range els {
+			if el.ID == 0 {
+				cleared++
+			} else if kept++; el.ID != elementAt(full, el.Path).ID {
+				t.Errorf("element at %v has ID %d, the full walk %d", el.Path, el.ID, elementAt(full, el.Path).ID)
+			}
+			ids(el.Children)
+		}
+	}
+	ids(tree)
+	if kept == 0 || cleared == 0 {
+		t.Errorf("%d IDs kept, %d cleared; want some of each", kept, cleared)
+	}
+}
+
+// elementAt returns the element at a child-index path, or nil.
+func elementAt(els []model.Element, path []int) *model.Element {
+	var el *model.Element
+	for _, i := range path {
+		if i < 0 || i >= len(els) {
+			return nil
+		}
+		el = &els[i]
+		els = el.Children
+	}
+	return el
+}
@@ -0,0 +1,247 @@
+package axtree
+
+import (
+	"fmt"
+	"strings"
+
+	"github.com/mj1618/desktop-cli/internal/model"
+)
+
+// ActionMap maps platform action names to short names.
+var ActionMap = map[string]string{
+	"AXPress":     "press",
+	"AXCancel":    "cancel",
+	"AXPick":      "pick",
+	"AXIncrement": "increment",
+	"AXDecrement": "decrement",
+	"AXConfirm":   "confirm",
+	"AXShowMenu":  "showmenu",
+}
+
+// ShortAction returns the short name for a platform action name.
+func ShortAction(action string) string {
+	if short, ok := ActionMap[action]; ok {
+		return short
+	}
+	return strings.ToLower(strings.TrimPrefix(action, "AX"))
+}
+
+// BuildTree converts the pre-order node list returned by Walk into a nested
+// element tree. Each element gets its child-index path: the index of its
+// root, then its index among its parent's children at every level. Walk
+// visits every child of an element it descends into, so these are the
+// platform's own child indices and actions can resolve the element by
+// descending the path rather than re-walking the tree.
+func BuildTree(nodes []Node) []model.Element {
+	pos := 0
+	// In pre-order, a node's children directly follow it and each child's
+	// subtree is contiguous, so one forward pass builds the whole tree.
+	var build func(parentID int, parentPath []int) []model.Element
+	build = func(parentID int, parentPath []int) []model.Element {
+		var out []model.Element
+		for pos < len(nodes) && nodes[pos].ParentID == parentID {
+			n := nodes[pos]
+			pos++
+			el := NodeElement(n)
+			el.Path = make([]int, len(parentPath)+1)
+			copy(el.Path, parentPath)
+			el.Path[len(parentPath)] = len(out)
+			el.Children = build(n.ID, el.Path)
+			out = append(out, el)
+		}
+		return out
+	}
+	roots := build(0, nil)
+	if roots == nil {
+		return []model.Element{}
+	}
+	return roots
+}
+
+// RebasePaths gives the elements BuildTree built from a walk of a single
+// root their paths in the whole tree, where the root is at path root.
+func RebasePaths(elements []model.Element, root []int) {
+	for i := range elements {
+		elements[i].Path = append(append([]int(nil), root...), elements[i].Path[1:]...)
+		RebasePaths(elements[i].Children, root)
+	}
+}
+
+// CountBefore returns the number of elements a full Walk of roots, without a
+// depth limit, visits before the element at path, so that a walk of that
+// element alone can be numbered from there (see OffsetIDs) with the IDs the
+// platform action lookups expect. Only children are fetched, one sibling
+// group per Source.Fetch call; the caller keeps ownership of roots. If done
+// is closed, it stops before the next call and returns ErrCanceled.
+func CountBefore(src Source, roots []Handle, path []int, done <-chan struct{}) (int, error) {
+	var size func(handles []Handle) (int, error)
+	size = func(handles []Handle) (int, error) {
+		if len(handles) == 0 {
+			return 0, nil
+		}
+		select {
+		case <-done:
+			return 0, ErrCanceled
+		default:
+		}
+		values, err := src.Fetch(handles, AttrChildren)
+		if err != nil {
+			return 0, err
+		}
+		n := len(values)
+		for i, v := range values {
+			m, err := size(v.Children)
+			src.Release(v.Children)
+			if err != nil {
+				for _, rest := range values[i+1:] {
+					src.Release(rest.Children)
+				}
+				return 0, err
+			}
+			n += m
+		}
+		return n, nil
+	}
+
+	count := 0
+	handles := roots
+	var held [][]Handle
+	defer func() {
+		for _, hs := range held {
+			src.Release(hs)
+		}
+	}()
+	for level, i := range path {
+		if i < 0 || i >= len(handles) {
+			return 0, fmt.Errorf("no element at path %s", model.FormatPath(path))
+		}
+		n, err := size(handles[:i])
+		if err != nil {
+			return 0, err
+		}
+		count += n
+		if level == len(path)-1 {
+			break
+		}
+		count++ // the ancestor at this level
+		values, err := src.Fetch(handles[i:i+1], AttrChildren)
+		if err != nil {
+			return 0, err
+		}
+		handles = values[0].Children
+		held = append(held, handles)
+	}
+	return count, nil
+}
+
+// OffsetIDs adds offset to the IDs of nodes, keeping roots' ParentID 0.
+func OffsetIDs(nodes []Node, offset int) {
+	for i := range nodes {
+		nodes[i].ID += offset
+		if nodes[i].ParentID != 0 {
+			nodes[i].ParentID += offset
+		}
+	}
+}
+
+// ClearIDs zeroes the IDs of elements whose place in a full walk is not
+// known, leaving them addressable by path only.
+func ClearIDs(elements []model.Element) {
+	for i := range elements {
+		elements[i].ID = 0
+		ClearIDs(elements[i].Children)
+	}
+}
+
+// ClearIDsAfterUnread zeroes the IDs of the elements that follow, in
+// pre-order, an element with unread children (see walkBreadthFirst): a full
+// walk would number those children first, so the IDs of later elements are
+// not known. Their paths stay exact.
+func ClearIDsAfterUnread(elements []model.Element) {
+	unread := false
+	var clear func([]model.Element)
+	clear = func(els []model.Element) {
+		for i := range els {
+			if unread {
+				els[i].ID = 0
+			}
+			unread = unread || els[i].More > 0
+			clear(els[i].Children)
+		}
+	}
+	clear(elements)
+}
+
+// Stream walks the trees under roots like Walk and calls fn with each
+// element, without children, as soon as it has been read, together with its
+// depth (1 for roots). Elements get the IDs and paths BuildTree would give
+// them. Returning false from fn stops the walk. opts.Roles is ignored.
+func Stream(src Source, roots []Handle, opts Options, fn func(el model.Element, depth int) bool) error {
+	var path []int
+	opts.Roles = nil
+	opts.Visit = func(n Node) bool {
+		// Pre-order: a deeper node is the first child of the previous one,
+		// otherwise it is the next sibling at its depth.
+		if n.Depth > len(path) {
+			path = append(path, 0)
+		} else {
+			path = path[:n.Depth]
+			path[n.Depth-1]++
+		}
+		el := NodeElement(n)
+		el.Path = append([]int(nil), path...)
+		return fn(el, n.Depth)
+	}
+	_, err := Walk(src, roots, opts)
+	return err
+}
+
+// NodeElement converts a single node to an element without children.
+func NodeElement(n Node) model.Element {
+	var actions []string
+	for _, a := range n.Actions {
+		if a != "" {
+			actions = append(actions, ShortAction(a))
+		}
+	}
+	var enabled *bool
+	if !n.Enabled {
+		f := false
+		enabled = &f
+	}
+	// Text content that did not fit inline is marked with its full length
+	// so callers know to fetch it on demand.
+	var textLength int
+	if n.TextLength > utf16Len(n.Value) {
+		textLength = n.TextLength
+	}
+	return model.Element{
+		ID:          n.ID,
+		Role:        model.MapRole(n.Role),
+		Subrole:     n.Subrole,
+		Title:       n.Title,
+		Value:       n.Value,
+		Description: n.Description,
+		Bounds:      [4]int{int(n.X), int(n.Y), int(n.Width), int(n.Height)},
+		Focused:     n.Focused,
+		Enabled:     enabled,
+		Selected:    n.Selected,
+		Actions:     actions,
+		TextLength:  textLength,
+		More:        n.Unread,
+	}
+}
+
+// utf16Len returns the length of s in UTF-16 code units, the unit platform
+// text lengths (AXNumberOfCharacters) are counted in.
+func utf16Len(s string) int {
+	n := 0
+	for _, r := range s {
+		if r >= 0x10000 {
+			n += 2 // surrogate pair
+		} else {
+			n++
+		}
+	}
+	return n
+}
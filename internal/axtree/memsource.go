@@ -0,0 +1,240 @@
+package axtree
+
+import (
+	"fmt"
+	"sync"
+	"sync/atomic"
+)
+
+// MemNode is an element in an in-memory accessibility tree.
+type MemNode struct {
+	Role        string
+	Subrole     string
+	Title       string
+	Value       string
+	Description string
+	Disabled    bool
+	Focused     bool
+	Selected    bool
+	Bounds      [4]int
+	Actions     []string
+	Text        string // text content reachable only via Source.Text
+	Children    []*MemNode
+}
+
+// MemSource is a Source over an in-memory tree. It counts the platform
+// calls a real source would make, so traversal strategies can be compared
+// without a live desktop.
+type MemSource struct {
+	// PerAttribute counts one call per requested attribute per element, as
+	// a source without a multi-attribute fetch would make. Otherwise all
+	// attributes of an element cost one call, plus one for its actions
+	// (which macOS exposes through a separate API).
+	PerAttribute bool
+
+	calls atomic.Int64
+
+	mu      sync.Mutex
+	handles map[Handle]*MemNode
+	live    map[Handle]bool // handles the caller must release
+	next    Handle
+}
+
+// NewMemSource creates a source over the given root elements and returns
+// their handles.
+func NewMemSource(roots ...*MemNode) (*MemSource, []Handle) {
+	s := &MemSource{handles: make(map[Handle]*MemNode), live: make(map[Handle]bool)}
+	hs := make([]Handle, len(roots))
+	for i, r := range roots {
+		hs[i] = s.handle(r, false)
+	}
+	return s, hs
+}
+
+// Handles returns new handles to the given elements, which the caller must
+// release (like windows copied from a platform source).
+func (s *MemSource) Handles(nodes ...*MemNode) []Handle {
+	hs := make([]Handle, len(nodes))
+	for i, n := range nodes {
+		hs[i] = s.handle(n, true)
+	}
+	return hs
+}
+
+// Calls returns the number of platform calls made so far.
+func (s *MemSource) Calls() int64 { return s.calls.Load() }
+
+// ResetCalls zeroes the call counter.
+func (s *MemSource) ResetCalls() { s.calls.Store(0) }
+
+// Live returns the number of handles handed out (as children or by
+// Handles) and not yet released.
+func (s *MemSource) Live() int {
+	s.mu.Lock()
+	defer s.mu.Unlock()
+	return len(s.live)
+}
+
+func (s *MemSource) handle(n *MemNode, live bool) Handle {
+	s.mu.Lock()
+	defer s.mu.Unlock()
+	s.next++
+	s.handles[s.next] = n
+	if live {
+		s.live[s.next] = true
+	}
+	return s.next
+}
+
+func (s *MemSource) lookup(h Handle) (*MemNode, error) {
+	s.mu.Lock()
+	defer s.mu.Unlock()
+	n, ok := s.handles[h]
+	if !ok {
+		return nil, fmt.Errorf("invalid handle %d", h)
+	}
+	return n, nil
+}
+
+func (s *MemSource) Fetch(handles []Handle, attrs Attr) ([]Values, error) {
+	return s.fetch(handles, attrs, nil)
+}
+
+func (s *MemSource) fetch(handles []Handle, attrs Attr, observe Observer) ([]Values, error) {
+	out := make([]Values, len(handles))
+	for i, h := range handles {
+		n, err := s.lookup(h)
+		if err != nil {
+			return nil, err
+		}
+		s.count(attrs, observe)
+
+		v := &out[i]
+		v.Enabled = true
+		if attrs&AttrRole != 0 {
+			v.Role = n.Role
+		}
+		if attrs&AttrSubrole != 0 {
+			v.Subrole = n.Subrole
+		}
+		if attrs&AttrTitle != 0 {
+			v.Title = n.Title
+		}
+		if attrs&AttrValue != 0 {
+			v.Value = n.Value
+		}
+		if attrs&AttrDescription != 0 {
+			v.Description = n.Description
+		}
+		if attrs&AttrEnabled != 0 {
+			v.Enabled = !n.Disabled
+		}
+		if attrs&AttrFocused != 0 {
+			v.Focused = n.Focused
+		}
+		if attrs&AttrSelected != 0 {
+			v.Selected = n.Selected
+		}
+		if attrs&AttrPosition != 0 {
+			v.X, v.Y = float64(n.Bounds[0]), float64(n.Bounds[1])
+		}
+		if attrs&AttrSize != 0 {
+			v.Width, v.Height = float64(n.Bounds[2]), float64(n.Bounds[3])
+		}
+		if attrs&AttrActions != 0 && len(n.Actions) > 0 {
+			v.Actions = append([]string(nil), n.Actions...)
+		}
+		if attrs&AttrTextLength != 0 {
+			v.TextLength = len([]rune(n.Text))
+		}
+		if attrs&AttrChildren != 0 && len(n.Children) > 0 {
+			v.Children = make([]Handle, len(n.Children))
+			for j, c := range n.Children {
+				v.Children[j] = s.handle(c, true)
+			}
+		}
+	}
+	return out, nil
+}
+
+// count records the calls needed to fetch attrs for one element.
+func (s *MemSource) count(attrs Attr, observe Observer) {
+	var calls []string
+	switch {
+	case s.PerAttribute:
+		calls = attrs.Names()
+	default:
+		if attrs&^AttrActions != 0 {
+			calls = append(calls, "AXUIElementCopyMultipleAttributeValues")
+		}
+		if attrs&AttrActions != 0 {
+			calls = append(calls, "AXUIElementCopyActionNames")
+		}
+	}
+	s.calls.Add(int64(len(calls)))
+	if observe != nil {
+		for _, c := range calls {
+			observe(c, 0)
+		}
+	}
+}
+
+func (s *MemSource) Text(h Handle, max int) (string, bool) {
+	return s.text(h, max, nil)
+}
+
+func (s *MemSource) text(h Handle, max int, observe Observer) (string, bool) {
+	n, err := s.lookup(h)
+	if err != nil {
+		return "", false
+	}
+	s.calls.Add(1)
+	if observe != nil {
+		observe("AXStringForRange", 0)
+	}
+	r := []rune(n.Text)
+	if len(r) == 0 {
+		return "", false
+	}
+	if len(r) > max {
+		r = r[:max]
+	}
+	return string(r), true
+}
+
+func (s *MemSource) Release(handles []Handle) {
+	s.mu.Lock()
+	defer s.mu.Unlock()
+	for _, h := range handles {
+		if s.live[h] {
+			delete(s.live, h)
+			delete(s.handles, h)
+		}
+	}
+}
+
+// Observe returns a view of the source that reports each call to fn.
+func (s *MemSource) Observe(fn Observer) Source {
+	return memObserved{s, fn}
+}
+
+type memObserved struct {
+	*MemSource
+	observe Observer
+}
+
+func (m memObserved) Fetch(handles []Handle, attrs Attr) ([]Values, error) {
+	return m.fetch(handles, attrs, m.observe)
+}
+
+func (m memObserved) Text(h Handle, max int) (string, bool) {
+	return m.text(h, max, m.observe)
+}
+
+// Equal reports whether two handles refer to the same element.
+func (s *MemSource) Equal(a, b Handle) bool {
+	s.mu.Lock()
+	defer s.mu.Unlock()
+	na, nb := s.handles[a], s.handles[b]
+	return na != nil && na == nb
+}
@@ -0,0 +1,277 @@
+package axtree
+
+// VolatileAttrs are the attributes that change often for an existing
+// element and are re-fetched on every Refresh. Role is included so that a
+// positional match (see Refresh) can be verified in the same round trip.
+const VolatileAttrs = AttrRole | AttrTitle | AttrValue | AttrEnabled | AttrFocused |
+	AttrSelected | AttrPosition | AttrSize | AttrChildren | AttrTextLength
+
+// stableAttrs almost never change for an existing element, so Refresh
+// fetches them only for elements it has not seen before.
+const stableAttrs = AttrAll &^ VolatileAttrs
+
+// Equaler is implemented by Sources that can tell whether two handles refer
+// to the same element without a round trip (CFEqual on macOS).
+type Equaler interface {
+	Equal(a, b Handle) bool
+}
+
+// Tree is a walked element tree whose handles stay retained, so that later
+// reads of the same scope can refresh only volatile attributes.
+type Tree struct {
+	src     Source
+	opts    Options
+	roots   []Handle
+	nodes   []Node
+	handles []Handle   // handles[i] is the handle of nodes[i]
+	held    [][]Handle // child handle groups to release
+}
+
+// WalkTree walks the trees under roots like Walk, but keeps every handle
+// retained. The Tree takes ownership of roots; call Release when done.
+//
+// A walk canceled through opts.Done releases everything and returns
+// ErrCanceled with a Tree that holds only the nodes read so far.
+func WalkTree(src Source, roots []Handle, opts Options) (*Tree, error) {
+	if opts.TextLimit == 0 {
+		opts.TextLimit = DefaultTextLimit
+	}
+	opts.Roles = nil
+	w := &walker{src: src, opts: opts, attrs: AttrAll, nextID: 1, retain: true}
+	if err := w.group(roots, 0, 1); err != nil {
+		w.releaseHeld()
+		src.Release(roots)
+		if err == ErrCanceled {
+			return &Tree{src: src, nodes: w.nodes}, err
+		}
+		return nil, err
+	}
+	opts.Done = nil // per walk; see RefreshUntil
+	return &Tree{src: src, opts: opts, roots: roots, nodes: w.nodes, handles: w.handles, held: w.held}, nil
+}
+
+// Nodes returns the elements of the last walk or refresh in pre-order.
+func (t *Tree) Nodes() []Node { return t.nodes }
+
+// Release drops all handles held by the tree.
+func (t *Tree) Release() {
+	for _, hs := range t.held {
+		t.src.Release(hs)
+	}
+	t.src.Release(t.roots)
+	t.held, t.roots, t.handles, t.nodes = nil, nil, nil, nil
+}
+
+// Refresh re-reads the tree under roots (taking ownership of them) and
+// returns its elements in pre-order, exactly as a fresh Walk would.
+//
+// Elements already in the tree only have VolatileAttrs re-fetched; their
+// subrole, description and actions are carried over. Known elements are
+// recognized by handle identity when the Source implements Equaler, and by
+// child-index path and role otherwise. New elements get a full fetch.
+func (t *Tree) Refresh(roots []Handle) ([]Node, error) {
+	return t.RefreshUntil(roots, nil)
+}
+
+// RefreshUntil is Refresh, canceled when done is closed (see Options.Done).
+// A canceled refresh returns the nodes read so far and ErrCanceled, and
+// leaves the tree as it was, so the next refresh can still reuse it.
+func (t *Tree) RefreshUntil(roots []Handle, done <-chan struct{}) ([]Node, error) {
+	opts := t.opts
+	opts.Done = done
+	r := &refresher{
+		walker: walker{src: t.src, opts: opts, nextID: 1, retain: true},
+		old:    t,
+		kids:   make([][]int, len(t.nodes)),
+	}
+	r.eq, _ = t.src.(Equaler)
+	var oldRoots []int
+	for i, n := range t.nodes {
+		if n.ParentID == 0 {
+			oldRoots = append(oldRoots, i)
+		} else {
+			// IDs are pre-order positions, so a node's parent is at ID-1.
+			r.kids[n.ParentID-1] = append(r.kids[n.ParentID-1], i)
+		}
+	}
+
+	if err := r.group(roots, oldRoots, 0, 1); err != nil {
+		r.releaseHeld()
+		t.src.Release(roots)
+		if err == ErrCanceled {
+			return r.nodes, err
+		}
+		return nil, err
+	}
+
+	for _, hs := range t.held {
+		t.src.Release(hs)
+	}
+	t.src.Release(t.roots)
+	t.roots, t.nodes, t.handles, t.held = roots, r.nodes, r.handles, r.held
+	return t.nodes, nil
+}
+
+type refresher struct {
+	walker
+	old  *Tree
+	kids [][]int // old node index -> old child node indexes
+	eq   Equaler
+}
+
+// group refreshes one sibling group. oldSibs are the old tree's nodes at
+// the same position (the previous children of the matched parent).
+func (r *refresher) group(handles []Handle, oldSibs []int, parentID, depth int) error {
+	if len(handles) == 0 || (r.opts.MaxDepth > 0 && depth > r.opts.MaxDepth) {
+		return nil
+	}
+	if r.canceled() {
+		return ErrCanceled
+	}
+	descend := r.opts.MaxDepth == 0 || depth < r.opts.MaxDepth
+
+	match := r.match(handles, oldSibs)
+	var known, fresh []int
+	for i, m := range match {
+		if m >= 0 {
+			known = append(known, i)
+		} else {
+			fresh = append(fresh, i)
+		}
+	}
+
+	values := make([]Values, len(handles))
+	release := func() {
+		for _, v := range values {
+			r.src.Release(v.Children)
+		}
+	}
+	volatile, full := VolatileAttrs, AttrAll
+	if !descend {
+		volatile &^= AttrChildren
+		full &^= AttrChildren
+	}
+	if err := r.fetchInto(values, handles, known, volatile); err != nil {
+		return err
+	}
+	if err := r.fetchInto(values, handles, fresh, full); err != nil {
+		release()
+		return err
+	}
+
+	// Carry stable attributes over; a positional match whose role changed
+	// is a different element and needs them fetched.
+	var changed []int
+	for _, i := range known {
+		o := &r.old.nodes[match[i]]
+		if values[i].Role != o.Role {
+			match[i] = -1
+			changed = append(changed, i)
+			continue
+		}
+		values[i].Subrole = o.Subrole
+		values[i].Description = o.Description
+		values[i].Actions = o.Actions
+	}
+	if len(changed) > 0 {
+		sub := make([]Handle, len(changed))
+		for j, i := range changed {
+			sub[j] = handles[i]
+		}
+		vs, err := r.src.Fetch(sub, stableAttrs)
+		if err != nil {
+			release()
+			return err
+		}
+		for j, i := range changed {
+			values[i].Subrole = vs[j].Subrole
+			values[i].Description = vs[j].Description
+			values[i].Actions = vs[j].Actions
+		}
+	}
+
+	for i := range values {
+		v := values[i]
+		r.inlineText(handles[i], &v)
+
+		id := r.nextID
+		r.nextID++
+		children := v.Children
+		v.Children = nil
+		values[i].Children = nil
+		r.nodes = append(r.nodes, Node{ID: id, ParentID: parentID, Depth: depth, Values: v})
+		r.handles = append(r.handles, handles[i])
+
+		if len(children) > 0 {
+			var oldKids []int
+			if match[i] >= 0 {
+				oldKids = r.kids[match[i]]
+			}
+			err := r.group(children, oldKids, id, depth+1)
+			r.held = append(r.held, children)
+			if err != nil {
+				release()
+				return err
+			}
+		}
+	}
+	return nil
+}
+
+// fetchInto fetches attrs for handles[idx...] and stores them in values.
+func (r *refresher) fetchInto(values []Values, handles []Handle, idx []int, attrs Attr) error {
+	if len(idx) == 0 {
+		return nil
+	}
+	sub := make([]Handle, len(idx))
+	for j, i := range idx {
+		sub[j] = handles[i]
+	}
+	vs, err := r.src.Fetch(sub, attrs)
+	if err != nil {
+		return err
+	}
+	for j, i := range idx {
+		values[i] = vs[j]
+	}
+	return nil
+}
+
+// matchWindow bounds how far from its old position a sibling is searched
+// for, keeping matching linear for long lists.
+const matchWindow = 32
+
+// match returns, for each handle, the index of the old node it refers to,
+// or -1 if it is new.
+func (r *refresher) match(handles []Handle, oldSibs []int) []int {
+	match := make([]int, len(handles))
+	for i := range match {
+		match[i] = -1
+	}
+	if r.eq == nil {
+		for i := range handles {
+			if i < len(oldSibs) {
+				match[i] = oldSibs[i]
+			}
+		}
+		return match
+	}
+	used := make([]bool, len(oldSibs))
+	for i, h := range handles {
+		lo, hi := max(0, i-matchWindow), min(len(oldSibs), i+matchWindow+1)
+		// Try the same position first: most refreshes change nothing.
+		if i < len(oldSibs) && !used[i] && r.eq.Equal(h, r.old.handles[oldSibs[i]]) {
+			match[i] = oldSibs[i]
+			used[i] = true
+			continue
+		}
+		for j := lo; j < hi; j++ {
+			if !used[j] && r.eq.Equal(h, r.old.handles[oldSibs[j]]) {
+				match[i] = oldSibs[j]
+				used[j] = true
+				break
+			}
+		}
+	}
+	return match
+}
@@ -0,0 +1,125 @@
+package axtree
+
+import (
+	"reflect"
+	"testing"
+)
+
+// pathOnly hides MemSource's Equaler so Refresh falls back to child-index
+// path matching.
+type pathOnly struct{ Source }
+
+func freshWalk(t *testing.T, win *MemNode) []Node {
+	t.Helper()
+	src, roots := NewMemSource(win)
+	nodes, err := Walk(src, roots, Options{})
+	if err != nil {
+		t.Fatal(err)
+	}
+	return nodes
+}
+
+func TestTreeRefresh_UnchangedCostsOneCallPerElement(t *testing.T) {
+	win := sampleWindow()
+	src, _ := NewMemSource()
+	tree, err := WalkTree(src, src.Handles(win), Options{})
+	if err != nil {
+		t.Fatal(err)
+	}
+	fullCalls := src.Calls()
+
+	src.ResetCalls()
+	nodes, err := tree.Refresh(src.Handles(win))
+	if err != nil {
+		t.Fatal(err)
+	}
+	if !reflect.DeepEqual(nodes, freshWalk(t, win)) {
+		t.Errorf("refresh differs from a fresh walk")
+	}
+	// Six elements plus one text fallback.
+	if src.Calls() != 7 {
+		t.Errorf("refresh made %d calls, want 7 (full walk made %d)", src.Calls(), fullCalls)
+	}
+
+	tree.Release()
+	if src.Live() != 0 {
+		t.Errorf("%d handles not released", src.Live())
+	}
+}
+
+func TestTreeRefresh_PicksUpChanges(t *testing.T) {
+	for _, tc := range []struct {
+		name string
+		src  func(*MemSource) Source
+	}{
+		{"identity", func(s *MemSource) Source { return s }},
+		{"path", func(s *MemSource) Source { return pathOnly{s} }},
+	} {
+		t.Run(tc.name, func(t *testing.T) {
+			win := sampleWindow()
+			mem, _ := NewMemSource()
+			tree, err := WalkTree(tc.src(mem), mem.Handles(win), Options{})
+			if err != nil {
+				t.Fatal(err)
+			}
+			defer tree.Release()
+
+			// Volatile change, an insertion that shifts siblings, and a
+			// replaced element with a different role at the same position.
+			win.Children[1].Value = "typed"
+			win.Children[1].Focused = false
+			toolbar := win.Children[0]
+			toolbar.Children = append([]*MemNode{{Role: "AXButton", Title: "Home", Description: "go home", Actions: []string{"AXPress"}}}, toolbar.Children...)
+			win.Children[2] = &MemNode{Role: "AXCheckBox", Title: "Wrap", Subrole: "AXToggle", Actions: []string{"AXPress"}}
+
+			nodes, err := tree.Refresh(mem.Handles(win))
+			if err != nil {
+				t.Fatal(err)
+			}
+			want := freshWalk(t, win)
+			// Path matching cannot see that "Back" moved, so for the
+			// inserted button it keeps stale stable attributes from the
+			// element previously at that position when roles agree.
+			if tc.name == "path" {
+				for i := range want {
+					want[i].Description, nodes[i].Description = "", ""
+					want[i].Actions, nodes[i].Actions = nil, nil
+				}
+			}
+			if !reflect.DeepEqual(nodes, want) {
+				t.Errorf("refresh differs from a fresh walk:\ngot  %+v\nwant %+v", nodes, want)
+			}
+		})
+	}
+}
+
+func TestTreeRefresh_MaxDepth(t *testing.T) {
+	win := sampleWindow()
+	src, _ := NewMemSource()
+	tree, _ := WalkTree(src, src.Handles(win), Options{MaxDepth: 2})
+	defer tree.Release()
+	nodes, _ := tree.Refresh(src.Handles(win))
+	if len(nodes) != 4 {
+		t.Errorf("got %d nodes, want 4", len(nodes))
+	}
+}
+
+func TestTreeRefresh_CanceledKeepsTree(t *testing.T) {
+	win := sampleWindow()
+	mem, _ := NewMemSource()
+	tree, _ := WalkTree(mem, mem.Handles(win), Options{})
+	defer tree.Release()
+
+	done := make(chan struct{})
+	close(done)
+	if nodes, err := tree.RefreshUntil(mem.Handles(win), done); err != ErrCanceled || len(nodes) != 0 {
+		t.Fatalf("canceled refresh returned %d nodes, err %v", len(nodes), err)
+	}
+	nodes, err := tree.Refresh(mem.Handles(win))
+	if err != nil {
+		t.Fatal(err)
+	}
+	if !reflect.DeepEqual(nodes, freshWalk(t, win)) {
+		t.Errorf("refresh after a canceled one differs from a fresh walk")
+	}
+}
@@ -0,0 +1,252 @@
+package axtree
+
+import (
+	"fmt"
+	"math/bits"
+	"sort"
+	"sync"
+	"time"
+)
+
+// Observer receives the duration of each platform call a Source makes,
+// named after the platform API (e.g. "AXUIElementCopyActionNames").
+type Observer func(call string, d time.Duration)
+
+// ObservableSource is implemented by Sources that can time their
+// underlying platform calls individually.
+type ObservableSource interface {
+	Source
+	// Observe returns a Source that reports every platform call to fn.
+	Observe(fn Observer) Source
+}
+
+// attrNames are the platform attribute names for each Attr bit.
+var attrNames = [...]string{
+	"AXRole", "AXSubrole", "AXTitle", "AXValue", "AXDescription",
+	"AXEnabled", "AXFocused", "AXSelected", "AXPosition", "AXSize",
+	"AXChildren", "AXActionNames", "AXNumberOfCharacters",
+}
+
+// Names returns the platform attribute names of the bits set in a.
+func (a Attr) Names() []string {
+	var names []string
+	for b := uint32(a); b != 0; b &= b - 1 {
+		if i := bits.TrailingZeros32(b); i < len(attrNames) {
+			names = append(names, attrNames[i])
+		}
+	}
+	return names
+}
+
+// latencyBuckets are the upper bounds of the latency histogram buckets;
+// a final bucket catches everything slower.
+var latencyBuckets = [...]time.Duration{
+	50 * time.Microsecond, 100 * time.Microsecond, 250 * time.Microsecond,
+	500 * time.Microsecond, time.Millisecond, 2500 * time.Microsecond,
+	5 * time.Millisecond, 10 * time.Millisecond, 25 * time.Millisecond,
+	50 * time.Millisecond, 100 * time.Millisecond,
+}
+
+// Stats accumulates accessibility call counts and latencies per app and per
+// call, plus how many elements each attribute was requested for. It is safe
+// for concurrent use; the zero value is not usable, see NewStats.
+type Stats struct {
+	mu   sync.Mutex
+	apps map[string]*appStats
+}
+
+type appStats struct {
+	calls map[string]*callStats
+	attrs map[string]int64
+}
+
+type callStats struct {
+	count   int64
+	total   time.Duration
+	max     time.Duration
+	buckets [len(latencyBuckets) + 1]int64
+}
+
+// NewStats creates an empty Stats.
+func NewStats() *Stats {
+	return &Stats{apps: make(map[string]*appStats)}
+}
+
+func (s *Stats) app(name string) *appStats {
+	a, ok := s.apps[name]
+	if !ok {
+		a = &appStats{calls: make(map[string]*callStats), attrs: make(map[string]int64)}
+		s.apps[name] = a
+	}
+	return a
+}
+
+// Record adds one call of the given duration.
+func (s *Stats) Record(app, call string, d time.Duration) {
+	s.mu.Lock()
+	defer s.mu.Unlock()
+	a := s.app(app)
+	c, ok := a.calls[call]
+	if !ok {
+		c = &callStats{}
+		a.calls[call] = c
+	}
+	c.count++
+	c.total += d
+	if d > c.max {
+		c.max = d
+	}
+	b := sort.Search(len(latencyBuckets), func(i int) bool { return d <= latencyBuckets[i] })
+	c.buckets[b]++
+}
+
+// countAttrs adds n elements to the request count of each attribute in attrs.
+func (s *Stats) countAttrs(app string, attrs Attr, n int) {
+	s.mu.Lock()
+	defer s.mu.Unlock()
+	a := s.app(app)
+	for _, name := range attrs.Names() {
+		a.attrs[name] += int64(n)
+	}
+}
+
+// Reset discards everything recorded so far.
+func (s *Stats) Reset() {
+	s.mu.Lock()
+	defer s.mu.Unlock()
+	s.apps = make(map[string]*appStats)
+}
+
+// AppReport is the recorded activity for one app.
+type AppReport struct {
+	App        string           `yaml:"app"                  json:"app"`
+	Calls      []CallReport     `yaml:"calls"                json:"calls"`
+	Attributes map[string]int64 `yaml:"attributes,omitempty" json:"attributes,omitempty"` // elements each attribute was requested for
+}
+
+// CallReport summarizes the latency of one kind of call.
+type CallReport struct {
+	Call      string         `yaml:"call"      json:"call"`
+	Count     int64          `yaml:"count"     json:"count"`
+	TotalMs   float64        `yaml:"total_ms"  json:"total_ms"`
+	MeanMs    float64        `yaml:"mean_ms"   json:"mean_ms"`
+	P50Ms     float64        `yaml:"p50_ms"    json:"p50_ms"` // bucket upper bound
+	P95Ms     float64        `yaml:"p95_ms"    json:"p95_ms"` // bucket upper bound
+	MaxMs     float64        `yaml:"max_ms"    json:"max_ms"`
+	Histogram []BucketReport `yaml:"histogram" json:"histogram"`
+}
+
+// BucketReport is one non-empty latency histogram bucket.
+type BucketReport struct {
+	LE    string `yaml:"le"    json:"le"` // upper bound, "+Inf" for the last bucket
+	Count int64  `yaml:"count" json:"count"`
+}
+
+// Report returns the recorded stats, apps sorted by name and calls by total
+// time spent, slowest first.
+func (s *Stats) Report() []AppReport {
+	s.mu.Lock()
+	defer s.mu.Unlock()
+	reports := make([]AppReport, 0, len(s.apps))
+	for name, a := range s.apps {
+		r := AppReport{App: name}
+		if len(a.attrs) > 0 {
+			r.Attributes = make(map[string]int64, len(a.attrs))
+			for k, v := range a.attrs {
+				r.Attributes[k] = v
+			}
+		}
+		for call, c := range a.calls {
+			r.Calls = append(r.Calls, c.report(call))
+		}
+		sort.Slice(r.Calls, func(i, j int) bool {
+			if r.Calls[i].TotalMs != r.Calls[j].TotalMs {
+				return r.Calls[i].TotalMs > r.Calls[j].TotalMs
+			}
+			return r.Calls[i].Call < r.Calls[j].Call
+		})
+		reports = append(reports, r)
+	}
+	sort.Slice(reports, func(i, j int) bool { return reports[i].App < reports[j].App })
+	return reports
+}
+
+func (c *callStats) report(call string) CallReport {
+	r := CallReport{
+		Call:    call,
+		Count:   c.count,
+		TotalMs: ms(c.total),
+		MaxMs:   ms(c.max),
+	}
+	if c.count > 0 {
+		r.MeanMs = ms(c.total / time.Duration(c.count))
+	}
+	var seen int64
+	for i, n := range c.buckets {
+		if n == 0 {
+			continue
+		}
+		le, bound := "+Inf", c.max
+		if i < len(latencyBuckets) {
+			le, bound = fmt.Sprint(latencyBuckets[i]), latencyBuckets[i]
+		}
+		r.Histogram = append(r.Histogram, BucketReport{LE: le, Count: n})
+		if seen*2 < c.count && (seen+n)*2 >= c.count {
+			r.P50Ms = ms(bound)
+		}
+		if seen*20 < c.count*19 && (seen+n)*20 >= c.count*19 {
+			r.P95Ms = ms(bound)
+		}
+		seen += n
+	}
+	return r
+}
+
+func ms(d time.Duration) float64 {
+	return float64(d.Microseconds()) / 1000
+}
+
+// Instrument wraps src so that every traversal call is recorded in stats
+// under app: the attributes requested, the wall time of each Fetch batch and
+// Text call, and, if src is an ObservableSource, each platform call.
+func Instrument(src Source, stats *Stats, app string) Source {
+	if o, ok := src.(ObservableSource); ok {
+		src = o.Observe(func(call string, d time.Duration) { stats.Record(app, call, d) })
+	}
+	in := instrumented{src: src, stats: stats, app: app}
+	if eq, ok := src.(Equaler); ok {
+		return instrumentedEqualer{in, eq}
+	}
+	return in
+}
+
+type instrumented struct {
+	src   Source
+	stats *Stats
+	app   string
+}
+
+func (s instrumented) Fetch(handles []Handle, attrs Attr) ([]Values, error) {
+	start := time.Now()
+	values, err := s.src.Fetch(handles, attrs)
+	s.stats.Record(s.app, "Fetch", time.Since(start))
+	s.stats.countAttrs(s.app, attrs, len(handles))
+	return values, err
+}
+
+func (s instrumented) Text(h Handle, max int) (string, bool) {
+	start := time.Now()
+	text, ok := s.src.Text(h, max)
+	s.stats.Record(s.app, "Text", time.Since(start))
+	return text, ok
+}
+
+func (s instrumented) Release(handles []Handle) { s.src.Release(handles) }
+
+// instrumentedEqualer keeps the wrapped Source's Equaler visible to Refresh.
+type instrumentedEqualer struct {
+	instrumented
+	eq Equaler
+}
+
+func (s instrumentedEqualer) Equal(a, b Handle) bool { return s.eq.Equal(a, b) }
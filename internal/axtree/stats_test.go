@@ -0,0 +1,76 @@
+package axtree
+
+import (
+	"testing"
+	"time"
+)
+
+func TestInstrument_CountsCallsPerAttributeAndApp(t *testing.T) {
+	stats := NewStats()
+	src, roots := NewMemSource(sampleWindow())
+	if _, err := Walk(Instrument(src, stats, "TextEdit"), roots, Options{}); err != nil {
+		t.Fatal(err)
+	}
+
+	reports := stats.Report()
+	if len(reports) != 1 || reports[0].App != "TextEdit" {
+		t.Fatalf("reports = %+v", reports)
+	}
+	r := reports[0]
+	if r.Attributes["AXRole"] != 6 || r.Attributes["AXActionNames"] != 6 {
+		t.Errorf("attribute counts = %v, want 6 elements each", r.Attributes)
+	}
+	calls := make(map[string]int64)
+	for _, c := range r.Calls {
+		calls[c.Call] = c.Count
+	}
+	want := map[string]int64{
+		"Fetch":                                  3, // one per sibling group
+		"Text":                                   1,
+		"AXUIElementCopyMultipleAttributeValues": 6,
+		"AXUIElementCopyActionNames":             6,
+		"AXStringForRange":                       1,
+	}
+	for call, n := range want {
+		if calls[call] != n {
+			t.Errorf("%s: %d calls, want %d", call, calls[call], n)
+		}
+	}
+}
+
+func TestInstrument_KeepsEqualer(t *testing.T) {
+	src, _ := NewMemSource()
+	if _, ok := Instrument(src, NewStats(), "x").(Equaler); !ok {
+		t.Error("instrumenting an Equaler should keep it an Equaler")
+	}
+	if _, ok := Instrument(pathOnly{src}, NewStats(), "x").(Equaler); ok {
+		t.Error("instrumenting a non-Equaler should not add Equal")
+	}
+}
+
+func TestStats_Histogram(t *testing.T) {
+	stats := NewStats()
+	for i := 0; i < 18; i++ {
+		stats.Record("Chrome", "AXStringForRange", 80*time.Microsecond)
+	}
+	stats.Record("Chrome", "AXStringForRange", 3*time.Millisecond)
+	stats.Record("Chrome", "AXStringForRange", 400*time.Millisecond)
+	stats.Record("Chrome", "AXUIElementCopyActionNames", time.Millisecond)
+
+	r := stats.Report()[0]
+	c := r.Calls[0]
+	if c.Call != "AXStringForRange" || c.Count != 20 {
+		t.Fatalf("slowest call = %+v", c)
+	}
+	if c.P50Ms != 0.1 || c.P95Ms != 5 || c.MaxMs != 400 {
+		t.Errorf("p50=%v p95=%v max=%v", c.P50Ms, c.P95Ms, c.MaxMs)
+	}
+	if n := len(c.Histogram); n != 3 || c.Histogram[2].LE != "+Inf" {
+		t.Errorf("histogram = %+v", c.Histogram)
+	}
+
+	stats.Reset()
+	if len(stats.Report()) != 0 {
+		t.Error("Reset should clear all stats")
+	}
+}
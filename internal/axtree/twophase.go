@@ -0,0 +1,108 @@
+package axtree
+
+import (
+	"sync"
+
+	"github.com/mj1618/desktop-cli/internal/model"
+)
+
+// DefaultParallelism is the number of concurrent Fetch batches used for the
+// second phase of a two-phase read.
+const DefaultParallelism = 4
+
+// detailBatch is the number of elements per second-phase Fetch call.
+const detailBatch = 64
+
+// skeletonAttrs are the attributes fetched for every element in the first
+// phase of a two-phase read.
+const skeletonAttrs = AttrRole | AttrChildren
+
+// walkTwoPhase reads a role-filtered tree in two passes. Phase one walks the
+// whole tree fetching only role and children, which fixes the pre-order IDs.
+// Phase two fetches the remaining attributes, in parallel batches, only for
+// elements whose role is in opts.Roles. Role filtering drops non-matching
+// ancestors and promotes their matching descendants, so no other element
+// needs its details.
+//
+// If opts.Done is closed, the skeleton walk stops and no further detail
+// batches are fetched; the result is cut before the first element still
+// missing its details.
+func walkTwoPhase(src Source, roots []Handle, opts Options) ([]Node, error) {
+	w := &walker{src: src, opts: opts, attrs: skeletonAttrs, nextID: 1, retain: true}
+	defer w.releaseHeld()
+	skelErr := w.group(roots, 0, 1)
+	if skelErr != nil && skelErr != ErrCanceled {
+		return nil, skelErr
+	}
+
+	roleSet := make(map[string]bool, len(opts.Roles))
+	for _, r := range opts.Roles {
+		roleSet[r] = true
+	}
+	var survivors []int
+	for i := range w.nodes {
+		if roleSet[model.MapRole(w.nodes[i].Role)] {
+			survivors = append(survivors, i)
+		} else {
+			w.nodes[i].Partial = true
+			w.nodes[i].Enabled = true
+		}
+	}
+
+	parallelism := opts.Parallelism
+	if parallelism <= 0 {
+		parallelism = DefaultParallelism
+	}
+	sem := make(chan struct{}, parallelism)
+	var wg sync.WaitGroup
+	var errOnce sync.Once
+	var firstErr error
+	fetched := make([]bool, (len(survivors)+detailBatch-1)/detailBatch)
+	for b := range fetched {
+		batch, done := survivors[b*detailBatch:min((b+1)*detailBatch, len(survivors))], &fetched[b]
+		wg.Add(1)
+		sem <- struct{}{}
+		go func() {
+			defer wg.Done()
+			defer func() { <-sem }()
+			if w.canceled() {
+				return
+			}
+			if err := w.fetchDetails(batch); err != nil {
+				errOnce.Do(func() { firstErr = err })
+				return
+			}
+			*done = true
+		}()
+	}
+	wg.Wait()
+	if firstErr != nil {
+		return nil, firstErr
+	}
+	for b, ok := range fetched {
+		if !ok {
+			return w.nodes[:survivors[b*detailBatch]], ErrCanceled
+		}
+	}
+	return w.nodes, skelErr
+}
+
+// fetchDetails fetches the non-skeleton attributes for the given nodes.
+// Each call touches a disjoint set of nodes, so batches may run concurrently.
+func (w *walker) fetchDetails(idx []int) error {
+	handles := make([]Handle, len(idx))
+	for i, n := range idx {
+		handles[i] = w.handles[n]
+	}
+	values, err := w.src.Fetch(handles, AttrAll&^skeletonAttrs)
+	if err != nil {
+		return err
+	}
+	for i, n := range idx {
+		v := values[i]
+		w.inlineText(handles[i], &v)
+		v.Role = w.nodes[n].Role
+		w.nodes[n].Values = v
+	}
+	return nil
+}
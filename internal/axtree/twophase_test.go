@@ -0,0 +1,105 @@
+package axtree
+
+import (
+	"reflect"
+	"testing"
+
+	"github.com/mj1618/desktop-cli/internal/model"
+)
+
+// formTree builds a window with many static texts and groups and a few
+// buttons nested at different depths.
+func formTree() *MemNode {
+	win := &MemNode{Role: "AXWindow", Title: "Form", Bounds: [4]int{0, 0, 800, 600}}
+	for i := 0; i < 20; i++ {
+		g := &MemNode{Role: "AXGroup", Bounds: [4]int{0, i * 30, 800, 30}}
+		for j := 0; j < 5; j++ {
+			g.Children = append(g.Children, &MemNode{Role: "AXStaticText", Value: "label", Bounds: [4]int{j * 100, i * 30, 100, 30}})
+		}
+		if i%5 == 0 {
+			g.Children = append(g.Children, &MemNode{Role: "AXButton", Title: "Go", Actions: []string{"AXPress"}, Bounds: [4]int{700, i * 30, 80, 30}})
+		}
+		win.Children = append(win.Children, g)
+	}
+	win.Children = append(win.Children, &MemNode{Role: "AXTextArea", Text: "notes", Bounds: [4]int{0, 600, 800, 100}})
+	return win
+}
+
+func TestWalkTwoPhase_MatchesFilteredFullRead(t *testing.T) {
+	for _, roles := range [][]string{{"btn"}, {"btn", "input"}, {"txt"}} {
+		full, roots := NewMemSource(formTree())
+		fullNodes, err := Walk(full, roots, Options{})
+		if err != nil {
+			t.Fatal(err)
+		}
+		want := model.FilterElements(BuildTree(fullNodes), roles, nil)
+
+		two, roots2 := NewMemSource(formTree())
+		nodes, err := Walk(two, roots2, Options{Roles: roles, Parallelism: 3})
+		if err != nil {
+			t.Fatal(err)
+		}
+		got := model.FilterElements(BuildTree(nodes), roles, nil)
+
+		if !reflect.DeepEqual(got, want) {
+			t.Errorf("roles %v: two-phase result differs from filtered full read\ngot  %+v\nwant %+v", roles, got, want)
+		}
+		if two.Live() != 0 {
+			t.Errorf("roles %v: %d handles not released", roles, two.Live())
+		}
+	}
+}
+
+func TestWalkTwoPhase_FetchesDetailsOnlyForSurvivors(t *testing.T) {
+	full, roots := NewMemSource(formTree())
+	Walk(full, roots, Options{})
+
+	two, roots2 := NewMemSource(formTree())
+	nodes, _ := Walk(two, roots2, Options{Roles: []string{"btn"}})
+
+	// Skeleton: one call per element. Details: one multi-attribute call and
+	// one action call per button.
+	buttons := 4
+	if want := int64(len(nodes) + 2*buttons); two.Calls() != want {
+		t.Errorf("two-phase made %d calls, want %d", two.Calls(), want)
+	}
+	// A full batched read costs two calls per element (attributes, actions).
+	if two.Calls()*10 > full.Calls()*6 {
+		t.Errorf("two-phase made %d calls vs %d for a full read; want under 60%%", two.Calls(), full.Calls())
+	}
+	for _, n := range nodes {
+		if n.Partial == (n.Role == "AXButton") {
+			t.Errorf("node %d (%s): Partial = %v", n.ID, n.Role, n.Partial)
+		}
+	}
+}
+
+func TestWalkTwoPhase_TextFallbackForSurvivors(t *testing.T) {
+	src, roots := NewMemSource(formTree())
+	nodes, _ := Walk(src, roots, Options{Roles: []string{"input"}})
+	last := nodes[len(nodes)-1]
+	if last.Role != "AXTextArea" || last.Value != "notes" {
+		t.Errorf("text area = %s %q, want text fallback value", last.Role, last.Value)
+	}
+}
+
+func TestWalkTwoPhase_CanceledReturnsDetailedPrefix(t *testing.T) {
+	roles := []string{"txt"} // 100 survivors: two detail batches
+	mem, roots := NewMemSource(formTree())
+	full, _ := Walk(mem, roots, Options{Roles: roles})
+
+	for _, n := range []int{30, len(full) + 1} { // during the skeleton, during the details
+		mem, roots := NewMemSource(formTree())
+		src, done := cancelAfter(mem, n)
+		nodes, err := Walk(src, roots, Options{Roles: roles, Done: done, Parallelism: 1})
+		if err != ErrCanceled {
+			t.Fatalf("cancel after %d calls: err = %v, want ErrCanceled", n, err)
+		}
+		if len(nodes) >= len(full) || !reflect.DeepEqual(nodes, full[:len(nodes)]) {
+			t.Errorf("cancel after %d calls: got %d nodes, want a proper prefix of the %d-node read", n, len(nodes), len(full))
+		}
+		if mem.Live() != 0 {
+			t.Errorf("cancel after %d calls: %d handles not released", n, mem.Live())
+		}
+	}
+}
@@ -0,0 +1,144 @@
+// Package keystroke compiles text into batches of synthetic keyboard events.
+//
+// Platform inputters supply a KeyMap from characters to their virtual key
+// codes; keystroke decides which characters are typed as real key presses
+// and which are coalesced into multi-character Unicode string events, groups
+// key presses that share the same modifiers, and paces the batches. The
+// inputter then only posts what the Plan says, so typing can be tested and
+// benchmarked on any OS.
+package keystroke
+
+import (
+	"time"
+	"unicode"
+)
+
+const (
+	// MaxStringUnits is the most UTF-16 code units a single Unicode string
+	// event carries (the limit of CGEventKeyboardSetUnicodeString).
+	MaxStringUnits = 20
+
+	// CoalesceMin is the length in characters from which text is coalesced
+	// into string events. Shorter text — URLs, search terms, shortcuts typed
+	// as text — is typed key by key with real key codes, which apps such as
+	// Chrome's omnibox inspect; the time saved on it would be small anyway.
+	CoalesceMin = 32
+
+	// MaxBatchKeys is the most key presses posted back to back before
+	// pausing, so that the target app's event queue can drain.
+	MaxBatchKeys = 16
+
+	// KeyPause is the pause per key press after a batch of key presses.
+	KeyPause = time.Millisecond
+
+	// StringPause is the pause after a string event. Apps insert its text in
+	// one go, so it costs about as much as a single key press.
+	StringPause = 5 * time.Millisecond
+)
+
+// Key is a virtual key and whether Shift must be held to type a character
+// with it.
+type Key struct {
+	Code  uint16
+	Shift bool
+}
+
+// KeyMap returns the key that types r on the current keyboard layout, or
+// false if there is none.
+type KeyMap func(r rune) (Key, bool)
+
+// Event is one key-down/key-up pair that types Text. Key presses carry the
+// character's virtual key code; string events carry up to MaxStringUnits
+// UTF-16 code units of text and key code 0, which apps ignore in favour of
+// the text.
+type Event struct {
+	Code uint16
+	Text string
+}
+
+// Batch is a run of events posted back to back with the same modifier
+// state, followed by a pause.
+type Batch struct {
+	Events []Event
+	Shift  bool
+	Pause  time.Duration
+}
+
+// Plan is the batches that type a text, in order.
+type Plan []Batch
+
+// Options controls how text is compiled.
+type Options struct {
+	// Delay, if positive, types every character as its own key press and
+	// pauses this long after each (the pacing callers ask for with --delay).
+	Delay time.Duration
+}
+
+// Compile returns the plan that types text. Characters keys does not map
+// are typed with key code 0 and their text, like string events.
+//
+// Text of at least CoalesceMin characters is sent as string events of up to
+// MaxStringUnits code units, except for control characters (newline, tab),
+// which are typed as key presses so that they act like the keys they stand
+// for. Otherwise consecutive key presses with the same Shift state are
+// grouped into batches of up to MaxBatchKeys.
+func Compile(text string, keys KeyMap, opts Options) Plan {
+	runes := []rune(text)
+	coalesce := opts.Delay <= 0 && len(runes) >= CoalesceMin
+
+	var plan Plan
+	var units int // UTF-16 length of the open string event, 0 if none is open
+	for _, r := range runes {
+		if coalesce && !unicode.IsControl(r) {
+			n := 1
+			if r > 0xFFFF && r <= unicode.MaxRune {
+				n = 2 // surrogate pair
+			}
+			if units == 0 || units+n > MaxStringUnits {
+				plan = append(plan, Batch{Events: []Event{{}}, Pause: StringPause})
+				units = 0
+			}
+			last := &plan[len(plan)-1]
+			last.Events[0].Text += string(r)
+			units += n
+			continue
+		}
+
+		key, _ := keys(r)
+		ev := Event{Code: key.Code, Text: string(r)}
+		var last *Batch
+		if len(plan) > 0 {
+			last = &plan[len(plan)-1]
+		}
+		if opts.Delay > 0 || last == nil || units > 0 || last.Shift != key.Shift || len(last.Events) >= MaxBatchKeys {
+			plan = append(plan, Batch{Shift: key.Shift})
+			last = &plan[len(plan)-1]
+		}
+		units = 0
+		last.Events = append(last.Events, ev)
+		if opts.Delay > 0 {
+			last.Pause = opts.Delay
+		} else {
+			last.Pause = time.Duration(len(last.Events)) * KeyPause
+		}
+	}
+	return plan
+}
+
+// Events returns the number of events in the plan.
+func (p Plan) Events() int {
+	n := 0
+	for _, b := range p {
+		n += len(b.Events)
+	}
+	return n
+}
+
+// Pause returns the total time the plan spends pausing between batches.
+func (p Plan) Pause() time.Duration {
+	var d time.Duration
+	for _, b := range p {
+		d += b.Pause
+	}
+	return d
+}
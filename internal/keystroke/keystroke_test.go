@@ -0,0 +1,114 @@
+package keystroke
+
+import (
+	"fmt"
+	"reflect"
+	"strings"
+	"testing"
+	"time"
+	"unicode/utf16"
+)
+
+// usKeys maps a few characters like a US layout would.
+func usKeys(r rune) (Key, bool) {
+	switch {
+	case r >= 'a' && r <= 'z':
+		return Key{Code: uint16(r - 'a' + 1)}, true
+	case r >= 'A' && r <= 'Z':
+		return Key{Code: uint16(r - 'A' + 1), Shift: true}, true
+	case r == ' ':
+		return Key{Code: 0x31}, true
+	case r == '\n':
+		return Key{Code: 0x24}, true
+	case r == '!':
+		return Key{Code: 0x12, Shift: true}, true
+	}
+	return Key{}, false
+}
+
+// typed returns the text a plan types.
+func typed(p Plan) string {
+	var sb strings.Builder
+	for _, b := range p {
+		for _, ev := range b.Events {
+			sb.WriteString(ev.Text)
+		}
+	}
+	return sb.String()
+}
+
+func TestCompile_ShortTextKeyByKey(t *testing.T) {
+	p := Compile("Hi there!", usKeys, Options{})
+	want := Plan{
+		{Events: []Event{{Code: 8, Text: "H"}}, Shift: true, Pause: KeyPause},
+		{Events: []Event{{Code: 9, Text: "i"}, {Code: 0x31, Text: " "}, {Code: 20, Text: "t"}, {Code: 8, Text: "h"}, {Code: 5, Text: "e"}, {Code: 18, Text: "r"}, {Code: 5, Text: "e"}}, Pause: 7 * KeyPause},
+		{Events: []Event{{Code: 0x12, Text: "!"}}, Shift: true, Pause: KeyPause},
+	}
+	if !reflect.DeepEqual(p, want) {
+		t.Errorf("plan = %+v\nwant %+v", p, want)
+	}
+}
+
+func TestCompile_BatchesAreBounded(t *testing.T) {
+	p := Compile(strings.Repeat("a", CoalesceMin-1), usKeys, Options{})
+	if len(p) != 2 || len(p[0].Events) != MaxBatchKeys || p.Events() != CoalesceMin-1 {
+		t.Errorf("%d batches of %d events, want batches of at most %d", len(p), p.Events(), MaxBatchKeys)
+	}
+}
+
+func TestCompile_Delay(t *testing.T) {
+	p := Compile(strings.Repeat("ab", 40), usKeys, Options{Delay: 20 * time.Millisecond})
+	if len(p) != 80 || p.Pause() != 80*20*time.Millisecond {
+		t.Errorf("%d batches pausing %v, want one key per batch paced by the delay", len(p), p.Pause())
+	}
+}
+
+func TestCompile_LongTextCoalesced(t *testing.T) {
+	text := strings.Repeat("The quick brown fox — jumps 🦊. ", 4) + "\nDone\tnow"
+	p := Compile(text, usKeys, Options{})
+	if got := typed(p); got != text {
+		t.Fatalf("plan types %q, want %q", got, text)
+	}
+	for i, b := range p {
+		for _, ev := range b.Events {
+			units := len(utf16.Encode([]rune(ev.Text)))
+			switch {
+			case ev.Text == "\n":
+				if ev.Code != 0x24 {
+					t.Errorf("batch %d: newline typed with key %#x, want Return", i, ev.Code)
+				}
+			case ev.Text == "\t":
+				if len(b.Events) != 1 {
+					t.Errorf("batch %d: tab shares a batch", i)
+				}
+			case units > MaxStringUnits || ev.Code != 0:
+				t.Errorf("batch %d: string event %q has %d units, key %#x", i, ev.Text, units, ev.Code)
+			}
+		}
+	}
+	if p.Events() > len(text)/10 {
+		t.Errorf("%d events for %d characters", p.Events(), len([]rune(text)))
+	}
+}
+
+func TestCompile_LongTextIsFast(t *testing.T) {
+	p := Compile(strings.Repeat("lorem ipsum ", 84), usKeys, Options{})
+	// One key press per character with a 5ms minimum pause used to take
+	// over 5 seconds for this text.
+	if p.Pause() > 300*time.Millisecond {
+		t.Errorf("1000 characters pause for %v", p.Pause())
+	}
+}
+
+func BenchmarkCompile(b *testing.B) {
+	for _, n := range []int{16, 1000} {
+		text := strings.Repeat("Hello world!\n", n/13+1)[:n]
+		b.Run(fmt.Sprintf("chars=%d", n), func(b *testing.B) {
+			var events int
+			for i := 0; i < b.N; i++ {
+				events = Compile(text, usKeys, Options{}).Events()
+			}
+			b.ReportMetric(float64(events), "events")
+		})
+	}
+}
@@ -27,7 +27,8 @@ type UIChange struct {
 }
 
 // DiffElements compares two flat element lists and returns the changes.
-// Elements are matched by their ID (sequential traversal index).
+// Elements are matched by their ID (sequential traversal index, or a
+// persistent ID when the reads were assigned through an IdentityTracker).
 func DiffElements(prev, curr []FlatElement) []UIChange {
 	prevMap := make(map[int]FlatElement, len(prev))
 	for _, el := range prev {
@@ -1,8 +1,14 @@
 package model
 
+import (
+	"fmt"
+	"strconv"
+	"strings"
+)
+
 // Element represents a UI element in the accessibility tree.
 type Element struct {
-	ID          int       `yaml:"i"            json:"i"`            // Sequential integer ID
+	ID          int       `yaml:"i,omitempty"   json:"i,omitempty"`            // Sequential integer ID; 0 (omitted) when a partial read cannot tell which ID a full read gives the element
 	Role        string    `yaml:"r"            json:"r"`            // Abbreviated role code
 	Subrole     string    `yaml:"sr,omitempty" json:"sr,omitempty"` // macOS AXSubrole (e.g. "AXDialog", "AXSheet")
 	Title       string    `yaml:"t,omitempty"  json:"t,omitempty"`  // Visible label / title
@@ -15,4 +21,42 @@ type Element struct {
 	Children    []Element `yaml:"c,omitempty"  json:"c,omitempty"`  // Child elements
 	Actions     []string  `yaml:"a,omitempty"  json:"a,omitempty"`  // Available actions
 	Ref         string    `yaml:"ref,omitempty" json:"ref,omitempty"` // Stable path-based reference
+	TextLength  int       `yaml:"tl,omitempty" json:"tl,omitempty"` // Full text length when Value holds only part of the text content (see read-text)
+	More        int       `yaml:"more,omitempty" json:"more,omitempty"` // Number of children a budgeted read did not reach (see read --budget-ms)
+	Expand      string    `yaml:"expand,omitempty" json:"expand,omitempty"` // With More, or without ID: the --scope-path that reads those children, or the element with its ID
+	Index       int       `yaml:"-"            json:"-"`            // Reader traversal index when ID has been remapped (see IdentityTracker)
+	Path        []int     `yaml:"-"            json:"-"`            // Child-index path: window index within the read scope, then AXChildren indices (see platform.ActionOptions)
+}
+
+// TraversalIndex returns the element's index in the reader's pre-order
+// traversal, which is what platform action lookups expect. It differs from
+// ID only after IDs have been made persistent by an IdentityTracker.
+func (e Element) TraversalIndex() int {
+	if e.Index != 0 {
+		return e.Index
+	}
+	return e.ID
+}
+
+// FormatPath renders a child-index path as dot-separated indices
+// (e.g. "0.3.1"), the form --scope-path accepts.
+func FormatPath(path []int) string {
+	parts := make([]string, len(path))
+	for i, p := range path {
+		parts[i] = strconv.Itoa(p)
+	}
+	return strings.Join(parts, ".")
+}
+
+// ParsePath parses a path written by FormatPath.
+func ParsePath(s string) ([]int, error) {
+	var path []int
+	for _, part := range strings.Split(s, ".") {
+		p, err := strconv.Atoi(strings.TrimSpace(part))
+		if err != nil || p < 0 {
+			return nil, fmt.Errorf("invalid path %q: expected dot-separated child indices like 0.3.1", s)
+		}
+		path = append(path, p)
+	}
+	return path, nil
 }
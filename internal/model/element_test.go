@@ -212,3 +212,20 @@ func TestElement_RoundTrip(t *testing.T) {
 		t.Errorf("Actions: got %d, want 2", len(decoded.Actions))
 	}
 }
+
+func TestParsePath_RoundTrip(t *testing.T) {
+	path := []int{0, 3, 12}
+	s := FormatPath(path)
+	if s != "0.3.12" {
+		t.Fatalf("FormatPath = %q, want 0.3.12", s)
+	}
+	got, err := ParsePath(s)
+	if err != nil || len(got) != 3 || got[0] != 0 || got[1] != 3 || got[2] != 12 {
+		t.Errorf("ParsePath(%q) = %v, %v", s, got, err)
+	}
+	for _, bad := range []string{"", "0..1", "0.-1", "a.b"} {
+		if _, err := ParsePath(bad); err == nil {
+			t.Errorf("ParsePath(%q) accepted", bad)
+		}
+	}
+}
@@ -2,7 +2,7 @@ package model
 
 // FlatElement is an element with a path breadcrumb instead of children.
 type FlatElement struct {
-	ID          int      `yaml:"i"            json:"i"`
+	ID          int      `yaml:"i,omitempty"   json:"i,omitempty"`
 	Role        string   `yaml:"r"            json:"r"`
 	Subrole     string   `yaml:"sr,omitempty" json:"sr,omitempty"`
 	Title       string   `yaml:"t,omitempty"  json:"t,omitempty"`
@@ -15,6 +15,9 @@ type FlatElement struct {
 	Actions     []string `yaml:"a,omitempty"  json:"a,omitempty"`
 	Ref         string   `yaml:"ref,omitempty" json:"ref,omitempty"`
 	Path        string   `yaml:"p,omitempty"  json:"p,omitempty"`
+	TextLength  int      `yaml:"tl,omitempty" json:"tl,omitempty"`
+	More        int      `yaml:"more,omitempty" json:"more,omitempty"`
+	Expand      string   `yaml:"expand,omitempty" json:"expand,omitempty"`
 }
 
 // FlattenElements converts a tree of elements into a flat list.
@@ -48,6 +51,9 @@ func flattenRecursive(el Element, parentPath string, result *[]FlatElement) {
 		Actions:     el.Actions,
 		Ref:         el.Ref,
 		Path:        currentPath,
+		TextLength:  el.TextLength,
+		More:        el.More,
+		Expand:      el.Expand,
 	}
 	*result = append(*result, flat)
 
@@ -0,0 +1,228 @@
+package model
+
+import "strings"
+
+// identityProximity is the maximum bounds distance (in pixels, summed over
+// center offset and size change) at which an element whose path changed is
+// still considered the same element as a previous one with identical content.
+const identityProximity = 60
+
+// identityNudge is the maximum bounds distance at which an element whose
+// content changed (e.g. a button retitled from "Play" to "Pause") is still
+// considered the same element, provided its role and path are unchanged.
+const identityNudge = 4
+
+// IdentityTracker assigns persistent element IDs across successive reads of
+// the same scope. Readers number elements by traversal index, so a single
+// element inserted near the top of the tree renumbers everything after it;
+// the tracker instead matches each new read against the previous one by
+// content hash, role path, parent identity and bounds proximity, and keeps
+// the ID of every element it can match. Unmatched elements get fresh IDs
+// that are never reused.
+//
+// The reader's traversal index is preserved in Element.Index so that
+// platform action lookups (which walk the tree by index) keep working.
+type IdentityTracker struct {
+	prev   []trackedElement
+	nextID *int // the next fresh ID, possibly shared with other trackers
+}
+
+// trackedElement is the identity-relevant state of one element from the
+// previous read.
+type trackedElement struct {
+	id       int
+	parentID int
+	content  string // role|subrole|title|description (value excluded: it changes)
+	path     string // role breadcrumb from the root
+	role     string
+	bounds   [4]int
+	matched  bool
+}
+
+// NewIdentityTracker creates an empty tracker. The first read assigned
+// through it keeps IDs equal to traversal indices.
+func NewIdentityTracker() *IdentityTracker {
+	return NewIdentityTrackerSharing(new(int))
+}
+
+// NewIdentityTrackerSharing creates an empty tracker that takes fresh IDs
+// from *next, which other trackers may share, so that no two of them ever
+// assign the same ID. Only the first read assigned through any of them
+// keeps IDs equal to traversal indices.
+func NewIdentityTrackerSharing(next *int) *IdentityTracker {
+	if *next < 1 {
+		*next = 1
+	}
+	return &IdentityTracker{nextID: next}
+}
+
+// Assign rewrites element IDs in place with persistent identities and
+// records each element's traversal index in Element.Index.
+func (t *IdentityTracker) Assign(elements []Element) {
+	byKey := make(map[string][]int, len(t.prev))
+	byContent := make(map[string][]int, len(t.prev))
+	byPath := make(map[string][]int, len(t.prev))
+	for i := range t.prev {
+		t.prev[i].matched = false
+		p := &t.prev[i]
+		byKey[p.content+"\x00"+p.path] = append(byKey[p.content+"\x00"+p.path], i)
+		byContent[p.content] = append(byContent[p.content], i)
+		byPath[p.role+"\x00"+p.path] = append(byPath[p.role+"\x00"+p.path], i)
+	}
+
+	// On the first read, identities start from the traversal indices so
+	// IDs match what a plain read would have returned.
+	first := *t.nextID == 1
+	if first {
+		maxID := 0
+		walkElements(elements, func(el *Element) {
+			if el.TraversalIndex() > maxID {
+				maxID = el.TraversalIndex()
+			}
+		})
+		if maxID >= *t.nextID {
+			*t.nextID = maxID + 1
+		}
+	}
+
+	// Flatten in pre-order so matching can run in two passes: exact matches
+	// first, so that a newly inserted element never takes the identity of an
+	// existing element through one of the looser fallbacks.
+	type node struct {
+		el      *Element
+		parent  int // index into nodes, -1 for roots
+		content string
+		path    string
+	}
+	var nodes []node
+	var flatten func(elements []Element, parent int, parentPath string)
+	flatten = func(elements []Element, parent int, parentPath string) {
+		for i := range elements {
+			el := &elements[i]
+			if el.Index == 0 {
+				el.Index = el.ID
+			}
+			path := el.Role
+			if parentPath != "" {
+				path = parentPath + " > " + el.Role
+			}
+			nodes = append(nodes, node{el: el, parent: parent, content: identityContent(*el), path: path})
+			flatten(el.Children, len(nodes)-1, path)
+		}
+	}
+	flatten(elements, -1, "")
+
+	ids := make([]int, len(nodes))
+	parentID := func(n node) int {
+		if n.parent < 0 {
+			return 0
+		}
+		return ids[n.parent]
+	}
+
+	if first {
+		for i, n := range nodes {
+			ids[i] = n.el.Index
+		}
+	} else {
+		for i, n := range nodes {
+			if m := t.bestMatch(byKey[n.content+"\x00"+n.path], parentID(n), n.el.Bounds, -1); m >= 0 {
+				ids[i] = t.claim(m)
+			}
+		}
+		for i, n := range nodes {
+			if ids[i] != 0 {
+				continue
+			}
+			if bestLabel(*n.el) != "" {
+				// Same labeled content under a different path (e.g. a wrapper
+				// group was inserted): accept only if it barely moved.
+				if m := t.bestMatch(byContent[n.content], parentID(n), n.el.Bounds, identityProximity); m >= 0 {
+					ids[i] = t.claim(m)
+					continue
+				}
+			}
+			// Same role and path at (almost) the same place: the element's
+			// own content changed, not its identity.
+			if m := t.bestMatch(byPath[n.el.Role+"\x00"+n.path], parentID(n), n.el.Bounds, identityNudge); m >= 0 {
+				ids[i] = t.claim(m)
+			}
+		}
+	}
+
+	next := make([]trackedElement, len(nodes))
+	for i, n := range nodes {
+		if ids[i] == 0 {
+			ids[i] = *t.nextID
+			*t.nextID++
+		}
+		n.el.ID = ids[i]
+		next[i] = trackedElement{
+			id:       ids[i],
+			parentID: parentID(n),
+			content:  n.content,
+			path:     n.path,
+			role:     n.el.Role,
+			bounds:   n.el.Bounds,
+		}
+	}
+	t.prev = next
+}
+
+// bestMatch picks the unmatched candidate closest to the given bounds,
+// preferring candidates under the same parent. maxDist < 0 means unbounded.
+// Returns -1 if no candidate qualifies.
+func (t *IdentityTracker) bestMatch(candidates []int, parentID int, bounds [4]int, maxDist int) int {
+	best, bestCost := -1, 0
+	for _, c := range candidates {
+		p := &t.prev[c]
+		if p.matched {
+			continue
+		}
+		dist := boundsDistance(p.bounds, bounds)
+		if maxDist >= 0 && dist > maxDist {
+			continue
+		}
+		cost := dist
+		if p.parentID != parentID {
+			cost += 1 << 20
+		}
+		if best < 0 || cost < bestCost {
+			best, bestCost = c, cost
+		}
+	}
+	return best
+}
+
+// claim marks a previous element as matched and returns its ID.
+func (t *IdentityTracker) claim(i int) int {
+	t.prev[i].matched = true
+	return t.prev[i].id
+}
+
+// identityContent returns the identity-relevant content of an element.
+func identityContent(el Element) string {
+	return strings.Join([]string{el.Role, el.Subrole, el.Title, el.Description}, "|")
+}
+
+// boundsDistance is the Manhattan distance between two rectangles' centers
+// plus the change in their sizes.
+func boundsDistance(a, b [4]int) int {
+	d := abs((a[0]+a[2]/2)-(b[0]+b[2]/2)) + abs((a[1]+a[3]/2)-(b[1]+b[3]/2))
+	return d + abs(a[2]-b[2]) + abs(a[3]-b[3])
+}
+
+func abs(n int) int {
+	if n < 0 {
+		return -n
+	}
+	return n
+}
+
+// walkElements calls fn for every element in the tree in pre-order.
+func walkElements(elements []Element, fn func(el *Element)) {
+	for i := range elements {
+		fn(&elements[i])
+		walkElements(elements[i].Children, fn)
+	}
+}
@@ -0,0 +1,165 @@
+package model
+
+import "testing"
+
+// identityTree builds a window with a toolbar and a list of rows, numbering
+// IDs in pre-order like the platform readers do.
+func identityTree(rows ...string) []Element {
+	list := Element{Role: "list", Bounds: [4]int{0, 40, 400, 400}}
+	for i, title := range rows {
+		list.Children = append(list.Children, Element{
+			Role: "row", Title: title, Bounds: [4]int{0, 40 + i*20, 400, 20},
+		})
+	}
+	win := []Element{{
+		Role: "window", Title: "Mail", Bounds: [4]int{0, 0, 400, 440},
+		Children: []Element{
+			{Role: "toolbar", Bounds: [4]int{0, 0, 400, 40}, Children: []Element{
+				{Role: "btn", Title: "Reply", Bounds: [4]int{0, 0, 60, 40}},
+			}},
+			list,
+		},
+	}}
+	n := 0
+	walkElements(win, func(el *Element) {
+		n++
+		el.ID = n
+	})
+	return win
+}
+
+func idsByTitle(elements []Element) map[string]int {
+	m := make(map[string]int)
+	walkElements(elements, func(el *Element) {
+		if el.Title != "" {
+			m[el.Title] = el.ID
+		}
+	})
+	return m
+}
+
+func TestIdentityTracker_FirstReadKeepsIndexes(t *testing.T) {
+	tr := NewIdentityTracker()
+	els := identityTree("a", "b")
+	tr.Assign(els)
+	walkElements(els, func(el *Element) {
+		if el.ID != el.Index {
+			t.Errorf("first read: ID %d != traversal index %d", el.ID, el.Index)
+		}
+	})
+}
+
+func TestIdentityTracker_InsertionKeepsLaterIDs(t *testing.T) {
+	tr := NewIdentityTracker()
+	first := identityTree("a", "b", "c")
+	tr.Assign(first)
+	before := idsByTitle(first)
+
+	// A new row at the top shifts every later traversal index and bounds.
+	second := identityTree("new", "a", "b", "c")
+	tr.Assign(second)
+	after := idsByTitle(second)
+
+	for _, title := range []string{"Mail", "Reply", "a", "b", "c"} {
+		if before[title] != after[title] {
+			t.Errorf("%q: ID changed from %d to %d", title, before[title], after[title])
+		}
+	}
+	for title, id := range before {
+		if after["new"] == id {
+			t.Errorf("new row reused ID %d of %q", id, title)
+		}
+	}
+
+	var rowA Element
+	walkElements(second, func(el *Element) {
+		if el.Title == "a" {
+			rowA = *el
+		}
+	})
+	if rowA.TraversalIndex() != 6 {
+		t.Errorf("row a traversal index = %d, want 6", rowA.TraversalIndex())
+	}
+}
+
+func TestIdentityTracker_DiffReportsSingleAddition(t *testing.T) {
+	tr := NewIdentityTracker()
+	first := identityTree("a", "b", "c")
+	tr.Assign(first)
+	second := identityTree("new", "a", "b", "c")
+	tr.Assign(second)
+
+	changes := DiffElements(FlattenElements(first), FlattenElements(second))
+	var added, removed int
+	for _, c := range changes {
+		switch c.Type {
+		case ChangeAdded:
+			added++
+		case ChangeRemoved:
+			removed++
+		}
+	}
+	if added != 1 || removed != 0 {
+		t.Errorf("expected 1 added, 0 removed; got %d added, %d removed (%+v)", added, removed, changes)
+	}
+}
+
+func TestIdentityTracker_RemovalDoesNotReuseIDs(t *testing.T) {
+	tr := NewIdentityTracker()
+	first := identityTree("a", "b", "c")
+	tr.Assign(first)
+	removedID := idsByTitle(first)["a"]
+
+	tr.Assign(identityTree("b", "c"))
+	third := identityTree("z", "b", "c")
+	tr.Assign(third)
+	if idsByTitle(third)["z"] == removedID {
+		t.Errorf("removed element's ID %d was reused", removedID)
+	}
+}
+
+func TestIdentityTracker_RetitledInPlaceKeepsID(t *testing.T) {
+	tr := NewIdentityTracker()
+	first := identityTree("Play")
+	tr.Assign(first)
+	second := identityTree("Pause")
+	tr.Assign(second)
+	if idsByTitle(first)["Play"] != idsByTitle(second)["Pause"] {
+		t.Error("retitled element at the same position should keep its ID")
+	}
+}
+
+func TestIdentityTracker_DuplicatesMatchedOnce(t *testing.T) {
+	tr := NewIdentityTracker()
+	first := identityTree("x", "x")
+	tr.Assign(first)
+	second := identityTree("x", "x", "x")
+	tr.Assign(second)
+
+	seen := make(map[int]bool)
+	walkElements(second, func(el *Element) {
+		if seen[el.ID] {
+			t.Errorf("duplicate ID %d", el.ID)
+		}
+		seen[el.ID] = true
+	})
+	rows := second[0].Children[1].Children
+	if rows[0].ID != first[0].Children[1].Children[0].ID || rows[1].ID != first[0].Children[1].Children[1].ID {
+		t.Error("identical rows should keep their IDs by position")
+	}
+}
+
+func TestIdentityTracker_SharedCounterKeepsIDsDisjoint(t *testing.T) {
+	next := new(int)
+	a, b := NewIdentityTrackerSharing(next), NewIdentityTrackerSharing(next)
+	first, second := identityTree("a"), identityTree("a")
+	a.Assign(first)
+	b.Assign(second)
+	seen := make(map[int]bool)
+	walkElements(first, func(el *Element) { seen[el.ID] = true })
+	walkElements(second, func(el *Element) {
+		if seen[el.ID] {
+			t.Errorf("ID %d assigned by both trackers", el.ID)
+		}
+	})
+}
@@ -56,6 +56,7 @@ type ReadResult struct {
 	Window        string          `yaml:"window,omitempty"         json:"window,omitempty"`
 	SmartDefaults string          `yaml:"smart_defaults,omitempty" json:"smart_defaults,omitempty"`
 	TS            int64           `yaml:"ts"                       json:"ts"`
+	Truncated     bool            `yaml:"truncated,omitempty"      json:"truncated,omitempty"`
 	Elements      []model.Element `yaml:"elements"                 json:"elements"`
 }
 
@@ -66,9 +67,14 @@ type ReadFlatResult struct {
 	Window        string              `yaml:"window,omitempty"         json:"window,omitempty"`
 	SmartDefaults string              `yaml:"smart_defaults,omitempty" json:"smart_defaults,omitempty"`
 	TS            int64               `yaml:"ts"                       json:"ts"`
+	Truncated     bool                `yaml:"truncated,omitempty"      json:"truncated,omitempty"`
 	Elements      []model.FlatElement `yaml:"elements"                 json:"elements"`
 }
 
+// TruncatedNote ends agent-format reads whose tree was cut short because
+// time ran out (Truncated in ReadResult and ReadFlatResult).
+const TruncatedNote = "\n# ... truncated: time ran out before the whole tree was read. Narrow the read with window/depth, allow more time, or read an element marked expand=PATH by passing PATH as scope-path (--scope-path on the command line).\n"
+
 // ReadDiffResult is the output when --since is used, returning only changes.
 type ReadDiffResult struct {
 	App           string         `yaml:"app,omitempty"            json:"app,omitempty"`
@@ -150,9 +156,17 @@ func PrintYAML(v interface{}) error {
 func PrintAgent(v interface{}) error {
 	switch result := v.(type) {
 	case ReadResult:
-		return printAgentTree(result.App, result.PID, result.Window, result.Elements)
+		if err := printAgentTree(result.App, result.PID, result.Window, result.Elements); err != nil || !result.Truncated {
+			return err
+		}
+		_, err := os.Stdout.WriteString(TruncatedNote)
+		return err
 	case ReadFlatResult:
-		return printAgentFlat(result.App, result.PID, result.Window, result.Elements)
+		if err := printAgentFlat(result.App, result.PID, result.Window, result.Elements); err != nil || !result.Truncated {
+			return err
+		}
+		_, err := os.Stdout.WriteString(TruncatedNote)
+		return err
 	case ReadDiffResult:
 		return printAgentDiff(result)
 	default:
@@ -209,12 +223,7 @@ func formatAgentStringWithMax(app string, pid int, window string, elements []mod
 	count := 0
 	totalVisible := 0
 	for _, el := range elements {
-		if el.Bounds[2] <= 0 || el.Bounds[3] <= 0 {
-			continue
-		}
-		isInteractive := hasAction(el.Actions, "press")
-		isDisplayText := el.Role == "txt" && el.Value != ""
-		if !isInteractive && !isDisplayText {
+		if !agentVisible(el) {
 			continue
 		}
 		totalVisible++
@@ -232,6 +241,101 @@ func formatAgentStringWithMax(app string, pid int, window string, elements []mod
 	return buf.String()
 }
 
+// agentVisible reports whether agent format lists el: interactive elements
+// and display text with a non-empty size.
+func agentVisible(el model.FlatElement) bool {
+	if el.Bounds[2] <= 0 || el.Bounds[3] <= 0 {
+		return false
+	}
+	isInteractive := hasAction(el.Actions, "press")
+	isDisplayText := el.Role == "txt" && el.Value != ""
+	// Containers a budgeted read did not expand are kept so that they
+	// can be expanded (their content may be interactive).
+	return isInteractive || isDisplayText || el.More != 0
+}
+
+// AgentDiffMaxChanges is the most changed elements FormatAgentDiff lists;
+// beyond that the full state is more useful than the diff.
+const AgentDiffMaxChanges = 40
+
+// FormatAgentDiff formats what changed in a window between two reads, pre
+// (before an action) and post (after it), in agent format: the elements
+// agent format would list that were added (+), removed (-) or changed (~),
+// and where focus moved. Elements are matched by role, title, description
+// and role path (see model.DiffElementsByHash); changed elements are shown
+// as they are now.
+//
+// ok is false when the change is too large for a diff to help — the window
+// itself changed, or more than AgentDiffMaxChanges elements or half of the
+// listed ones changed — and the full state should be shown instead.
+func FormatAgentDiff(app string, pid int, window string, pre, post []model.Element) (string, bool) {
+	model.GenerateRefs(post)
+	preAll := model.FlattenElements(pre)
+	postAll := model.FlattenElements(post)
+
+	if agentHeader(app, pid, window, preAll) != agentHeader(app, pid, window, postAll) {
+		return "", false // navigated or switched windows
+	}
+	visible := func(elements []model.FlatElement) []model.FlatElement {
+		var out []model.FlatElement
+		for _, el := range elements {
+			if agentVisible(el) {
+				out = append(out, el)
+			}
+		}
+		return out
+	}
+	preFlat, postFlat := visible(preAll), visible(postAll)
+	diff := model.DiffElementsByHash(preFlat, postFlat)
+	n := len(diff.Added) + len(diff.Removed) + len(diff.Changed)
+	if n > AgentDiffMaxChanges || 2*n > len(postFlat) {
+		return "", false
+	}
+
+	var buf bytes.Buffer
+	header := agentHeader(app, pid, window, postAll)
+	if header != "" {
+		header += " — "
+	}
+	fmt.Fprintf(&buf, "# %schanges: %d added, %d removed, %d changed, %d unchanged\n",
+		header, len(diff.Added), len(diff.Removed), len(diff.Changed), diff.UnchangedCount)
+	for _, el := range diff.Added {
+		fmt.Fprintf(&buf, "+ %s\n", formatAgentLine(el))
+	}
+	for _, el := range diff.Removed {
+		fmt.Fprintf(&buf, "- %s\n", formatAgentLine(el))
+	}
+	byID := make(map[int]model.FlatElement, len(postFlat))
+	for _, el := range postFlat {
+		byID[el.ID] = el
+	}
+	for _, ch := range diff.Changed {
+		line := "~ " + formatAgentLine(byID[ch.ID])
+		if v, ok := ch.Changes["v"]; ok {
+			line += fmt.Sprintf(" was=%q", truncate(v[0], 60))
+		}
+		fmt.Fprintln(&buf, line)
+	}
+
+	focused := func(elements []model.FlatElement) *model.FlatElement {
+		var last *model.FlatElement
+		for i := range elements {
+			if elements[i].Focused {
+				last = &elements[i] // the deepest focused element comes last
+			}
+		}
+		return last
+	}
+	preFocus, postFocus := focused(preAll), focused(postAll)
+	switch {
+	case postFocus != nil && (preFocus == nil || model.ElementHash(*preFocus) != model.ElementHash(*postFocus)):
+		fmt.Fprintf(&buf, "# focus: %s\n", formatAgentLine(*postFocus))
+	case postFocus == nil && preFocus != nil:
+		fmt.Fprintln(&buf, "# focus: none")
+	}
+	return buf.String(), true
+}
+
 func agentHeader(app string, pid int, window string, elements []model.FlatElement) string {
 	// Try to get window title from the first window-role element
 	winTitle := window
@@ -274,11 +378,15 @@ func formatAgentLine(el model.FlatElement) string {
 	}
 	label = truncate(label, 80)
 
+	id := "-" // not known from a partial read; see Expand
+	if el.ID != 0 {
+		id = fmt.Sprint(el.ID)
+	}
 	var idPart string
 	if el.Ref != "" {
-		idPart = fmt.Sprintf("[%d|%s]", el.ID, el.Ref)
+		idPart = fmt.Sprintf("[%s|%s]", id, el.Ref)
 	} else {
-		idPart = fmt.Sprintf("[%d]", el.ID)
+		idPart = fmt.Sprintf("[%s]", id)
 	}
 
 	line := fmt.Sprintf("%s %s %q (%d,%d,%d,%d)",
@@ -311,6 +419,15 @@ func formatAgentLine(el model.FlatElement) string {
 			line += fmt.Sprintf(" val=%q", truncate(el.Value, 60))
 		}
 	}
+	if el.TextLength > 0 {
+		line += fmt.Sprintf(" textlen=%d", el.TextLength)
+	}
+	if el.More > 0 {
+		line += fmt.Sprintf(" more=%d", el.More)
+	}
+	if el.Expand != "" {
+		line += " expand=" + el.Expand
+	}
 
 	return line
 }
@@ -2,6 +2,7 @@ package output
 
 import (
 	"bytes"
+	"fmt"
 	"os"
 	"strings"
 	"testing"
@@ -426,3 +427,59 @@ func TestReadResult_OmitEmpty(t *testing.T) {
 		t.Error("ts should always be present")
 	}
 }
+
+// diffWindow returns a window with a few buttons, a checkbox, an input, a
+// status text and the given extra buttons.
+func diffWindow(title, checked string, inputFocused bool, status string, extra ...string) []model.Element {
+	press := []string{"press"}
+	b := [4]int{0, 0, 10, 10}
+	var children []model.Element
+	for i, name := range append([]string{"Reply", "Forward", "Archive", "Delete", "Move", "Label"}, extra...) {
+		children = append(children, model.Element{ID: 10 + i, Role: "btn", Title: name, Bounds: b, Actions: press})
+	}
+	children = append(children,
+		model.Element{ID: 40, Role: "chk", Title: "Remember me", Value: checked, Bounds: b, Actions: press},
+		model.Element{ID: 41, Role: "input", Title: "Email", Focused: inputFocused, Bounds: b, Actions: press},
+		model.Element{ID: 42, Role: "txt", Value: status, Bounds: b},
+	)
+	return []model.Element{{ID: 1, Role: "window", Title: title, Bounds: [4]int{0, 0, 800, 600}, Children: children}}
+}
+
+func TestFormatAgentDiff(t *testing.T) {
+	pre := diffWindow("Inbox", "0", false, "Loading", "Cancel")
+	post := diffWindow("Inbox", "1", true, "Saved", "Undo")
+
+	out, ok := FormatAgentDiff("Mail", 0, "", pre, post)
+	if !ok {
+		t.Fatal("small change reported as too large")
+	}
+	for _, want := range []string{
+		"# Inbox - Mail — changes: 1 added, 1 removed, 3 changed, 6 unchanged\n",
+		`+ [16|undo] btn "Undo"`,
+		`- [16] btn "Cancel"`,
+		`~ [40|remember-me] chk "Remember me" (0,0,10,10) checked was="0"`,
+		`~ [42|txt] txt "Saved" (0,0,10,10) display was="Loading"`,
+		`# focus: [41|email] input "Email" (0,0,10,10) focused`,
+	} {
+		if !strings.Contains(out, want) {
+			t.Errorf("missing %q in:\n%s", want, out)
+		}
+	}
+	if strings.Contains(out, "Reply") {
+		t.Errorf("unchanged elements listed:\n%s", out)
+	}
+}
+
+func TestFormatAgentDiff_LargeChange(t *testing.T) {
+	pre := diffWindow("Inbox", "0", false, "Ready")
+	if _, ok := FormatAgentDiff("Mail", 0, "", pre, diffWindow("Settings", "0", false, "Ready")); ok {
+		t.Error("navigation to another window title diffed")
+	}
+	many := make([]string, 20)
+	for i := range many {
+		many[i] = fmt.Sprintf("Row %d", i)
+	}
+	if _, ok := FormatAgentDiff("Mail", 0, "", pre, diffWindow("Inbox", "0", false, "Ready", many...)); ok {
+		t.Error("20 new elements in a window of 9 diffed")
+	}
+}
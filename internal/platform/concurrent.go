@@ -0,0 +1,155 @@
+package platform
+
+import (
+	"context"
+	"errors"
+	"sync"
+
+	"github.com/mj1618/desktop-cli/internal/model"
+)
+
+// DefaultWindowWorkers is the number of windows WithConcurrentWindows reads
+// at once.
+const DefaultWindowWorkers = 4
+
+// WindowEnumerator is implemented by readers that can list the windows a
+// ReadElements call would traverse.
+type WindowEnumerator interface {
+	// WindowIDs returns the system IDs of the windows ReadElements(opts)
+	// reads, in the order it numbers them. Windows without a system ID are
+	// reported as 0.
+	WindowIDs(opts ReadOptions) ([]int, error)
+}
+
+// WithConcurrentWindows returns a reader that, when a read spans several
+// windows (no --window or --window-id), reads each window with its own
+// ReadElements call, up to workers at a time. The results are merged in
+// window order and renumbered so that every element gets the ID a single
+// sequential read would have given it; action lookups, which walk the
+// windows sequentially, therefore still find the same elements.
+//
+// Readers that do not implement WindowEnumerator are returned unchanged.
+func WithConcurrentWindows(r Reader, workers int) Reader {
+	enum, ok := r.(WindowEnumerator)
+	if !ok || workers <= 1 {
+		return r
+	}
+	return &concurrentReader{Reader: r, enum: enum, workers: workers}
+}
+
+type concurrentReader struct {
+	Reader
+	enum    WindowEnumerator
+	workers int
+}
+
+func (r *concurrentReader) ReadElements(opts ReadOptions) ([]model.Element, error) {
+	return r.ReadElementsContext(context.Background(), opts)
+}
+
+// ReadElementsContext implements ContextReader. When a window's read is
+// truncated, the windows after it are dropped: their IDs would have to
+// follow elements that were never read.
+func (r *concurrentReader) ReadElementsContext(ctx context.Context, opts ReadOptions) ([]model.Element, error) {
+	read := func(o ReadOptions) ([]model.Element, error) { return ReadElementsContext(ctx, r.Reader, o) }
+	// A breadth-first read spreads over every window in one pass, and a
+	// scoped read covers a single subtree. A role-filtered read is left to
+	// the platform's two-phase read, which already fetches the details of
+	// matching elements in parallel; split by window, each window would
+	// have to be read unfiltered so that its elements can be renumbered.
+	if opts.Window != "" || opts.WindowID != 0 || opts.BreadthFirst || len(opts.Scope) > 0 || len(opts.Roles) > 0 {
+		return read(opts)
+	}
+	ids, err := r.enum.WindowIDs(opts)
+	if err != nil || len(ids) < 2 {
+		return read(opts)
+	}
+	for _, id := range ids {
+		if id == 0 {
+			// A window that cannot be addressed on its own.
+			return read(opts)
+		}
+	}
+
+	// A bbox filter changes how many elements each window contributes, so
+	// the per-window reads are unfiltered and filtering happens after
+	// merging.
+	bbox := opts.BBox
+	opts.BBox = nil
+
+	results := make([][]model.Element, len(ids))
+	errs := make([]error, len(ids))
+	next := make(chan int)
+	var wg sync.WaitGroup
+	for w := 0; w < min(r.workers, len(ids)); w++ {
+		wg.Add(1)
+		go func() {
+			defer wg.Done()
+			for i := range next {
+				o := opts
+				o.WindowID = ids[i]
+				results[i], errs[i] = read(o)
+			}
+		}()
+	}
+	for i := range ids {
+		next <- i
+	}
+	close(next)
+	wg.Wait()
+
+	var merged []model.Element
+	var truncated error
+	offset := 0
+	for i, els := range results {
+		if errs[i] != nil && !errors.Is(errs[i], ErrTruncated) {
+			// The window list changed under us (e.g. a window closed);
+			// only a sequential read numbers the remaining windows right.
+			opts.BBox = bbox
+			return read(opts)
+		}
+		offset = renumber(els, offset, i)
+		merged = append(merged, els...)
+		if errs[i] != nil {
+			truncated = errs[i]
+			break
+		}
+	}
+	if merged == nil {
+		merged = []model.Element{}
+	}
+
+	var b *[4]int
+	if bbox != nil {
+		v := [4]int{bbox.X, bbox.Y, bbox.Width, bbox.Height}
+		b = &v
+	}
+	return model.FilterElements(merged, nil, b), truncated
+}
+
+// StreamElements implements StreamReader. A stream is read sequentially,
+// which numbers elements as the merged concurrent read does, so it goes
+// straight to the wrapped reader.
+func (r *concurrentReader) StreamElements(opts ReadOptions, fn func(el model.Element, depth int) bool) error {
+	return StreamElements(r.Reader, opts, fn)
+}
+
+// renumber shifts the IDs of a window's elements (numbered from 1) by
+// offset, rebases their paths on the window's index in the full read, and
+// returns the offset for the next window.
+func renumber(els []model.Element, offset, window int) int {
+	last := offset
+	var walk func([]model.Element)
+	walk = func(els []model.Element) {
+		for i := range els {
+			els[i].ID += offset
+			if len(els[i].Path) > 0 {
+				els[i].Path[0] = window
+			}
+			last = max(last, els[i].ID)
+			walk(els[i].Children)
+		}
+	}
+	walk(els)
+	return last
+}
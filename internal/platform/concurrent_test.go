@@ -0,0 +1,199 @@
+package platform_test
+
+import (
+	"fmt"
+	"reflect"
+	"testing"
+	"time"
+
+	"github.com/mj1618/desktop-cli/internal/model"
+	"github.com/mj1618/desktop-cli/internal/platform"
+	"github.com/mj1618/desktop-cli/internal/platform/fake"
+)
+
+// window builds a window whose tree is a group of n buttons.
+func window(id int, title string, n int) fake.Window {
+	group := model.Element{Role: "group", Title: title}
+	for i := 0; i < n; i++ {
+		group.Children = append(group.Children, model.Element{Role: "btn", Title: fmt.Sprintf("%s %d", title, i)})
+	}
+	return fake.Window{ID: id, Title: title, Elements: []model.Element{group}}
+}
+
+func newFake(latency time.Duration) *fake.Reader {
+	return &fake.Reader{
+		App:     "Mail",
+		PID:     42,
+		Latency: latency,
+		Windows: []fake.Window{
+			window(101, "Inbox", 20),
+			window(102, "Drafts", 5),
+			window(103, "Compose", 12),
+			window(104, "Settings", 8),
+		},
+	}
+}
+
+func TestConcurrentWindows_MatchesSequentialRead(t *testing.T) {
+	for _, opts := range []platform.ReadOptions{
+		{App: "Mail"},
+		{App: "Mail", Depth: 1},
+		{App: "Mail", BBox: &platform.Bounds{X: 0, Y: 0, Width: 10, Height: 10}},
+	} {
+		f := newFake(0)
+		want, err := f.ReadElements(opts)
+		if err != nil {
+			t.Fatal(err)
+		}
+		got, err := platform.WithConcurrentWindows(f, 3).ReadElements(opts)
+		if err != nil {
+			t.Fatal(err)
+		}
+		if !reflect.DeepEqual(got, want) {
+			t.Errorf("%+v: concurrent read differs from sequential read\n got: %+v\nwant: %+v", opts, got, want)
+		}
+		if f.Reads() != 1+len(f.Windows) {
+			t.Errorf("%+v: %d reads, want one per window after the sequential one", opts, f.Reads()-1)
+		}
+	}
+}
+
+func TestConcurrentWindows_IDsResolveInSequentialRead(t *testing.T) {
+	f := newFake(0)
+	merged, err := platform.WithConcurrentWindows(f, 4).ReadElements(platform.ReadOptions{App: "Mail"})
+	if err != nil {
+		t.Fatal(err)
+	}
+	seq, _ := f.ReadElements(platform.ReadOptions{App: "Mail"})
+	byID := make(map[int]string)
+	for _, el := range model.FlattenElements(seq) {
+		byID[el.ID] = el.Title
+	}
+	for _, el := range model.FlattenElements(merged) {
+		if byID[el.ID] != el.Title {
+			t.Errorf("id %d is %q in the merged read but %q sequentially", el.ID, el.Title, byID[el.ID])
+		}
+	}
+}
+
+func TestConcurrentWindows_PathsResolve(t *testing.T) {
+	f := newFake(0)
+	opts := platform.ReadOptions{App: "Mail"}
+	merged, err := platform.WithConcurrentWindows(f, 4).ReadElements(opts)
+	if err != nil {
+		t.Fatal(err)
+	}
+	var check func([]model.Element)
+	check = func(els []model.Element) {
+		for _, el := range els {
+			got, ok := f.Resolve(opts, el.Path)
+			if !ok || got.Title != el.Title {
+				t.Errorf("path %v of %q resolves to %q (ok=%v)", el.Path, el.Title, got.Title, ok)
+			}
+			check(el.Children)
+		}
+	}
+	check(merged)
+}
+
+func TestConcurrentWindows_PassesThroughScopedReads(t *testing.T) {
+	for _, opts := range []platform.ReadOptions{
+		{App: "Mail", Window: "Inbox"},
+		{App: "Mail", WindowID: 103},
+		// Left whole to the platform's two-phase read.
+		{App: "Mail", Roles: []string{"btn"}},
+	} {
+		f := newFake(0)
+		if _, err := platform.WithConcurrentWindows(f, 4).ReadElements(opts); err != nil {
+			t.Fatal(err)
+		}
+		if f.Reads() != 1 {
+			t.Errorf("%+v: %d reads, want 1", opts, f.Reads())
+		}
+	}
+}
+
+func TestConcurrentWindows_FallsBackOnUnaddressableWindow(t *testing.T) {
+	f := newFake(0)
+	f.Windows[2].ID = 0
+	got, err := platform.WithConcurrentWindows(f, 4).ReadElements(platform.ReadOptions{App: "Mail"})
+	if err != nil {
+		t.Fatal(err)
+	}
+	if f.Reads() != 1 {
+		t.Errorf("%d reads, want a single sequential read", f.Reads())
+	}
+	if len(got) != len(f.Windows) {
+		t.Errorf("got %d windows, want %d", len(got), len(f.Windows))
+	}
+}
+
+func TestWithConcurrentWindows_RequiresEnumerator(t *testing.T) {
+	var r platform.Reader = struct{ platform.Reader }{newFake(0)}
+	if platform.WithConcurrentWindows(r, 4) != r {
+		t.Error("reader without WindowIDs was wrapped")
+	}
+	f := newFake(0)
+	if platform.WithConcurrentWindows(f, 1) != platform.Reader(f) {
+		t.Error("reader was wrapped with a single worker")
+	}
+}
+
+func TestConcurrentWindows_IsFasterThanSequential(t *testing.T) {
+	const latency = 200 * time.Microsecond
+	opts := platform.ReadOptions{App: "Mail"}
+
+	f := newFake(latency)
+	start := time.Now()
+	if _, err := f.ReadElements(opts); err != nil {
+		t.Fatal(err)
+	}
+	sequential := time.Since(start)
+
+	r := platform.WithConcurrentWindows(newFake(latency), 4)
+	start = time.Now()
+	if _, err := r.ReadElements(opts); err != nil {
+		t.Fatal(err)
+	}
+	concurrent := time.Since(start)
+
+	// The largest window is 22 of 53 elements, so the ideal is ~0.42x.
+	if concurrent > sequential*3/4 {
+		t.Errorf("concurrent read took %v, sequential %v", concurrent, sequential)
+	}
+}
+
+func BenchmarkReadWindows(b *testing.B) {
+	opts := platform.ReadOptions{App: "Mail"}
+	for _, workers := range []int{1, 2, 4} {
+		r := platform.WithConcurrentWindows(newFake(100*time.Microsecond), workers)
+		b.Run(fmt.Sprintf("workers=%d", workers), func(b *testing.B) {
+			for i := 0; i < b.N; i++ {
+				if _, err := r.ReadElements(opts); err != nil {
+					b.Fatal(err)
+				}
+			}
+		})
+	}
+}
+
+func TestConcurrentWindows_ScopedRead(t *testing.T) {
+	f := newFake(0)
+	opts := platform.ReadOptions{App: "Mail", Scope: []int{2, 0}}
+	got, err := platform.WithConcurrentWindows(f, 3).ReadElements(opts)
+	if err != nil {
+		t.Fatal(err)
+	}
+	if f.Reads() != 1 {
+		t.Errorf("%d reads, want a single read of the scope", f.Reads())
+	}
+	if len(got) != 1 || got[0].Title != "Compose" || len(got[0].Children) != 12 {
+		t.Fatalf("scoped read = %+v, want the Compose group", got)
+	}
+	full, _ := f.ReadElements(platform.ReadOptions{App: "Mail"})
+	want := full[2].Children[0]
+	if got[0].ID != want.ID || got[0].Children[3].ID != want.Children[3].ID || !reflect.DeepEqual(got[0].Children[3].Path, []int{2, 0, 3}) {
+		t.Errorf("scope root has ID %d, child ID %d at %v; want the full read's IDs %d, %d and full paths",
+			got[0].ID, got[0].Children[3].ID, got[0].Children[3].Path, want.ID, want.Children[3].ID)
+	}
+}
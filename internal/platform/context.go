@@ -0,0 +1,360 @@
+package platform
+
+import (
+	"context"
+	"errors"
+	"fmt"
+	"sync"
+	"time"
+
+	"github.com/mj1618/desktop-cli/internal/axtree"
+	"github.com/mj1618/desktop-cli/internal/model"
+)
+
+// ErrTruncated is returned, together with the part of the tree read so far,
+// by reads whose context was done before the whole tree was read (see
+// ContextReader). Callers that can use a partial tree check for it with
+// errors.Is; others treat it like any read error.
+var ErrTruncated = errors.New("read truncated")
+
+// Truncated returns the error a read cut short by ctx reports. It wraps
+// both ErrTruncated and the cause of ctx being done (ctx.Err() unless it
+// was canceled with a cause).
+func Truncated(ctx context.Context) error {
+	return fmt.Errorf("%w: %w", ErrTruncated, context.Cause(ctx))
+}
+
+// ContextReader is implemented by readers that can stop a read when a
+// context is done, so that a hung or very large app cannot block the caller
+// past its deadline.
+type ContextReader interface {
+	// ReadElementsContext reads like ReadElements until ctx is done. It then
+	// stops traversing and returns the elements read so far — the first
+	// elements of the full read in pre-order, with the same IDs and paths,
+	// filtered like ReadElements — together with Truncated(ctx). With
+	// opts.BreadthFirst they are the top levels of the tree instead (see
+	// ReadOptions.BreadthFirst).
+	ReadElementsContext(ctx context.Context, opts ReadOptions) ([]model.Element, error)
+}
+
+// ReadElementsContext reads opts from r, giving up when ctx is done. Readers
+// that implement ContextReader return the part of the tree read by then
+// (see ContextReader); for others the read is abandoned, left to finish in
+// the background, and nothing but Truncated(ctx) is returned.
+func ReadElementsContext(ctx context.Context, r Reader, opts ReadOptions) ([]model.Element, error) {
+	if cr, ok := r.(ContextReader); ok {
+		return cr.ReadElementsContext(ctx, opts)
+	}
+	elements, err := await(ctx, func() ([]model.Element, error) { return r.ReadElements(opts) })
+	if err != nil && ctx.Err() != nil && errors.Is(err, ctx.Err()) {
+		return nil, Truncated(ctx)
+	}
+	return elements, err
+}
+
+// await runs fn and returns its result, or ctx.Err() as soon as ctx is done.
+// fn is not started if ctx is already done; once started it cannot be
+// interrupted, so it keeps running in the background and its result is
+// dropped.
+func await[T any](ctx context.Context, fn func() (T, error)) (T, error) {
+	var zero T
+	if ctx.Done() == nil {
+		return fn()
+	}
+	if err := ctx.Err(); err != nil {
+		return zero, err
+	}
+	return abandonable(ctx, fn)
+}
+
+// awaitWrite is await for calls that write to the UI. They are counted in
+// writes until they return, even when they are left running in the
+// background (see WithContextWait).
+func awaitWrite[T any](ctx context.Context, writes *sync.WaitGroup, fn func() (T, error)) (T, error) {
+	var zero T
+	if ctx.Done() == nil {
+		return fn()
+	}
+	if err := ctx.Err(); err != nil {
+		return zero, err
+	}
+	writes.Add(1)
+	return abandonable(ctx, func() (T, error) {
+		defer writes.Done()
+		return fn()
+	})
+}
+
+// abandonable starts fn and returns its result, or ctx.Err() as soon as
+// ctx is done, leaving fn to finish in the background.
+func abandonable[T any](ctx context.Context, fn func() (T, error)) (T, error) {
+	var zero T
+	type result struct {
+		v   T
+		err error
+	}
+	ch := make(chan result, 1)
+	go func() {
+		v, err := fn()
+		ch <- result{v, err}
+	}()
+	select {
+	case r := <-ch:
+		return r.v, r.err
+	case <-ctx.Done():
+		return zero, ctx.Err()
+	}
+}
+
+// repeatErr returns n copies of err, for batch calls that failed as a whole.
+func repeatErr(err error, n int) []error {
+	errs := make([]error, n)
+	for i := range errs {
+		errs[i] = err
+	}
+	return errs
+}
+
+// awaitErr is await for calls that only return an error.
+func awaitErr(ctx context.Context, fn func() error) error {
+	_, err := await(ctx, func() (struct{}, error) { return struct{}{}, fn() })
+	return err
+}
+
+// awaitWriteErr is awaitWrite for calls that only return an error.
+func awaitWriteErr(ctx context.Context, writes *sync.WaitGroup, fn func() error) error {
+	_, err := awaitWrite(ctx, writes, func() (struct{}, error) { return struct{}{}, fn() })
+	return err
+}
+
+// WithContext returns a copy of p whose Reader, Inputter, ActionPerformer,
+// ValueSetter, TextReader and WindowManager give up when ctx is done, so
+// that a hung app cannot block the caller past ctx's deadline.
+//
+// Reads stop traversing and return the part of the tree read so far with
+// an error wrapping ErrTruncated (see ReadElementsContext). Other calls
+// that are already running when ctx is done cannot be interrupted: they are
+// left to finish in the background and ctx.Err() is returned; calls made
+// after ctx is done are not started at all.
+func WithContext(ctx context.Context, p *Provider) *Provider {
+	out, _ := WithContextWait(ctx, p)
+	return out
+}
+
+// WithContextWait is WithContext that also returns a function that waits
+// until every input, action, set-value and window focus call made through
+// the returned provider has returned, including calls left running in the
+// background when ctx was done. A caller that hands the UI on to another
+// waits for it first, so that the other's input cannot interleave with
+// input still being sent. Reads are not waited for.
+//
+// The function waits at most limit (0 = no limit) and reports whether every
+// call returned: a call into an app that never responds would otherwise
+// keep the UI from ever being handed on.
+func WithContextWait(ctx context.Context, p *Provider) (*Provider, func(limit time.Duration) bool) {
+	writes := &sync.WaitGroup{}
+	wait := func(limit time.Duration) bool {
+		if limit <= 0 {
+			writes.Wait()
+			return true
+		}
+		done := make(chan struct{})
+		go func() {
+			writes.Wait()
+			close(done)
+		}()
+		timer := time.NewTimer(limit)
+		defer timer.Stop()
+		select {
+		case <-done:
+			return true
+		case <-timer.C:
+			return false
+		}
+	}
+	if p == nil {
+		return p, wait
+	}
+	out := *p
+	if p.Reader != nil {
+		out.Reader = &contextReader{inner: p.Reader, ctx: ctx}
+	}
+	if p.Inputter != nil {
+		out.Inputter = &contextInputter{inner: p.Inputter, ctx: ctx, writes: writes}
+	}
+	if p.ActionPerformer != nil {
+		out.ActionPerformer = &contextActionPerformer{inner: p.ActionPerformer, ctx: ctx, writes: writes}
+	}
+	if p.ValueSetter != nil {
+		out.ValueSetter = &contextValueSetter{inner: p.ValueSetter, ctx: ctx, writes: writes}
+	}
+	if p.TextReader != nil {
+		out.TextReader = &contextTextReader{inner: p.TextReader, ctx: ctx}
+	}
+	if p.WindowManager != nil {
+		out.WindowManager = &contextWindowManager{inner: p.WindowManager, ctx: ctx, writes: writes}
+	}
+	return &out, wait
+}
+
+type contextReader struct {
+	inner Reader
+	ctx   context.Context
+}
+
+func (r *contextReader) ReadElements(opts ReadOptions) ([]model.Element, error) {
+	return ReadElementsContext(r.ctx, r.inner, opts)
+}
+
+// ReadElementsContext implements ContextReader, giving up when either ctx or
+// the reader's own context is done.
+func (r *contextReader) ReadElementsContext(ctx context.Context, opts ReadOptions) ([]model.Element, error) {
+	ctx, cancel := context.WithCancelCause(ctx)
+	defer cancel(nil)
+	stop := context.AfterFunc(r.ctx, func() { cancel(r.ctx.Err()) })
+	defer stop()
+	return ReadElementsContext(ctx, r.inner, opts)
+}
+
+func (r *contextReader) ListWindows(opts ListOptions) ([]model.Window, error) {
+	return await(r.ctx, func() ([]model.Window, error) { return r.inner.ListWindows(opts) })
+}
+
+// WindowIDs lets the reader be wrapped by WithConcurrentWindows when the
+// wrapped reader is a WindowEnumerator.
+func (r *contextReader) WindowIDs(opts ReadOptions) ([]int, error) {
+	enum, ok := r.inner.(WindowEnumerator)
+	if !ok {
+		return nil, errors.ErrUnsupported
+	}
+	return await(r.ctx, func() ([]int, error) { return enum.WindowIDs(opts) })
+}
+
+// SetStats implements StatsReader when the wrapped reader does.
+func (r *contextReader) SetStats(stats *axtree.Stats) {
+	if sr, ok := r.inner.(StatsReader); ok {
+		sr.SetStats(stats)
+	}
+}
+
+// StreamElements stops the traversal at the next element once the context
+// is done, returning Truncated(ctx) (see StreamReader).
+func (r *contextReader) StreamElements(opts ReadOptions, fn func(el model.Element, depth int) bool) error {
+	sr, ok := r.inner.(StreamReader)
+	if !ok {
+		return streamRead(r, opts, fn)
+	}
+	canceled := false
+	err := sr.StreamElements(opts, func(el model.Element, depth int) bool {
+		if r.ctx.Err() != nil {
+			canceled = true
+			return false
+		}
+		return fn(el, depth)
+	})
+	if canceled {
+		return Truncated(r.ctx)
+	}
+	return err
+}
+
+type contextInputter struct {
+	inner  Inputter
+	ctx    context.Context
+	writes *sync.WaitGroup
+}
+
+func (in *contextInputter) Click(x, y int, button MouseButton, count int) error {
+	return awaitWriteErr(in.ctx, in.writes, func() error { return in.inner.Click(x, y, button, count) })
+}
+
+func (in *contextInputter) MoveMouse(x, y int) error {
+	return awaitWriteErr(in.ctx, in.writes, func() error { return in.inner.MoveMouse(x, y) })
+}
+
+func (in *contextInputter) Scroll(x, y int, dx, dy int) error {
+	return awaitWriteErr(in.ctx, in.writes, func() error { return in.inner.Scroll(x, y, dx, dy) })
+}
+
+func (in *contextInputter) Drag(fromX, fromY, toX, toY int) error {
+	return awaitWriteErr(in.ctx, in.writes, func() error { return in.inner.Drag(fromX, fromY, toX, toY) })
+}
+
+func (in *contextInputter) TypeText(text string, delayMs int) error {
+	return awaitWriteErr(in.ctx, in.writes, func() error { return in.inner.TypeText(text, delayMs) })
+}
+
+func (in *contextInputter) KeyCombo(keys []string) error {
+	return awaitWriteErr(in.ctx, in.writes, func() error { return in.inner.KeyCombo(keys) })
+}
+
+type contextActionPerformer struct {
+	inner  ActionPerformer
+	ctx    context.Context
+	writes *sync.WaitGroup
+}
+
+func (a *contextActionPerformer) PerformAction(opts ActionOptions) error {
+	return awaitWriteErr(a.ctx, a.writes, func() error { return a.inner.PerformAction(opts) })
+}
+
+func (a *contextActionPerformer) PerformActions(opts PerformActionsOptions) (int, error) {
+	return awaitWrite(a.ctx, a.writes, func() (int, error) { return a.inner.PerformActions(opts) })
+}
+
+type contextValueSetter struct {
+	inner  ValueSetter
+	ctx    context.Context
+	writes *sync.WaitGroup
+}
+
+func (v *contextValueSetter) SetValue(opts SetValueOptions) error {
+	return awaitWriteErr(v.ctx, v.writes, func() error { return v.inner.SetValue(opts) })
+}
+
+func (v *contextValueSetter) SetValues(opts SetValuesOptions) []error {
+	errs, err := awaitWrite(v.ctx, v.writes, func() ([]error, error) { return v.inner.SetValues(opts), nil })
+	if err != nil {
+		return repeatErr(err, len(opts.Values))
+	}
+	return errs
+}
+
+type contextTextReader struct {
+	inner TextReader
+	ctx   context.Context
+}
+
+func (t *contextTextReader) ReadText(opts ReadTextOptions) (string, int, error) {
+	type text struct {
+		s string
+		n int
+	}
+	r, err := await(t.ctx, func() (text, error) {
+		s, n, err := t.inner.ReadText(opts)
+		return text{s, n}, err
+	})
+	return r.s, r.n, err
+}
+
+type contextWindowManager struct {
+	inner  WindowManager
+	ctx    context.Context
+	writes *sync.WaitGroup
+}
+
+func (w *contextWindowManager) FocusWindow(opts FocusOptions) error {
+	return awaitWriteErr(w.ctx, w.writes, func() error { return w.inner.FocusWindow(opts) })
+}
+
+func (w *contextWindowManager) GetFrontmostApp() (string, int, error) {
+	type app struct {
+		name string
+		pid  int
+	}
+	r, err := await(w.ctx, func() (app, error) {
+		name, pid, err := w.inner.GetFrontmostApp()
+		return app{name, pid}, err
+	})
+	return r.name, r.pid, err
+}
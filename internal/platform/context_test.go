@@ -0,0 +1,192 @@
+package platform_test
+
+import (
+	"context"
+	"errors"
+	"reflect"
+	"testing"
+	"time"
+
+	"github.com/mj1618/desktop-cli/internal/model"
+	"github.com/mj1618/desktop-cli/internal/platform"
+)
+
+// checkPrefix fails unless got is the start of want in pre-order.
+func checkPrefix(t *testing.T, got, want []model.Element) {
+	t.Helper()
+	g, _ := flatten(got)
+	w, _ := flatten(want)
+	if len(g) == 0 || len(g) >= len(w) {
+		t.Fatalf("truncated read returned %d of %d elements", len(g), len(w))
+	}
+	if !reflect.DeepEqual(g, w[:len(g)]) {
+		t.Errorf("truncated read is not a prefix of the full read\n got: %+v\nwant: %+v", g, w[:len(g)])
+	}
+}
+
+func TestReadElementsContext_ReturnsPrefixOnDeadline(t *testing.T) {
+	opts := platform.ReadOptions{App: "Mail"}
+	full, _ := newFake(0).ReadElements(opts)
+
+	ctx, cancel := context.WithTimeout(context.Background(), 5*time.Millisecond)
+	defer cancel()
+	got, err := platform.ReadElementsContext(ctx, newFake(time.Millisecond), opts)
+	if !errors.Is(err, platform.ErrTruncated) || !errors.Is(err, context.DeadlineExceeded) {
+		t.Fatalf("err = %v, want a truncated read past its deadline", err)
+	}
+	checkPrefix(t, got, full)
+}
+
+func TestReadElementsContext_ConcurrentWindowsKeepIDs(t *testing.T) {
+	opts := platform.ReadOptions{App: "Mail"}
+	full, _ := newFake(0).ReadElements(opts)
+
+	ctx, cancel := context.WithTimeout(context.Background(), 5*time.Millisecond)
+	defer cancel()
+	r := platform.WithConcurrentWindows(newFake(time.Millisecond), 4)
+	got, err := platform.ReadElementsContext(ctx, r, opts)
+	if !errors.Is(err, platform.ErrTruncated) {
+		t.Fatalf("err = %v, want ErrTruncated", err)
+	}
+	checkPrefix(t, got, full)
+}
+
+func TestWithContext_Reader(t *testing.T) {
+	ctx, cancel := context.WithTimeout(context.Background(), 5*time.Millisecond)
+	defer cancel()
+	p := platform.WithContext(ctx, &platform.Provider{Reader: newFake(time.Millisecond)})
+	got, err := p.Reader.ReadElements(platform.ReadOptions{App: "Mail"})
+	if !errors.Is(err, platform.ErrTruncated) || len(got) == 0 {
+		t.Errorf("got %d elements, err %v; want a partial tree and ErrTruncated", len(got), err)
+	}
+
+	// Without a deadline the read is whole.
+	p = platform.WithContext(context.Background(), &platform.Provider{Reader: newFake(0)})
+	if _, err := p.Reader.ReadElements(platform.ReadOptions{App: "Mail"}); err != nil {
+		t.Errorf("read without deadline: %v", err)
+	}
+}
+
+// blockingReader is a reader that cannot be interrupted.
+type blockingReader struct {
+	platform.Reader
+	unblock chan struct{}
+}
+
+func (r blockingReader) ReadElements(platform.ReadOptions) ([]model.Element, error) {
+	<-r.unblock
+	return nil, nil
+}
+
+func TestReadElementsContext_AbandonsUninterruptibleReader(t *testing.T) {
+	r := blockingReader{unblock: make(chan struct{})}
+	defer close(r.unblock)
+	ctx, cancel := context.WithTimeout(context.Background(), 5*time.Millisecond)
+	defer cancel()
+	if _, err := platform.ReadElementsContext(ctx, r, platform.ReadOptions{}); !errors.Is(err, platform.ErrTruncated) {
+		t.Errorf("err = %v, want ErrTruncated", err)
+	}
+}
+
+// blockingActions performs actions that hang until unblocked.
+type blockingActions struct {
+	unblock chan struct{}
+	calls   chan int
+}
+
+func (a blockingActions) PerformAction(opts platform.ActionOptions) error {
+	a.calls <- opts.ID
+	<-a.unblock
+	return nil
+}
+
+func (a blockingActions) PerformActions(opts platform.PerformActionsOptions) (int, error) {
+	for _, act := range opts.Actions {
+		if err := a.PerformAction(platform.ActionOptions{ID: act.ID}); err != nil {
+			return 0, err
+		}
+	}
+	return len(opts.Actions), nil
+}
+
+func TestWithContext_GivesUpOnHungAction(t *testing.T) {
+	a := blockingActions{unblock: make(chan struct{}), calls: make(chan int, 2)}
+	defer close(a.unblock)
+	ctx, cancel := context.WithTimeout(context.Background(), 5*time.Millisecond)
+	defer cancel()
+	p := platform.WithContext(ctx, &platform.Provider{ActionPerformer: a})
+
+	start := time.Now()
+	if err := p.ActionPerformer.PerformAction(platform.ActionOptions{ID: 1}); !errors.Is(err, context.DeadlineExceeded) {
+		t.Errorf("err = %v, want context.DeadlineExceeded", err)
+	}
+	if d := time.Since(start); d > time.Second {
+		t.Errorf("hung action held the caller for %v", d)
+	}
+
+	// Once the context is done, no further action is started.
+	if err := p.ActionPerformer.PerformAction(platform.ActionOptions{ID: 2}); !errors.Is(err, context.DeadlineExceeded) {
+		t.Errorf("err = %v, want context.DeadlineExceeded", err)
+	}
+	if len(a.calls) != 1 {
+		t.Errorf("%d actions started, want 1", len(a.calls))
+	}
+}
+
+func TestReadElementsContext_BreadthFirstReachesEveryWindow(t *testing.T) {
+	ctx, cancel := context.WithTimeout(context.Background(), 15*time.Millisecond)
+	defer cancel()
+	r := platform.WithConcurrentWindows(newFake(time.Millisecond), 4)
+	got, err := platform.ReadElementsContext(ctx, r, platform.ReadOptions{App: "Mail", BreadthFirst: true})
+	if !errors.Is(err, platform.ErrTruncated) {
+		t.Fatalf("err = %v, want ErrTruncated", err)
+	}
+	if len(got) != 4 {
+		t.Fatalf("got %d windows, want all 4", len(got))
+	}
+	unexpanded := 0
+	for _, w := range got {
+		if len(w.Children) != 1 {
+			t.Fatalf("window %q has %d children, want its group", w.Title, len(w.Children))
+		}
+		if g := w.Children[0]; g.More > 0 {
+			unexpanded++
+			if len(g.Children) != 0 {
+				t.Errorf("group %q is marked more=%d but has %d children", g.Title, g.More, len(g.Children))
+			}
+		}
+	}
+	if unexpanded == 0 {
+		t.Error("no group left unexpanded")
+	}
+}
+
+func TestWithContextWait_WaitsForAbandonedAction(t *testing.T) {
+	a := blockingActions{unblock: make(chan struct{}), calls: make(chan int, 1)}
+	ctx, cancel := context.WithTimeout(context.Background(), 5*time.Millisecond)
+	defer cancel()
+	p, wait := platform.WithContextWait(ctx, &platform.Provider{ActionPerformer: a})
+
+	if err := p.ActionPerformer.PerformAction(platform.ActionOptions{ID: 1}); !errors.Is(err, context.DeadlineExceeded) {
+		t.Fatalf("err = %v, want context.DeadlineExceeded", err)
+	}
+	if wait(10 * time.Millisecond) {
+		t.Fatal("wait reported the abandoned action done while it was still running")
+	}
+	waited := make(chan struct{})
+	go func() {
+		wait(0)
+		close(waited)
+	}()
+	select {
+	case <-waited:
+		t.Fatal("wait returned while the abandoned action was still running")
+	case <-time.After(20 * time.Millisecond):
+	}
+	close(a.unblock)
+	select {
+	case <-waited:
+	case <-time.After(time.Second):
+		t.Fatal("wait did not return after the action did")
+	}
+}
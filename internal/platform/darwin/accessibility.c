@@ -2,6 +2,7 @@
 #include <CoreFoundation/CoreFoundation.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 #include <unistd.h>
 #include "accessibility.h"
 
@@ -17,139 +18,104 @@ static char* ax_cfstring_to_cstring(CFStringRef str) {
     return buf;
 }
 
-// Helper: get a string attribute from an AX element. Returns strdup("") if not available.
-static char* ax_get_string_attr(AXUIElementRef elem, CFStringRef attr) {
-    CFTypeRef value = NULL;
-    AXError err = AXUIElementCopyAttributeValue(elem, attr, &value);
-    if (err != kAXErrorSuccess || !value) {
-        return strdup("");
-    }
+// Helper: convert an attribute value to a C string (caller frees).
+// Strings are copied, booleans and numbers are formatted; any other type
+// (including the AXError values CopyMultipleAttributeValues reports for
+// missing attributes) yields NULL.
+static char* ax_value_to_cstring(CFTypeRef value) {
+    if (!value) return NULL;
     if (CFGetTypeID(value) == CFStringGetTypeID()) {
-        char* result = ax_cfstring_to_cstring((CFStringRef)value);
-        CFRelease(value);
-        return result;
+        return ax_cfstring_to_cstring((CFStringRef)value);
     }
     // For non-string values (e.g., AXValue might be a number/bool), try description
     if (CFGetTypeID(value) == CFBooleanGetTypeID()) {
-        int bval = CFBooleanGetValue((CFBooleanRef)value);
-        CFRelease(value);
-        return strdup(bval ? "true" : "false");
+        return strdup(CFBooleanGetValue((CFBooleanRef)value) ? "true" : "false");
     }
     if (CFGetTypeID(value) == CFNumberGetTypeID()) {
         double dval = 0;
         CFNumberGetValue((CFNumberRef)value, kCFNumberDoubleType, &dval);
-        CFRelease(value);
         char buf[64];
         snprintf(buf, sizeof(buf), "%g", dval);
         return strdup(buf);
     }
-    CFRelease(value);
-    return strdup("");
+    return NULL;
 }
 
-// Helper: get a boolean attribute (returns 0 or 1, defaults to defaultVal on error).
-static int ax_get_bool_attr(AXUIElementRef elem, CFStringRef attr, int defaultVal) {
-    CFTypeRef value = NULL;
-    AXError err = AXUIElementCopyAttributeValue(elem, attr, &value);
-    if (err != kAXErrorSuccess || !value) {
-        return defaultVal;
-    }
+// Helper: convert an attribute value to 0 or 1 (defaultVal if not a bool/number).
+static int ax_value_to_bool(CFTypeRef value, int defaultVal) {
+    if (!value) return defaultVal;
     int result = defaultVal;
     if (CFGetTypeID(value) == CFBooleanGetTypeID()) {
         result = CFBooleanGetValue((CFBooleanRef)value) ? 1 : 0;
     } else if (CFGetTypeID(value) == CFNumberGetTypeID()) {
         CFNumberGetValue((CFNumberRef)value, kCFNumberIntType, &result);
     }
-    CFRelease(value);
     return result;
 }
 
-// Helper: get position and size of an element.
-static void ax_get_bounds(AXUIElementRef elem, float* x, float* y, float* w, float* h) {
-    *x = 0; *y = 0; *w = 0; *h = 0;
-
-    CFTypeRef posValue = NULL;
-    if (AXUIElementCopyAttributeValue(elem, kAXPositionAttribute, &posValue) == kAXErrorSuccess && posValue) {
-        CGPoint point;
-        if (AXValueGetValue((AXValueRef)posValue, kAXValueCGPointType, &point)) {
-            *x = (float)point.x;
-            *y = (float)point.y;
-        }
-        CFRelease(posValue);
-    }
-
-    CFTypeRef sizeValue = NULL;
-    if (AXUIElementCopyAttributeValue(elem, kAXSizeAttribute, &sizeValue) == kAXErrorSuccess && sizeValue) {
-        CGSize size;
-        if (AXValueGetValue((AXValueRef)sizeValue, kAXValueCGSizeType, &size)) {
-            *w = (float)size.width;
-            *h = (float)size.height;
-        }
-        CFRelease(sizeValue);
+// Helper: get a string attribute from an AX element. Returns strdup("") if not available.
+static char* ax_get_string_attr(AXUIElementRef elem, CFStringRef attr) {
+    CFTypeRef value = NULL;
+    AXError err = AXUIElementCopyAttributeValue(elem, attr, &value);
+    if (err != kAXErrorSuccess || !value) {
+        return strdup("");
     }
+    char* result = ax_value_to_cstring(value);
+    CFRelease(value);
+    return result ? result : strdup("");
 }
 
-// Dynamic array for collecting elements during traversal.
-typedef struct {
-    AXElementInfo* items;
-    int count;
-    int capacity;
-} ElementArray;
-
-static void elem_array_init(ElementArray* arr) {
-    arr->count = 0;
-    arr->capacity = 256;
-    arr->items = (AXElementInfo*)calloc(arr->capacity, sizeof(AXElementInfo));
-}
-
-static void elem_array_grow(ElementArray* arr) {
-    arr->capacity *= 2;
-    arr->items = (AXElementInfo*)realloc(arr->items, arr->capacity * sizeof(AXElementInfo));
+// Write a CFString into the open field of b (without a terminator).
+static void ax_append_cfstring(AXBuf* b, CFStringRef str) {
+    CFIndex len = CFStringGetLength(str);
+    CFIndex maxSize = CFStringGetMaximumSizeForEncoding(len, kCFStringEncodingUTF8) + 1;
+    char* p = (char*)axbuf_reserve(b, (size_t)maxSize);
+    if (p && CFStringGetCString(str, p, maxSize, kCFStringEncodingUTF8)) {
+        axbuf_commit(b, strlen(p));
+    }
 }
 
-static int elem_array_add(ElementArray* arr) {
-    if (arr->count >= arr->capacity) {
-        elem_array_grow(arr);
+// Write an attribute value as a string field of record rec. Strings are
+// copied, booleans and numbers are formatted; any other type (including the
+// AXError values CopyMultipleAttributeValues reports for missing
+// attributes) leaves the field empty.
+static void ax_put_string_value(AXBuf* b, uint32_t rec, int slot, CFTypeRef value) {
+    if (!value) return;
+    axbuf_begin(b);
+    if (CFGetTypeID(value) == CFStringGetTypeID()) {
+        ax_append_cfstring(b, (CFStringRef)value);
+    } else if (CFGetTypeID(value) == CFBooleanGetTypeID()) {
+        const char* s = CFBooleanGetValue((CFBooleanRef)value) ? "true" : "false";
+        axbuf_append(b, s, strlen(s));
+    } else if (CFGetTypeID(value) == CFNumberGetTypeID()) {
+        double dval = 0;
+        CFNumberGetValue((CFNumberRef)value, kCFNumberDoubleType, &dval);
+        char buf[64];
+        int n = snprintf(buf, sizeof(buf), "%g", dval);
+        if (n > 0) axbuf_append(b, buf, (size_t)n);
     }
-    int idx = arr->count;
-    arr->count++;
-    memset(&arr->items[idx], 0, sizeof(AXElementInfo));
-    return idx;
+    axbuf_end(b, rec, slot);
 }
 
-// Get action names for an element.
-static void ax_get_actions(AXUIElementRef elem, char*** outActions, int* outCount) {
-    *outActions = NULL;
-    *outCount = 0;
-
+// Write an element's action names as the actions field of record rec.
+static void ax_put_actions(AXBuf* b, uint32_t rec, AXUIElementRef elem) {
     CFArrayRef actionNames = NULL;
     AXError err = AXUIElementCopyActionNames(elem, &actionNames);
     if (err != kAXErrorSuccess || !actionNames) {
         return;
     }
 
+    axbuf_begin(b);
     CFIndex count = CFArrayGetCount(actionNames);
-    if (count == 0) {
-        CFRelease(actionNames);
-        return;
-    }
-
-    char** actions = (char**)malloc(count * sizeof(char*));
-    int validCount = 0;
-
     for (CFIndex i = 0; i < count; i++) {
-        CFStringRef name = (CFStringRef)CFArrayGetValueAtIndex(actionNames, i);
-        char* cname = ax_cfstring_to_cstring(name);
-        if (cname && cname[0] != '\0') {
-            actions[validCount++] = cname;
-        } else {
-            free(cname);
+        size_t before = b->len;
+        ax_append_cfstring(b, (CFStringRef)CFArrayGetValueAtIndex(actionNames, i));
+        if (b->len > before) {
+            axbuf_append(b, "", 1);
         }
     }
-
+    axbuf_end(b, rec, AXBUF_ACTIONS);
     CFRelease(actionNames);
-    *outActions = actions;
-    *outCount = validCount;
 }
 
 // Match a CGWindowID from an AXUIElement window.
@@ -164,35 +130,145 @@ static int ax_get_window_id(AXUIElementRef windowElem) {
     return 0;
 }
 
-// Helper: try to get text content via AXStringForRange parameterized attribute.
-// This is a fallback for elements (like contenteditable divs) where AXValue is empty
-// but the element has text content accessible via the text navigation attributes.
-// Returns a malloc'd string on success, NULL if not available.
-static char* ax_get_text_content(AXUIElementRef elem) {
-    // Check if the element reports AXNumberOfCharacters
-    CFTypeRef charCountValue = NULL;
-    AXError err = AXUIElementCopyAttributeValue(elem, CFSTR("AXNumberOfCharacters"), &charCountValue);
-    if (err != kAXErrorSuccess || !charCountValue) {
-        return NULL;
+// Store one value from an AXUIElementCopyMultipleAttributeValues result
+// in record rec. *flags accumulates the AXBUF_FLAG_* bits.
+static void ax_store_value(AXBuf* b, uint32_t rec, unsigned int attr, CFTypeRef value, uint32_t* flags) {
+    switch (attr) {
+    case AX_ATTR_ROLE:        ax_put_string_value(b, rec, AXBUF_ROLE, value); break;
+    case AX_ATTR_SUBROLE:     ax_put_string_value(b, rec, AXBUF_SUBROLE, value); break;
+    case AX_ATTR_TITLE:       ax_put_string_value(b, rec, AXBUF_TITLE, value); break;
+    case AX_ATTR_VALUE:       ax_put_string_value(b, rec, AXBUF_VALUE, value); break;
+    case AX_ATTR_DESCRIPTION: ax_put_string_value(b, rec, AXBUF_DESCRIPTION, value); break;
+    case AX_ATTR_ENABLED:
+        if (!ax_value_to_bool(value, 1)) *flags &= ~AXBUF_FLAG_ENABLED;
+        break;
+    case AX_ATTR_FOCUSED:
+        if (ax_value_to_bool(value, 0)) *flags |= AXBUF_FLAG_FOCUSED;
+        break;
+    case AX_ATTR_SELECTED:
+        if (ax_value_to_bool(value, 0)) *flags |= AXBUF_FLAG_SELECTED;
+        break;
+    case AX_ATTR_POSITION:
+        if (value && CFGetTypeID(value) == AXValueGetTypeID()) {
+            CGPoint point;
+            if (AXValueGetValue((AXValueRef)value, kAXValueCGPointType, &point)) {
+                axbuf_set_f32(b, rec, AXBUF_OFF_X, (float)point.x);
+                axbuf_set_f32(b, rec, AXBUF_OFF_Y, (float)point.y);
+            }
+        }
+        break;
+    case AX_ATTR_SIZE:
+        if (value && CFGetTypeID(value) == AXValueGetTypeID()) {
+            CGSize size;
+            if (AXValueGetValue((AXValueRef)value, kAXValueCGSizeType, &size)) {
+                axbuf_set_f32(b, rec, AXBUF_OFF_WIDTH, (float)size.width);
+                axbuf_set_f32(b, rec, AXBUF_OFF_HEIGHT, (float)size.height);
+            }
+        }
+        break;
+    case AX_ATTR_TEXT_LENGTH:
+        if (value && CFGetTypeID(value) == CFNumberGetTypeID()) {
+            int textLength = 0;
+            CFNumberGetValue((CFNumberRef)value, kCFNumberIntType, &textLength);
+            axbuf_set_u32(b, rec, AXBUF_OFF_TEXT_LENGTH, (uint32_t)textLength);
+        }
+        break;
+    case AX_ATTR_CHILDREN:
+        if (value && CFGetTypeID(value) == CFArrayGetTypeID()) {
+            CFArrayRef childArray = (CFArrayRef)value;
+            CFIndex childCount = CFArrayGetCount(childArray);
+            axbuf_begin(b);
+            for (CFIndex i = 0; i < childCount; i++) {
+                axbuf_append_child(b, (uint64_t)(uintptr_t)CFRetain(CFArrayGetValueAtIndex(childArray, i)));
+            }
+            axbuf_end(b, rec, AXBUF_CHILDREN);
+        }
+        break;
+    }
+}
+
+int ax_fetch_attributes(AXUIElementRef* elems, int count, unsigned int attrs,
+                        unsigned char** outBuf, size_t* outLen) {
+    *outBuf = NULL;
+    *outLen = 0;
+    AXBuf b;
+    // Roughly 64 bytes of strings per element avoids most regrowth.
+    if (axbuf_init(&b, (uint32_t)count, (size_t)count * 64) != 0) {
+        return -1;
     }
 
-    CFIndex charCount = 0;
-    if (CFGetTypeID(charCountValue) == CFNumberGetTypeID()) {
-        CFNumberGetValue((CFNumberRef)charCountValue, kCFNumberCFIndexType, &charCount);
+    // Build the attribute name list once for the whole batch; bits[i] records
+    // which attribute names[i] is so results can be stored by position.
+    CFStringRef names[12];
+    unsigned int bits[12];
+    int n = 0;
+    if (attrs & AX_ATTR_ROLE)        { names[n] = kAXRoleAttribute;        bits[n++] = AX_ATTR_ROLE; }
+    if (attrs & AX_ATTR_SUBROLE)     { names[n] = kAXSubroleAttribute;     bits[n++] = AX_ATTR_SUBROLE; }
+    if (attrs & AX_ATTR_TITLE)       { names[n] = kAXTitleAttribute;       bits[n++] = AX_ATTR_TITLE; }
+    if (attrs & AX_ATTR_VALUE)       { names[n] = kAXValueAttribute;       bits[n++] = AX_ATTR_VALUE; }
+    if (attrs & AX_ATTR_DESCRIPTION) { names[n] = kAXDescriptionAttribute; bits[n++] = AX_ATTR_DESCRIPTION; }
+    if (attrs & AX_ATTR_ENABLED)     { names[n] = kAXEnabledAttribute;     bits[n++] = AX_ATTR_ENABLED; }
+    if (attrs & AX_ATTR_FOCUSED)     { names[n] = kAXFocusedAttribute;     bits[n++] = AX_ATTR_FOCUSED; }
+    if (attrs & AX_ATTR_SELECTED)    { names[n] = kAXSelectedAttribute;    bits[n++] = AX_ATTR_SELECTED; }
+    if (attrs & AX_ATTR_POSITION)    { names[n] = kAXPositionAttribute;    bits[n++] = AX_ATTR_POSITION; }
+    if (attrs & AX_ATTR_SIZE)        { names[n] = kAXSizeAttribute;        bits[n++] = AX_ATTR_SIZE; }
+    if (attrs & AX_ATTR_CHILDREN)    { names[n] = kAXChildrenAttribute;    bits[n++] = AX_ATTR_CHILDREN; }
+    if (attrs & AX_ATTR_TEXT_LENGTH) { names[n] = CFSTR("AXNumberOfCharacters"); bits[n++] = AX_ATTR_TEXT_LENGTH; }
+
+    CFArrayRef nameArray = NULL;
+    if (n > 0) {
+        nameArray = CFArrayCreate(NULL, (const void**)names, n, &kCFTypeArrayCallBacks);
     }
-    CFRelease(charCountValue);
 
-    if (charCount <= 0) {
-        return NULL;
+    for (int i = 0; i < count; i++) {
+        uint32_t rec = (uint32_t)i;
+        uint32_t flags = AXBUF_FLAG_ENABLED;
+
+        // One cross-process round trip for all attributes. Without
+        // kAXCopyMultipleAttributeOptionStopOnError, attributes the element
+        // lacks come back as AXError values, which ax_store_value ignores.
+        if (nameArray) {
+            CFArrayRef values = NULL;
+            uint64_t start = clock_gettime_nsec_np(CLOCK_UPTIME_RAW);
+            AXError err = AXUIElementCopyMultipleAttributeValues(elems[i], nameArray, 0, &values);
+            axbuf_set_u64(&b, rec, AXBUF_OFF_FETCH_NANOS, clock_gettime_nsec_np(CLOCK_UPTIME_RAW) - start);
+            if (err == kAXErrorSuccess && values) {
+                CFIndex valueCount = CFArrayGetCount(values);
+                for (CFIndex j = 0; j < valueCount && j < n; j++) {
+                    ax_store_value(&b, rec, bits[j], CFArrayGetValueAtIndex(values, j), &flags);
+                }
+                CFRelease(values);
+            }
+        }
+
+        if (attrs & AX_ATTR_ACTIONS) {
+            uint64_t start = clock_gettime_nsec_np(CLOCK_UPTIME_RAW);
+            ax_put_actions(&b, rec, elems[i]);
+            axbuf_set_u64(&b, rec, AXBUF_OFF_ACTIONS_NANOS, clock_gettime_nsec_np(CLOCK_UPTIME_RAW) - start);
+        }
+        axbuf_set_u32(&b, rec, AXBUF_OFF_FLAGS, flags);
     }
 
-    // Cap to a reasonable length to avoid huge allocations
-    if (charCount > 10000) {
-        charCount = 10000;
+    if (nameArray) CFRelease(nameArray);
+
+    if (b.failed) {
+        // Out of memory: children retained so far cannot be handed back and
+        // leak, which is preferable to releasing references of unknown state.
+        axbuf_free(&b);
+        return -1;
+    }
+    *outBuf = b.data;
+    *outLen = b.len;
+    return 0;
+}
+
+char* ax_copy_text(AXUIElementRef elem, int maxChars) {
+    if (maxChars <= 0) {
+        return NULL;
     }
 
     // Create a CFRange and wrap it in an AXValueRef
-    CFRange range = CFRangeMake(0, charCount);
+    CFRange range = CFRangeMake(0, maxChars);
     AXValueRef rangeValue = AXValueCreate(kAXValueCFRangeType, &range);
     if (!rangeValue) {
         return NULL;
@@ -200,7 +276,7 @@ static char* ax_get_text_content(AXUIElementRef elem) {
 
     // Use the parameterized attribute to get the string for that range
     CFTypeRef textValue = NULL;
-    err = AXUIElementCopyParameterizedAttributeValue(elem,
+    AXError err = AXUIElementCopyParameterizedAttributeValue(elem,
         CFSTR("AXStringForRange"), rangeValue, &textValue);
     CFRelease(rangeValue);
 
@@ -218,56 +294,16 @@ static char* ax_get_text_content(AXUIElementRef elem) {
     return NULL;
 }
 
-// Recursively traverse the accessibility tree.
-static void ax_traverse(AXUIElementRef elem, int parentID, int currentDepth,
-                        int maxDepth, int* nextID, ElementArray* arr) {
-    if (maxDepth > 0 && currentDepth > maxDepth) {
-        return;
-    }
-
-    int idx = elem_array_add(arr);
-    int myID = (*nextID)++;
-    AXElementInfo* info = &arr->items[idx];
-
-    info->id = myID;
-    info->parentID = parentID;
-    info->role = ax_get_string_attr(elem, kAXRoleAttribute);
-    info->subrole = ax_get_string_attr(elem, kAXSubroleAttribute);
-    info->title = ax_get_string_attr(elem, kAXTitleAttribute);
-    info->value = ax_get_string_attr(elem, kAXValueAttribute);
-    info->description = ax_get_string_attr(elem, kAXDescriptionAttribute);
-
-    // Fallback: if AXValue is empty, try AXStringForRange parameterized attribute.
-    // This captures text from contenteditable divs and rich-text editors (e.g. Gmail
-    // compose body in Chrome) that don't expose text through kAXValueAttribute.
-    if (info->value[0] == '\0') {
-        char* textContent = ax_get_text_content(elem);
-        if (textContent) {
-            free(info->value);
-            info->value = textContent;
-        }
+void ax_release_elements(AXUIElementRef* elems, int count) {
+    if (!elems) return;
+    for (int i = 0; i < count; i++) {
+        if (elems[i]) CFRelease(elems[i]);
     }
+}
 
-    info->enabled = ax_get_bool_attr(elem, kAXEnabledAttribute, 1);
-    info->focused = ax_get_bool_attr(elem, kAXFocusedAttribute, 0);
-    info->selected = ax_get_bool_attr(elem, kAXSelectedAttribute, 0);
-    ax_get_bounds(elem, &info->x, &info->y, &info->width, &info->height);
-    ax_get_actions(elem, &info->actions, &info->actionCount);
-
-    // Get children and recurse
-    if (maxDepth == 0 || currentDepth < maxDepth) {
-        CFTypeRef children = NULL;
-        AXError err = AXUIElementCopyAttributeValue(elem, kAXChildrenAttribute, &children);
-        if (err == kAXErrorSuccess && children && CFGetTypeID(children) == CFArrayGetTypeID()) {
-            CFArrayRef childArray = (CFArrayRef)children;
-            CFIndex childCount = CFArrayGetCount(childArray);
-            for (CFIndex i = 0; i < childCount; i++) {
-                AXUIElementRef child = (AXUIElementRef)CFArrayGetValueAtIndex(childArray, i);
-                ax_traverse(child, myID, currentDepth + 1, maxDepth, nextID, arr);
-            }
-        }
-        if (children) CFRelease(children);
-    }
+int ax_elements_equal(AXUIElementRef a, AXUIElementRef b) {
+    if (!a || !b) return 0;
+    return CFEqual(a, b) ? 1 : 0;
 }
 
 // Activate enhanced UI mode for the application.
@@ -294,9 +330,9 @@ static void ax_activate_enhanced_ui(AXUIElementRef app) {
     }
 }
 
-int ax_read_elements(pid_t pid, const char* windowTitle, int windowID,
-                     int maxDepth, AXElementInfo** outElements, int* outCount) {
-    *outElements = NULL;
+int ax_copy_windows(pid_t pid, const char* windowTitle, int windowID,
+                    AXUIElementRef** outWindows, int* outCount) {
+    *outWindows = NULL;
     *outCount = 0;
 
     AXUIElementRef app = AXUIElementCreateApplication(pid);
@@ -323,10 +359,11 @@ int ax_read_elements(pid_t pid, const char* windowTitle, int windowID,
 
     CFArrayRef windows = (CFArrayRef)windowsValue;
     CFIndex windowCount = CFArrayGetCount(windows);
-
-    ElementArray arr;
-    elem_array_init(&arr);
-    int nextID = 1;
+    AXUIElementRef* matched = NULL;
+    int matchedCount = 0;
+    if (windowCount > 0) {
+        matched = (AXUIElementRef*)malloc(windowCount * sizeof(AXUIElementRef));
+    }
 
     for (CFIndex i = 0; i < windowCount; i++) {
         AXUIElementRef win = (AXUIElementRef)CFArrayGetValueAtIndex(windows, i);
@@ -349,18 +386,52 @@ int ax_read_elements(pid_t pid, const char* windowTitle, int windowID,
             }
         }
 
-        // Traverse this window's element tree
-        ax_traverse(win, -1, 1, maxDepth, &nextID, &arr);
+        matched[matchedCount++] = (AXUIElementRef)CFRetain(win);
     }
 
     CFRelease(windows);
     CFRelease(app);
 
-    *outElements = arr.items;
-    *outCount = arr.count;
+    *outWindows = matched;
+    *outCount = matchedCount;
     return 0;
 }
 
+AXUIElementRef ax_copy_element_at_path(pid_t pid, const char* windowTitle, int windowID,
+                                       const int* path, int pathLen) {
+    if (pathLen < 1 || path[0] < 0) {
+        return NULL;
+    }
+
+    AXUIElementRef* windows = NULL;
+    int windowCount = 0;
+    if (ax_copy_windows(pid, windowTitle, windowID, &windows, &windowCount) != 0) {
+        return NULL;
+    }
+    AXUIElementRef elem = NULL;
+    if (path[0] < windowCount) {
+        elem = (AXUIElementRef)CFRetain(windows[path[0]]);
+    }
+    ax_release_elements(windows, windowCount);
+    free(windows);
+
+    for (int i = 1; elem && i < pathLen; i++) {
+        AXUIElementRef child = NULL;
+        CFTypeRef children = NULL;
+        AXError err = AXUIElementCopyAttributeValue(elem, kAXChildrenAttribute, &children);
+        if (err == kAXErrorSuccess && children && CFGetTypeID(children) == CFArrayGetTypeID()) {
+            CFArrayRef childArray = (CFArrayRef)children;
+            if (path[i] >= 0 && path[i] < CFArrayGetCount(childArray)) {
+                child = (AXUIElementRef)CFRetain(CFArrayGetValueAtIndex(childArray, path[i]));
+            }
+        }
+        if (children) CFRelease(children);
+        CFRelease(elem);
+        elem = child;
+    }
+    return elem;
+}
+
 int ax_list_window_titles(pid_t pid, AXWindowTitle** outTitles, int* outCount) {
     *outTitles = NULL;
     *outCount = 0;
@@ -398,8 +469,6 @@ int ax_list_window_titles(pid_t pid, AXWindowTitle** outTitles, int* outCount) {
         AXUIElementRef win = (AXUIElementRef)CFArrayGetValueAtIndex(windows, i);
 
         int wid = ax_get_window_id(win);
-        if (wid == 0) continue;
-
         char* title = ax_get_string_attr(win, kAXTitleAttribute);
         titles[validCount].windowID = wid;
         titles[validCount].title = title;
@@ -421,21 +490,3 @@ void ax_free_window_titles(AXWindowTitle* titles, int count) {
     }
     free(titles);
 }
-
-void ax_free_elements(AXElementInfo* elements, int count) {
-    if (!elements) return;
-    for (int i = 0; i < count; i++) {
-        free(elements[i].role);
-        free(elements[i].subrole);
-        free(elements[i].title);
-        free(elements[i].value);
-        free(elements[i].description);
-        if (elements[i].actions) {
-            for (int j = 0; j < elements[i].actionCount; j++) {
-                free(elements[i].actions[j]);
-            }
-            free(elements[i].actions);
-        }
-    }
-    free(elements);
-}
@@ -2,33 +2,60 @@
 #define ACCESSIBILITY_H
 
 #include <ApplicationServices/ApplicationServices.h>
+#include "axbuf.h"
 
-typedef struct {
-    int id;
-    char* role;
-    char* subrole;
-    char* title;
-    char* value;
-    char* description;
-    float x, y, width, height;
-    int enabled;
-    int focused;
-    int selected;
-    int parentID;    // -1 for root elements
-    int actionCount;
-    char** actions;
-} AXElementInfo;
-
-// Read the element tree for a given app PID.
+// Attribute bits for ax_fetch_attributes. Must match axtree.Attr.
+#define AX_ATTR_ROLE        (1u << 0)
+#define AX_ATTR_SUBROLE     (1u << 1)
+#define AX_ATTR_TITLE       (1u << 2)
+#define AX_ATTR_VALUE       (1u << 3)
+#define AX_ATTR_DESCRIPTION (1u << 4)
+#define AX_ATTR_ENABLED     (1u << 5)
+#define AX_ATTR_FOCUSED     (1u << 6)
+#define AX_ATTR_SELECTED    (1u << 7)
+#define AX_ATTR_POSITION    (1u << 8)
+#define AX_ATTR_SIZE        (1u << 9)
+#define AX_ATTR_CHILDREN    (1u << 10)
+#define AX_ATTR_ACTIONS     (1u << 11)
+#define AX_ATTR_TEXT_LENGTH (1u << 12)
+
+// Get the windows of an app PID to traverse, in AXWindows order.
 // If windowTitle is non-NULL, filters to windows matching that substring.
 // If windowID > 0, filters to the specific window ID.
-// maxDepth of 0 means unlimited.
+// The returned windows are retained; release them with ax_release_elements
+// and free the array.
 // Returns 0 on success, -1 on failure.
-int ax_read_elements(pid_t pid, const char* windowTitle, int windowID,
-                     int maxDepth, AXElementInfo** outElements, int* outCount);
+int ax_copy_windows(pid_t pid, const char* windowTitle, int windowID,
+                    AXUIElementRef** outWindows, int* outCount);
+
+// Fetch the requested AX_ATTR_* attributes for each element. All attributes
+// of an element except its action names are fetched with a single
+// AXUIElementCopyMultipleAttributeValues call.
+// The results for all count elements, strings included, are written to one
+// malloc'd buffer in the axbuf format (see axbuf.h), returned in outBuf and
+// outLen; the caller frees it with free(). Child references in it are
+// retained; release them with ax_release_elements.
+// Returns 0 on success, -1 if the buffer could not be allocated.
+int ax_fetch_attributes(AXUIElementRef* elems, int count, unsigned int attrs,
+                        unsigned char** outBuf, size_t* outLen);
 
-// Free the element array returned by ax_read_elements.
-void ax_free_elements(AXElementInfo* elements, int count);
+// Get up to maxChars characters of an element's text via AXStringForRange.
+// Returns a malloc'd string, or NULL if not available.
+char* ax_copy_text(AXUIElementRef elem, int maxChars);
+
+// Release each element in the array (does not free the array itself).
+void ax_release_elements(AXUIElementRef* elems, int count);
+
+// Whether two element references refer to the same UI element (CFEqual).
+int ax_elements_equal(AXUIElementRef a, AXUIElementRef b);
+
+// Copy the element at a child-index path: path[0] indexes the windows
+// ax_copy_windows returns for (pid, windowTitle, windowID), and each further
+// entry indexes the previous element's AXChildren. Descends pathLen elements
+// instead of walking the tree in traversal order.
+// Returns the element (retained), or NULL if the path no longer resolves.
+AXUIElementRef ax_copy_element_at_path(pid_t pid, const char* windowTitle, int windowID,
+                                       const int* path, int pathLen);
 
 // Window title info returned by ax_list_window_titles.
 typedef struct {
@@ -36,8 +63,9 @@ typedef struct {
     char* title;
 } AXWindowTitle;
 
-// Get window titles for all windows of an application via accessibility API.
-// Returns 0 on success, -1 on failure.
+// Get window IDs and titles for all windows of an application via the
+// accessibility API, in AXWindows order. Windows whose ID cannot be
+// determined are included with windowID 0. Returns 0 on success, -1 on failure.
 int ax_list_window_titles(pid_t pid, AXWindowTitle** outTitles, int* outCount);
 
 // Free the window title array returned by ax_list_window_titles.
@@ -3,6 +3,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
+#include "accessibility.h"
 #include "action.h"
 
 // Helper: copy CFString to C string (caller frees).
@@ -43,7 +44,7 @@ static int action_get_window_id(AXUIElementRef windowElem) {
     return 0;
 }
 
-// Recursively traverse the tree in the same order as ax_traverse in accessibility.c,
+// Recursively traverse the tree in the same order as axtree.Walk,
 // looking for the element at targetIndex. Returns the AXUIElementRef (retained) or NULL.
 static AXUIElementRef find_element_by_index(AXUIElementRef elem, int targetIndex,
                                              int currentDepth, int maxDepth, int* nextID) {
@@ -58,7 +59,7 @@ static AXUIElementRef find_element_by_index(AXUIElementRef elem, int targetIndex
         return elem;
     }
 
-    // Recurse into children (same condition as ax_traverse)
+    // Recurse into children (same condition as axtree.Walk)
     if (maxDepth == 0 || currentDepth < maxDepth) {
         CFTypeRef children = NULL;
         AXError err = AXUIElementCopyAttributeValue(elem, kAXChildrenAttribute, &children);
@@ -101,10 +102,20 @@ static void action_activate_enhanced_ui(AXUIElementRef app) {
     }
 }
 
-int ax_perform_action(pid_t pid, const char* windowTitle, int windowID,
-                      int maxDepth, int elementIndex, const char* actionName) {
+// Perform actionName on elem.
+static int action_perform(AXUIElementRef elem, const char* actionName) {
+    CFStringRef action = CFStringCreateWithCString(kCFAllocatorDefault, actionName, kCFStringEncodingUTF8);
+    AXError result = AXUIElementPerformAction(elem, action);
+    CFRelease(action);
+    return (result == kAXErrorSuccess) ? 0 : -1;
+}
+
+// Find the element at elementIndex in the windows of pid matching windowTitle
+// and windowID, in the same order as ax_copy_windows. Returns it retained, or NULL.
+static AXUIElementRef action_find_by_index(pid_t pid, const char* windowTitle, int windowID,
+                                           int maxDepth, int elementIndex) {
     AXUIElementRef app = AXUIElementCreateApplication(pid);
-    if (!app) return -1;
+    if (!app) return NULL;
 
     // Activate enhanced UI to ensure Chrome exposes web content
     action_activate_enhanced_ui(app);
@@ -114,13 +125,13 @@ int ax_perform_action(pid_t pid, const char* windowTitle, int windowID,
     AXError err = AXUIElementCopyAttributeValue(app, kAXWindowsAttribute, &windowsValue);
     if (err != kAXErrorSuccess || !windowsValue) {
         CFRelease(app);
-        return -1;
+        return NULL;
     }
 
     if (CFGetTypeID(windowsValue) != CFArrayGetTypeID()) {
         CFRelease(windowsValue);
         CFRelease(app);
-        return -1;
+        return NULL;
     }
 
     CFArrayRef windows = (CFArrayRef)windowsValue;
@@ -129,7 +140,7 @@ int ax_perform_action(pid_t pid, const char* windowTitle, int windowID,
     int nextID = 1;
     AXUIElementRef foundElement = NULL;
 
-    // Iterate windows in the same order as ax_read_elements
+    // Iterate windows in the same order as ax_copy_windows
     for (CFIndex i = 0; i < windowCount && !foundElement; i++) {
         AXUIElementRef win = (AXUIElementRef)CFArrayGetValueAtIndex(windows, i);
 
@@ -157,15 +168,71 @@ int ax_perform_action(pid_t pid, const char* windowTitle, int windowID,
 
     CFRelease(windows);
     CFRelease(app);
+    return foundElement;
+}
 
-    if (!foundElement) return -1;
+// Find an element by path when it has one, else by index. Returns it retained, or NULL.
+static AXUIElementRef action_find(pid_t pid, const char* windowTitle, int windowID, int maxDepth,
+                                  int elementIndex, const int* path, int pathLen) {
+    if (pathLen > 0) {
+        return ax_copy_element_at_path(pid, windowTitle, windowID, path, pathLen);
+    }
+    return action_find_by_index(pid, windowTitle, windowID, maxDepth, elementIndex);
+}
 
-    // Perform the action
-    CFStringRef action = CFStringCreateWithCString(kCFAllocatorDefault, actionName, kCFStringEncodingUTF8);
-    AXError result = AXUIElementPerformAction(foundElement, action);
+int ax_perform_action(pid_t pid, const char* windowTitle, int windowID,
+                      int maxDepth, int elementIndex, const int* path, int pathLen,
+                      const char* actionName) {
+    AXUIElementRef elem = action_find(pid, windowTitle, windowID, maxDepth, elementIndex, path, pathLen);
+    if (!elem) return -1;
+    int result = action_perform(elem, actionName);
+    CFRelease(elem);
+    return result;
+}
 
-    CFRelease(action);
-    CFRelease(foundElement);
+int ax_perform_actions(pid_t pid, const char* windowTitle, int windowID, int maxDepth,
+                       int elementCount, const int* elementIndexes, const int* paths, const int* pathLens,
+                       int stepCount, const int* steps, const char* const* actionNames, int* missing) {
+    *missing = 0;
+    AXUIElementRef* elems = (AXUIElementRef*)calloc(elementCount, sizeof(AXUIElementRef));
+    const int** elemPaths = (const int**)calloc(elementCount, sizeof(const int*));
+    if (!elems || !elemPaths) {
+        free(elems);
+        free((void*)elemPaths);
+        return 0;
+    }
 
-    return (result == kAXErrorSuccess) ? 0 : -1;
+    // Resolve every element before performing any action, since an action
+    // may change the tree the paths and indices refer to.
+    const int* path = paths;
+    for (int j = 0; j < elementCount; j++) {
+        elemPaths[j] = path;
+        elems[j] = action_find(pid, windowTitle, windowID, maxDepth, elementIndexes[j], path, pathLens[j]);
+        path += pathLens[j];
+    }
+
+    // Then perform the steps back to back through the retained elements.
+    // An element not found up front may only appear after an earlier step
+    // (a key that replaces another once pressed), so it is looked up again
+    // just before its first step.
+    int performed = 0;
+    for (; performed < stepCount; performed++) {
+        int j = steps[performed];
+        if (j < 0 || j >= elementCount) break;
+        if (!elems[j]) {
+            elems[j] = action_find(pid, windowTitle, windowID, maxDepth, elementIndexes[j], elemPaths[j], pathLens[j]);
+        }
+        if (!elems[j]) {
+            *missing = 1;
+            break;
+        }
+        if (action_perform(elems[j], actionNames[performed]) != 0) break;
+    }
+
+    for (int j = 0; j < elementCount; j++) {
+        if (elems[j]) CFRelease(elems[j]);
+    }
+    free((void*)elemPaths);
+    free(elems);
+    return performed;
 }
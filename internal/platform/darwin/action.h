@@ -4,15 +4,37 @@
 #include <ApplicationServices/ApplicationServices.h>
 
 // Perform an accessibility action on the element at the given traversal index
-// within the specified app. Uses the same traversal order as ax_read_elements.
+// within the specified app. Uses the same traversal order as the reader (axtree.Walk).
 // pid: target process ID
 // windowTitle: filter to window matching this title (NULL = no filter)
 // windowID: filter to specific window ID (0 = no filter)
 // maxDepth: max traversal depth (0 = unlimited), must match the read call
 // elementIndex: element ID from read output (1-based)
+// path, pathLen: child-index path of the element (see ax_copy_element_at_path);
+//                when pathLen > 0 it is used instead of elementIndex
 // actionName: AX action name (e.g. "AXPress", "AXCancel")
 // Returns 0 on success, -1 on failure.
 int ax_perform_action(pid_t pid, const char* windowTitle, int windowID,
-                      int maxDepth, int elementIndex, const char* actionName);
+                      int maxDepth, int elementIndex, const int* path, int pathLen,
+                      const char* actionName);
+
+// Perform a sequence of actions on a set of elements, resolving each element
+// once, as ax_perform_action does, before performing any action, and then
+// performing them back to back through the retained elements. Elements not
+// found up front are looked up again just before their first step, after the
+// earlier steps have been performed.
+// elementCount: number of elements
+// elementIndexes: element ID of each element (used when its pathLen is 0)
+// paths: the child-index paths of all elements, concatenated
+// pathLens: length of each element's path in paths (0 = look up by index)
+// stepCount: number of actions
+// steps: index into the elements of each action's element, in order
+// actionNames: AX action name of each action
+// missing: set to 1 if the steps stopped because an element was not found
+// Returns the number of actions performed: stepCount, unless an element was
+// not found or an action failed, in which case the rest are not performed.
+int ax_perform_actions(pid_t pid, const char* windowTitle, int windowID, int maxDepth,
+                       int elementCount, const int* elementIndexes, const int* paths, const int* pathLens,
+                       int stepCount, const int* steps, const char* const* actionNames, int* missing);
 
 #endif
@@ -29,7 +29,7 @@ func NewActionPerformer(reader *DarwinReader) *DarwinActionPerformer {
 }
 
 func (p *DarwinActionPerformer) PerformAction(opts platform.ActionOptions) error {
-	if opts.ID <= 0 {
+	if opts.ID <= 0 && len(opts.Path) == 0 {
 		return fmt.Errorf("--id is required")
 	}
 	if opts.Action == "" {
@@ -64,15 +64,120 @@ func (p *DarwinActionPerformer) PerformAction(opts platform.ActionOptions) error
 		defer C.free(unsafe.Pointer(cWindowTitle))
 	}
 
+	path, pathLen := cPath(opts.Path)
 	rc := C.ax_perform_action(C.pid_t(pid), cWindowTitle, C.int(windowID),
-		C.int(0), C.int(opts.ID), cAction)
+		C.int(0), C.int(opts.ID), path, pathLen, cAction)
 	if rc != 0 {
-		return fmt.Errorf("failed to perform action %q on element %d", opts.Action, opts.ID)
+		return fmt.Errorf("failed to perform action %q on element %d%s", opts.Action, opts.ID, pathNote(opts.Path))
 	}
 
 	return nil
 }
 
+// PerformActions performs all the actions with one call into C, which
+// resolves each distinct element once and then performs the actions back to
+// back on the retained elements. An element not found up front, such as a
+// key that only appears once an earlier one is pressed, is looked up again
+// just before its first action.
+func (p *DarwinActionPerformer) PerformActions(opts platform.PerformActionsOptions) (int, error) {
+	if len(opts.Actions) == 0 {
+		return 0, nil
+	}
+	for _, act := range opts.Actions {
+		if act.ID <= 0 && len(act.Path) == 0 {
+			return 0, fmt.Errorf("--id is required")
+		}
+		if act.Action == "" {
+			return 0, fmt.Errorf("--action is required")
+		}
+	}
+
+	if err := CheckAccessibilityPermission(); err != nil {
+		return 0, err
+	}
+
+	readOpts := platform.ReadOptions{
+		App:      opts.App,
+		Window:   opts.Window,
+		WindowID: opts.WindowID,
+		PID:      opts.PID,
+	}
+	pid, windowTitle, windowID := p.reader.resolvePIDAndWindow(readOpts)
+	if pid == 0 {
+		return 0, fmt.Errorf("no target specified: use --app, --pid, --window, or --window-id")
+	}
+
+	cWindowTitle := (*C.char)(nil)
+	if windowTitle != "" {
+		cWindowTitle = C.CString(windowTitle)
+		defer C.free(unsafe.Pointer(cWindowTitle))
+	}
+
+	// Each distinct element is passed once; steps index into them.
+	var indexes, pathLens []C.int
+	var paths []C.int // all the paths, concatenated
+	seen := map[string]int{}
+	steps := make([]C.int, len(opts.Actions))
+	actions := make([]*C.char, len(opts.Actions))
+	for i, act := range opts.Actions {
+		key := fmt.Sprint(act.ID, act.Path)
+		if len(act.Path) > 0 {
+			key = fmt.Sprint(act.Path)
+		}
+		j, ok := seen[key]
+		if !ok {
+			j = len(indexes)
+			seen[key] = j
+			indexes = append(indexes, C.int(act.ID))
+			pathLens = append(pathLens, C.int(len(act.Path)))
+			for _, idx := range act.Path {
+				paths = append(paths, C.int(idx))
+			}
+		}
+		steps[i] = C.int(j)
+		actions[i] = C.CString(mapActionName(act.Action))
+		defer C.free(unsafe.Pointer(actions[i]))
+	}
+
+	var cPaths *C.int
+	if len(paths) > 0 {
+		cPaths = &paths[0]
+	}
+
+	var missing C.int
+	n := int(C.ax_perform_actions(C.pid_t(pid), cWindowTitle, C.int(windowID), C.int(0),
+		C.int(len(indexes)), &indexes[0], cPaths, &pathLens[0],
+		C.int(len(steps)), &steps[0], &actions[0], &missing))
+	if n < len(opts.Actions) {
+		act := opts.Actions[n]
+		if missing != 0 {
+			return n, fmt.Errorf("step %d: element %d not found%s", n+1, act.ID, pathNote(act.Path))
+		}
+		return n, fmt.Errorf("step %d: failed to perform action %q on element %d%s", n+1, act.Action, act.ID, pathNote(act.Path))
+	}
+	return n, nil
+}
+
+// cPath converts a child-index path for the C lookups (nil, 0 when empty).
+func cPath(path []int) (*C.int, C.int) {
+	if len(path) == 0 {
+		return nil, 0
+	}
+	out := make([]C.int, len(path))
+	for i, p := range path {
+		out[i] = C.int(p)
+	}
+	return &out[0], C.int(len(out))
+}
+
+// pathNote describes a path lookup in error messages.
+func pathNote(path []int) string {
+	if len(path) == 0 {
+		return ""
+	}
+	return fmt.Sprintf(" at path %v (the UI may have changed; re-read it)", path)
+}
+
 func mapActionName(short string) string {
 	switch strings.ToLower(short) {
 	case "press":
@@ -0,0 +1,127 @@
+//go:build darwin
+
+package darwin
+
+/*
+#cgo CFLAGS: -x objective-c -I${SRCDIR}/../../axtree/axbuf
+#cgo LDFLAGS: -framework CoreFoundation -framework ApplicationServices -framework Foundation
+#include "accessibility.h"
+#include <stdlib.h>
+*/
+import "C"
+import (
+	"fmt"
+	"time"
+	"unsafe"
+
+	"github.com/mj1618/desktop-cli/internal/axtree"
+	"github.com/mj1618/desktop-cli/internal/axtree/axbuf"
+)
+
+// axSource implements axtree.Source over the macOS Accessibility API.
+// Handles are retained AXUIElementRefs.
+type axSource struct {
+	observe axtree.Observer // nil = no per-call timing
+}
+
+// Observe returns a source that reports each AX call's duration to fn.
+func (s axSource) Observe(fn axtree.Observer) axtree.Source {
+	s.observe = fn
+	return s
+}
+
+// copyWindows returns retained handles for the windows of pid matching the
+// title substring or window ID. Release them with Release.
+func (s axSource) copyWindows(pid int, windowTitle string, windowID int) ([]axtree.Handle, bool) {
+	cWindowTitle := (*C.char)(nil)
+	if windowTitle != "" {
+		cWindowTitle = C.CString(windowTitle)
+		defer C.free(unsafe.Pointer(cWindowTitle))
+	}
+	var cWindows *C.AXUIElementRef
+	var cCount C.int
+	if C.ax_copy_windows(C.pid_t(pid), cWindowTitle, C.int(windowID), &cWindows, &cCount) != 0 {
+		return nil, false
+	}
+	defer C.free(unsafe.Pointer(cWindows))
+	handles := make([]axtree.Handle, int(cCount))
+	for i, w := range unsafe.Slice(cWindows, int(cCount)) {
+		handles[i] = axtree.Handle(unsafe.Pointer(w))
+	}
+	return handles, true
+}
+
+// copyElementAtPath returns a retained handle for the element at a
+// child-index path (see ax_copy_element_at_path). Release it with Release.
+func (s axSource) copyElementAtPath(pid int, windowTitle string, windowID int, path []int) (axtree.Handle, bool) {
+	cWindowTitle := (*C.char)(nil)
+	if windowTitle != "" {
+		cWindowTitle = C.CString(windowTitle)
+		defer C.free(unsafe.Pointer(cWindowTitle))
+	}
+	cPath := make([]C.int, len(path))
+	for i, p := range path {
+		cPath[i] = C.int(p)
+	}
+	var h axtree.Handle
+	*(*C.AXUIElementRef)(unsafe.Pointer(&h)) = C.ax_copy_element_at_path(C.pid_t(pid), cWindowTitle, C.int(windowID), &cPath[0], C.int(len(cPath)))
+	return h, h != 0
+}
+
+func (s axSource) Fetch(handles []axtree.Handle, attrs axtree.Attr) ([]axtree.Values, error) {
+	if len(handles) == 0 {
+		return nil, nil
+	}
+	var cBuf *C.uchar
+	var cLen C.size_t
+	if C.ax_fetch_attributes((*C.AXUIElementRef)(unsafe.Pointer(&handles[0])), C.int(len(handles)), C.uint(attrs), &cBuf, &cLen) != 0 {
+		return nil, fmt.Errorf("failed to allocate attribute buffer for %d elements", len(handles))
+	}
+	// One copy and one free for the whole batch; strings in the decoded
+	// values are views into buf.
+	buf := C.GoBytes(unsafe.Pointer(cBuf), C.int(cLen))
+	C.free(unsafe.Pointer(cBuf))
+
+	out, timings, err := axbuf.Decode(buf)
+	if err != nil {
+		return nil, err
+	}
+	if s.observe != nil {
+		for _, t := range timings {
+			if t.Fetch > 0 {
+				s.observe("AXUIElementCopyMultipleAttributeValues", t.Fetch)
+			}
+			if t.Actions > 0 {
+				s.observe("AXUIElementCopyActionNames", t.Actions)
+			}
+		}
+	}
+	return out, nil
+}
+
+func (s axSource) Text(h axtree.Handle, max int) (string, bool) {
+	elem := *(*C.AXUIElementRef)(unsafe.Pointer(&h))
+	start := time.Now()
+	cText := C.ax_copy_text(elem, C.int(max))
+	if s.observe != nil {
+		s.observe("AXStringForRange", time.Since(start))
+	}
+	if cText == nil {
+		return "", false
+	}
+	defer C.free(unsafe.Pointer(cText))
+	return C.GoString(cText), true
+}
+
+func (axSource) Equal(a, b axtree.Handle) bool {
+	ea := *(*C.AXUIElementRef)(unsafe.Pointer(&a))
+	eb := *(*C.AXUIElementRef)(unsafe.Pointer(&b))
+	return C.ax_elements_equal(ea, eb) != 0
+}
+
+func (axSource) Release(handles []axtree.Handle) {
+	if len(handles) == 0 {
+		return
+	}
+	C.ax_release_elements((*C.AXUIElementRef)(unsafe.Pointer(&handles[0])), C.int(len(handles)))
+}
@@ -2,6 +2,13 @@
 
 package darwin
 
+/*
+#cgo CFLAGS: -x objective-c
+#cgo LDFLAGS: -framework AppKit
+#include "pasteboard.h"
+*/
+import "C"
+
 import (
 	"bytes"
 	"fmt"
@@ -9,7 +16,8 @@ import (
 	"strings"
 )
 
-// Clipboard implements platform.ClipboardManager using pbcopy/pbpaste.
+// Clipboard implements platform.ClipboardManager using pbcopy/pbpaste, and
+// platform.ClipboardChangeCounter.
 type Clipboard struct{}
 
 // NewClipboard returns a new Clipboard instance.
@@ -45,3 +53,9 @@ func (c *Clipboard) Clear() error {
 	}
 	return nil
 }
+
+// ChangeCount returns the change count of the general pasteboard, which is
+// much cheaper than running pbpaste to see whether the clipboard changed.
+func (c *Clipboard) ChangeCount() (int, error) {
+	return int(C.ns_pasteboard_change_count()), nil
+}
@@ -15,6 +15,7 @@ func init() {
 		screenshotter := NewScreenshotter(reader)
 		actionPerformer := NewActionPerformer(reader)
 		valueSetter := NewValueSetter(reader)
+		textReader := NewTextReader(reader)
 		clipboard := NewClipboard()
 		return &platform.Provider{
 			Reader:           reader,
@@ -23,6 +24,7 @@ func init() {
 			Screenshotter:    screenshotter,
 			ActionPerformer:  actionPerformer,
 			ValueSetter:      valueSetter,
+			TextReader:       textReader,
 			ClipboardManager: clipboard,
 		}, nil
 	}
@@ -77,29 +77,33 @@ static CGEventSourceRef get_kb_source() {
     return _kbSource;
 }
 
-// Type a single Unicode character using CGEvent key simulation.
-// keyCode should be the real macOS virtual key code for the character
-// (use 0 only when the correct code is unknown, e.g. non-ASCII).
-// modifiers should include kCGEventFlagMaskShift when the character
-// requires the Shift key (e.g. uppercase letters, symbols like '!').
-static int cg_type_char(UniChar ch, CGKeyCode keyCode, CGEventFlags modifiers) {
+// Post a batch of key events (see keystroke.Batch) back to back.
+// Event i has virtual key code codes[i] and types the UTF-16 code units
+// units[offsets[i]:offsets[i+1]]; key code 0 with several code units is a
+// Unicode string event. modifiers apply to every event of the batch, e.g.
+// kCGEventFlagMaskShift for uppercase letters and symbols like '!'.
+static int cg_post_keys(const CGKeyCode* codes, const UniChar* units, const int* offsets,
+                        int count, CGEventFlags modifiers) {
     CGEventSourceRef src = get_kb_source();
-    CGEventRef keyDown = CGEventCreateKeyboardEvent(src, keyCode, true);
-    CGEventRef keyUp   = CGEventCreateKeyboardEvent(src, keyCode, false);
-    if (!keyDown || !keyUp) {
-        if (keyDown) CFRelease(keyDown);
-        if (keyUp)   CFRelease(keyUp);
-        return -1;
+    for (int i = 0; i < count; i++) {
+        CGEventRef keyDown = CGEventCreateKeyboardEvent(src, codes[i], true);
+        CGEventRef keyUp   = CGEventCreateKeyboardEvent(src, codes[i], false);
+        if (!keyDown || !keyUp) {
+            if (keyDown) CFRelease(keyDown);
+            if (keyUp)   CFRelease(keyUp);
+            return -1;
+        }
+        UniCharCount len = offsets[i + 1] - offsets[i];
+        CGEventKeyboardSetUnicodeString(keyDown, len, units + offsets[i]);
+        CGEventKeyboardSetUnicodeString(keyUp, len, units + offsets[i]);
+        CGEventSetFlags(keyDown, modifiers);
+        CGEventSetFlags(keyUp, modifiers);
+        CGEventPost(kCGHIDEventTap, keyDown);
+        usleep(1000); // 1 ms between key-down and key-up
+        CGEventPost(kCGHIDEventTap, keyUp);
+        CFRelease(keyDown);
+        CFRelease(keyUp);
     }
-    CGEventKeyboardSetUnicodeString(keyDown, 1, &ch);
-    CGEventKeyboardSetUnicodeString(keyUp, 1, &ch);
-    CGEventSetFlags(keyDown, modifiers);
-    CGEventSetFlags(keyUp, modifiers);
-    CGEventPost(kCGHIDEventTap, keyDown);
-    usleep(1000); // 1 ms between key-down and key-up
-    CGEventPost(kCGHIDEventTap, keyUp);
-    CFRelease(keyDown);
-    CFRelease(keyUp);
     return 0;
 }
 
@@ -206,7 +210,9 @@ import (
 	"fmt"
 	"strings"
 	"time"
+	"unicode/utf16"
 
+	"github.com/mj1618/desktop-cli/internal/keystroke"
 	"github.com/mj1618/desktop-cli/internal/platform"
 )
 
@@ -266,17 +272,28 @@ func (inp *DarwinInputter) Drag(fromX, fromY, toX, toY int) error {
 	return nil
 }
 
+// TypeText types text as the batches keystroke.Compile plans for it.
 func (inp *DarwinInputter) TypeText(text string, delayMs int) error {
-	// Minimum inter-character delay to prevent event loss.
-	if delayMs < 5 {
-		delayMs = 5
-	}
-	for _, ch := range text {
-		keyCode, modifiers := charToKeyCode(ch)
-		if C.cg_type_char(C.UniChar(ch), C.CGKeyCode(keyCode), C.CGEventFlags(modifiers)) != 0 {
-			return fmt.Errorf("failed to type character %q", string(ch))
+	plan := keystroke.Compile(text, charToKey, keystroke.Options{Delay: time.Duration(delayMs) * time.Millisecond})
+	for _, b := range plan {
+		codes := make([]C.CGKeyCode, len(b.Events))
+		offsets := make([]C.int, 1, len(b.Events)+1)
+		var units []C.UniChar
+		for i, ev := range b.Events {
+			codes[i] = C.CGKeyCode(ev.Code)
+			for _, u := range utf16.Encode([]rune(ev.Text)) {
+				units = append(units, C.UniChar(u))
+			}
+			offsets = append(offsets, C.int(len(units)))
+		}
+		var modifiers uint64
+		if b.Shift {
+			modifiers = uint64(C.kCGEventFlagMaskShift)
+		}
+		if C.cg_post_keys(&codes[0], &units[0], &offsets[0], C.int(len(codes)), C.CGEventFlags(modifiers)) != 0 {
+			return fmt.Errorf("failed to type %q", b.Events[0].Text)
 		}
-		time.Sleep(time.Duration(delayMs) * time.Millisecond)
+		time.Sleep(b.Pause)
 	}
 	return nil
 }
@@ -338,18 +355,12 @@ var charKeyMap = map[rune]charKeyInfo{
 	' ': {0x31, false}, '\t': {0x30, false}, '\n': {0x24, false},
 }
 
-// charToKeyCode returns the virtual key code and CGEvent modifier flags
-// for a character.  For unknown characters it returns key code 0 with no
-// modifiers, falling back to the Unicode-string-only approach.
-func charToKeyCode(ch rune) (uint16, uint64) {
-	if info, ok := charKeyMap[ch]; ok {
-		var mods uint64
-		if info.shift {
-			mods = uint64(C.kCGEventFlagMaskShift)
-		}
-		return info.keyCode, mods
-	}
-	return 0, 0
+// charToKey returns the virtual key and shift state for a character (a
+// keystroke.KeyMap). Unknown characters are typed by the keystroke plan with
+// key code 0, falling back to the Unicode-string-only approach.
+func charToKey(ch rune) (keystroke.Key, bool) {
+	info, ok := charKeyMap[ch]
+	return keystroke.Key{Code: info.keyCode, Shift: info.shift}, ok
 }
 
 // macOS virtual key codes from Carbon Events.h.
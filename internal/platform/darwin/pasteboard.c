@@ -0,0 +1,6 @@
+#import <AppKit/AppKit.h>
+#include "pasteboard.h"
+
+long ns_pasteboard_change_count(void) {
+    return (long)[[NSPasteboard generalPasteboard] changeCount];
+}
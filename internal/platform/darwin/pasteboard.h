@@ -0,0 +1,8 @@
+#ifndef PASTEBOARD_H
+#define PASTEBOARD_H
+
+// Get the change count of the general pasteboard, which increases whenever
+// its contents change.
+long ns_pasteboard_change_count(void);
+
+#endif
@@ -11,26 +11,59 @@ package darwin
 */
 import "C"
 import (
+	"context"
 	"fmt"
 	"sort"
 	"strings"
+	"sync"
 	"unsafe"
 
+	"github.com/mj1618/desktop-cli/internal/axtree"
 	"github.com/mj1618/desktop-cli/internal/model"
 	"github.com/mj1618/desktop-cli/internal/platform"
 )
 
+// maxRetainedTrees bounds the number of scopes an incremental reader keeps
+// element handles for.
+const maxRetainedTrees = 8
+
 // DarwinReader implements the platform.Reader interface for macOS.
-type DarwinReader struct{}
+type DarwinReader struct {
+	mu          sync.Mutex
+	incremental bool
+	trees       map[treeKey]*retainedTree
+	treeOrder   []treeKey // oldest first
+	stats       *axtree.Stats
+	windows     *platform.WindowDirectory
+}
+
+// treeKey identifies a retained tree: the resolved read target, depth and
+// inline text limit.
+type treeKey struct {
+	pid         int
+	windowTitle string
+	windowID    int
+	depth       int
+	textLimit   int
+}
 
 // NewReader creates a new macOS reader.
 func NewReader() *DarwinReader {
-	return &DarwinReader{}
+	r := &DarwinReader{}
+	r.windows = platform.NewWindowDirectory(listWindows, 0)
+	return r
 }
 
-// ListWindows returns all windows visible on screen using CGWindowListCopyWindowInfo.
-// Filters by app name and PID per ListOptions.
+// ListWindows returns the windows visible on screen, filtered by app name
+// and PID per ListOptions. Lists are cached briefly (see
+// platform.WindowDirectory).
 func (r *DarwinReader) ListWindows(opts platform.ListOptions) ([]model.Window, error) {
+	return r.windows.List(opts)
+}
+
+// listWindows enumerates the windows visible on screen using
+// CGWindowListCopyWindowInfo, filtered by app name and PID per ListOptions.
+func listWindows(opts platform.ListOptions) ([]model.Window, error) {
 	var cWindows *C.CGWindowInfo
 	var cCount C.int
 
@@ -120,7 +153,7 @@ func (r *DarwinReader) ListWindows(opts platform.ListOptions) ([]model.Window, e
 				axSlice := unsafe.Slice(axTitles, int(axCount))
 				for j := 0; j < int(axCount); j++ {
 					t := C.GoString(axSlice[j].title)
-					if t != "" {
+					if t != "" && axSlice[j].windowID != 0 {
 						axTitleMap[int(axSlice[j].windowID)] = t
 					}
 				}
@@ -148,26 +181,15 @@ func (r *DarwinReader) ListWindows(opts platform.ListOptions) ([]model.Window, e
 	return windows, nil
 }
 
-// ActionMap maps AX action names to short names.
-var ActionMap = map[string]string{
-	"AXPress":     "press",
-	"AXCancel":    "cancel",
-	"AXPick":      "pick",
-	"AXIncrement": "increment",
-	"AXDecrement": "decrement",
-	"AXConfirm":   "confirm",
-	"AXShowMenu":  "showmenu",
-}
-
-func mapAction(axAction string) string {
-	if short, ok := ActionMap[axAction]; ok {
-		return short
-	}
-	return strings.ToLower(strings.TrimPrefix(axAction, "AX"))
-}
-
 // ReadElements reads the accessibility element tree for the specified target.
 func (r *DarwinReader) ReadElements(opts platform.ReadOptions) ([]model.Element, error) {
+	return r.ReadElementsContext(context.Background(), opts)
+}
+
+// ReadElementsContext implements platform.ContextReader. The traversal
+// checks ctx between accessibility calls, so it overruns ctx by at most one
+// call (bounded by the app's messaging timeout when the app is hung).
+func (r *DarwinReader) ReadElementsContext(ctx context.Context, opts platform.ReadOptions) ([]model.Element, error) {
 	if err := CheckAccessibilityPermission(); err != nil {
 		return nil, err
 	}
@@ -177,21 +199,62 @@ func (r *DarwinReader) ReadElements(opts platform.ReadOptions) ([]model.Element,
 		return nil, fmt.Errorf("no target specified: use --app, --pid, --window, or --window-id")
 	}
 
-	var cElements *C.AXElementInfo
-	var cCount C.int
-	cWindowTitle := (*C.char)(nil)
-	if windowTitle != "" {
-		cWindowTitle = C.CString(windowTitle)
-		defer C.free(unsafe.Pointer(cWindowTitle))
+	ax := axSource{}
+	var roots []axtree.Handle
+	if len(opts.Scope) > 0 {
+		root, ok := ax.copyElementAtPath(pid, windowTitle, windowID, opts.Scope)
+		if !ok {
+			return nil, fmt.Errorf("no element at path %s (the UI may have changed; re-read it)", model.FormatPath(opts.Scope))
+		}
+		roots = []axtree.Handle{root}
+	} else {
+		var ok bool
+		if roots, ok = ax.copyWindows(pid, windowTitle, windowID); !ok {
+			// The cached window list may name a process that has quit.
+			r.windows.Invalidate()
+			return nil, fmt.Errorf("failed to read accessibility tree for PID %d", pid)
+		}
 	}
-
-	if C.ax_read_elements(C.pid_t(pid), cWindowTitle, C.int(windowID),
-		C.int(opts.Depth), &cElements, &cCount) != 0 {
-		return nil, fmt.Errorf("failed to read accessibility tree for PID %d", pid)
+	src := r.source(ax, opts.App, pid)
+
+	var nodes []axtree.Node
+	var err error
+	if r.isIncremental() && len(opts.Roles) == 0 && !opts.BreadthFirst && len(opts.Scope) == 0 {
+		nodes, err = r.readIncremental(treeKey{pid, windowTitle, windowID, opts.Depth, opts.TextLimit}, src, roots, ctx.Done())
+	} else {
+		// With a role filter, Walk reads a role-only skeleton first and fetches
+		// full attributes only for elements that survive the filter.
+		nodes, err = axtree.Walk(src, roots, axtree.Options{MaxDepth: opts.Depth, TextLimit: opts.TextLimit, Roles: opts.Roles, BreadthFirst: opts.BreadthFirst, Done: ctx.Done()})
+		src.Release(roots)
+	}
+	if err == axtree.ErrCanceled {
+		err = platform.Truncated(ctx)
+	} else if err != nil {
+		return nil, fmt.Errorf("failed to read accessibility tree for PID %d: %w", pid, err)
+	}
+	// Actions look an ID up by counting from the first window, so a
+	// subtree is numbered from where a full read would reach it.
+	numbered := true
+	if len(opts.Scope) > 0 {
+		before, cerr := countBefore(ax, src, pid, windowTitle, windowID, opts.Scope, ctx.Done())
+		switch {
+		case cerr == axtree.ErrCanceled:
+			numbered, err = false, platform.Truncated(ctx)
+		case cerr != nil:
+			return nil, fmt.Errorf("failed to number elements at path %s: %w", model.FormatPath(opts.Scope), cerr)
+		default:
+			axtree.OffsetIDs(nodes, before)
+		}
+	}
+	elements := axtree.BuildTree(nodes)
+	if len(opts.Scope) > 0 {
+		axtree.RebasePaths(elements, opts.Scope)
+	}
+	if !numbered {
+		axtree.ClearIDs(elements)
+	} else if opts.BreadthFirst {
+		axtree.ClearIDsAfterUnread(elements)
 	}
-	defer C.ax_free_elements(cElements, cCount)
-
-	elements := buildElementTree(cElements, cCount)
 
 	// Apply role and bbox filters
 	var bbox *[4]int
@@ -201,147 +264,207 @@ func (r *DarwinReader) ReadElements(opts platform.ReadOptions) ([]model.Element,
 	}
 	elements = model.FilterElements(elements, opts.Roles, bbox)
 
-	return elements, nil
+	return elements, err
 }
 
-// resolvePIDAndWindow resolves the target PID from --app, --pid, --window, or --window-id.
-func (r *DarwinReader) resolvePIDAndWindow(opts platform.ReadOptions) (pid int, windowTitle string, windowID int) {
-	if opts.PID != 0 {
-		return opts.PID, opts.Window, opts.WindowID
+// countBefore counts the elements a full read of the windows visits before
+// the element at path (see axtree.CountBefore).
+func countBefore(ax axSource, src axtree.Source, pid int, windowTitle string, windowID int, path []int, done <-chan struct{}) (int, error) {
+	windows, ok := ax.copyWindows(pid, windowTitle, windowID)
+	if !ok {
+		return 0, fmt.Errorf("failed to list the windows of PID %d", pid)
 	}
-	if opts.App != "" {
-		windows, err := r.ListWindows(platform.ListOptions{App: opts.App})
-		if err != nil || len(windows) == 0 {
-			return 0, "", 0
-		}
-		if opts.Window != "" {
-			for _, w := range windows {
-				if strings.Contains(strings.ToLower(w.Title), strings.ToLower(opts.Window)) {
-					return w.PID, "", w.ID
-				}
-			}
-		}
-		return windows[0].PID, opts.Window, opts.WindowID
+	defer src.Release(windows)
+	return axtree.CountBefore(src, windows, path, done)
+}
+
+// StreamElements implements platform.StreamReader. It walks the live tree
+// (neither incrementally nor in two phases) and stops reading as soon as fn
+// returns false.
+func (r *DarwinReader) StreamElements(opts platform.ReadOptions, fn func(el model.Element, depth int) bool) error {
+	if err := CheckAccessibilityPermission(); err != nil {
+		return err
 	}
-	if opts.WindowID != 0 {
-		windows, err := r.ListWindows(platform.ListOptions{})
-		if err != nil {
-			return 0, "", 0
-		}
-		for _, w := range windows {
-			if w.ID == opts.WindowID {
-				return w.PID, "", w.ID
-			}
-		}
+
+	pid, windowTitle, windowID := r.resolvePIDAndWindow(opts)
+	if pid == 0 {
+		return fmt.Errorf("no target specified: use --app, --pid, --window, or --window-id")
 	}
-	if opts.Window != "" {
-		windows, err := r.ListWindows(platform.ListOptions{})
-		if err != nil {
-			return 0, "", 0
-		}
-		for _, w := range windows {
-			if strings.Contains(strings.ToLower(w.Title), strings.ToLower(opts.Window)) {
-				return w.PID, "", w.ID
-			}
-		}
+
+	ax := axSource{}
+	roots, ok := ax.copyWindows(pid, windowTitle, windowID)
+	if !ok {
+		r.windows.Invalidate()
+		return fmt.Errorf("failed to read accessibility tree for PID %d", pid)
+	}
+	src := r.source(ax, opts.App, pid)
+	err := axtree.Stream(src, roots, axtree.Options{MaxDepth: opts.Depth, TextLimit: opts.TextLimit}, fn)
+	src.Release(roots)
+	if err != nil {
+		return fmt.Errorf("failed to read accessibility tree for PID %d: %w", pid, err)
 	}
-	return 0, "", 0
+	return nil
 }
 
-// buildElementTree converts the flat C array into a nested Go element tree.
-func buildElementTree(cElements *C.AXElementInfo, cCount C.int) []model.Element {
-	count := int(cCount)
-	if count == 0 {
-		return []model.Element{}
+// source returns ax, instrumented if call statistics are being recorded.
+func (r *DarwinReader) source(ax axSource, app string, pid int) axtree.Source {
+	stats := r.getStats()
+	if stats == nil {
+		return ax
+	}
+	if app == "" {
+		app = fmt.Sprintf("pid %d", pid)
 	}
+	return axtree.Instrument(ax, stats, app)
+}
 
-	cSlice := unsafe.Slice(cElements, count)
+// WindowIDs returns the IDs of the windows ReadElements(opts) traverses, in
+// AXWindows order (see platform.WindowEnumerator).
+func (r *DarwinReader) WindowIDs(opts platform.ReadOptions) ([]int, error) {
+	pid, windowTitle, windowID := r.resolvePIDAndWindow(opts)
+	if pid == 0 {
+		return nil, fmt.Errorf("no target specified: use --app, --pid, --window, or --window-id")
+	}
+	if windowID != 0 {
+		return []int{windowID}, nil
+	}
 
-	// Build flat list of elements
-	type elemEntry struct {
-		elem     model.Element
-		parentID int
+	var axTitles *C.AXWindowTitle
+	var axCount C.int
+	if C.ax_list_window_titles(C.pid_t(pid), &axTitles, &axCount) != 0 {
+		return nil, fmt.Errorf("failed to list windows for PID %d", pid)
+	}
+	defer C.ax_free_window_titles(axTitles, axCount)
+	var ids []int
+	for _, w := range unsafe.Slice(axTitles, int(axCount)) {
+		if windowTitle != "" && !strings.Contains(strings.ToLower(C.GoString(w.title)), strings.ToLower(windowTitle)) {
+			continue
+		}
+		ids = append(ids, int(w.windowID))
 	}
-	entries := make([]elemEntry, count)
-	elemMap := make(map[int]int, count) // id -> index in entries
-	var roots []int
+	return ids, nil
+}
 
-	for i := 0; i < count; i++ {
-		ce := cSlice[i]
-		id := int(ce.id)
-		parentID := int(ce.parentID)
+// SetIncremental enables or disables retaining element handles between
+// reads. Disabling it releases everything retained so far.
+func (r *DarwinReader) SetIncremental(enabled bool) {
+	r.mu.Lock()
+	r.incremental = enabled
+	var dropped map[treeKey]*retainedTree
+	if !enabled {
+		dropped = r.trees
+		r.trees, r.treeOrder = nil, nil
+	}
+	r.mu.Unlock()
+	for _, e := range dropped {
+		e.release()
+	}
+}
 
-		role := model.MapRole(C.GoString(ce.role))
+// SetStats starts recording accessibility call counts and latencies into
+// stats (nil stops recording).
+func (r *DarwinReader) SetStats(stats *axtree.Stats) {
+	r.mu.Lock()
+	defer r.mu.Unlock()
+	r.stats = stats
+}
 
-		var actions []string
-		if ce.actionCount > 0 {
-			cActions := unsafe.Slice(ce.actions, int(ce.actionCount))
-			for j := 0; j < int(ce.actionCount); j++ {
-				actions = append(actions, mapAction(C.GoString(cActions[j])))
-			}
-		}
+func (r *DarwinReader) getStats() *axtree.Stats {
+	r.mu.Lock()
+	defer r.mu.Unlock()
+	return r.stats
+}
 
-		var enabled *bool
-		if ce.enabled == 0 {
-			f := false
-			enabled = &f
-		}
+func (r *DarwinReader) isIncremental() bool {
+	r.mu.Lock()
+	defer r.mu.Unlock()
+	return r.incremental
+}
 
-		subrole := C.GoString(ce.subrole)
-
-		entries[i] = elemEntry{
-			elem: model.Element{
-				ID:          id,
-				Role:        role,
-				Subrole:     subrole,
-				Title:       C.GoString(ce.title),
-				Value:       C.GoString(ce.value),
-				Description: C.GoString(ce.description),
-				Bounds:      [4]int{int(ce.x), int(ce.y), int(ce.width), int(ce.height)},
-				Focused:     ce.focused != 0,
-				Enabled:     enabled,
-				Selected:    ce.selected != 0,
-				Actions:     actions,
-			},
-			parentID: parentID,
+// readIncremental refreshes the retained tree for key, or walks and retains
+// a new one. It takes ownership of roots. Each tree has its own lock, so
+// reads of different scopes (e.g. concurrent per-window reads) proceed in
+// parallel.
+func (r *DarwinReader) readIncremental(key treeKey, src axtree.Source, roots []axtree.Handle, done <-chan struct{}) ([]axtree.Node, error) {
+	r.mu.Lock()
+	e, ok := r.trees[key]
+	var evicted *retainedTree
+	if !ok {
+		if r.trees == nil {
+			r.trees = make(map[treeKey]*retainedTree)
 		}
-		elemMap[id] = i
-
-		if parentID < 0 {
-			roots = append(roots, i)
+		if len(r.treeOrder) >= maxRetainedTrees {
+			oldest := r.treeOrder[0]
+			evicted = r.trees[oldest]
+			r.dropTree(oldest)
 		}
+		e = &retainedTree{}
+		r.trees[key] = e
+		r.treeOrder = append(r.treeOrder, key)
+	}
+	r.mu.Unlock()
+	if evicted != nil {
+		evicted.release()
 	}
 
-	// Build tree bottom-up: assign children to parents
-	// Process in reverse order so children are added in order
-	for i := count - 1; i >= 0; i-- {
-		if entries[i].parentID >= 0 {
-			if pIdx, ok := elemMap[entries[i].parentID]; ok {
-				entries[pIdx].elem.Children = append([]model.Element{entries[i].elem}, entries[pIdx].elem.Children...)
-			}
+	e.mu.Lock()
+	defer e.mu.Unlock()
+	if e.tree != nil {
+		// A canceled refresh leaves the tree as it was, ready for the next.
+		nodes, err := e.tree.RefreshUntil(roots, done)
+		if err != nil && err != axtree.ErrCanceled {
+			e.tree.Release()
+			e.tree = nil
 		}
+		return nodes, err
+	}
+	t, err := axtree.WalkTree(src, roots, axtree.Options{MaxDepth: key.depth, TextLimit: key.textLimit, Done: done})
+	if err == axtree.ErrCanceled {
+		return t.Nodes(), err
 	}
+	if err != nil {
+		return nil, err
+	}
+	if e.dropped {
+		// Evicted while walking: nothing would ever release it.
+		t.Release()
+		return t.Nodes(), nil
+	}
+	e.tree = t
+	return t.Nodes(), nil
+}
 
-	// Update children recursively since we built with copies
-	// We need to rebuild from roots using the final entries
-	var buildTree func(idx int) model.Element
-	buildTree = func(idx int) model.Element {
-		elem := entries[idx].elem
-		if len(elem.Children) > 0 {
-			rebuilt := make([]model.Element, 0, len(elem.Children))
-			for _, child := range elem.Children {
-				if childIdx, ok := elemMap[child.ID]; ok {
-					rebuilt = append(rebuilt, buildTree(childIdx))
-				}
-			}
-			elem.Children = rebuilt
-		}
-		return elem
+// retainedTree is one entry of an incremental reader's tree cache. tree is
+// nil until the first walk succeeds and after a failed refresh.
+type retainedTree struct {
+	mu      sync.Mutex
+	tree    *axtree.Tree
+	dropped bool // removed from the cache; must not retain a tree again
+}
+
+// release releases the entry's tree once any read using it has finished.
+func (e *retainedTree) release() {
+	e.mu.Lock()
+	defer e.mu.Unlock()
+	e.dropped = true
+	if e.tree != nil {
+		e.tree.Release()
+		e.tree = nil
 	}
+}
 
-	result := make([]model.Element, 0, len(roots))
-	for _, ri := range roots {
-		result = append(result, buildTree(ri))
+// dropTree forgets the retained tree for key (without releasing it).
+func (r *DarwinReader) dropTree(key treeKey) {
+	delete(r.trees, key)
+	for i, k := range r.treeOrder {
+		if k == key {
+			r.treeOrder = append(r.treeOrder[:i], r.treeOrder[i+1:]...)
+			break
+		}
 	}
-	return result
+}
+
+// resolvePIDAndWindow resolves the target PID from --app, --pid, --window, or --window-id.
+func (r *DarwinReader) resolvePIDAndWindow(opts platform.ReadOptions) (pid int, windowTitle string, windowID int) {
+	return r.windows.Resolve(opts)
 }
@@ -16,7 +16,6 @@ import (
 	"image/draw"
 	"image/jpeg"
 	"image/png"
-	"strings"
 	"unsafe"
 
 	"github.com/mj1618/desktop-cli/internal/platform"
@@ -182,32 +181,9 @@ func encodeImage(img image.Image, format, quality int) ([]byte, error) {
 
 // resolveWindowID finds the window ID matching the given options.
 func (s *DarwinScreenshotter) resolveWindowID(opts platform.ScreenshotOptions) (int, error) {
-	listOpts := platform.ListOptions{}
-	if opts.App != "" {
-		listOpts.App = opts.App
-	}
-	if opts.PID != 0 {
-		listOpts.PID = opts.PID
-	}
-
-	windows, err := s.reader.ListWindows(listOpts)
+	w, err := s.reader.windows.Lookup(platform.ListOptions{App: opts.App, PID: opts.PID}, opts.Window, 0)
 	if err != nil {
-		return 0, fmt.Errorf("failed to list windows: %w", err)
-	}
-	if len(windows) == 0 {
-		return 0, fmt.Errorf("no windows found matching the specified criteria")
+		return 0, err
 	}
-
-	// If a window title filter is specified, find the matching window
-	if opts.Window != "" {
-		for _, w := range windows {
-			if strings.Contains(strings.ToLower(w.Title), strings.ToLower(opts.Window)) {
-				return w.ID, nil
-			}
-		}
-		return 0, fmt.Errorf("no window found matching title %q", opts.Window)
-	}
-
-	// Return the first matching window
-	return windows[0].ID, nil
+	return w.ID, nil
 }
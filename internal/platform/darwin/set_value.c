@@ -3,6 +3,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
+#include "accessibility.h"
 #include "set_value.h"
 
 // Helper: copy CFString to C string (caller frees).
@@ -43,42 +44,106 @@ static int setval_get_window_id(AXUIElementRef windowElem) {
     return 0;
 }
 
-// Recursively traverse the tree in the same order as ax_traverse in accessibility.c,
-// looking for the element at targetIndex. Returns the AXUIElementRef (retained) or NULL.
-static AXUIElementRef setval_find_element_by_index(AXUIElementRef elem, int targetIndex,
-                                                    int currentDepth, int maxDepth, int* nextID) {
+static void setval_activate_enhanced_ui(AXUIElementRef app);
+
+// Recursively traverse the tree in the same order as axtree.Walk, retaining
+// in found[j] the element at indices[j] for each j not found yet. Returns
+// how many of them are still missing, stopping as soon as none are.
+static int setval_collect_by_index(AXUIElementRef elem, const int* indices, AXUIElementRef* found,
+                                   int count, int missing, int currentDepth, int maxDepth, int* nextID) {
     if (maxDepth > 0 && currentDepth > maxDepth) {
-        return NULL;
+        return missing;
     }
 
     int myID = (*nextID)++;
 
-    if (myID == targetIndex) {
-        CFRetain(elem);
-        return elem;
+    for (int j = 0; j < count; j++) {
+        if (indices[j] == myID && !found[j]) {
+            CFRetain(elem);
+            found[j] = elem;
+            missing--;
+        }
+    }
+    if (missing == 0) {
+        return 0;
     }
 
-    // Recurse into children (same condition as ax_traverse)
+    // Recurse into children (same condition as axtree.Walk)
     if (maxDepth == 0 || currentDepth < maxDepth) {
         CFTypeRef children = NULL;
         AXError err = AXUIElementCopyAttributeValue(elem, kAXChildrenAttribute, &children);
         if (err == kAXErrorSuccess && children && CFGetTypeID(children) == CFArrayGetTypeID()) {
             CFArrayRef childArray = (CFArrayRef)children;
             CFIndex childCount = CFArrayGetCount(childArray);
-            for (CFIndex i = 0; i < childCount; i++) {
+            for (CFIndex i = 0; i < childCount && missing > 0; i++) {
                 AXUIElementRef child = (AXUIElementRef)CFArrayGetValueAtIndex(childArray, i);
-                AXUIElementRef found = setval_find_element_by_index(child, targetIndex,
-                                                                     currentDepth + 1, maxDepth, nextID);
-                if (found) {
-                    CFRelease(children);
-                    return found;
-                }
+                missing = setval_collect_by_index(child, indices, found, count, missing,
+                                                  currentDepth + 1, maxDepth, nextID);
             }
         }
         if (children) CFRelease(children);
     }
 
-    return NULL;
+    return missing;
+}
+
+// Find the elements at the given traversal indices in one traversal of the
+// matching windows, retaining each in found. Indices <= 0 are skipped.
+static void setval_find_by_indices(pid_t pid, const char* windowTitle, int windowID, int maxDepth,
+                                   const int* indices, AXUIElementRef* found, int count, int missing) {
+    AXUIElementRef app = AXUIElementCreateApplication(pid);
+    if (!app) return;
+
+    // Activate enhanced UI to ensure Chrome exposes web content
+    setval_activate_enhanced_ui(app);
+
+    // Get windows
+    CFTypeRef windowsValue = NULL;
+    AXError err = AXUIElementCopyAttributeValue(app, kAXWindowsAttribute, &windowsValue);
+    if (err != kAXErrorSuccess || !windowsValue) {
+        CFRelease(app);
+        return;
+    }
+
+    if (CFGetTypeID(windowsValue) != CFArrayGetTypeID()) {
+        CFRelease(windowsValue);
+        CFRelease(app);
+        return;
+    }
+
+    CFArrayRef windows = (CFArrayRef)windowsValue;
+    CFIndex windowCount = CFArrayGetCount(windows);
+
+    int nextID = 1;
+
+    // Iterate windows in the same order as ax_copy_windows
+    for (CFIndex i = 0; i < windowCount && missing > 0; i++) {
+        AXUIElementRef win = (AXUIElementRef)CFArrayGetValueAtIndex(windows, i);
+
+        // Filter by window ID if specified
+        if (windowID > 0) {
+            int wid = setval_get_window_id(win);
+            if (wid != windowID) {
+                continue;
+            }
+        }
+
+        // Filter by window title if specified
+        if (windowTitle && windowTitle[0] != '\0') {
+            char* title = setval_get_string_attr(win, kAXTitleAttribute);
+            int match = (title && strcasestr(title, windowTitle) != NULL);
+            free(title);
+            if (!match) {
+                continue;
+            }
+        }
+
+        // Search this window's element tree
+        missing = setval_collect_by_index(win, indices, found, count, missing, 1, maxDepth, &nextID);
+    }
+
+    CFRelease(windows);
+    CFRelease(app);
 }
 
 // Create the appropriate CFTypeRef value based on the current attribute type.
@@ -144,86 +209,73 @@ static void setval_activate_enhanced_ui(AXUIElementRef app) {
     }
 }
 
-int ax_set_value(pid_t pid, const char* windowTitle, int windowID,
-                 int maxDepth, int elementIndex, const char* attributeName,
-                 const char* value) {
-    AXUIElementRef app = AXUIElementCreateApplication(pid);
-    if (!app) return -1;
-
-    // Activate enhanced UI to ensure Chrome exposes web content
-    setval_activate_enhanced_ui(app);
-
-    // Get windows
-    CFTypeRef windowsValue = NULL;
-    AXError err = AXUIElementCopyAttributeValue(app, kAXWindowsAttribute, &windowsValue);
-    if (err != kAXErrorSuccess || !windowsValue) {
-        CFRelease(app);
-        return -1;
-    }
-
-    if (CFGetTypeID(windowsValue) != CFArrayGetTypeID()) {
-        CFRelease(windowsValue);
-        CFRelease(app);
-        return -1;
-    }
-
-    CFArrayRef windows = (CFArrayRef)windowsValue;
-    CFIndex windowCount = CFArrayGetCount(windows);
-
-    int nextID = 1;
-    AXUIElementRef foundElement = NULL;
-
-    // Iterate windows in the same order as ax_read_elements
-    for (CFIndex i = 0; i < windowCount && !foundElement; i++) {
-        AXUIElementRef win = (AXUIElementRef)CFArrayGetValueAtIndex(windows, i);
-
-        // Filter by window ID if specified
-        if (windowID > 0) {
-            int wid = setval_get_window_id(win);
-            if (wid != windowID) {
-                continue;
-            }
-        }
-
-        // Filter by window title if specified
-        if (windowTitle && windowTitle[0] != '\0') {
-            char* title = setval_get_string_attr(win, kAXTitleAttribute);
-            int match = (title && strcasestr(title, windowTitle) != NULL);
-            free(title);
-            if (!match) {
-                continue;
-            }
-        }
-
-        // Search this window's element tree
-        foundElement = setval_find_element_by_index(win, elementIndex, 1, maxDepth, &nextID);
-    }
-
-    CFRelease(windows);
-    CFRelease(app);
-
-    if (!foundElement) return -1;
-
+// Set attributeName on elem from its string form and release elem.
+static int setval_set_on(AXUIElementRef elem, const char* attributeName, const char* value) {
     // Create the attribute name CFString
     CFStringRef attrName = CFStringCreateWithCString(kCFAllocatorDefault, attributeName, kCFStringEncodingUTF8);
 
     // Create the typed value
-    CFTypeRef cfValue = create_typed_value(foundElement, attrName, value);
+    CFTypeRef cfValue = create_typed_value(elem, attrName, value);
     if (!cfValue) {
         CFRelease(attrName);
-        CFRelease(foundElement);
+        CFRelease(elem);
         return -1;
     }
 
     // Set the value
-    AXError result = AXUIElementSetAttributeValue(foundElement, attrName, cfValue);
+    AXError result = AXUIElementSetAttributeValue(elem, attrName, cfValue);
 
     // Clean up — don't release CFBoolean singletons
     if (cfValue != kCFBooleanTrue && cfValue != kCFBooleanFalse) {
         CFRelease(cfValue);
     }
     CFRelease(attrName);
-    CFRelease(foundElement);
+    CFRelease(elem);
 
     return (result == kAXErrorSuccess) ? 0 : -1;
 }
+
+int ax_set_value(pid_t pid, const char* windowTitle, int windowID,
+                 int maxDepth, int elementIndex, const int* path, int pathLen,
+                 const char* attributeName, const char* value) {
+    int result = -1;
+    ax_set_values(pid, windowTitle, windowID, maxDepth, 1, &elementIndex, path, &pathLen,
+                  &attributeName, &value, &result);
+    return result;
+}
+
+void ax_set_values(pid_t pid, const char* windowTitle, int windowID, int maxDepth, int count,
+                   const int* elementIndexes, const int* paths, const int* pathLens,
+                   const char* const* attributeNames, const char* const* values, int* results) {
+    AXUIElementRef* found = (AXUIElementRef*)calloc(count, sizeof(AXUIElementRef));
+    if (!found) {
+        for (int j = 0; j < count; j++) results[j] = -1;
+        return;
+    }
+
+    // Elements with a path are looked up directly; the rest are found
+    // together in one traversal.
+    int missing = 0;
+    int* indices = (int*)calloc(count, sizeof(int));
+    const int* path = paths;
+    for (int j = 0; j < count; j++) {
+        if (pathLens[j] > 0) {
+            found[j] = ax_copy_element_at_path(pid, windowTitle, windowID, path, pathLens[j]);
+            path += pathLens[j];
+        } else if (elementIndexes[j] > 0 && indices) {
+            indices[j] = elementIndexes[j];
+            missing++;
+        }
+    }
+    if (missing > 0) {
+        setval_find_by_indices(pid, windowTitle, windowID, maxDepth, indices, found, count, missing);
+    }
+    free(indices);
+
+    // Set the values only once every element is resolved, since setting one
+    // may change the tree the indices refer to.
+    for (int j = 0; j < count; j++) {
+        results[j] = found[j] ? setval_set_on(found[j], attributeNames[j], values[j]) : -1;
+    }
+    free(found);
+}
@@ -4,17 +4,32 @@
 #include <ApplicationServices/ApplicationServices.h>
 
 // Set an accessibility attribute value on the element at the given traversal index.
-// Uses the same traversal order as ax_read_elements.
+// Uses the same traversal order as the reader (axtree.Walk).
 // pid: target process ID
 // windowTitle: filter to window matching this title (NULL = no filter)
 // windowID: filter to specific window ID (0 = no filter)
 // maxDepth: max traversal depth (0 = unlimited), must match the read call
 // elementIndex: element ID from read output (1-based)
+// path, pathLen: child-index path of the element (see ax_copy_element_at_path);
+//                when pathLen > 0 it is used instead of elementIndex
 // attributeName: AX attribute name (e.g. "AXValue", "AXSelected", "AXFocused")
 // value: string representation of the value to set
 // Returns 0 on success, -1 on failure.
 int ax_set_value(pid_t pid, const char* windowTitle, int windowID,
-                 int maxDepth, int elementIndex, const char* attributeName,
-                 const char* value);
+                 int maxDepth, int elementIndex, const int* path, int pathLen,
+                 const char* attributeName, const char* value);
+
+// Set several attribute values, as ax_set_value does for each, resolving all
+// the elements before setting any: elements with a path are looked up
+// directly and the rest in a single traversal.
+// count: number of values
+// elementIndexes: element ID of each value (used when its pathLen is 0)
+// paths: the child-index paths of all values, concatenated
+// pathLens: length of each value's path in paths (0 = look up by index)
+// attributeNames, values: attribute and value of each value
+// results: set to 0 for each value that was set, -1 otherwise.
+void ax_set_values(pid_t pid, const char* windowTitle, int windowID, int maxDepth, int count,
+                   const int* elementIndexes, const int* paths, const int* pathLens,
+                   const char* const* attributeNames, const char* const* values, int* results);
 
 #endif
@@ -0,0 +1,182 @@
+#include <ApplicationServices/ApplicationServices.h>
+#include <CoreFoundation/CoreFoundation.h>
+#include <stdlib.h>
+#include <string.h>
+#include "accessibility.h"
+#include "text.h"
+
+// Helper: copy CFString to C string (caller frees).
+static char* text_cfstring_to_cstring(CFStringRef str) {
+    if (!str) return strdup("");
+    CFIndex len = CFStringGetLength(str);
+    CFIndex maxSize = CFStringGetMaximumSizeForEncoding(len, kCFStringEncodingUTF8) + 1;
+    char* buf = (char*)malloc(maxSize);
+    if (!CFStringGetCString(str, buf, maxSize, kCFStringEncodingUTF8)) {
+        buf[0] = '\0';
+    }
+    return buf;
+}
+
+// Helper: get a string attribute from an AX element.
+static char* text_get_string_attr(AXUIElementRef elem, CFStringRef attr) {
+    CFTypeRef value = NULL;
+    AXError err = AXUIElementCopyAttributeValue(elem, attr, &value);
+    if (err != kAXErrorSuccess || !value) {
+        return strdup("");
+    }
+    if (CFGetTypeID(value) == CFStringGetTypeID()) {
+        char* result = text_cfstring_to_cstring((CFStringRef)value);
+        CFRelease(value);
+        return result;
+    }
+    CFRelease(value);
+    return strdup("");
+}
+
+// Match a CGWindowID from an AXUIElement window.
+static int text_get_window_id(AXUIElementRef windowElem) {
+    CGWindowID windowID = 0;
+    extern AXError _AXUIElementGetWindow(AXUIElementRef, CGWindowID*);
+    if (_AXUIElementGetWindow(windowElem, &windowID) == kAXErrorSuccess) {
+        return (int)windowID;
+    }
+    return 0;
+}
+
+// Recursively traverse the tree in the same order as axtree.Walk,
+// looking for the element at targetIndex. Returns the AXUIElementRef (retained) or NULL.
+static AXUIElementRef text_find_element_by_index(AXUIElementRef elem, int targetIndex,
+                                                 int currentDepth, int maxDepth, int* nextID) {
+    if (maxDepth > 0 && currentDepth > maxDepth) {
+        return NULL;
+    }
+
+    int myID = (*nextID)++;
+
+    if (myID == targetIndex) {
+        CFRetain(elem);
+        return elem;
+    }
+
+    // Recurse into children (same condition as axtree.Walk)
+    if (maxDepth == 0 || currentDepth < maxDepth) {
+        CFTypeRef children = NULL;
+        AXError err = AXUIElementCopyAttributeValue(elem, kAXChildrenAttribute, &children);
+        if (err == kAXErrorSuccess && children && CFGetTypeID(children) == CFArrayGetTypeID()) {
+            CFArrayRef childArray = (CFArrayRef)children;
+            CFIndex childCount = CFArrayGetCount(childArray);
+            for (CFIndex i = 0; i < childCount; i++) {
+                AXUIElementRef child = (AXUIElementRef)CFArrayGetValueAtIndex(childArray, i);
+                AXUIElementRef found = text_find_element_by_index(child, targetIndex,
+                                                                  currentDepth + 1, maxDepth, nextID);
+                if (found) {
+                    CFRelease(children);
+                    return found;
+                }
+            }
+        }
+        if (children) CFRelease(children);
+    }
+
+    return NULL;
+}
+
+// Number of characters of the element's text content (AXNumberOfCharacters),
+// or 0 if it does not expose one.
+static int text_length(AXUIElementRef elem) {
+    CFTypeRef value = NULL;
+    AXError err = AXUIElementCopyAttributeValue(elem, CFSTR("AXNumberOfCharacters"), &value);
+    if (err != kAXErrorSuccess || !value) {
+        return 0;
+    }
+    int n = 0;
+    if (CFGetTypeID(value) == CFNumberGetTypeID()) {
+        CFNumberGetValue((CFNumberRef)value, kCFNumberIntType, &n);
+    }
+    CFRelease(value);
+    return n;
+}
+
+// Copy up to maxChars characters of elem's text and release elem.
+static void text_read_from(AXUIElementRef elem, int maxChars, char** outText, int* outLength) {
+    // Prefer the element's text content; fall back to its string value for
+    // elements without text attributes.
+    int length = text_length(elem);
+    char* text = NULL;
+    if (length > 0) {
+        int n = (maxChars > 0 && maxChars < length) ? maxChars : length;
+        text = ax_copy_text(elem, n);
+    }
+    if (!text) {
+        text = text_get_string_attr(elem, kAXValueAttribute);
+        length = 0;
+    }
+    CFRelease(elem);
+
+    *outText = text;
+    *outLength = length;
+}
+
+int ax_read_text(pid_t pid, const char* windowTitle, int windowID,
+                 int maxDepth, int elementIndex, const int* path, int pathLen,
+                 int maxChars, char** outText, int* outLength) {
+    *outText = NULL;
+    *outLength = 0;
+
+    if (pathLen > 0) {
+        AXUIElementRef elem = ax_copy_element_at_path(pid, windowTitle, windowID, path, pathLen);
+        if (!elem) return -1;
+        text_read_from(elem, maxChars, outText, outLength);
+        return 0;
+    }
+
+    AXUIElementRef app = AXUIElementCreateApplication(pid);
+    if (!app) return -1;
+
+    CFTypeRef windowsValue = NULL;
+    AXError err = AXUIElementCopyAttributeValue(app, kAXWindowsAttribute, &windowsValue);
+    if (err != kAXErrorSuccess || !windowsValue) {
+        CFRelease(app);
+        return -1;
+    }
+
+    if (CFGetTypeID(windowsValue) != CFArrayGetTypeID()) {
+        CFRelease(windowsValue);
+        CFRelease(app);
+        return -1;
+    }
+
+    CFArrayRef windows = (CFArrayRef)windowsValue;
+    CFIndex windowCount = CFArrayGetCount(windows);
+
+    int nextID = 1;
+    AXUIElementRef foundElement = NULL;
+
+    // Iterate windows in the same order as ax_copy_windows
+    for (CFIndex i = 0; i < windowCount && !foundElement; i++) {
+        AXUIElementRef win = (AXUIElementRef)CFArrayGetValueAtIndex(windows, i);
+
+        if (windowID > 0 && text_get_window_id(win) != windowID) {
+            continue;
+        }
+
+        if (windowTitle && windowTitle[0] != '\0') {
+            char* title = text_get_string_attr(win, kAXTitleAttribute);
+            int match = (title && strcasestr(title, windowTitle) != NULL);
+            free(title);
+            if (!match) {
+                continue;
+            }
+        }
+
+        foundElement = text_find_element_by_index(win, elementIndex, 1, maxDepth, &nextID);
+    }
+
+    CFRelease(windows);
+    CFRelease(app);
+
+    if (!foundElement) return -1;
+
+    text_read_from(foundElement, maxChars, outText, outLength);
+    return 0;
+}
@@ -0,0 +1,24 @@
+#ifndef TEXT_H
+#define TEXT_H
+
+#include <ApplicationServices/ApplicationServices.h>
+
+// Read the full text content of the element at the given traversal index.
+// Uses the same traversal order as the reader (axtree.Walk).
+// pid: target process ID
+// windowTitle: filter to window matching this title (NULL = no filter)
+// windowID: filter to specific window ID (0 = no filter)
+// maxDepth: max traversal depth (0 = unlimited), must match the read call
+// elementIndex: element ID from read output (1-based)
+// path, pathLen: child-index path of the element (see ax_copy_element_at_path);
+//                when pathLen > 0 it is used instead of elementIndex
+// maxChars: max characters to return (0 = all)
+// outText: receives the text (caller frees with free())
+// outLength: receives the element's full text length in characters, or 0 if
+//            the text is the element's AXValue (returned whole)
+// Returns 0 on success, -1 if the element was not found.
+int ax_read_text(pid_t pid, const char* windowTitle, int windowID,
+                 int maxDepth, int elementIndex, const int* path, int pathLen,
+                 int maxChars, char** outText, int* outLength);
+
+#endif
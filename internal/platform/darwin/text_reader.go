@@ -0,0 +1,76 @@
+//go:build darwin
+
+package darwin
+
+/*
+#cgo CFLAGS: -x objective-c
+#cgo LDFLAGS: -framework ApplicationServices -framework CoreFoundation -framework Foundation
+#include "text.h"
+#include <stdlib.h>
+*/
+import "C"
+
+import (
+	"fmt"
+	"unsafe"
+
+	"github.com/mj1618/desktop-cli/internal/platform"
+)
+
+// DarwinTextReader implements the platform.TextReader interface for macOS.
+type DarwinTextReader struct {
+	reader *DarwinReader
+}
+
+// NewTextReader creates a new macOS text reader.
+func NewTextReader(reader *DarwinReader) *DarwinTextReader {
+	return &DarwinTextReader{reader: reader}
+}
+
+func (t *DarwinTextReader) ReadText(opts platform.ReadTextOptions) (string, int, error) {
+	if opts.ID <= 0 && len(opts.Path) == 0 {
+		return "", 0, fmt.Errorf("--id is required")
+	}
+
+	if err := CheckAccessibilityPermission(); err != nil {
+		return "", 0, err
+	}
+
+	readOpts := platform.ReadOptions{
+		App:      opts.App,
+		Window:   opts.Window,
+		WindowID: opts.WindowID,
+		PID:      opts.PID,
+	}
+	pid, windowTitle, windowID := t.reader.resolvePIDAndWindow(readOpts)
+	if pid == 0 {
+		return "", 0, fmt.Errorf("no target specified: use --app, --pid, --window, or --window-id")
+	}
+
+	cWindowTitle := (*C.char)(nil)
+	if windowTitle != "" {
+		cWindowTitle = C.CString(windowTitle)
+		defer C.free(unsafe.Pointer(cWindowTitle))
+	}
+
+	var cText *C.char
+	var cLength C.int
+	path, pathLen := cPath(opts.Path)
+	rc := C.ax_read_text(C.pid_t(pid), cWindowTitle, C.int(windowID),
+		C.int(0), C.int(opts.ID), path, pathLen, C.int(opts.MaxChars), &cText, &cLength)
+	if rc != 0 {
+		return "", 0, fmt.Errorf("element %d not found%s", opts.ID, pathNote(opts.Path))
+	}
+	defer C.free(unsafe.Pointer(cText))
+
+	text, length := C.GoString(cText), int(cLength)
+	// The AXValue fallback comes back whole; apply the limit here.
+	if length == 0 {
+		r := []rune(text)
+		length = len(r)
+		if opts.MaxChars > 0 && len(r) > opts.MaxChars {
+			text = string(r[:opts.MaxChars])
+		}
+	}
+	return text, length, nil
+}
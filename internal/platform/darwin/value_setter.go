@@ -28,7 +28,7 @@ func NewValueSetter(reader *DarwinReader) *DarwinValueSetter {
 }
 
 func (s *DarwinValueSetter) SetValue(opts platform.SetValueOptions) error {
-	if opts.ID <= 0 {
+	if opts.ID <= 0 && len(opts.Path) == 0 {
 		return fmt.Errorf("--id is required")
 	}
 
@@ -48,18 +48,7 @@ func (s *DarwinValueSetter) SetValue(opts platform.SetValueOptions) error {
 		return fmt.Errorf("no target specified: use --app, --pid, --window, or --window-id")
 	}
 
-	// Map short attribute name to full AX attribute name
-	attribute := "AXValue"
-	switch opts.Attribute {
-	case "", "value":
-		attribute = "AXValue"
-	case "selected":
-		attribute = "AXSelected"
-	case "focused":
-		attribute = "AXFocused"
-	default:
-		attribute = opts.Attribute
-	}
+	attribute := axAttribute(opts.Attribute)
 
 	cWindowTitle := (*C.char)(nil)
 	if windowTitle != "" {
@@ -73,11 +62,101 @@ func (s *DarwinValueSetter) SetValue(opts platform.SetValueOptions) error {
 	cValue := C.CString(opts.Value)
 	defer C.free(unsafe.Pointer(cValue))
 
+	path, pathLen := cPath(opts.Path)
 	rc := C.ax_set_value(C.pid_t(pid), cWindowTitle, C.int(windowID),
-		C.int(0), C.int(opts.ID), cAttribute, cValue)
+		C.int(0), C.int(opts.ID), path, pathLen, cAttribute, cValue)
 	if rc != 0 {
-		return fmt.Errorf("failed to set %s=%q on element %d", attribute, opts.Value, opts.ID)
+		return fmt.Errorf("failed to set %s=%q on element %d%s", attribute, opts.Value, opts.ID, pathNote(opts.Path))
 	}
 
 	return nil
 }
+
+// SetValues sets all the values with one call into C, which finds the
+// elements given by ID in a single traversal.
+func (s *DarwinValueSetter) SetValues(opts platform.SetValuesOptions) []error {
+	errs := make([]error, len(opts.Values))
+	fail := func(err error) []error {
+		for i := range errs {
+			errs[i] = err
+		}
+		return errs
+	}
+	if len(opts.Values) == 0 {
+		return errs
+	}
+	for _, v := range opts.Values {
+		if v.ID <= 0 && len(v.Path) == 0 {
+			return fail(fmt.Errorf("--id is required"))
+		}
+	}
+
+	if err := CheckAccessibilityPermission(); err != nil {
+		return fail(err)
+	}
+
+	readOpts := platform.ReadOptions{
+		App:      opts.App,
+		Window:   opts.Window,
+		WindowID: opts.WindowID,
+		PID:      opts.PID,
+	}
+	pid, windowTitle, windowID := s.reader.resolvePIDAndWindow(readOpts)
+	if pid == 0 {
+		return fail(fmt.Errorf("no target specified: use --app, --pid, --window, or --window-id"))
+	}
+
+	cWindowTitle := (*C.char)(nil)
+	if windowTitle != "" {
+		cWindowTitle = C.CString(windowTitle)
+		defer C.free(unsafe.Pointer(cWindowTitle))
+	}
+
+	n := len(opts.Values)
+	indexes := make([]C.int, n)
+	pathLens := make([]C.int, n)
+	var paths []C.int // all the paths, concatenated
+	attributes := make([]*C.char, n)
+	values := make([]*C.char, n)
+	results := make([]C.int, n)
+	for i, v := range opts.Values {
+		indexes[i] = C.int(v.ID)
+		pathLens[i] = C.int(len(v.Path))
+		for _, p := range v.Path {
+			paths = append(paths, C.int(p))
+		}
+		attributes[i] = C.CString(axAttribute(v.Attribute))
+		defer C.free(unsafe.Pointer(attributes[i]))
+		values[i] = C.CString(v.Value)
+		defer C.free(unsafe.Pointer(values[i]))
+	}
+
+	var cPaths *C.int
+	if len(paths) > 0 {
+		cPaths = &paths[0]
+	}
+
+	C.ax_set_values(C.pid_t(pid), cWindowTitle, C.int(windowID), C.int(0), C.int(n),
+		&indexes[0], cPaths, &pathLens[0], &attributes[0], &values[0], &results[0])
+	for i, rc := range results {
+		if rc != 0 {
+			v := opts.Values[i]
+			errs[i] = fmt.Errorf("failed to set %s=%q on element %d%s", axAttribute(v.Attribute), v.Value, v.ID, pathNote(v.Path))
+		}
+	}
+	return errs
+}
+
+// axAttribute maps a short attribute name to the full AX attribute name.
+func axAttribute(short string) string {
+	switch short {
+	case "", "value":
+		return "AXValue"
+	case "selected":
+		return "AXSelected"
+	case "focused":
+		return "AXFocused"
+	default:
+		return short
+	}
+}
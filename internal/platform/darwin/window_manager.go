@@ -11,7 +11,6 @@ package darwin
 import "C"
 import (
 	"fmt"
-	"strings"
 	"unsafe"
 
 	"github.com/mj1618/desktop-cli/internal/platform"
@@ -34,56 +33,31 @@ func (wm *DarwinWindowManager) FocusWindow(opts platform.FocusOptions) error {
 
 	pid := opts.PID
 
-	// Resolve PID from --app if needed
-	if pid == 0 && opts.App != "" {
-		windows, err := wm.reader.ListWindows(platform.ListOptions{App: opts.App})
-		if err != nil {
-			return fmt.Errorf("failed to find app %q: %w", opts.App, err)
-		}
-		if len(windows) == 0 {
-			return fmt.Errorf("no windows found for app %q", opts.App)
+	// Resolve PID from --app, --window-id or --window (title match)
+	if pid == 0 && (opts.App != "" || opts.WindowID > 0 || opts.Window != "") {
+		var title string
+		var windowID int
+		switch {
+		case opts.App != "":
+		case opts.WindowID > 0:
+			windowID = opts.WindowID
+		default:
+			title = opts.Window
 		}
-		pid = windows[0].PID
-	}
-
-	// Resolve PID from --window-id
-	if pid == 0 && opts.WindowID > 0 {
-		windows, err := wm.reader.ListWindows(platform.ListOptions{})
+		w, err := wm.reader.windows.Lookup(platform.ListOptions{App: opts.App}, title, windowID)
 		if err != nil {
-			return fmt.Errorf("failed to list windows: %w", err)
-		}
-		for _, w := range windows {
-			if w.ID == opts.WindowID {
-				pid = w.PID
-				break
-			}
-		}
-		if pid == 0 {
-			return fmt.Errorf("no window found with ID %d", opts.WindowID)
-		}
-	}
-
-	// Resolve PID from --window (title match)
-	if pid == 0 && opts.Window != "" {
-		windows, err := wm.reader.ListWindows(platform.ListOptions{})
-		if err != nil {
-			return fmt.Errorf("failed to list windows: %w", err)
-		}
-		for _, w := range windows {
-			if strings.Contains(strings.ToLower(w.Title), strings.ToLower(opts.Window)) {
-				pid = w.PID
-				break
-			}
-		}
-		if pid == 0 {
-			return fmt.Errorf("no window found matching title %q", opts.Window)
+			return err
 		}
+		pid = w.PID
 	}
 
 	if pid == 0 {
 		return fmt.Errorf("could not resolve target: specify --app, --pid, --window, or --window-id")
 	}
 
+	// Focus changes the focused flag and order of the window list.
+	defer wm.reader.windows.Invalidate()
+
 	// If a specific window is targeted, raise it via AX API
 	if opts.Window != "" || opts.WindowID > 0 {
 		var cTitle *C.char
@@ -0,0 +1,463 @@
+// Package fake provides an in-memory platform.Reader, platform.ValueSetter
+// and platform.ActionPerformer with injectable latency, for testing and
+// benchmarking reader wrappers without a desktop.
+package fake
+
+import (
+	"context"
+	"fmt"
+	"strings"
+	"sync"
+	"sync/atomic"
+	"time"
+
+	"github.com/mj1618/desktop-cli/internal/axtree"
+	"github.com/mj1618/desktop-cli/internal/model"
+	"github.com/mj1618/desktop-cli/internal/platform"
+)
+
+// Window is one window of the fake app. Reads return it as a "window"
+// element with Elements as its children.
+type Window struct {
+	ID       int
+	Title    string
+	Elements []model.Element // the window's content; IDs and paths are assigned on read
+}
+
+// Reader serves reads of one app's windows. Like the platform readers it
+// numbers elements in pre-order from 1 across the windows it reads, and it
+// implements platform.WindowEnumerator. It is also a platform.ValueSetter
+// that sets values in Windows, and a platform.ActionPerformer that records
+// the actions it performs.
+type Reader struct {
+	App     string
+	PID     int
+	Windows []Window
+
+	// Latency is the time each element costs to read, simulating the
+	// cross-process accessibility calls of a real reader.
+	Latency time.Duration
+
+	reads   atomic.Int64
+	lookups atomic.Int64
+
+	mu        sync.Mutex
+	performed []string
+}
+
+// Reads returns the number of ReadElements and StreamElements calls made so
+// far.
+func (r *Reader) Reads() int { return int(r.reads.Load()) }
+
+// Lookups returns the number of traversals the value setters and action
+// performers made so far to find elements by ID.
+func (r *Reader) Lookups() int { return int(r.lookups.Load()) }
+
+func (r *Reader) matches(opts platform.ReadOptions) error {
+	if opts.App != "" && !strings.EqualFold(opts.App, r.App) {
+		return fmt.Errorf("app %q not found", opts.App)
+	}
+	if opts.PID != 0 && opts.PID != r.PID {
+		return fmt.Errorf("pid %d not found", opts.PID)
+	}
+	return nil
+}
+
+// windows returns the windows a read with opts covers.
+func (r *Reader) windows(opts platform.ReadOptions) []Window {
+	var out []Window
+	for _, w := range r.Windows {
+		if opts.WindowID != 0 && w.ID != opts.WindowID {
+			continue
+		}
+		if opts.Window != "" && !strings.Contains(strings.ToLower(w.Title), strings.ToLower(opts.Window)) {
+			continue
+		}
+		out = append(out, w)
+	}
+	return out
+}
+
+// tree returns the unfiltered tree a read with opts returns and its size.
+func (r *Reader) tree(opts platform.ReadOptions) ([]model.Element, int) {
+	nextID := 1
+	elements := []model.Element{}
+	if len(opts.Scope) > 0 {
+		root, ok := r.Resolve(opts, opts.Scope)
+		if !ok {
+			return elements, 0
+		}
+		// Numbered from where a full read reaches it, like the platform
+		// readers, so that its IDs resolve in lookups.
+		before := r.countBefore(opts, opts.Scope)
+		nextID += before
+		root.Path = append([]int(nil), opts.Scope...)
+		elements = copyTree([]model.Element{root}, &nextID, nil, 1, opts.Depth)
+		return elements, nextID - 1 - before
+	}
+	for i, w := range r.windows(opts) {
+		root := model.Element{Role: "window", Title: w.Title, Path: []int{i}, Children: w.Elements}
+		elements = append(elements, copyTree([]model.Element{root}, &nextID, nil, 1, opts.Depth)...)
+	}
+	return elements, nextID - 1
+}
+
+func (r *Reader) ReadElements(opts platform.ReadOptions) ([]model.Element, error) {
+	return r.ReadElementsContext(context.Background(), opts)
+}
+
+// ReadElementsContext implements platform.ContextReader: when ctx is done
+// before all elements have been paid for, it returns the elements read by
+// then.
+func (r *Reader) ReadElementsContext(ctx context.Context, opts platform.ReadOptions) ([]model.Element, error) {
+	r.reads.Add(1)
+	if err := r.matches(opts); err != nil {
+		return nil, err
+	}
+	elements, n := r.tree(opts)
+
+	var err error
+	start := time.Now()
+	timer := time.NewTimer(time.Duration(n) * r.Latency)
+	defer timer.Stop()
+	select {
+	case <-timer.C:
+	case <-ctx.Done():
+		read := 0
+		if r.Latency > 0 {
+			read = int(time.Since(start) / r.Latency)
+		}
+		if opts.BreadthFirst {
+			elements = breadthFirst(elements, read)
+		} else {
+			elements = prefix(elements, &read)
+		}
+		err = platform.Truncated(ctx)
+	}
+
+	var bbox *[4]int
+	if opts.BBox != nil {
+		b := [4]int{opts.BBox.X, opts.BBox.Y, opts.BBox.Width, opts.BBox.Height}
+		bbox = &b
+	}
+	return model.FilterElements(elements, opts.Roles, bbox), err
+}
+
+// prefix returns the first n elements of els in pre-order.
+func prefix(els []model.Element, n *int) []model.Element {
+	out := []model.Element{}
+	for _, el := range els {
+		if *n <= 0 {
+			break
+		}
+		*n--
+		el.Children = prefix(el.Children, n)
+		if len(el.Children) == 0 {
+			el.Children = nil
+		}
+		out = append(out, el)
+	}
+	return out
+}
+
+// breadthFirst returns the part of els a breadth-first read reaches after
+// reading n elements: whole sibling groups, level by level, with More set on
+// elements whose children were not reached and, like the platform readers,
+// no IDs on the elements after the first of those in pre-order.
+func breadthFirst(els []model.Element, n int) []model.Element {
+	out := make([]model.Element, len(els))
+	copy(out, els)
+	if len(out) > n {
+		return []model.Element{}
+	}
+	n -= len(out)
+	level := []*model.Element{}
+	for i := range out {
+		level = append(level, &out[i])
+	}
+	for len(level) > 0 {
+		var next []*model.Element
+		for _, el := range level {
+			if len(el.Children) == 0 {
+				continue
+			}
+			if len(el.Children) > n {
+				n = 0 // later groups of this level are not reached either
+				el.More = len(el.Children)
+				el.Children = nil
+				continue
+			}
+			n -= len(el.Children)
+			children := make([]model.Element, len(el.Children))
+			copy(children, el.Children)
+			el.Children = children
+			for i := range children {
+				next = append(next, &children[i])
+			}
+		}
+		level = next
+	}
+	axtree.ClearIDsAfterUnread(out)
+	return out
+}
+
+// StreamElements implements platform.StreamReader, spending Latency per
+// element streamed (in one sleep at the end, as short sleeps overshoot).
+func (r *Reader) StreamElements(opts platform.ReadOptions, fn func(el model.Element, depth int) bool) error {
+	r.reads.Add(1)
+	if err := r.matches(opts); err != nil {
+		return err
+	}
+	elements, _ := r.tree(opts)
+	streamed := 0
+	defer func() { time.Sleep(time.Duration(streamed) * r.Latency) }()
+	var walk func(els []model.Element, depth int) bool
+	walk = func(els []model.Element, depth int) bool {
+		for _, el := range els {
+			streamed++
+			children := el.Children
+			el.Children = nil
+			if !fn(el, depth) || !walk(children, depth+1) {
+				return false
+			}
+		}
+		return true
+	}
+	walk(elements, 1)
+	return nil
+}
+
+// copyTree deep-copies els, numbering them in pre-order, giving them
+// child-index paths below parentPath (roots keep theirs) and dropping
+// elements deeper than maxDepth (0 = unlimited).
+func copyTree(els []model.Element, nextID *int, parentPath []int, depth, maxDepth int) []model.Element {
+	if len(els) == 0 || (maxDepth > 0 && depth > maxDepth) {
+		return nil
+	}
+	out := make([]model.Element, len(els))
+	for i, el := range els {
+		el.ID = *nextID
+		*nextID++
+		if parentPath != nil {
+			el.Path = append(append([]int(nil), parentPath...), i)
+		}
+		el.Children = copyTree(el.Children, nextID, el.Path, depth+1, maxDepth)
+		out[i] = el
+	}
+	return out
+}
+
+// Resolve returns the element at a child-index path in the app's windows
+// as a read with opts would see them, like the platform path lookups.
+// countBefore returns the number of elements a full read with opts visits
+// before the element at path.
+func (r *Reader) countBefore(opts platform.ReadOptions, path []int) int {
+	var size func(els []model.Element) int
+	size = func(els []model.Element) int {
+		n := len(els)
+		for _, el := range els {
+			n += size(el.Children)
+		}
+		return n
+	}
+	var roots []model.Element
+	for _, w := range r.windows(opts) {
+		roots = append(roots, model.Element{Children: w.Elements})
+	}
+	count := 0
+	for level, i := range path {
+		if i < 0 || i >= len(roots) {
+			break
+		}
+		count += size(roots[:i])
+		if level < len(path)-1 {
+			count++
+			roots = roots[i].Children
+		}
+	}
+	return count
+}
+
+func (r *Reader) Resolve(opts platform.ReadOptions, path []int) (model.Element, bool) {
+	windows := r.windows(opts)
+	if len(path) == 0 || path[0] < 0 || path[0] >= len(windows) {
+		return model.Element{}, false
+	}
+	el := model.Element{Role: "window", Title: windows[path[0]].Title, Children: windows[path[0]].Elements}
+	for _, i := range path[1:] {
+		if i < 0 || i >= len(el.Children) {
+			return model.Element{}, false
+		}
+		el = el.Children[i]
+	}
+	return el, true
+}
+
+func (r *Reader) ListWindows(opts platform.ListOptions) ([]model.Window, error) {
+	if (opts.App != "" && !strings.EqualFold(opts.App, r.App)) || (opts.PID != 0 && opts.PID != r.PID) {
+		return []model.Window{}, nil
+	}
+	windows := make([]model.Window, len(r.Windows))
+	for i, w := range r.Windows {
+		windows[i] = model.Window{App: r.App, PID: r.PID, Title: w.Title, ID: w.ID, Focused: i == 0}
+	}
+	return windows, nil
+}
+
+func (r *Reader) WindowIDs(opts platform.ReadOptions) ([]int, error) {
+	if err := r.matches(opts); err != nil {
+		return nil, err
+	}
+	var ids []int
+	for _, w := range r.windows(opts) {
+		ids = append(ids, w.ID)
+	}
+	return ids, nil
+}
+
+// SetValue sets a value in Windows, like SetValues with one value.
+func (r *Reader) SetValue(opts platform.SetValueOptions) error {
+	return r.SetValues(platform.SetValuesOptions{
+		App: opts.App, Window: opts.Window, WindowID: opts.WindowID, PID: opts.PID,
+		Values: []platform.ElementValue{{ID: opts.ID, Path: opts.Path, Attribute: opts.Attribute, Value: opts.Value}},
+	})[0]
+}
+
+// SetValues sets the value, selected or focused attribute of elements in
+// Windows. Elements without a path are found in one traversal, spending
+// Latency per element visited. It must not run concurrently with reads.
+func (r *Reader) SetValues(opts platform.SetValuesOptions) []error {
+	errs := make([]error, len(opts.Values))
+	readOpts := platform.ReadOptions{App: opts.App, Window: opts.Window, WindowID: opts.WindowID, PID: opts.PID}
+	if err := r.matches(readOpts); err != nil {
+		for i := range errs {
+			errs[i] = err
+		}
+		return errs
+	}
+
+	ids := make([]int, len(opts.Values))
+	paths := make([][]int, len(opts.Values))
+	for i, v := range opts.Values {
+		ids[i], paths[i] = v.ID, v.Path
+	}
+	r.resolve(readOpts, ids, paths)
+
+	for i, v := range opts.Values {
+		el := r.element(readOpts, paths[i])
+		if el == nil {
+			errs[i] = fmt.Errorf("failed to set %s=%q on element %d", v.Attribute, v.Value, v.ID)
+			continue
+		}
+		switch v.Attribute {
+		case "", "value":
+			el.Value = v.Value
+		case "selected":
+			el.Selected = v.Value == "true" || v.Value == "1"
+		case "focused":
+			el.Focused = v.Value == "true" || v.Value == "1"
+		default:
+			errs[i] = fmt.Errorf("attribute %q not supported", v.Attribute)
+		}
+	}
+	return errs
+}
+
+// PerformAction performs an action in Windows, like PerformActions with one
+// action.
+func (r *Reader) PerformAction(opts platform.ActionOptions) error {
+	_, err := r.PerformActions(platform.PerformActionsOptions{
+		App: opts.App, Window: opts.Window, WindowID: opts.WindowID, PID: opts.PID,
+		Actions: []platform.ElementAction{{ID: opts.ID, Path: opts.Path, Action: opts.Action}},
+	})
+	return err
+}
+
+// PerformActions records each action, as "<action> <title>", for
+// Performed. Elements without a path are found in one traversal, like
+// SetValues. It must not run concurrently with reads.
+func (r *Reader) PerformActions(opts platform.PerformActionsOptions) (int, error) {
+	readOpts := platform.ReadOptions{App: opts.App, Window: opts.Window, WindowID: opts.WindowID, PID: opts.PID}
+	if err := r.matches(readOpts); err != nil {
+		return 0, err
+	}
+	ids := make([]int, len(opts.Actions))
+	paths := make([][]int, len(opts.Actions))
+	for i, act := range opts.Actions {
+		ids[i], paths[i] = act.ID, act.Path
+	}
+	r.resolve(readOpts, ids, paths)
+
+	for i, act := range opts.Actions {
+		el := r.element(readOpts, paths[i])
+		if el == nil {
+			return i, fmt.Errorf("failed to perform action %q on element %d", act.Action, act.ID)
+		}
+		r.mu.Lock()
+		r.performed = append(r.performed, act.Action+" "+el.Title)
+		r.mu.Unlock()
+	}
+	return len(opts.Actions), nil
+}
+
+// Performed returns the actions PerformAction and PerformActions performed
+// so far, as "<action> <title>".
+func (r *Reader) Performed() []string {
+	r.mu.Lock()
+	defer r.mu.Unlock()
+	return append([]string(nil), r.performed...)
+}
+
+// resolve fills in the path of each element without one from its ID in
+// ids, finding them all in one traversal that spends Latency per element
+// visited.
+func (r *Reader) resolve(opts platform.ReadOptions, ids []int, paths [][]int) {
+	byID := map[int][]int{} // ID → indexes in ids of the elements looked up by it
+	for i, id := range ids {
+		if len(paths[i]) == 0 {
+			byID[id] = append(byID[id], i)
+		}
+	}
+	if len(byID) == 0 {
+		return
+	}
+	r.lookups.Add(1)
+	nextID := 1
+	var visit func(el model.Element, path []int)
+	visit = func(el model.Element, path []int) {
+		if len(byID) == 0 {
+			return
+		}
+		for _, j := range byID[nextID] {
+			paths[j] = path
+		}
+		delete(byID, nextID)
+		nextID++
+		for i, child := range el.Children {
+			visit(child, append(path[:len(path):len(path)], i))
+		}
+	}
+	for i, w := range r.windows(opts) {
+		visit(model.Element{Children: w.Elements}, []int{i})
+	}
+	time.Sleep(time.Duration(nextID-1) * r.Latency)
+}
+
+// element returns the element at a child-index path in Windows, below a
+// window, or nil.
+func (r *Reader) element(opts platform.ReadOptions, path []int) *model.Element {
+	windows := r.windows(opts)
+	if len(path) < 2 || path[0] < 0 || path[0] >= len(windows) {
+		return nil
+	}
+	els := windows[path[0]].Elements
+	var el *model.Element
+	for _, i := range path[1:] {
+		if i < 0 || i >= len(els) {
+			return nil
+		}
+		el = &els[i]
+		els = el.Children
+	}
+	return el
+}
@@ -0,0 +1,70 @@
+package fake
+
+import (
+	"reflect"
+	"testing"
+
+	"github.com/mj1618/desktop-cli/internal/model"
+	"github.com/mj1618/desktop-cli/internal/platform"
+)
+
+func TestReaderSetValues_OneLookup(t *testing.T) {
+	reader := &Reader{App: "Mail", Windows: []Window{{ID: 1, Title: "Sign Up", Elements: []model.Element{
+		{Role: "input", Title: "Name"}, {Role: "group", Children: []model.Element{{Role: "input", Title: "Email"}}},
+	}}}}
+	// IDs: 1 window, 2 Name, 3 group, 4 Email.
+	errs := reader.SetValues(platform.SetValuesOptions{App: "Mail", Values: []platform.ElementValue{
+		{ID: 4, Value: "ann@example.com"}, {ID: 2, Value: "Ann"}, {ID: 9, Value: "x"},
+	}})
+	if errs[0] != nil || errs[1] != nil || errs[2] == nil {
+		t.Fatalf("errs = %v", errs)
+	}
+	if reader.Lookups() != 1 {
+		t.Errorf("%d lookups, want 1", reader.Lookups())
+	}
+	els := reader.Windows[0].Elements
+	if els[0].Value != "Ann" || els[1].Children[0].Value != "ann@example.com" {
+		t.Errorf("values = %q, %q", els[0].Value, els[1].Children[0].Value)
+	}
+}
+
+func TestReaderPerformActions(t *testing.T) {
+	reader := &Reader{App: "Calculator", Windows: []Window{{ID: 1, Title: "Calculator", Elements: []model.Element{
+		{Role: "btn", Title: "1"}, {Role: "btn", Title: "2"},
+	}}}}
+	// IDs: 1 window, 2 "1", 3 "2".
+	n, err := reader.PerformActions(platform.PerformActionsOptions{App: "Calculator", Actions: []platform.ElementAction{
+		{ID: 3, Action: "press"}, {ID: 2, Action: "press"}, {Path: []int{0, 1}, Action: "press"}, {ID: 9, Action: "press"}, {ID: 2, Action: "press"},
+	}})
+	if n != 3 || err == nil {
+		t.Fatalf("performed %d, err %v; want 3 and an error for ID 9", n, err)
+	}
+	if reader.Lookups() != 1 {
+		t.Errorf("%d lookups, want 1", reader.Lookups())
+	}
+	want := []string{"press 2", "press 1", "press 2"}
+	if got := reader.Performed(); !reflect.DeepEqual(got, want) {
+		t.Errorf("performed %q, want %q", got, want)
+	}
+}
+
+func TestReader_ScopedReadIDsResolveInActions(t *testing.T) {
+	reader := &Reader{App: "Mail", Windows: []Window{
+		{ID: 1, Title: "Inbox", Elements: []model.Element{{Role: "btn", Title: "Reply"}, {Role: "btn", Title: "Forward"}}},
+		{ID: 2, Title: "Draft", Elements: []model.Element{{Role: "group", Children: []model.Element{
+			{Role: "btn", Title: "Send"}, {Role: "btn", Title: "Delete"},
+		}}}},
+	}}
+	scoped, err := reader.ReadElements(platform.ReadOptions{App: "Mail", Scope: []int{1, 0}})
+	if err != nil {
+		t.Fatal(err)
+	}
+	del := scoped[0].Children[1]
+	// Actions given only an ID look it up from the first window.
+	if err := reader.PerformAction(platform.ActionOptions{App: "Mail", ID: del.ID, Action: "press"}); err != nil {
+		t.Fatal(err)
+	}
+	if got := reader.Performed(); !reflect.DeepEqual(got, []string{"press Delete"}) {
+		t.Errorf("pressing ID %d from a scoped read performed %q, want press Delete", del.ID, got)
+	}
+}
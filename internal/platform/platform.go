@@ -1,6 +1,9 @@
 package platform
 
-import "github.com/mj1618/desktop-cli/internal/model"
+import (
+	"github.com/mj1618/desktop-cli/internal/axtree"
+	"github.com/mj1618/desktop-cli/internal/model"
+)
 
 // Reader reads the UI element tree from the OS accessibility layer.
 type Reader interface {
@@ -11,6 +14,32 @@ type Reader interface {
 	ListWindows(opts ListOptions) ([]model.Window, error)
 }
 
+// StreamReader is implemented by readers that can hand out elements as they
+// are read, so that callers looking for something near the top of a large
+// tree can stop the traversal early (see StreamElements).
+type StreamReader interface {
+	// StreamElements calls fn with each element of the unfiltered tree
+	// ReadElements(opts) would return, in pre-order and without its
+	// children, together with its depth (1 for windows). IDs and paths match
+	// those of ReadElements. Returning false from fn stops the traversal.
+	// opts.Roles and opts.BBox are ignored.
+	StreamElements(opts ReadOptions, fn func(el model.Element, depth int) bool) error
+}
+
+// IncrementalReader is implemented by readers that can keep element handles
+// between reads of the same scope and re-fetch only the attributes that
+// change often (value, focus, selection, bounds). Useful for long-lived
+// processes that read the same windows repeatedly.
+type IncrementalReader interface {
+	SetIncremental(enabled bool)
+}
+
+// StatsReader is implemented by readers that can record per-attribute,
+// per-app accessibility call counts and latency histograms.
+type StatsReader interface {
+	SetStats(stats *axtree.Stats) // nil stops recording
+}
+
 // Inputter simulates mouse and keyboard input.
 type Inputter interface {
 	Click(x, y int, button MouseButton, count int) error
@@ -39,6 +68,12 @@ type ActionPerformer interface {
 	// PerformAction executes an accessibility action on an element identified
 	// by its sequential ID within the given read scope.
 	PerformAction(opts ActionOptions) error
+
+	// PerformActions performs a sequence of actions within one read scope,
+	// resolving each distinct element once before performing any and then
+	// performing the actions back to back, in order. It stops at the first
+	// action that fails, and returns the number performed and that error.
+	PerformActions(opts PerformActionsOptions) (int, error)
 }
 
 // ValueSetter sets accessibility attribute values directly on UI elements.
@@ -46,6 +81,22 @@ type ValueSetter interface {
 	// SetValue sets the value attribute on an element identified
 	// by its sequential ID within the given read scope.
 	SetValue(opts SetValueOptions) error
+
+	// SetValues sets several values within one read scope, resolving all
+	// their elements in a single traversal before setting any, in order. It
+	// returns one error per value, nil for those that were set.
+	SetValues(opts SetValuesOptions) []error
+}
+
+// TextReader fetches the full text content of UI elements on demand. Reads
+// inline only the first part of long text (see ReadOptions.TextLimit) and
+// mark such elements with their full length.
+type TextReader interface {
+	// ReadText returns the text content of an element identified by its
+	// sequential ID within the given read scope, and the full length of
+	// that text in characters (which exceeds the returned text when
+	// opts.MaxChars cut it short).
+	ReadText(opts ReadTextOptions) (text string, length int, err error)
 }
 
 // ClipboardManager reads and writes the system clipboard.
@@ -54,3 +105,11 @@ type ClipboardManager interface {
 	SetText(text string) error
 	Clear() error
 }
+
+// ClipboardChangeCounter is implemented by clipboard managers that can tell
+// whether the clipboard changed without reading it.
+type ClipboardChangeCounter interface {
+	// ChangeCount returns a number that changes whenever the clipboard's
+	// content does.
+	ChangeCount() (int, error)
+}
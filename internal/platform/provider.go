@@ -13,6 +13,7 @@ type Provider struct {
 	Screenshotter    Screenshotter
 	ActionPerformer  ActionPerformer
 	ValueSetter      ValueSetter
+	TextReader       TextReader
 	ClipboardManager ClipboardManager
 }
 
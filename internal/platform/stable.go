@@ -0,0 +1,376 @@
+package platform
+
+import (
+	"context"
+	"errors"
+	"fmt"
+	"sync"
+
+	"github.com/mj1618/desktop-cli/internal/model"
+)
+
+// WithStableIDs returns a copy of p whose element IDs persist across reads of
+// the same scope (see model.IdentityTracker). ActionPerformer, ValueSetter and
+// TextReader are wrapped to translate those IDs back to the traversal index
+// and child-index path the platform lookup expects, so IDs returned by one
+// read stay valid for actions after the UI has changed.
+//
+// Intended for long-lived processes (the MCP server); one-shot CLI commands
+// only ever see a single read and gain nothing from it.
+func WithStableIDs(p *Provider) *Provider {
+	if p == nil || p.Reader == nil {
+		return p
+	}
+	r := &stableReader{
+		inner:    p.Reader,
+		nextIDs:  make(map[stableTarget]*int),
+		trackers: make(map[stableScope]*model.IdentityTracker),
+		indexes:  make(map[stableScope]map[int]elementAddr),
+		ids:      make(map[stableTarget]map[string]knownElement),
+	}
+	out := *p
+	out.Reader = r
+	if p.ActionPerformer != nil {
+		out.ActionPerformer = &stableActionPerformer{inner: p.ActionPerformer, reader: r}
+	}
+	if p.ValueSetter != nil {
+		out.ValueSetter = &stableValueSetter{inner: p.ValueSetter, reader: r}
+	}
+	if p.TextReader != nil {
+		out.TextReader = &stableTextReader{inner: p.TextReader, reader: r}
+	}
+	return &out
+}
+
+// stableTarget identifies the window scope a read or action addresses.
+type stableTarget struct {
+	App      string
+	Window   string
+	WindowID int
+	PID      int
+}
+
+// stableScope is a stableTarget plus the traversal depth: depth-limited reads
+// see a different tree, so they get their own identity history. The
+// trackers of a target share their fresh IDs, so an ID names an element in
+// exactly one scope.
+type stableScope struct {
+	stableTarget
+	Depth int
+}
+
+// stableReader assigns persistent IDs to every read and remembers, for each
+// scope, which element each ID it issued currently refers to.
+type stableReader struct {
+	inner Reader
+
+	mu       sync.Mutex
+	nextIDs  map[stableTarget]*int // the next fresh ID of the target's trackers
+	trackers map[stableScope]*model.IdentityTracker
+	indexes  map[stableScope]map[int]elementAddr      // persistent ID -> current address
+	ids      map[stableTarget]map[string]knownElement // formatted path -> element, from the last full-depth read
+}
+
+// knownElement is what the last full-depth read of a target saw at a path.
+type knownElement struct {
+	id          int
+	role, title string
+}
+
+// elementAddr is where the platform finds an element: its traversal index
+// and, if the reader provides one, its child-index path.
+type elementAddr struct {
+	index int
+	path  []int
+}
+
+func (r *stableReader) ReadElements(opts ReadOptions) ([]model.Element, error) {
+	return r.ReadElementsContext(context.Background(), opts)
+}
+
+// ReadElementsContext implements ContextReader. A truncated read says
+// nothing about the elements it did not reach, so it adds to the addresses
+// known for the target instead of replacing them.
+func (r *stableReader) ReadElementsContext(ctx context.Context, opts ReadOptions) ([]model.Element, error) {
+	// Identities are tracked over the unfiltered tree so that reads with
+	// different role or bbox filters agree on the IDs of shared elements.
+	// The role filter still reaches the platform, whose two-phase read
+	// fetches details only for matching elements, when nothing needs the
+	// rest of the tree: a scoped read matches elements by path, and the
+	// first read of a target has no earlier IDs to agree with.
+	target := stableTarget{App: opts.App, Window: opts.Window, WindowID: opts.WindowID, PID: opts.PID}
+	r.mu.Lock()
+	_, seen := r.nextIDs[target]
+	r.mu.Unlock()
+	roles, bbox := opts.Roles, opts.BBox
+	opts.BBox = nil
+	if seen && len(opts.Scope) == 0 {
+		opts.Roles = nil
+	}
+	elements, err := ReadElementsContext(ctx, r.inner, opts)
+	truncated := errors.Is(err, ErrTruncated)
+	if err != nil && (!truncated || len(elements) == 0) {
+		return nil, err
+	}
+
+	if len(opts.Scope) > 0 {
+		r.assignScoped(target, elements)
+		return filterStable(elements, roles, bbox), err
+	}
+	scope := stableScope{stableTarget: target, Depth: opts.Depth}
+
+	r.mu.Lock()
+	tracker, ok := r.trackers[scope]
+	if !ok {
+		next, ok := r.nextIDs[target]
+		if !ok {
+			next = new(int)
+			r.nextIDs[target] = next
+		}
+		tracker = model.NewIdentityTrackerSharing(next)
+		r.trackers[scope] = tracker
+	}
+	tracker.Assign(elements)
+
+	index := make(map[int]elementAddr)
+	known := make(map[string]knownElement)
+	if truncated {
+		for id, addr := range r.indexes[scope] {
+			index[id] = addr
+		}
+		if opts.Depth == 0 {
+			for path, k := range r.ids[target] {
+				known[path] = k
+			}
+		}
+	}
+	var collect func([]model.Element)
+	collect = func(els []model.Element) {
+		for _, el := range els {
+			// Platform lookups by traversal index walk the full tree, so
+			// elements of depth-limited reads can only be found by path.
+			if opts.Depth == 0 {
+				index[el.ID] = elementAddr{index: el.TraversalIndex(), path: el.Path}
+				if len(el.Path) > 0 {
+					known[model.FormatPath(el.Path)] = knownElement{id: el.ID, role: el.Role, title: el.Title}
+				}
+			} else if len(el.Path) > 0 {
+				index[el.ID] = elementAddr{path: el.Path}
+			}
+			collect(el.Children)
+		}
+	}
+	collect(elements)
+	r.indexes[scope] = index
+	if opts.Depth == 0 {
+		r.ids[target] = known
+	}
+	r.mu.Unlock()
+
+	return filterStable(elements, roles, bbox), err
+}
+
+// assignScoped gives the elements of a scoped read the persistent IDs of the
+// elements at their paths in the last full-depth read of target, if they are
+// still those elements (same role and title). Other elements, such as the
+// children a budgeted read did not reach, get fresh IDs, addressed by path.
+// The identity history is left alone: a subtree says nothing about the rest
+// of the tree.
+func (r *stableReader) assignScoped(target stableTarget, elements []model.Element) {
+	r.mu.Lock()
+	defer r.mu.Unlock()
+	scope := stableScope{stableTarget: target}
+	known, index := r.ids[target], r.indexes[scope]
+	if known == nil {
+		known = make(map[string]knownElement)
+		r.ids[target] = known
+	}
+	if index == nil {
+		index = make(map[int]elementAddr)
+		r.indexes[scope] = index
+	}
+	next, ok := r.nextIDs[target]
+	if !ok {
+		next = new(int)
+		*next = 1
+		r.nextIDs[target] = next
+	}
+	var assign func([]model.Element)
+	assign = func(els []model.Element) {
+		for i := range els {
+			el := &els[i]
+			path := model.FormatPath(el.Path)
+			if k, ok := known[path]; ok && k.role == el.Role && k.title == el.Title {
+				el.Index, el.ID = el.TraversalIndex(), k.id
+			} else if len(el.Path) > 0 {
+				id := *next
+				*next++
+				index[id] = elementAddr{index: el.TraversalIndex(), path: el.Path}
+				known[path] = knownElement{id: id, role: el.Role, title: el.Title}
+				el.Index, el.ID = el.TraversalIndex(), id
+			} else {
+				el.ID = 0
+			}
+			assign(el.Children)
+		}
+	}
+	assign(elements)
+}
+
+// StreamElements implements StreamReader. Persistent IDs come from the
+// identity tracker, which needs the whole tree, so elements are streamed
+// with the IDs of the elements at their paths in the last full-depth read
+// of the target for as long as they are still those elements (same role and
+// title). From the first one that is not, the rest of the stream comes from
+// a full read. Without such a read to go by, the tree is read in full.
+func (r *stableReader) StreamElements(opts ReadOptions, fn func(el model.Element, depth int) bool) error {
+	opts.Roles, opts.BBox = nil, nil
+	target := stableTarget{App: opts.App, Window: opts.Window, WindowID: opts.WindowID, PID: opts.PID}
+	r.mu.Lock()
+	known := r.ids[target]
+	r.mu.Unlock()
+	sr, ok := r.inner.(StreamReader)
+	if !ok || known == nil || opts.Depth != 0 || len(opts.Scope) > 0 {
+		return streamRead(r, opts, fn)
+	}
+
+	streamed, diverged := 0, false
+	err := sr.StreamElements(opts, func(el model.Element, depth int) bool {
+		k, ok := known[model.FormatPath(el.Path)]
+		if len(el.Path) == 0 || !ok || k.role != el.Role || k.title != el.Title {
+			diverged = true
+			return false
+		}
+		el.Index, el.ID = el.TraversalIndex(), k.id
+		streamed++
+		return fn(el, depth)
+	})
+	if !diverged {
+		return err
+	}
+	return streamRead(r, opts, func(el model.Element, depth int) bool {
+		if streamed > 0 {
+			streamed--
+			return true
+		}
+		return fn(el, depth)
+	})
+}
+
+// filterStable applies the role and bbox filters the read was made with.
+func filterStable(elements []model.Element, roles []string, bbox *Bounds) []model.Element {
+	var b *[4]int
+	if bbox != nil {
+		v := [4]int{bbox.X, bbox.Y, bbox.Width, bbox.Height}
+		b = &v
+	}
+	return model.FilterElements(elements, roles, b)
+}
+
+func (r *stableReader) ListWindows(opts ListOptions) ([]model.Window, error) {
+	return r.inner.ListWindows(opts)
+}
+
+// address maps a persistent ID to the element's current address in the
+// scope whose tracker issued it. An ID that scope's last read no longer has,
+// or that no read of target issued, is unknown: translating it through
+// another tracker, or a fresh one, could name a different element.
+func (r *stableReader) address(target stableTarget, id int) (elementAddr, error) {
+	r.mu.Lock()
+	defer r.mu.Unlock()
+	for scope, index := range r.indexes {
+		if scope.stableTarget != target {
+			continue
+		}
+		if addr, ok := index[id]; ok {
+			return addr, nil
+		}
+	}
+	return elementAddr{}, fmt.Errorf("unknown element id %d (it may have been removed; re-read the UI)", id)
+}
+
+type stableActionPerformer struct {
+	inner  ActionPerformer
+	reader *stableReader
+}
+
+func (a *stableActionPerformer) PerformAction(opts ActionOptions) error {
+	addr, err := a.reader.address(stableTarget{App: opts.App, Window: opts.Window, WindowID: opts.WindowID, PID: opts.PID}, opts.ID)
+	if err != nil {
+		return err
+	}
+	opts.ID, opts.Path = addr.index, addr.path
+	return a.inner.PerformAction(opts)
+}
+
+// PerformActions addresses every action by its stable ID before performing
+// any, so a sequence with an unknown element is not started.
+func (a *stableActionPerformer) PerformActions(opts PerformActionsOptions) (int, error) {
+	target := stableTarget{App: opts.App, Window: opts.Window, WindowID: opts.WindowID, PID: opts.PID}
+	actions := make([]ElementAction, len(opts.Actions))
+	for i, act := range opts.Actions {
+		addr, err := a.reader.address(target, act.ID)
+		if err != nil {
+			return 0, err
+		}
+		act.ID, act.Path = addr.index, addr.path
+		actions[i] = act
+	}
+	opts.Actions = actions
+	return a.inner.PerformActions(opts)
+}
+
+type stableValueSetter struct {
+	inner  ValueSetter
+	reader *stableReader
+}
+
+func (v *stableValueSetter) SetValue(opts SetValueOptions) error {
+	addr, err := v.reader.address(stableTarget{App: opts.App, Window: opts.Window, WindowID: opts.WindowID, PID: opts.PID}, opts.ID)
+	if err != nil {
+		return err
+	}
+	opts.ID, opts.Path = addr.index, addr.path
+	return v.inner.SetValue(opts)
+}
+
+// SetValues addresses every value by its stable ID and sets those that
+// could be addressed in one batch.
+func (v *stableValueSetter) SetValues(opts SetValuesOptions) []error {
+	target := stableTarget{App: opts.App, Window: opts.Window, WindowID: opts.WindowID, PID: opts.PID}
+	errs := make([]error, len(opts.Values))
+	var values []ElementValue
+	var indexes []int // index in opts.Values of each of values
+	for i, val := range opts.Values {
+		addr, err := v.reader.address(target, val.ID)
+		if err != nil {
+			errs[i] = err
+			continue
+		}
+		val.ID, val.Path = addr.index, addr.path
+		values = append(values, val)
+		indexes = append(indexes, i)
+	}
+	if len(values) == 0 {
+		return errs
+	}
+	opts.Values = values
+	for j, err := range v.inner.SetValues(opts) {
+		errs[indexes[j]] = err
+	}
+	return errs
+}
+
+type stableTextReader struct {
+	inner  TextReader
+	reader *stableReader
+}
+
+func (t *stableTextReader) ReadText(opts ReadTextOptions) (string, int, error) {
+	addr, err := t.reader.address(stableTarget{App: opts.App, Window: opts.Window, WindowID: opts.WindowID, PID: opts.PID}, opts.ID)
+	if err != nil {
+		return "", 0, err
+	}
+	opts.ID, opts.Path = addr.index, addr.path
+	return t.inner.ReadText(opts)
+}
@@ -0,0 +1,271 @@
+package platform
+
+import (
+	"reflect"
+	"testing"
+
+	"github.com/mj1618/desktop-cli/internal/model"
+)
+
+// seqReader returns a fixed tree per call, numbered in pre-order, filtered
+// by role as a platform reader filters it.
+type seqReader struct {
+	trees [][]model.Element
+	calls int
+	roles [][]string // the roles each call was made with
+}
+
+func (r *seqReader) ReadElements(opts ReadOptions) ([]model.Element, error) {
+	tree := r.trees[r.calls]
+	if r.calls < len(r.trees)-1 {
+		r.calls++
+	}
+	r.roles = append(r.roles, opts.Roles)
+	out := make([]model.Element, len(tree))
+	copy(out, tree)
+	return model.FilterElements(out, opts.Roles, nil), nil
+}
+
+func (r *seqReader) ListWindows(opts ListOptions) ([]model.Window, error) { return nil, nil }
+
+type recordingPerformer struct {
+	got     ActionOptions
+	gotMany PerformActionsOptions
+}
+
+func (p *recordingPerformer) PerformAction(opts ActionOptions) error {
+	p.got = opts
+	return nil
+}
+
+func (p *recordingPerformer) PerformActions(opts PerformActionsOptions) (int, error) {
+	p.gotMany = opts
+	return len(opts.Actions), nil
+}
+
+type recordingSetter struct{ got SetValuesOptions }
+
+func (s *recordingSetter) SetValue(opts SetValueOptions) error { return nil }
+
+func (s *recordingSetter) SetValues(opts SetValuesOptions) []error {
+	s.got = opts
+	return make([]error, len(opts.Values))
+}
+
+func windowWith(titles ...string) []model.Element {
+	win := model.Element{ID: 1, Role: "window", Bounds: [4]int{0, 0, 100, 100}, Path: []int{0}}
+	for i, t := range titles {
+		win.Children = append(win.Children, model.Element{
+			ID: i + 2, Role: "btn", Title: t, Bounds: [4]int{0, i * 20, 100, 20}, Path: []int{0, i},
+		})
+	}
+	return []model.Element{win}
+}
+
+func TestWithStableIDs_TranslatesActionIDs(t *testing.T) {
+	reader := &seqReader{trees: [][]model.Element{
+		windowWith("OK", "Cancel"),
+		windowWith("Help", "OK", "Cancel"),
+	}}
+	performer := &recordingPerformer{}
+	p := WithStableIDs(&Provider{Reader: reader, ActionPerformer: performer})
+
+	first, _ := p.Reader.ReadElements(ReadOptions{App: "Test"})
+	cancelID := first[0].Children[1].ID
+
+	second, _ := p.Reader.ReadElements(ReadOptions{App: "Test"})
+	if got := second[0].Children[2]; got.Title != "Cancel" || got.ID != cancelID {
+		t.Fatalf("Cancel: got ID %d, want persistent ID %d", got.ID, cancelID)
+	}
+
+	if err := p.ActionPerformer.PerformAction(ActionOptions{App: "Test", ID: cancelID, Action: "press"}); err != nil {
+		t.Fatal(err)
+	}
+	if performer.got.ID != 4 {
+		t.Errorf("PerformAction received index %d, want traversal index 4", performer.got.ID)
+	}
+	if !reflect.DeepEqual(performer.got.Path, []int{0, 2}) {
+		t.Errorf("PerformAction received path %v, want the current path [0 2]", performer.got.Path)
+	}
+}
+
+func TestWithStableIDs_UnknownID(t *testing.T) {
+	reader := &seqReader{trees: [][]model.Element{windowWith("OK")}}
+	p := WithStableIDs(&Provider{Reader: reader, ActionPerformer: &recordingPerformer{}})
+	if err := p.ActionPerformer.PerformAction(ActionOptions{App: "Test", ID: 99}); err == nil {
+		t.Error("expected error for unknown ID")
+	}
+}
+
+func TestWithStableIDs_RoleFilterSharesIDs(t *testing.T) {
+	reader := &seqReader{trees: [][]model.Element{windowWith("OK", "Cancel")}}
+	p := WithStableIDs(&Provider{Reader: reader})
+
+	full, _ := p.Reader.ReadElements(ReadOptions{App: "Test"})
+	filtered, _ := p.Reader.ReadElements(ReadOptions{App: "Test", Roles: []string{"btn"}})
+	if len(filtered) != 2 {
+		t.Fatalf("expected 2 promoted buttons, got %d", len(filtered))
+	}
+	if filtered[1].ID != full[0].Children[1].ID {
+		t.Errorf("filtered read ID %d != full read ID %d", filtered[1].ID, full[0].Children[1].ID)
+	}
+}
+
+func TestWithStableIDs_FirstReadFiltersByRoleOnPlatform(t *testing.T) {
+	reader := &seqReader{trees: [][]model.Element{windowWith("OK", "Cancel")}}
+	performer := &recordingPerformer{}
+	p := WithStableIDs(&Provider{Reader: reader, ActionPerformer: performer})
+
+	filtered, _ := p.Reader.ReadElements(ReadOptions{App: "Test", Roles: []string{"btn"}})
+	full, _ := p.Reader.ReadElements(ReadOptions{App: "Test"})
+	again, _ := p.Reader.ReadElements(ReadOptions{App: "Test", Roles: []string{"btn"}})
+	if want := [][]string{{"btn"}, nil, nil}; !reflect.DeepEqual(reader.roles, want) {
+		t.Errorf("platform read with roles %v, want %v: only the first read has no IDs to agree with", reader.roles, want)
+	}
+	if len(filtered) != 2 || len(again) != 2 {
+		t.Fatalf("got %d and %d buttons, want 2", len(filtered), len(again))
+	}
+	for i, el := range filtered {
+		if full[0].Children[i].ID != el.ID || again[i].ID != el.ID {
+			t.Errorf("%s: IDs %d, %d, %d; want the filtered read's ID kept", el.Title, el.ID, full[0].Children[i].ID, again[i].ID)
+		}
+	}
+
+	if err := p.ActionPerformer.PerformAction(ActionOptions{App: "Test", ID: filtered[1].ID, Action: "press"}); err != nil {
+		t.Fatal(err)
+	}
+	if !reflect.DeepEqual(performer.got.Path, []int{0, 1}) {
+		t.Errorf("PerformAction received path %v, want Cancel's path [0 1]", performer.got.Path)
+	}
+}
+
+func TestWithStableIDs_SetValues(t *testing.T) {
+	reader := &seqReader{trees: [][]model.Element{
+		windowWith("Name", "Email"),
+		windowWith("Help", "Name", "Email"),
+	}}
+	setter := &recordingSetter{}
+	p := WithStableIDs(&Provider{Reader: reader, ValueSetter: setter})
+
+	first, _ := p.Reader.ReadElements(ReadOptions{App: "Test"})
+	name, email := first[0].Children[0].ID, first[0].Children[1].ID
+	p.Reader.ReadElements(ReadOptions{App: "Test"})
+
+	errs := p.ValueSetter.SetValues(SetValuesOptions{App: "Test", Values: []ElementValue{
+		{ID: email, Value: "a@b.c"},
+		{ID: 999, Value: "x"},
+		{ID: name, Value: "Ann"},
+	}})
+	if errs[0] != nil || errs[1] == nil || errs[2] != nil {
+		t.Fatalf("errs = %v, want only the unknown ID to fail", errs)
+	}
+	want := []ElementValue{{ID: 4, Path: []int{0, 2}, Value: "a@b.c"}, {ID: 3, Path: []int{0, 1}, Value: "Ann"}}
+	if !reflect.DeepEqual(setter.got.Values, want) {
+		t.Errorf("set %+v, want %+v", setter.got.Values, want)
+	}
+}
+
+func TestWithStableIDs_PerformActions(t *testing.T) {
+	reader := &seqReader{trees: [][]model.Element{
+		windowWith("1", "2"),
+		windowWith("Clear", "1", "2"),
+	}}
+	performer := &recordingPerformer{}
+	p := WithStableIDs(&Provider{Reader: reader, ActionPerformer: performer})
+
+	first, _ := p.Reader.ReadElements(ReadOptions{App: "Test"})
+	one, two := first[0].Children[0].ID, first[0].Children[1].ID
+	p.Reader.ReadElements(ReadOptions{App: "Test"})
+
+	n, err := p.ActionPerformer.PerformActions(PerformActionsOptions{App: "Test", Actions: []ElementAction{
+		{ID: two, Action: "press"}, {ID: one, Action: "press"}, {ID: two, Action: "press"},
+	}})
+	if err != nil || n != 3 {
+		t.Fatalf("performed %d, err %v", n, err)
+	}
+	want := []ElementAction{
+		{ID: 4, Path: []int{0, 2}, Action: "press"},
+		{ID: 3, Path: []int{0, 1}, Action: "press"},
+		{ID: 4, Path: []int{0, 2}, Action: "press"},
+	}
+	if !reflect.DeepEqual(performer.gotMany.Actions, want) {
+		t.Errorf("performed %+v, want %+v", performer.gotMany.Actions, want)
+	}
+
+	performer.gotMany = PerformActionsOptions{}
+	if _, err := p.ActionPerformer.PerformActions(PerformActionsOptions{App: "Test", Actions: []ElementAction{
+		{ID: one, Action: "press"}, {ID: 999, Action: "press"},
+	}}); err == nil || performer.gotMany.Actions != nil {
+		t.Errorf("err = %v, performed %+v; want an error before any action", err, performer.gotMany.Actions)
+	}
+}
+
+func TestWithStableIDs_ScopedRead(t *testing.T) {
+	reader := &seqReader{trees: [][]model.Element{
+		windowWith("OK", "Cancel"),
+		windowWith("Help", "OK", "Cancel"),
+	}}
+	p := WithStableIDs(&Provider{Reader: reader})
+	first, _ := p.Reader.ReadElements(ReadOptions{App: "Test"})
+	p.Reader.ReadElements(ReadOptions{App: "Test"})
+
+	// The scoped read's elements get the IDs of the last full read at
+	// their paths.
+	reader.trees, reader.calls = [][]model.Element{windowWith("Help", "OK", "Cancel")}, 0
+	scoped, err := p.Reader.ReadElements(ReadOptions{App: "Test", Scope: []int{0}})
+	if err != nil {
+		t.Fatal(err)
+	}
+	if got, want := scoped[0].Children[1].ID, first[0].Children[0].ID; got != want {
+		t.Errorf("OK has ID %d in the scoped read, want %d", got, want)
+	}
+}
+
+func TestWithStableIDs_ScopedReadNewElementsGetAddressableIDs(t *testing.T) {
+	reader := &seqReader{trees: [][]model.Element{windowWith("OK"), windowWith("OK", "More")}}
+	performer := &recordingPerformer{}
+	p := WithStableIDs(&Provider{Reader: reader, ActionPerformer: performer})
+	full, _ := p.Reader.ReadElements(ReadOptions{App: "Test"})
+
+	// A budgeted read may not have reached an element a scoped read then
+	// returns; it gets an ID of its own.
+	scoped, _ := p.Reader.ReadElements(ReadOptions{App: "Test", Scope: []int{0}})
+	more := scoped[0].Children[1]
+	if more.ID == 0 || more.ID == full[0].ID || more.ID == full[0].Children[0].ID {
+		t.Fatalf("new element got ID %d, want a fresh one", more.ID)
+	}
+	if err := p.ActionPerformer.PerformAction(ActionOptions{App: "Test", ID: more.ID, Action: "press"}); err != nil {
+		t.Fatal(err)
+	}
+	if !reflect.DeepEqual(performer.got.Path, []int{0, 1}) {
+		t.Errorf("PerformAction received path %v, want [0 1]", performer.got.Path)
+	}
+}
+
+func TestWithStableIDs_DepthLimitedIDsStayWithTheirTracker(t *testing.T) {
+	reader := &seqReader{trees: [][]model.Element{windowWith("OK", "Cancel"), windowWith("OK", "Cancel")}}
+	performer := &recordingPerformer{}
+	p := WithStableIDs(&Provider{Reader: reader, ActionPerformer: performer})
+
+	full, _ := p.Reader.ReadElements(ReadOptions{App: "Test"})
+	shallow, _ := p.Reader.ReadElements(ReadOptions{App: "Test", Depth: 2})
+	okID := shallow[0].Children[0].ID
+	for _, el := range full[0].Children {
+		if el.ID == okID {
+			t.Fatalf("depth-limited read reused ID %d of the full read's %q", okID, el.Title)
+		}
+	}
+
+	if err := p.ActionPerformer.PerformAction(ActionOptions{App: "Test", ID: okID, Action: "press"}); err != nil {
+		t.Fatal(err)
+	}
+	if !reflect.DeepEqual(performer.got.Path, []int{0, 0}) || performer.got.ID != 0 {
+		t.Errorf("got ID %d path %v, want lookup by path [0 0] only", performer.got.ID, performer.got.Path)
+	}
+
+	// An ID no read of the target issued is unknown, not re-read and
+	// renumbered.
+	if err := p.ActionPerformer.PerformAction(ActionOptions{App: "Other", ID: 2, Action: "press"}); err == nil {
+		t.Error("expected an unknown element error for an ID no read issued")
+	}
+}
@@ -0,0 +1,37 @@
+package platform
+
+import "github.com/mj1618/desktop-cli/internal/model"
+
+// StreamElements calls fn with each element of the unfiltered tree
+// r.ReadElements(opts) would return, in pre-order, as described by
+// StreamReader. Readers that cannot stream are read in full first, so
+// stopping early then saves only the caller's own work.
+func StreamElements(r Reader, opts ReadOptions, fn func(el model.Element, depth int) bool) error {
+	opts.Roles, opts.BBox = nil, nil
+	if sr, ok := r.(StreamReader); ok {
+		return sr.StreamElements(opts, fn)
+	}
+	return streamRead(r, opts, fn)
+}
+
+// streamRead streams a full read of opts from r.
+func streamRead(r Reader, opts ReadOptions, fn func(el model.Element, depth int) bool) error {
+	opts.Roles, opts.BBox = nil, nil
+	elements, err := r.ReadElements(opts)
+	if err != nil {
+		return err
+	}
+	var walk func(els []model.Element, depth int) bool
+	walk = func(els []model.Element, depth int) bool {
+		for _, el := range els {
+			children := el.Children
+			el.Children = nil
+			if !fn(el, depth) || !walk(children, depth+1) {
+				return false
+			}
+		}
+		return true
+	}
+	walk(elements, 1)
+	return nil
+}
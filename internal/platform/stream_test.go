@@ -0,0 +1,141 @@
+package platform_test
+
+import (
+	"context"
+	"reflect"
+	"testing"
+	"time"
+
+	"github.com/mj1618/desktop-cli/internal/model"
+	"github.com/mj1618/desktop-cli/internal/platform"
+	"github.com/mj1618/desktop-cli/internal/platform/fake"
+)
+
+// collect streams opts from r, stopping after limit elements (0 = no limit).
+func collect(t *testing.T, r platform.Reader, opts platform.ReadOptions, limit int) ([]model.Element, []int) {
+	t.Helper()
+	var els []model.Element
+	var depths []int
+	err := platform.StreamElements(r, opts, func(el model.Element, depth int) bool {
+		els = append(els, el)
+		depths = append(depths, depth)
+		return limit == 0 || len(els) < limit
+	})
+	if err != nil {
+		t.Fatal(err)
+	}
+	return els, depths
+}
+
+// flatten lists a read in pre-order without children, with depths.
+func flatten(tree []model.Element) ([]model.Element, []int) {
+	var els []model.Element
+	var depths []int
+	var walk func([]model.Element, int)
+	walk = func(tree []model.Element, depth int) {
+		for _, el := range tree {
+			children := el.Children
+			el.Children = nil
+			els = append(els, el)
+			depths = append(depths, depth)
+			walk(children, depth+1)
+		}
+	}
+	walk(tree, 1)
+	return els, depths
+}
+
+func TestStreamElements_MatchesRead(t *testing.T) {
+	for _, opts := range []platform.ReadOptions{
+		{App: "Mail"},
+		{App: "Mail", Depth: 2},
+		{App: "Mail", WindowID: 103},
+	} {
+		f := newFake(0)
+		tree, err := f.ReadElements(opts)
+		if err != nil {
+			t.Fatal(err)
+		}
+		wantEls, wantDepths := flatten(tree)
+
+		// The fake streams natively; hiding that exercises the fallback.
+		for _, r := range []platform.Reader{f, struct{ platform.Reader }{f}} {
+			els, depths := collect(t, r, opts, 0)
+			if !reflect.DeepEqual(els, wantEls) || !reflect.DeepEqual(depths, wantDepths) {
+				t.Errorf("%+v (%T): stream differs from read\n got: %+v %v\nwant: %+v %v", opts, r, els, depths, wantEls, wantDepths)
+			}
+		}
+	}
+}
+
+func TestStreamElements_IgnoresFilters(t *testing.T) {
+	f := newFake(0)
+	all, _ := collect(t, f, platform.ReadOptions{App: "Mail"}, 0)
+	filtered, _ := collect(t, f, platform.ReadOptions{App: "Mail", Roles: []string{"btn"}}, 0)
+	if len(filtered) != len(all) {
+		t.Errorf("streamed %d elements with a role filter, want the unfiltered %d", len(filtered), len(all))
+	}
+}
+
+func TestStreamElements_StopsEarly(t *testing.T) {
+	const latency = 200 * time.Microsecond
+	opts := platform.ReadOptions{App: "Mail"}
+
+	f := newFake(latency)
+	start := time.Now()
+	if _, err := f.ReadElements(opts); err != nil {
+		t.Fatal(err)
+	}
+	full := time.Since(start)
+
+	start = time.Now()
+	els, _ := collect(t, newFake(latency), opts, 5)
+	early := time.Since(start)
+
+	if len(els) != 5 {
+		t.Fatalf("streamed %d elements, want 5", len(els))
+	}
+	// 5 of 53 elements.
+	if early > full/2 {
+		t.Errorf("stopping after 5 elements took %v, a full read %v", early, full)
+	}
+}
+
+// serverReader wraps f in the readers the MCP server builds around the
+// platform.
+func serverReader(f *fake.Reader) platform.Reader {
+	p := &platform.Provider{Reader: platform.WithConcurrentWindows(f, platform.DefaultWindowWorkers)}
+	return platform.WithContext(context.Background(), platform.WithStableIDs(p)).Reader
+}
+
+func TestStreamElements_ThroughServerWrappers(t *testing.T) {
+	f := newFake(0)
+	r := serverReader(f)
+	opts := platform.ReadOptions{App: "Mail"}
+	tree, err := r.ReadElements(opts)
+	if err != nil {
+		t.Fatal(err)
+	}
+	want, _ := flatten(tree)
+
+	before := f.Reads()
+	els, _ := collect(t, r, opts, 5)
+	if n := f.Reads() - before; n != 1 {
+		t.Errorf("streaming 5 elements made %d reads, want a single stream", n)
+	}
+	if !reflect.DeepEqual(els, want[:5]) {
+		t.Errorf("stream differs from read\n got: %+v\nwant: %+v", els, want[:5])
+	}
+
+	// Once the stream leaves the last read's tree, the rest comes from a
+	// read that tracks identities, so the IDs still match ReadElements.
+	f.Windows[0].Elements[0].Children[2].Title = "Renamed"
+	els, _ = collect(t, r, opts, 0)
+	tree, err = r.ReadElements(opts)
+	if err != nil {
+		t.Fatal(err)
+	}
+	if want, _ = flatten(tree); !reflect.DeepEqual(els, want) {
+		t.Errorf("stream after a change differs from read\n got: %+v\nwant: %+v", els, want)
+	}
+}
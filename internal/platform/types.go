@@ -64,6 +64,21 @@ type ReadOptions struct {
 	Compact     bool     // Use compact output format
 	Text        string   // Filter by text content (title, value, description)
 	Flat        bool     // Return flat list instead of tree
+	TextLimit   int      // Max characters of hidden text content inlined per element (0 = default, -1 = none)
+
+	// BreadthFirst reads the tree level by level, so that a read cut short
+	// by its context (see ContextReader) returns the top levels of every
+	// window instead of the first windows in full. Elements whose children
+	// were not reached have model.Element.More set. In a truncated
+	// breadth-first read, the elements a full read would number after the
+	// first such element get ID 0: their traversal indices are unknown, so
+	// actions must address them by Path.
+	BreadthFirst bool
+
+	// Scope, if set, reads only the subtree under the element at this
+	// child-index path (model.Element.Path). Elements keep their full paths
+	// and the IDs a full read would give them.
+	Scope []int
 }
 
 // ListOptions controls window/app listing.
@@ -100,9 +115,28 @@ type ActionOptions struct {
 	WindowID int    // Scope to window by system ID
 	PID      int    // Scope to process
 	ID       int    // Element ID (from read output)
+	Path     []int  // Child-index path (model.Element.Path from a read of the same scope); resolved in O(depth) instead of ID when set
 	Action   string // Action to perform: "press", "cancel", "pick", "increment", "decrement", "confirm", "showMenu", "raise"
 }
 
+// PerformActionsOptions configures a sequence of actions to perform within
+// one read scope (see ActionPerformer.PerformActions).
+type PerformActionsOptions struct {
+	App      string // Scope to application
+	Window   string // Scope to window
+	WindowID int    // Scope to window by system ID
+	PID      int    // Scope to process
+	Actions  []ElementAction
+}
+
+// ElementAction is one action of a PerformActionsOptions: the element, by
+// ID or path as in ActionOptions, and the action to perform on it.
+type ElementAction struct {
+	ID     int
+	Path   []int
+	Action string
+}
+
 // SetValueOptions configures which element to set a value on and what value to set.
 type SetValueOptions struct {
 	App       string // Scope to application
@@ -110,6 +144,37 @@ type SetValueOptions struct {
 	WindowID  int    // Scope to window by system ID
 	PID       int    // Scope to process
 	ID        int    // Element ID (from read output)
+	Path      []int  // Child-index path of the element (see ActionOptions.Path)
 	Value     string // The value to set (text for text fields, number for sliders, "true"/"false" for checkboxes)
 	Attribute string // AX attribute to set (default: "value" → kAXValueAttribute)
 }
+
+// SetValuesOptions configures several values to set within one read scope
+// (see ValueSetter.SetValues).
+type SetValuesOptions struct {
+	App      string // Scope to application
+	Window   string // Scope to window
+	WindowID int    // Scope to window by system ID
+	PID      int    // Scope to process
+	Values   []ElementValue
+}
+
+// ElementValue is one value of a SetValuesOptions: the element, by ID or
+// path as in SetValueOptions, and the attribute and value to set on it.
+type ElementValue struct {
+	ID        int
+	Path      []int
+	Attribute string
+	Value     string
+}
+
+// ReadTextOptions configures which element to read the full text content of.
+type ReadTextOptions struct {
+	App      string // Scope to application
+	Window   string // Scope to window
+	WindowID int    // Scope to window by system ID
+	PID      int    // Scope to process
+	ID       int    // Element ID (from read output)
+	Path     []int  // Child-index path of the element (see ActionOptions.Path)
+	MaxChars int    // Max characters to return (0 = all)
+}
@@ -0,0 +1,192 @@
+package platform
+
+import (
+	"fmt"
+	"strings"
+	"sync"
+	"time"
+
+	"github.com/mj1618/desktop-cli/internal/model"
+)
+
+// DefaultWindowTTL is how long a WindowDirectory serves a window list before
+// enumerating the windows again.
+const DefaultWindowTTL = 500 * time.Millisecond
+
+// WindowDirectory caches the system window list so that resolving --app,
+// --pid, --window and --window-id to a window costs one enumeration per
+// command instead of one per read, action and screenshot.
+//
+// A list is served for at most the TTL. Lookups that find no matching window
+// in a cached list enumerate again before giving up, so windows that were
+// opened or renamed since are still found. Callers that change the window
+// layout themselves (focusing a window) should call Invalidate.
+//
+// Safe for concurrent use; concurrent misses share a single enumeration.
+type WindowDirectory struct {
+	list func(ListOptions) ([]model.Window, error)
+	ttl  time.Duration
+	now  func() time.Time
+
+	mu      sync.Mutex
+	entries map[ListOptions]windowEntry
+	seq     uint64 // enumerations so far
+}
+
+type windowEntry struct {
+	windows []model.Window
+	fetched time.Time
+	seq     uint64 // the enumeration that produced windows
+}
+
+// NewWindowDirectory returns a directory that enumerates windows with list,
+// which must apply the PID and App filters of its options itself. A ttl of
+// 0 means DefaultWindowTTL.
+func NewWindowDirectory(list func(ListOptions) ([]model.Window, error), ttl time.Duration) *WindowDirectory {
+	if ttl <= 0 {
+		ttl = DefaultWindowTTL
+	}
+	return &WindowDirectory{list: list, ttl: ttl, now: time.Now, entries: make(map[ListOptions]windowEntry)}
+}
+
+// List returns the windows matching opts, like Reader.ListWindows. A cached
+// list of all windows also serves filtered requests.
+func (d *WindowDirectory) List(opts ListOptions) ([]model.Window, error) {
+	windows, _, err := d.get(opts, 0)
+	return windows, err
+}
+
+// Lookup returns the first window matching opts whose title contains title
+// (case-insensitively) or, if windowID is set, whose ID is windowID. With
+// neither set it returns the first matching window.
+func (d *WindowDirectory) Lookup(opts ListOptions, title string, windowID int) (model.Window, error) {
+	match := func(windows []model.Window) (model.Window, bool) {
+		for _, w := range windows {
+			if windowID != 0 && w.ID != windowID {
+				continue
+			}
+			if title != "" && !strings.Contains(strings.ToLower(w.Title), strings.ToLower(title)) {
+				continue
+			}
+			return w, true
+		}
+		return model.Window{}, false
+	}
+
+	windows, seq, err := d.get(opts, 0)
+	if err != nil {
+		return model.Window{}, err
+	}
+	w, ok := match(windows)
+	if !ok && seq > 0 {
+		if windows, _, err = d.get(opts, seq); err != nil {
+			return model.Window{}, err
+		}
+		w, ok = match(windows)
+	}
+	if ok {
+		return w, nil
+	}
+	switch {
+	case windowID != 0:
+		return model.Window{}, fmt.Errorf("no window found with ID %d", windowID)
+	case title != "":
+		return model.Window{}, fmt.Errorf("no window found matching title %q", title)
+	case opts.App != "":
+		return model.Window{}, fmt.Errorf("no windows found for app %q", opts.App)
+	default:
+		return model.Window{}, fmt.Errorf("no windows found matching the specified criteria")
+	}
+}
+
+// Resolve returns the process, and the window within it, that a read or
+// action with the target fields of opts (App, PID, Window, WindowID)
+// addresses. When the window has been identified its title is returned
+// empty and its ID set; otherwise the title and ID are opts' own, for the
+// platform to match against the process's windows. pid is 0 if no target
+// was given or nothing matched.
+func (d *WindowDirectory) Resolve(opts ReadOptions) (pid int, windowTitle string, windowID int) {
+	if opts.PID != 0 {
+		return opts.PID, opts.Window, opts.WindowID
+	}
+	if opts.App != "" {
+		if opts.Window != "" {
+			if w, err := d.Lookup(ListOptions{App: opts.App}, opts.Window, 0); err == nil {
+				return w.PID, "", w.ID
+			}
+		}
+		w, err := d.Lookup(ListOptions{App: opts.App}, "", 0)
+		if err != nil {
+			return 0, "", 0
+		}
+		return w.PID, opts.Window, opts.WindowID
+	}
+	if opts.WindowID != 0 {
+		if w, err := d.Lookup(ListOptions{}, "", opts.WindowID); err == nil {
+			return w.PID, "", w.ID
+		}
+	}
+	if opts.Window != "" {
+		if w, err := d.Lookup(ListOptions{}, opts.Window, 0); err == nil {
+			return w.PID, "", w.ID
+		}
+	}
+	return 0, "", 0
+}
+
+// Invalidate drops every cached list, so the next lookup enumerates the
+// windows again.
+func (d *WindowDirectory) Invalidate() {
+	d.mu.Lock()
+	defer d.mu.Unlock()
+	d.entries = make(map[ListOptions]windowEntry)
+}
+
+// get returns the windows matching opts and, if they came from the cache,
+// the enumeration they came from (0 if they were just enumerated). Only
+// lists from enumerations later than after are used, so that a lookup that
+// missed enumerates again — unless a concurrent lookup already has.
+func (d *WindowDirectory) get(opts ListOptions, after uint64) ([]model.Window, uint64, error) {
+	d.mu.Lock()
+	defer d.mu.Unlock()
+
+	usable := func(e windowEntry) bool {
+		return e.seq > after && d.now().Sub(e.fetched) < d.ttl
+	}
+	if e, ok := d.entries[opts]; ok && usable(e) {
+		return cloneWindows(e.windows), e.seq, nil
+	}
+	if all, ok := d.entries[ListOptions{Apps: opts.Apps}]; ok && usable(all) {
+		return filterWindows(all.windows, opts), all.seq, nil
+	}
+
+	windows, err := d.list(opts)
+	if err != nil {
+		return nil, 0, err
+	}
+	d.seq++
+	d.entries[opts] = windowEntry{windows: windows, fetched: d.now(), seq: d.seq}
+	return cloneWindows(windows), 0, nil
+}
+
+// filterWindows returns the windows matching the PID and App filters of
+// opts, in order.
+func filterWindows(windows []model.Window, opts ListOptions) []model.Window {
+	out := []model.Window{}
+	for _, w := range windows {
+		if opts.PID != 0 && w.PID != opts.PID {
+			continue
+		}
+		if opts.App != "" && !strings.EqualFold(w.App, opts.App) {
+			continue
+		}
+		out = append(out, w)
+	}
+	return out
+}
+
+// cloneWindows copies windows so that callers may reorder the slice they
+// are given (find sorts it) without touching the cache.
+func cloneWindows(windows []model.Window) []model.Window {
+	return append([]model.Window{}, windows...)
+}
@@ -0,0 +1,107 @@
+package platform
+
+import (
+	"strings"
+	"testing"
+	"time"
+
+	"github.com/mj1618/desktop-cli/internal/model"
+)
+
+// fakeWindows is a window lister that counts its enumerations.
+type fakeWindows struct {
+	windows []model.Window
+	calls   int
+}
+
+func (f *fakeWindows) list(opts ListOptions) ([]model.Window, error) {
+	f.calls++
+	out := []model.Window{}
+	for _, w := range f.windows {
+		if (opts.PID == 0 || w.PID == opts.PID) && (opts.App == "" || strings.EqualFold(w.App, opts.App)) {
+			out = append(out, w)
+		}
+	}
+	return out, nil
+}
+
+func newTestDirectory(f *fakeWindows) (*WindowDirectory, *time.Time) {
+	now := time.Unix(0, 0)
+	d := NewWindowDirectory(f.list, time.Second)
+	d.now = func() time.Time { return now }
+	return d, &now
+}
+
+func TestWindowDirectory_OneEnumerationPerCommand(t *testing.T) {
+	f := &fakeWindows{windows: []model.Window{
+		{App: "Safari", PID: 10, Title: "GitHub", ID: 100},
+		{App: "Mail", PID: 20, Title: "Inbox", ID: 200},
+		{App: "Mail", PID: 20, Title: "Compose", ID: 201},
+	}}
+	d, _ := newTestDirectory(f)
+
+	// Read, action and screenshot of the same target.
+	for i := 0; i < 3; i++ {
+		if pid, title, id := d.Resolve(ReadOptions{App: "Mail", Window: "compose"}); pid != 20 || title != "" || id != 201 {
+			t.Fatalf("Resolve = %d, %q, %d; want Compose in Mail", pid, title, id)
+		}
+	}
+	if w, err := d.Lookup(ListOptions{App: "Mail"}, "", 0); err != nil || w.ID != 200 {
+		t.Fatalf("Lookup = %+v, %v", w, err)
+	}
+	if f.calls != 1 {
+		t.Errorf("%d enumerations, want 1", f.calls)
+	}
+
+	// A list of all windows serves filtered requests.
+	all, _ := d.List(ListOptions{})
+	got, _ := d.List(ListOptions{App: "safari"})
+	if len(all) != 3 || len(got) != 1 || got[0].ID != 100 {
+		t.Errorf("List = %d windows, filtered %+v", len(all), got)
+	}
+	if pid, _, _ := d.Resolve(ReadOptions{WindowID: 100}); pid != 10 || f.calls != 2 {
+		t.Errorf("Resolve by window ID = pid %d after %d enumerations, want 10 after 2", pid, f.calls)
+	}
+}
+
+func TestWindowDirectory_RefreshesOnExpiryMissAndInvalidate(t *testing.T) {
+	f := &fakeWindows{windows: []model.Window{{App: "Mail", PID: 20, Title: "Inbox", ID: 200}}}
+	d, now := newTestDirectory(f)
+	d.List(ListOptions{})
+
+	// A window opened since the list was cached is found by enumerating again.
+	f.windows = append(f.windows, model.Window{App: "Mail", PID: 20, Title: "Compose", ID: 201})
+	if w, err := d.Lookup(ListOptions{}, "Compose", 0); err != nil || w.ID != 201 || f.calls != 2 {
+		t.Fatalf("Lookup of new window = %+v, %v after %d enumerations", w, err, f.calls)
+	}
+	if _, err := d.Lookup(ListOptions{}, "Drafts", 0); err == nil || f.calls != 3 {
+		t.Errorf("Lookup of missing window: err %v after %d enumerations, want an error after 3", err, f.calls)
+	}
+
+	*now = now.Add(2 * time.Second)
+	d.List(ListOptions{})
+	if f.calls != 4 {
+		t.Errorf("%d enumerations after the TTL, want 4", f.calls)
+	}
+	d.Invalidate()
+	d.List(ListOptions{})
+	if f.calls != 5 {
+		t.Errorf("%d enumerations after Invalidate, want 5", f.calls)
+	}
+}
+
+func TestWindowDirectory_ResolveKeepsUnlistedTitle(t *testing.T) {
+	// Window titles the system list does not know are left for the
+	// platform to match against the app's own windows.
+	f := &fakeWindows{windows: []model.Window{{App: "Mail", PID: 20, Title: "", ID: 200}}}
+	d, _ := newTestDirectory(f)
+	if pid, title, id := d.Resolve(ReadOptions{App: "Mail", Window: "Drafts"}); pid != 20 || title != "Drafts" || id != 0 {
+		t.Errorf("Resolve = %d, %q, %d; want pid 20 with the title to match", pid, title, id)
+	}
+	if pid, _, _ := d.Resolve(ReadOptions{App: "Notes"}); pid != 0 {
+		t.Errorf("Resolve of a missing app = pid %d, want 0", pid)
+	}
+	if pid, title, _ := d.Resolve(ReadOptions{PID: 7, Window: "x"}); pid != 7 || title != "x" {
+		t.Errorf("Resolve with PID = %d, %q", pid, title)
+	}
+}
@@ -38,7 +38,7 @@ func NewTreeCache(ttl time.Duration) *TreeCache {
 }
 
 // ReadElements returns cached elements if within TTL, otherwise reads fresh.
-// The caller must hold the provider mutex.
+// The caller must hold the provider (see Server.acquire).
 func (c *TreeCache) ReadElements(reader platform.Reader, opts platform.ReadOptions) ([]model.Element, error) {
 	if c.ttl == 0 {
 		return reader.ReadElements(opts)
@@ -61,7 +61,8 @@ func (c *TreeCache) ReadElements(reader platform.Reader, opts platform.ReadOptio
 
 	elements, err := reader.ReadElements(opts)
 	if err != nil {
-		return nil, err
+		// Truncated reads return a partial tree; pass it on but don't cache it.
+		return elements, err
 	}
 
 	c.mu.Lock()
@@ -3,6 +3,7 @@ package server
 import (
 	"context"
 	"encoding/base64"
+	"errors"
 	"fmt"
 
 	"github.com/mark3labs/mcp-go/mcp"
@@ -22,8 +23,9 @@ func resultToText(result cmd.StepResult) string {
 	return string(b)
 }
 
-// writeActionHandler wraps an executeX call: locks provider, executes, invalidates cache.
+// writeActionHandler wraps an executeX call: acquires the provider, executes, invalidates cache.
 func (s *Server) writeActionHandler(
+	ctx context.Context,
 	request mcp.CallToolRequest,
 	action string,
 	fn func(*platform.Provider, map[string]interface{}, string, string) (cmd.StepResult, error),
@@ -32,10 +34,13 @@ func (s *Server) writeActionHandler(
 	app := cmd.StringParam(params, "app", "")
 	window := cmd.StringParam(params, "window", "")
 
-	s.providerMu.Lock()
-	defer s.providerMu.Unlock()
+	p, release, err := s.acquire(ctx)
+	if err != nil {
+		return mcp.NewToolResultError(err.Error()), nil
+	}
+	defer release()
 
-	result, err := fn(s.provider, params, app, window)
+	result, err := fn(p, params, app, window)
 	if err != nil {
 		result.OK = false
 		result.Error = err.Error()
@@ -52,20 +57,23 @@ func (s *Server) writeActionHandler(
 	return mcp.NewToolResultText(resultToText(result)), nil
 }
 
-func (s *Server) handleList(_ context.Context, request mcp.CallToolRequest) (*mcp.CallToolResult, error) {
+func (s *Server) handleList(ctx context.Context, request mcp.CallToolRequest) (*mcp.CallToolResult, error) {
 	params := request.GetArguments()
 	apps := cmd.BoolParam(params, "apps", false)
 	pid := cmd.IntParam(params, "pid", 0)
 	appName := cmd.StringParam(params, "app", "")
 
-	s.providerMu.Lock()
-	defer s.providerMu.Unlock()
+	p, release, err := s.acquire(ctx)
+	if err != nil {
+		return mcp.NewToolResultError(err.Error()), nil
+	}
+	defer release()
 
-	if s.provider.Reader == nil {
+	if p.Reader == nil {
 		return mcp.NewToolResultError("reader not available on this platform"), nil
 	}
 
-	windows, err := s.provider.Reader.ListWindows(platform.ListOptions{
+	windows, err := p.Reader.ListWindows(platform.ListOptions{
 		Apps: apps,
 		PID:  pid,
 		App:  appName,
@@ -95,7 +103,7 @@ func (s *Server) handleList(_ context.Context, request mcp.CallToolRequest) (*mc
 	return mcp.NewToolResultText(string(b)), nil
 }
 
-func (s *Server) handleRead(_ context.Context, request mcp.CallToolRequest) (*mcp.CallToolResult, error) {
+func (s *Server) handleRead(ctx context.Context, request mcp.CallToolRequest) (*mcp.CallToolResult, error) {
 	params := request.GetArguments()
 	app := cmd.StringParam(params, "app", "")
 	window := cmd.StringParam(params, "window", "")
@@ -106,10 +114,13 @@ func (s *Server) handleRead(_ context.Context, request mcp.CallToolRequest) (*mc
 	text := cmd.StringParam(params, "text", "")
 	focused := cmd.BoolParam(params, "focused", false)
 
-	s.providerMu.Lock()
-	defer s.providerMu.Unlock()
+	p, release, err := s.acquire(ctx)
+	if err != nil {
+		return mcp.NewToolResultError(err.Error()), nil
+	}
+	defer release()
 
-	if s.provider.Reader == nil {
+	if p.Reader == nil {
 		return mcp.NewToolResultError("reader not available on this platform"), nil
 	}
 
@@ -121,8 +132,10 @@ func (s *Server) handleRead(_ context.Context, request mcp.CallToolRequest) (*mc
 		Depth:    depth,
 	}
 
-	elements, err := s.cache.ReadElements(s.provider.Reader, opts)
-	if err != nil {
+	// A read that ran out of time still returns what it reached.
+	elements, err := s.cache.ReadElements(p.Reader, opts)
+	truncated := errors.Is(err, platform.ErrTruncated)
+	if err != nil && !truncated {
 		return mcp.NewToolResultError(err.Error()), nil
 	}
 
@@ -163,47 +176,53 @@ func (s *Server) handleRead(_ context.Context, request mcp.CallToolRequest) (*mc
 	}
 
 	agentStr := output.FormatAgentString(app, pid, windowTitle, elements)
+	if truncated {
+		agentStr += output.TruncatedNote
+	}
 	return mcp.NewToolResultText(agentStr), nil
 }
 
-func (s *Server) handleClick(_ context.Context, request mcp.CallToolRequest) (*mcp.CallToolResult, error) {
-	return s.writeActionHandler(request, "click", cmd.ExecuteClick)
+func (s *Server) handleClick(ctx context.Context, request mcp.CallToolRequest) (*mcp.CallToolResult, error) {
+	return s.writeActionHandler(ctx, request, "click", cmd.ExecuteClick)
 }
 
-func (s *Server) handleType(_ context.Context, request mcp.CallToolRequest) (*mcp.CallToolResult, error) {
-	return s.writeActionHandler(request, "type", cmd.ExecuteType)
+func (s *Server) handleType(ctx context.Context, request mcp.CallToolRequest) (*mcp.CallToolResult, error) {
+	return s.writeActionHandler(ctx, request, "type", cmd.ExecuteType)
 }
 
-func (s *Server) handleAction(_ context.Context, request mcp.CallToolRequest) (*mcp.CallToolResult, error) {
-	return s.writeActionHandler(request, "action", cmd.ExecuteAction)
+func (s *Server) handleAction(ctx context.Context, request mcp.CallToolRequest) (*mcp.CallToolResult, error) {
+	return s.writeActionHandler(ctx, request, "action", cmd.ExecuteAction)
 }
 
-func (s *Server) handleSetValue(_ context.Context, request mcp.CallToolRequest) (*mcp.CallToolResult, error) {
-	return s.writeActionHandler(request, "set_value", cmd.ExecuteSetValue)
+func (s *Server) handleSetValue(ctx context.Context, request mcp.CallToolRequest) (*mcp.CallToolResult, error) {
+	return s.writeActionHandler(ctx, request, "set_value", cmd.ExecuteSetValue)
 }
 
-func (s *Server) handleScroll(_ context.Context, request mcp.CallToolRequest) (*mcp.CallToolResult, error) {
-	return s.writeActionHandler(request, "scroll", cmd.ExecuteScroll)
+func (s *Server) handleScroll(ctx context.Context, request mcp.CallToolRequest) (*mcp.CallToolResult, error) {
+	return s.writeActionHandler(ctx, request, "scroll", cmd.ExecuteScroll)
 }
 
-func (s *Server) handleHover(_ context.Context, request mcp.CallToolRequest) (*mcp.CallToolResult, error) {
-	return s.writeActionHandler(request, "hover", cmd.ExecuteHover)
+func (s *Server) handleHover(ctx context.Context, request mcp.CallToolRequest) (*mcp.CallToolResult, error) {
+	return s.writeActionHandler(ctx, request, "hover", cmd.ExecuteHover)
 }
 
-func (s *Server) handleFocus(_ context.Context, request mcp.CallToolRequest) (*mcp.CallToolResult, error) {
-	return s.writeActionHandler(request, "focus", cmd.ExecuteFocus)
+func (s *Server) handleFocus(ctx context.Context, request mcp.CallToolRequest) (*mcp.CallToolResult, error) {
+	return s.writeActionHandler(ctx, request, "focus", cmd.ExecuteFocus)
 }
 
-func (s *Server) handleFill(_ context.Context, request mcp.CallToolRequest) (*mcp.CallToolResult, error) {
+func (s *Server) handleFill(ctx context.Context, request mcp.CallToolRequest) (*mcp.CallToolResult, error) {
 	params := request.GetArguments()
 	app := cmd.StringParam(params, "app", "")
 	window := cmd.StringParam(params, "window", "")
 
-	s.providerMu.Lock()
-	defer s.providerMu.Unlock()
+	p, release, err := s.acquire(ctx)
+	if err != nil {
+		return mcp.NewToolResultError(err.Error()), nil
+	}
+	defer release()
 
 	// ExecuteStep handles fill dispatch
-	result, err := cmd.ExecuteStep(s.provider, "fill", params, app, window)
+	result, err := cmd.ExecuteStep(p, "fill", params, app, window)
 	if err != nil {
 		result.OK = false
 		result.Error = err.Error()
@@ -223,10 +242,13 @@ func (s *Server) handleWait(ctx context.Context, request mcp.CallToolRequest) (*
 	app := cmd.StringParam(params, "app", "")
 	window := cmd.StringParam(params, "window", "")
 
-	s.providerMu.Lock()
-	defer s.providerMu.Unlock()
+	p, release, err := s.acquire(ctx)
+	if err != nil {
+		return mcp.NewToolResultError(err.Error()), nil
+	}
+	defer release()
 
-	result, err := cmd.ExecuteWait(s.provider, params, app, window)
+	result, err := cmd.ExecuteWait(p, params, app, window)
 	if err != nil {
 		result.OK = false
 		result.Error = err.Error()
@@ -236,15 +258,18 @@ func (s *Server) handleWait(ctx context.Context, request mcp.CallToolRequest) (*
 	return mcp.NewToolResultText(resultToText(result)), nil
 }
 
-func (s *Server) handleAssert(_ context.Context, request mcp.CallToolRequest) (*mcp.CallToolResult, error) {
+func (s *Server) handleAssert(ctx context.Context, request mcp.CallToolRequest) (*mcp.CallToolResult, error) {
 	params := request.GetArguments()
 	app := cmd.StringParam(params, "app", "")
 	window := cmd.StringParam(params, "window", "")
 
-	s.providerMu.Lock()
-	defer s.providerMu.Unlock()
+	p, release, err := s.acquire(ctx)
+	if err != nil {
+		return mcp.NewToolResultError(err.Error()), nil
+	}
+	defer release()
 
-	result, err := cmd.ExecuteAssert(s.provider, params, app, window)
+	result, err := cmd.ExecuteAssert(p, params, app, window)
 	if err != nil {
 		result.OK = false
 		result.Error = err.Error()
@@ -267,7 +292,7 @@ func (s *Server) handleOpen(_ context.Context, request mcp.CallToolRequest) (*mc
 	return mcp.NewToolResultText(resultToText(result)), nil
 }
 
-func (s *Server) handleScreenshot(_ context.Context, request mcp.CallToolRequest) (*mcp.CallToolResult, error) {
+func (s *Server) handleScreenshot(ctx context.Context, request mcp.CallToolRequest) (*mcp.CallToolResult, error) {
 	params := request.GetArguments()
 	app := cmd.StringParam(params, "app", "")
 	window := cmd.StringParam(params, "window", "")
@@ -282,14 +307,17 @@ func (s *Server) handleScreenshot(_ context.Context, request mcp.CallToolRequest
 		}
 	}
 
-	s.providerMu.Lock()
-	defer s.providerMu.Unlock()
+	p, release, err := s.acquire(ctx)
+	if err != nil {
+		return mcp.NewToolResultError(err.Error()), nil
+	}
+	defer release()
 
-	if s.provider.Screenshotter == nil {
+	if p.Screenshotter == nil {
 		return mcp.NewToolResultError("screenshot not supported on this platform"), nil
 	}
 
-	data, err := s.provider.Screenshotter.CaptureWindow(platform.ScreenshotOptions{
+	data, err := p.Screenshotter.CaptureWindow(platform.ScreenshotOptions{
 		App:      app,
 		Window:   window,
 		WindowID: windowID,
@@ -319,7 +347,7 @@ func (s *Server) handleScreenshot(_ context.Context, request mcp.CallToolRequest
 	}, nil
 }
 
-func (s *Server) handleDo(_ context.Context, request mcp.CallToolRequest) (*mcp.CallToolResult, error) {
+func (s *Server) handleDo(ctx context.Context, request mcp.CallToolRequest) (*mcp.CallToolResult, error) {
 	params := request.GetArguments()
 	app := cmd.StringParam(params, "app", "")
 	window := cmd.StringParam(params, "window", "")
@@ -344,24 +372,36 @@ func (s *Server) handleDo(_ context.Context, request mcp.CallToolRequest) (*mcp.
 		steps = append(steps, m)
 	}
 
-	s.providerMu.Lock()
-	defer s.providerMu.Unlock()
+	// Validate the whole batch before touching the UI.
+	plan, err := s.plans.Compile(steps, app, window)
+	if err != nil {
+		return mcp.NewToolResultError(err.Error()), nil
+	}
+
+	p, release, err := s.acquire(ctx)
+	if err != nil {
+		return mcp.NewToolResultError(err.Error()), nil
+	}
+	defer release()
 
 	doCtx := &cmd.DoContext{
-		Provider:      s.provider,
+		Provider:      p,
 		DefaultApp:    app,
 		DefaultWindow: window,
 		StopOnError:   stopOnError,
 	}
-	doCtx.ExecuteSteps(steps, 0)
+	doCtx.ExecutePlan(plan)
 
 	s.cache.InvalidateAll()
 
 	doResult := cmd.DoResult{
 		OK:      !doCtx.HasFailure,
 		Action:  "do",
-		Steps:   len(steps),
+		Steps:   plan.Len(),
 		Results: doCtx.Results,
+
+		TraversalsSaved: doCtx.TraversalsSaved(),
+		PrefetchHits:    doCtx.PrefetchHits(),
 	}
 	completed := 0
 	for _, r := range doCtx.Results {
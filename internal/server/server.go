@@ -1,28 +1,32 @@
 package server
 
 import (
+	"context"
 	"fmt"
-	"sync"
 	"time"
 
 	"github.com/mark3labs/mcp-go/mcp"
 	mcpserver "github.com/mark3labs/mcp-go/server"
+	"github.com/mj1618/desktop-cli/cmd"
 	"github.com/mj1618/desktop-cli/internal/platform"
 )
 
 // Server wraps the MCP server with the platform provider and cache.
 type Server struct {
-	provider   *platform.Provider
-	cache      *TreeCache
-	providerMu sync.Mutex
-	mcpServer  *mcpserver.MCPServer
+	provider       *platform.Provider
+	cache          *TreeCache
+	plans          *cmd.DoPlanCache
+	providerSem    chan struct{} // held by the request using the provider
+	requestTimeout time.Duration
+	mcpServer      *mcpserver.MCPServer
 }
 
 // Config holds MCP server configuration.
 type Config struct {
-	Transport string
-	Port      int
-	CacheTTL  time.Duration
+	Transport      string
+	Port           int
+	CacheTTL       time.Duration
+	RequestTimeout time.Duration // 0 = only the client's cancellation
 }
 
 // New creates and configures an MCP server with all desktop-cli tools.
@@ -33,8 +37,11 @@ func New(cfg Config) (*Server, error) {
 	}
 
 	s := &Server{
-		provider: provider,
-		cache:    NewTreeCache(cfg.CacheTTL),
+		provider:       provider,
+		cache:          NewTreeCache(cfg.CacheTTL),
+		plans:          cmd.NewDoPlanCache(0),
+		providerSem:    make(chan struct{}, 1),
+		requestTimeout: cfg.RequestTimeout,
 	}
 
 	s.mcpServer = mcpserver.NewMCPServer(
@@ -46,6 +53,42 @@ func New(cfg Config) (*Server, error) {
 	return s, nil
 }
 
+// abandonedWriteLimit is how long the next request waits for the input,
+// action or set-value calls a request left running when it ran out of time:
+// long enough for a slow app to finish, so that their input does not
+// interleave, but bounded so that an app that never returns does not lock
+// the server.
+const abandonedWriteLimit = 5 * time.Second
+
+// acquire takes the provider for one request and returns it bound to the
+// request's context, limited to the server's request timeout: reads that
+// run out of time return the part of the tree read so far, and a hung app
+// no longer holds up the requests queued behind it. Requests use the
+// provider one at a time; one still waiting when its context is done gives
+// up. Call release when done: the next request gets the provider once any
+// input, action or set-value call the request abandoned when it ran out of
+// time has returned, or after abandonedWriteLimit.
+func (s *Server) acquire(ctx context.Context) (p *platform.Provider, release func(), err error) {
+	cancel := func() {}
+	if s.requestTimeout > 0 {
+		ctx, cancel = context.WithTimeout(ctx, s.requestTimeout)
+	}
+	select {
+	case s.providerSem <- struct{}{}:
+	case <-ctx.Done():
+		cancel()
+		return nil, nil, fmt.Errorf("gave up waiting for an earlier request to finish: %w", ctx.Err())
+	}
+	p, wait := platform.WithContextWait(ctx, s.provider)
+	return p, func() {
+		cancel()
+		go func() {
+			wait(abandonedWriteLimit)
+			<-s.providerSem
+		}()
+	}, nil
+}
+
 // Serve starts the MCP server with the configured transport.
 func (s *Server) Serve(cfg Config) error {
 	switch cfg.Transport {
@@ -123,6 +166,7 @@ func (s *Server) registerTools() {
 			mcp.WithBoolean("exact", mcp.Description("Require exact text match")),
 			mcp.WithNumber("scope-id", mcp.Description("Limit text search")),
 			mcp.WithNumber("delay", mcp.Description("Delay between keystrokes in ms")),
+			mcp.WithBoolean("keypad", mcp.Description("Type by pressing on-screen keys (Calculator, PIN pads); on by default for Calculator")),
 		),
 		s.handleType,
 	)
@@ -294,7 +338,7 @@ func (s *Server) registerTools() {
 	// do (batch)
 	s.mcpServer.AddTool(
 		mcp.NewTool("do",
-			mcp.WithDescription("Execute multiple actions in a batch. Steps execute sequentially. Supports: click, type, action, set-value, scroll, hover, focus, wait, assert, fill, read, open, sleep, if-exists, if-focused, try"),
+			mcp.WithDescription("Execute multiple actions in a batch. Steps execute sequentially; the substeps of a parallel step run concurrently. Supports: click, type, action, set-value, scroll, hover, focus, wait, assert, fill, read, open, sleep, if-exists, if-focused, try, parallel"),
 			mcp.WithString("app", mcp.Description("Default app for all steps")),
 			mcp.WithString("window", mcp.Description("Default window for all steps")),
 			mcp.WithArray("steps", mcp.Description("Array of step objects"), mcp.Required()),